@@ -2,12 +2,14 @@
 #include "fdctl.h"
 
 #include "run/run.h"
+#include "run/tiles/fd_verify.h"
 
 #include "../../disco/topo/fd_topob.h"
 #include "../../disco/topo/fd_pod_format.h"
 #include "../../util/net/fd_eth.h"
 #include "../../util/net/fd_ip4.h"
 #include "../../util/tile/fd_tile_private.h"
+#include "../../waltz/xdp/fd_xdp_redirect_prog.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -216,6 +218,12 @@ static int parse_key_value( config_t *   config,
   ENTRY_UINT  ( ., tiles.net,           xdp_rx_queue_size                                         );
   ENTRY_UINT  ( ., tiles.net,           xdp_tx_queue_size                                         );
   ENTRY_UINT  ( ., tiles.net,           xdp_aio_depth                                             );
+  ENTRY_UINT  ( ., tiles.net,           xdp_queues_per_tile                                       );
+  ENTRY_BOOL  ( ., tiles.net,           rss_flow_steering                                         );
+  ENTRY_UINT  ( ., tiles.net,           shred_coalesce_max                                        );
+  ENTRY_UINT  ( ., tiles.net,           xdp_busy_poll_usecs                                       );
+  ENTRY_UINT  ( ., tiles.net,           xdp_busy_poll_budget                                      );
+  ENTRY_BOOL  ( ., tiles.net,           xdp_adaptive_wakeup                                       );
   ENTRY_UINT  ( ., tiles.net,           send_buffer_size                                          );
 
   ENTRY_USHORT( ., tiles.quic,          regular_transaction_listen_port                           );
@@ -506,6 +514,8 @@ fdctl_obj_align( fd_topo_t const *     topo,
     return fd_tpu_reasm_align();
   } else if( FD_UNLIKELY( !strcmp( obj->name, "fseq" ) ) ) {
     return fd_fseq_align();
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "tcache_shared" ) ) ) {
+    return fd_tcache_shared_align();
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     return FD_METRICS_ALIGN;
   } else {
@@ -543,6 +553,8 @@ fdctl_obj_footprint( fd_topo_t const *     topo,
     return fd_tpu_reasm_footprint( VAL("depth"), VAL("burst") );
   } else if( FD_UNLIKELY( !strcmp( obj->name, "fseq" ) ) ) {
     return fd_fseq_footprint();
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "tcache_shared" ) ) ) {
+    return fd_tcache_shared_footprint( VAL("set_cnt") );
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     return FD_METRICS_FOOTPRINT( VAL("in_cnt"), VAL("out_cnt") );
   } else {
@@ -584,6 +596,9 @@ topo_initialize( config_t * config ) {
   ulong verify_tile_cnt = config->layout.verify_tile_count;
   ulong bank_tile_cnt   = config->layout.bank_tile_count;
 
+  /* Net tiles coalescing shreds publish frags of up to a whole batch */
+  ulong net_mtu = fd_ulong_if( config->tiles.net.shred_coalesce_max>1U, FD_NET_SHRED_BATCH_MTU( config->tiles.net.shred_coalesce_max ), FD_NET_MTU );
+
   fd_topo_t topo[1] = { fd_topob_new( config->name ) };
 
   /*             topo, name */
@@ -594,6 +609,7 @@ topo_initialize( config_t * config ) {
   fd_topob_wksp( topo, "pack_bank"    );
   fd_topob_wksp( topo, "bank_poh"     );
   fd_topob_wksp( topo, "bank_busy"    );
+  fd_topob_wksp( topo, "verify_tcache" );
   fd_topob_wksp( topo, "poh_shred"    );
   fd_topob_wksp( topo, "shred_store"  );
   fd_topob_wksp( topo, "stake_out"    );
@@ -620,12 +636,12 @@ topo_initialize( config_t * config ) {
   #define FOR(cnt) for( ulong i=0UL; i<cnt; i++ )
 
   /*                                  topo, link_name,      wksp_name,      is_reasm, depth,                                    mtu,                    burst */
-  FOR(net_tile_cnt)    fd_topob_link( topo, "net_netmux",   "netmux_inout", 0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
+  FOR(net_tile_cnt)    fd_topob_link( topo, "net_netmux",   "netmux_inout", 0,        config->tiles.net.send_buffer_size,       net_mtu,                1UL );
   /**/                 fd_topob_link( topo, "netmux_out",   "netmux_inout", 0,        config->tiles.net.send_buffer_size,       0UL,                    1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_netmux",  "netmux_inout", 0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   /**/                 fd_topob_link( topo, "shred_netmux", "netmux_inout", 0,        config->tiles.net.send_buffer_size,       FD_NET_MTU,             1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  1,        config->tiles.verify.receive_buffer_size, 0UL,                    config->tiles.quic.txn_reassembly_count );
-  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
+  FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", 0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      VERIFY_BATCH_TXN_MAX );
   /**/                 fd_topob_link( topo, "dedup_pack",   "dedup_pack",   0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
   /* gossip_pack could be FD_TPU_MTU for now, since txns are not parsed, but better to just share one size for all the ins of pack */
   /**/                 fd_topob_link( topo, "gossip_pack",  "dedup_pack",   0,        config->tiles.verify.receive_buffer_size, FD_TPU_DCACHE_MTU,      1UL );
@@ -636,7 +652,7 @@ topo_initialize( config_t * config ) {
   /**/                 fd_topob_link( topo, "poh_shred",    "poh_shred",    0,        128UL,                                    USHORT_MAX,             1UL );
   /**/                 fd_topob_link( topo, "crds_shred",   "poh_shred",    0,        128UL,                                    8UL  + 40200UL * 38UL,  1UL );
   /* See long comment in fd_shred.c for an explanation about the size of this dcache. */
-  /**/                 fd_topob_link( topo, "shred_store",  "shred_store",  0,        16384UL,                                  4UL*FD_SHRED_STORE_MTU, 4UL+config->tiles.shred.max_pending_shred_sets );
+  /**/                 fd_topob_link( topo, "shred_store",  "shred_store",  0,        16384UL,                                  4UL*FD_SHRED_STORE_MTU, 4UL+FD_SHRED_SIGN_INFLIGHT_MAX+config->tiles.shred.max_pending_shred_sets );
 
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_sign",    "quic_sign",    0,        128UL,                                    130UL,                  1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "sign_quic",    "sign_quic",    0,        128UL,                                    64UL,                   1UL );
@@ -754,6 +770,19 @@ topo_initialize( config_t * config ) {
     FD_TEST( fd_pod_insertf_ulong( topo->props, busy_obj->id, "bank_busy.%lu", i ) );
   }
 
+  /* The verify tiles share a cache of the txns they recently verified,
+     so that a duplicate arriving at one verify tile after another one
+     verified the original is dropped without verifying it again.  The
+     dedup tile still does the authoritative deduplication. */
+
+  fd_topo_obj_t * verify_tcache_obj = fd_topob_obj( topo, "tcache_shared", "verify_tcache" );
+  for( ulong i=0UL; i<verify_tile_cnt; i++ ) {
+    fd_topo_tile_t * verify_tile = &topo->tiles[ fd_topo_find_tile( topo, "verify", i ) ];
+    fd_topob_tile_uses( topo, verify_tile, verify_tcache_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  }
+  FD_TEST( fd_pod_insertf_ulong( topo->props, VERIFY_SHARED_TCACHE_SET_CNT, "obj.%lu.set_cnt", verify_tcache_obj->id ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, verify_tcache_obj->id, "verify_tcache" ) );
+
   /* There's another special fseq that's used to communicate the shred
      version from the Solana Labs boot path to the shred tile. */
   fd_topo_obj_t * poh_shred_obj = fd_topob_obj( topo, "fseq", "poh_shred" );
@@ -774,6 +803,12 @@ topo_initialize( config_t * config ) {
       tile->net.xdp_aio_depth     = config->tiles.net.xdp_aio_depth;
       tile->net.xdp_rx_queue_size = config->tiles.net.xdp_rx_queue_size;
       tile->net.xdp_tx_queue_size = config->tiles.net.xdp_tx_queue_size;
+      tile->net.xdp_queue_cnt     = config->tiles.net.xdp_queues_per_tile;
+      tile->net.flow_steering     = config->tiles.net.rss_flow_steering;
+      tile->net.shred_coalesce_max = config->tiles.net.shred_coalesce_max;
+      tile->net.busy_poll_usecs   = config->tiles.net.xdp_busy_poll_usecs;
+      tile->net.busy_poll_budget  = config->tiles.net.xdp_busy_poll_budget;
+      tile->net.adaptive_wakeup   = config->tiles.net.xdp_adaptive_wakeup;
       tile->net.src_ip_addr       = config->tiles.net.ip_addr;
       tile->net.shred_listen_port = config->tiles.shred.shred_listen_port;
       tile->net.quic_transaction_listen_port   = config->tiles.quic.quic_transaction_listen_port;
@@ -824,6 +859,7 @@ topo_initialize( config_t * config ) {
       tile->shred.fec_resolver_depth     = config->tiles.shred.max_pending_shred_sets;
       tile->shred.expected_shred_version = config->consensus.expected_shred_version;
       tile->shred.shred_listen_port      = config->tiles.shred.shred_listen_port;
+      tile->shred.shred_coalesce_max     = config->tiles.net.shred_coalesce_max;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "store" ) ) ) {
 
@@ -892,6 +928,44 @@ validate_ports( config_t * result ) {
                  result->dynamic_port_range ));
 }
 
+static void
+validate_net( config_t * result ) {
+  uint queues_per_tile = result->tiles.net.xdp_queues_per_tile;
+  if( FD_UNLIKELY( !queues_per_tile || queues_per_tile>NET_XDP_QUEUES_PER_TILE_MAX ) )
+    FD_LOG_ERR(( "configuration specifies invalid [tiles.net.xdp_queues_per_tile] `%u`. "
+                 "This must be between 1 and %u",
+                 queues_per_tile, NET_XDP_QUEUES_PER_TILE_MAX ));
+
+  ulong queue_cnt = (ulong)result->layout.net_tile_count * (ulong)queues_per_tile;
+  if( FD_UNLIKELY( queue_cnt>FD_XDP_XSKS_MAP_CNT ) )
+    FD_LOG_ERR(( "configuration specifies %lu network device queues "
+                 "([layout.net_tile_count] times [tiles.net.xdp_queues_per_tile]), "
+                 "but at most %u are supported", queue_cnt, FD_XDP_XSKS_MAP_CNT ));
+
+  if( FD_UNLIKELY( queues_per_tile>1U && !strcmp( result->tiles.net.interface, "lo" ) ) )
+    FD_LOG_ERR(( "configuration specifies [tiles.net.xdp_queues_per_tile] `%u` but the "
+                 "loopback device has only one queue", queues_per_tile ));
+
+  if( FD_UNLIKELY( !result->tiles.net.shred_coalesce_max || result->tiles.net.shred_coalesce_max>FD_NET_SHRED_BATCH_MAX ) )
+    FD_LOG_ERR(( "configuration specifies invalid [tiles.net.shred_coalesce_max] `%u`. "
+                 "This must be between 1 and %lu",
+                 result->tiles.net.shred_coalesce_max, FD_NET_SHRED_BATCH_MAX ));
+
+  if( FD_UNLIKELY( result->tiles.net.xdp_busy_poll_budget>USHORT_MAX ) )
+    FD_LOG_ERR(( "configuration specifies invalid [tiles.net.xdp_busy_poll_budget] `%u`. "
+                 "This must be at most %u",
+                 result->tiles.net.xdp_busy_poll_budget, (uint)USHORT_MAX ));
+
+  /* With flow steering, the network device queue a packet arrived on
+     selects the QUIC tile that handles it, so for the QUIC tiles to be
+     evenly loaded each must get the same number of queues. */
+  if( FD_UNLIKELY( result->tiles.net.rss_flow_steering && queue_cnt%result->layout.quic_tile_count ) )
+    FD_LOG_ERR(( "configuration enables [tiles.net.rss_flow_steering] with %lu network "
+                 "device queues ([layout.net_tile_count] times [tiles.net.xdp_queues_per_tile]) "
+                 "which is not a multiple of [layout.quic_tile_count] `%u`",
+                 queue_cnt, result->layout.quic_tile_count ));
+}
+
 /* These CLUSTER_* values must be ordered from least important to most
    important network.  Eg, it's important that if a config has the
    MAINNET_BETA genesis hash, but has a bunch of entrypoints that we
@@ -1172,6 +1246,7 @@ config_parse( int *      pargc,
   }
 
   validate_ports( config );
+  validate_net( config );
   topo_initialize( config );
 }
 
@@ -14,6 +14,9 @@
 /* Maximum size of the string describing the CPU affinity of Firedancer */
 #define AFFINITY_SZ 256
 
+/* Maximum number of network device queues serviced by one net tile */
+#define NET_XDP_QUEUES_PER_TILE_MAX 4
+
 /* config_t represents all available configuration options that could be
    set in a user defined configuration toml file. For information about
    the options, see the `default.toml` file provided. */
@@ -157,6 +160,12 @@ typedef struct {
       uint xdp_rx_queue_size;
       uint xdp_tx_queue_size;
       uint xdp_aio_depth;
+      uint xdp_queues_per_tile;
+      int  rss_flow_steering;
+      uint shred_coalesce_max;
+      uint xdp_busy_poll_usecs;
+      uint xdp_busy_poll_budget;
+      int  xdp_adaptive_wakeup;
 
       uint send_buffer_size;
     } net;
@@ -90,8 +90,10 @@ init_device( const char * device,
 
 static void
 init( config_t * const config ) {
-  /* we need one channel for both TX and RX on the NIC for each QUIC
-     tile, but the interface probably defaults to one channel total */
+  /* we need one channel for both TX and RX on the NIC for each queue
+     serviced by a net tile, but the interface probably defaults to one
+     channel total */
+  uint channel_cnt = config->layout.net_tile_count*config->tiles.net.xdp_queues_per_tile;
   if( FD_UNLIKELY( device_is_bonded( config->tiles.net.interface ) ) ) {
     /* if using a bonded device, we need to set channels on the
        underlying devices. */
@@ -99,10 +101,10 @@ init( config_t * const config ) {
     device_read_slaves( config->tiles.net.interface, line );
     char * saveptr;
     for( char * token=strtok_r( line , " \t", &saveptr ); token!=NULL; token=strtok_r( NULL, " \t", &saveptr ) ) {
-      init_device( token, config->layout.net_tile_count );
+      init_device( token, channel_cnt );
     }
   } else {
-    init_device( config->tiles.net.interface, config->layout.net_tile_count );
+    init_device( config->tiles.net.interface, channel_cnt );
   }
 }
 
@@ -146,13 +148,14 @@ check_device( const char * device,
   if( FD_UNLIKELY( current_channels != expected_channel_count ) ) {
     if( FD_UNLIKELY( !supports_channels ) )
       FD_LOG_ERR(( "Network device `%s` does not support setting number of channels, "
-                   "but you are running with more than one net tile (expected {%u}), "
-                   "and there must be one channel per tile. You can either use a NIC "
+                   "but you are running with more than one net tile queue (expected {%u}), "
+                   "and there must be one channel per queue. You can either use a NIC "
                    "that supports multiple channels, or run Firedancer with only one "
-                   "net tile. You can configure Firedancer to run with only one QUIC "
-                   "tile by setting `layout.net_tile_count` to 1 in your "
-                   "configuration file. It is not recommended to do this in production "
-                   "as it will limit network performance.",
+                   "net tile. You can configure Firedancer to run with only one net "
+                   "tile queue by setting `layout.net_tile_count` and "
+                   "`tiles.net.xdp_queues_per_tile` to 1 in your configuration file. "
+                   "It is not recommended to do this in production as it will limit "
+                   "network performance.",
                    device, expected_channel_count ));
       else
         NOT_CONFIGURED( "device `%s` does not have right number of channels, "
@@ -165,15 +168,16 @@ check_device( const char * device,
 
 static configure_result_t
 check( config_t * const config ) {
+  uint channel_cnt = config->layout.net_tile_count*config->tiles.net.xdp_queues_per_tile;
   if( FD_UNLIKELY( device_is_bonded( config->tiles.net.interface ) ) ) {
     char line[ 4096 ];
     device_read_slaves( config->tiles.net.interface, line );
     char * saveptr;
     for( char * token=strtok_r( line, " \t", &saveptr ); token!=NULL; token=strtok_r( NULL, " \t", &saveptr ) ) {
-      CHECK( check_device( token, config->layout.net_tile_count ) );
+      CHECK( check_device( token, channel_cnt ) );
     }
   } else {
-    CHECK( check_device( config->tiles.net.interface, config->layout.net_tile_count ) );
+    CHECK( check_device( config->tiles.net.interface, channel_cnt ) );
   }
 
   CONFIGURE_OK();
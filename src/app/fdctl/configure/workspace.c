@@ -57,6 +57,8 @@ fdctl_obj_new( fd_topo_t const *     topo,
     fd_tpu_reasm_new( laddr, VAL("depth"), VAL("burst"), 0UL );
   } else if( FD_UNLIKELY( !strcmp( obj->name, "fseq" ) ) ) {
     fd_fseq_new( laddr, ULONG_MAX );
+  } else if( FD_UNLIKELY( !strcmp( obj->name, "tcache_shared" ) ) ) {
+    fd_tcache_shared_new( laddr, VAL("set_cnt"), (ulong)fd_tickcount() );
   } else if( FD_UNLIKELY( !strcmp( obj->name, "metrics" ) ) ) {
     fd_metrics_new( laddr, VAL("in_cnt"), VAL("out_cnt") );
   } else {
@@ -249,6 +249,9 @@ prometheus_print( fd_topo_t * topo,
   result = prometheus_print1( topo, out, out_len, NULL, FD_METRICS_ALL_LINK_OUT_TOTAL, FD_METRICS_ALL_LINK_OUT, PRINT_LINK_OUT );
   if( FD_UNLIKELY( result<0 ) ) return result;
   PRINT( "\n" );
+  result = prometheus_print1( topo, out, out_len, "net", FD_METRICS_NET_TOTAL, FD_METRICS_NET, PRINT_TILE );
+  if( FD_UNLIKELY( result<0 ) ) return result;
+  PRINT( "\n" );
   result = prometheus_print1( topo, out, out_len, "quic", FD_METRICS_QUIC_TOTAL, FD_METRICS_QUIC, PRINT_TILE );
   if( FD_UNLIKELY( result<0 ) ) return result;
   PRINT( "\n" );
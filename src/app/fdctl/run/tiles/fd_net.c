@@ -1,4 +1,4 @@
-#include "tiles.h"
+#include "fd_net.h"
 
 #include <sys/socket.h> /* MSG_DONTWAIT needed before importing the net seccomp filter */
 #include "generated/net_seccomp.h"
@@ -10,17 +10,63 @@
 
 #include <linux/unistd.h>
 
+/* The net tile reads outgoing frags in bursts of up to
+   NET_TX_BURST_MAX.  Each packet is enqueued on the XSK TX ring as it is
+   read, and the kernel is woken up (a sendto syscall) once at the end of
+   the burst rather than once per packet. */
+
+#define NET_TX_BURST_MAX (64UL)
+
+/* The net tile services the network device queues [xdp_queue0,
+   xdp_queue0+xdp_queue_cnt) with xdp_queue0 = kind_id*xdp_queue_cnt,
+   with one XSK per queue.  Net tile 0 additionally services the single
+   queue of the loopback device, unless that is the network device. */
+
+#define NET_XSK_MAX (NET_XDP_QUEUES_PER_TILE_MAX+1UL)
+
 typedef struct {
+  /* xsk_aio[ i ] for i in [0,xdp_queue_cnt) is the XSK of network
+     device queue xdp_queue0+i, xsk_aio[ lo_xsk_aio_idx ] is the XSK of
+     the loopback device. */
   ulong xsk_aio_cnt;
-  fd_xsk_aio_t * xsk_aio[ 2 ];
+  fd_xsk_aio_t * xsk_aio[ NET_XSK_MAX ];
+  fd_xsk_t *     xsk    [ NET_XSK_MAX ];
+  ulong xdp_queue_cnt;
+  ulong xdp_queue0;
 
   ulong round_robin_cnt;
   ulong round_robin_id;
 
+  /* If flow_steering, incoming packets are published with the id of
+     the network device queue they arrived on (rx_queue_id while
+     rx_steer is set, see before_credit) in place of the software hash
+     of their source address. */
+  int   flow_steering;
+  int   rx_steer;
+  ulong rx_queue_id;
+
+  /* If shred_coalesce_max>1, incoming shred packets are published in
+     batches of up to shred_coalesce_max (see fd_net_shred_batch_t).
+     shred_batch is the batch being built in the dcache at out_chunk, or
+     NULL if there is none. */
+  ulong                  shred_coalesce_max;
+  fd_net_shred_batch_t * shred_batch;
+
   const fd_aio_t * tx;
-  const fd_aio_t * lo_tx;
+  ulong            lo_xsk_aio_idx;
+
+  /* Outgoing packets that are not for loopback go out on
+     xsk_aio[ tx_queue_idx ], which changes with every burst. */
+  ulong            tx_queue_idx;
 
-  uchar frame[ FD_NET_MTU ];
+  /* The outgoing frame being processed is written directly into an XSK
+     TX frame of xsk_aio[ tx_xsk_aio_idx ] at tx_frame (see during_frag) */
+  ulong            tx_xsk_aio_idx;
+  uchar *          tx_frame;
+
+  /* tx_unflushed[ i ] is non-zero if packets were enqueued on
+     xsk_aio[ i ] since it was last flushed */
+  int              tx_unflushed[ NET_XSK_MAX ];
 
   fd_mux_context_t * mux;
 
@@ -45,8 +91,9 @@ typedef struct {
 } fd_net_ctx_t;
 
 typedef struct {
-  fd_xsk_t * xsk;
-  void *     xsk_aio;
+  ulong      xsk_cnt;
+  fd_xsk_t * xsk    [ NET_XDP_QUEUES_PER_TILE_MAX ];
+  void *     xsk_aio[ NET_XDP_QUEUES_PER_TILE_MAX ];
 
   fd_xsk_t * lo_xsk;
   void *     lo_xsk_aio;
@@ -66,8 +113,10 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   l = FD_LAYOUT_APPEND( l, alignof( fd_net_init_ctx_t ), sizeof( fd_net_init_ctx_t ) );
   l = FD_LAYOUT_APPEND( l, alignof( fd_net_ctx_t ),      sizeof( fd_net_ctx_t ) );
   l = FD_LAYOUT_APPEND( l, fd_aio_align(),               fd_aio_footprint() );
-  l = FD_LAYOUT_APPEND( l, fd_xsk_align(),               fd_xsk_footprint( FD_NET_MTU, tile->net.xdp_rx_queue_size, tile->net.xdp_rx_queue_size, tile->net.xdp_tx_queue_size, tile->net.xdp_tx_queue_size ) );
-  l = FD_LAYOUT_APPEND( l, fd_xsk_aio_align(),           fd_xsk_aio_footprint( tile->net.xdp_tx_queue_size, tile->net.xdp_aio_depth ) );
+  for( ulong i=0UL; i<tile->net.xdp_queue_cnt; i++ ) {
+    l = FD_LAYOUT_APPEND( l, fd_xsk_align(),     fd_xsk_footprint( FD_NET_MTU, tile->net.xdp_rx_queue_size, tile->net.xdp_rx_queue_size, tile->net.xdp_tx_queue_size, tile->net.xdp_tx_queue_size ) );
+    l = FD_LAYOUT_APPEND( l, fd_xsk_aio_align(), fd_xsk_aio_footprint( tile->net.xdp_tx_queue_size, tile->net.xdp_aio_depth ) );
+  }
   if( FD_UNLIKELY( strcmp( tile->net.interface, "lo" ) && !tile->kind_id ) ) {
     l = FD_LAYOUT_APPEND( l, fd_xsk_align(),     fd_xsk_footprint( FD_NET_MTU, tile->net.xdp_rx_queue_size, tile->net.xdp_rx_queue_size, tile->net.xdp_tx_queue_size, tile->net.xdp_tx_queue_size ) );
     l = FD_LAYOUT_APPEND( l, fd_xsk_aio_align(), fd_xsk_aio_footprint( tile->net.xdp_tx_queue_size, tile->net.xdp_aio_depth ) );
@@ -82,6 +131,49 @@ mux_ctx( void * scratch ) {
   return (void*)fd_ulong_align_up( net_init + sizeof( fd_net_init_ctx_t ), alignof( fd_net_ctx_t ) );
 }
 
+/* net_shred_batch_publish publishes the shred batch being built, if
+   any. */
+
+static void
+net_shred_batch_publish( fd_net_ctx_t * ctx ) {
+  fd_net_shred_batch_t * batch = ctx->shred_batch;
+  if( FD_LIKELY( !batch ) ) return;
+
+  ulong sz    = batch->off[ batch->cnt ];
+  ulong sig   = fd_disco_netmux_sig( 0U, 0U, 0U, DST_PROTO_SHRED_BATCH, FD_NETMUX_SIG_MIN_HDR_SZ );
+  ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+  fd_mux_publish( ctx->mux, sig, ctx->out_chunk, sz, 0, 0, tspub );
+
+  ctx->out_chunk   = fd_dcache_compact_next( ctx->out_chunk, sz, ctx->out_chunk0, ctx->out_wmark );
+  ctx->shred_batch = NULL;
+}
+
+/* net_shred_batch_append appends the shred payload[0,sz) to the shred
+   batch being built, starting a new batch at out_chunk if there is
+   none, and publishes the batch once it is full.  sz is at most
+   FD_NET_MTU, so a batch fits in the MTU of the out link. */
+
+static void
+net_shred_batch_append( fd_net_ctx_t * ctx,
+                        uchar const *  payload,
+                        ulong          sz ) {
+  fd_net_shred_batch_t * batch = ctx->shred_batch;
+  if( FD_LIKELY( !batch ) ) {
+    batch = (fd_net_shred_batch_t *)fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
+    batch->cnt      = (ushort)0;
+    batch->off[ 0 ] = (ushort)sizeof(fd_net_shred_batch_t);
+    ctx->shred_batch = batch;
+  }
+
+  ulong cnt = batch->cnt;
+  ulong off = batch->off[ cnt ];
+  fd_memcpy( (uchar *)batch + off, payload, sz );
+  batch->off[ cnt+1UL ] = (ushort)(off + sz);
+  batch->cnt            = (ushort)(cnt + 1UL);
+
+  if( FD_UNLIKELY( cnt+1UL==ctx->shred_coalesce_max ) ) net_shred_batch_publish( ctx );
+}
+
 /* net_rx_aio_send is a callback invoked by aio when new data is
    received on an incoming xsk.  The xsk might be bound to any interface
    or ports, so the purpose of this callback is to determine if the
@@ -146,10 +238,21 @@ net_rx_aio_send( void *                    _ctx,
                    ctx->legacy_transaction_listen_port ));
     }
 
+    /* Runs of consecutive shreds are coalesced into one frag, a packet
+       of any other kind ends the run so frags stay in arrival order */
+    if( FD_LIKELY( ctx->shred_coalesce_max>1UL ) ) {
+      if( FD_LIKELY( proto==DST_PROTO_SHRED ) ) {
+        net_shred_batch_append( ctx, udp+8U, (ulong)(packet_end-(udp+8U)) );
+        continue;
+      }
+      net_shred_batch_publish( ctx );
+    }
+
     fd_memcpy( fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk ), packet, batch[i].buf_sz );
 
-    /* tile can decide how to partition based on src ip addr and src port */
-    ulong sig = fd_disco_netmux_sig( ip_srcaddr, udp_srcport, 0U, proto, 14UL+8UL+iplen );
+    /* tile can decide how to partition based on src ip addr and src port,
+       or with flow steering, the queue the NIC delivered the packet on */
+    ulong sig = fd_net_rx_sig( ip_srcaddr, udp_srcport, proto, 14UL+8UL+iplen, ctx->rx_steer, ctx->rx_queue_id );
 
     ulong tspub  = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
     fd_mux_publish( ctx->mux, sig, ctx->out_chunk, batch[i].buf_sz, 0, 0, tspub );
@@ -157,6 +260,9 @@ net_rx_aio_send( void *                    _ctx,
     ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, FD_NET_MTU, ctx->out_chunk0, ctx->out_wmark );
   }
 
+  /* Don't hold shreds back waiting for more to arrive */
+  net_shred_batch_publish( ctx );
+
   if( FD_LIKELY( opt_batch_idx ) ) {
     *opt_batch_idx = batch_cnt;
   }
@@ -172,10 +278,32 @@ before_credit( void * _ctx,
   ctx->mux = mux;
 
   for( ulong i=0; i<ctx->xsk_aio_cnt; i++ ) {
+    /* The loopback device has no RSS, its packets keep the software hash */
+    ctx->rx_steer    = ctx->flow_steering & (i<ctx->xdp_queue_cnt);
+    ctx->rx_queue_id = ctx->xdp_queue0 + i;
     fd_xsk_aio_service( ctx->xsk_aio[i] );
   }
 }
 
+static void
+metrics_write( void * _ctx ) {
+  fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
+
+  fd_xsk_metrics_t sum = {0};
+  for( ulong i=0UL; i<ctx->xsk_aio_cnt; i++ ) {
+    fd_xsk_metrics_t const * metrics = fd_xsk_get_metrics( ctx->xsk[ i ] );
+    sum.rx_wakeup_cnt      += metrics->rx_wakeup_cnt;
+    sum.tx_wakeup_cnt      += metrics->tx_wakeup_cnt;
+    sum.rx_wakeup_skip_cnt += metrics->rx_wakeup_skip_cnt;
+    sum.tx_wakeup_skip_cnt += metrics->tx_wakeup_skip_cnt;
+  }
+
+  FD_MCNT_SET( NET_TILE, XDP_RX_WAKEUP,         sum.rx_wakeup_cnt      );
+  FD_MCNT_SET( NET_TILE, XDP_TX_WAKEUP,         sum.tx_wakeup_cnt      );
+  FD_MCNT_SET( NET_TILE, XDP_RX_WAKEUP_SKIPPED, sum.rx_wakeup_skip_cnt );
+  FD_MCNT_SET( NET_TILE, XDP_TX_WAKEUP_SKIPPED, sum.tx_wakeup_skip_cnt );
+}
+
 static void
 during_housekeeping( void * _ctx ) {
   fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
@@ -238,16 +366,47 @@ during_frag( void * _ctx,
              int * opt_filter ) {
   (void)in_idx;
   (void)seq;
-  (void)sig;
-  (void)opt_filter;
 
   fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
 
   if( FD_UNLIKELY( chunk<ctx->in_chunk0 || chunk>ctx->in_wmark || sz > FD_NET_MTU ) )
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in_chunk0, ctx->in_wmark ));
 
-  uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in_mem, chunk );
-  fd_memcpy( ctx->frame, src, sz ); // TODO: Change xsk_aio interface to eliminate this copy
+  /* Copy the packet (headers already built by the producer) straight
+     into a free TX frame of the XSK it will go out on, the link layer
+     header is then filled in place in after_frag.  If all TX frames are
+     in flight, the packet is dropped, as it would be on a full TX ring. */
+  ulong xsk_aio_idx = route_loopback( ctx->src_ip_addr, sig ) ? ctx->lo_xsk_aio_idx : ctx->tx_queue_idx;
+  uchar * frame = fd_xsk_aio_tx_prepare( ctx->xsk_aio[ xsk_aio_idx ] );
+  if( FD_UNLIKELY( !frame ) ) {
+    *opt_filter = 1;
+    return;
+  }
+
+  uchar const * src = (uchar const *)fd_chunk_to_laddr_const( ctx->in_mem, chunk );
+  fd_memcpy( frame, src, sz );
+
+  ctx->tx_xsk_aio_idx = xsk_aio_idx;
+  ctx->tx_frame       = frame;
+}
+
+/* net_tx_commit enqueues the frame prepared in during_frag for
+   transmission without waking up the kernel, see after_burst. */
+
+static void
+net_tx_commit( fd_net_ctx_t * ctx,
+               ulong          sz ) {
+  ulong          idx     = ctx->tx_xsk_aio_idx;
+  fd_xsk_aio_t * xsk_aio = ctx->xsk_aio[ idx ];
+
+  int err = fd_xsk_aio_tx_commit( xsk_aio, sz, 0 );
+  if( FD_UNLIKELY( err==FD_AIO_ERR_AGAIN && ctx->tx_unflushed[ idx ] ) ) {
+    /* The TX ring is full of packets the kernel was not told about yet */
+    fd_xsk_aio_tx_flush( xsk_aio );
+    ctx->tx_unflushed[ idx ] = 0;
+    err = fd_xsk_aio_tx_commit( xsk_aio, sz, 0 );
+  }
+  ctx->tx_unflushed[ idx ] |= (err==FD_AIO_SUCCESS);
 }
 
 static void
@@ -293,9 +452,8 @@ after_frag( void *             _ctx,
 
   fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
 
-  fd_aio_pkt_info_t aio_buf = { .buf = ctx->frame, .buf_sz = (ushort)*opt_sz };
   if( FD_UNLIKELY( route_loopback( ctx->src_ip_addr, *opt_sig ) ) ) {
-    ctx->lo_tx->send_func( ctx->xsk_aio[ 1 ], &aio_buf, 1, NULL, 1 );
+    net_tx_commit( ctx, *opt_sz );
   } else {
     /* extract dst ip */
     uint dst_ip = fd_uint_bswap( fd_disco_netmux_sig_dst_ip( *opt_sig ) );
@@ -341,12 +499,12 @@ after_frag( void *             _ctx,
         break;
       case FD_IP_SUCCESS:
         /* set destination mac address */
-        memcpy( ctx->frame, dst_mac, 6UL );
+        memcpy( ctx->tx_frame, dst_mac, 6UL );
 
         /* set source mac address */
-        memcpy( ctx->frame + 6UL, ctx->src_mac_addr, 6UL );
+        memcpy( ctx->tx_frame + 6UL, ctx->src_mac_addr, 6UL );
 
-        ctx->tx->send_func( ctx->xsk_aio[ 0 ], &aio_buf, 1, NULL, 1 );
+        net_tx_commit( ctx, *opt_sz );
         break;
       case FD_IP_RETRY:
         /* refresh tables */
@@ -365,6 +523,29 @@ after_frag( void *             _ctx,
   *opt_filter = 1;
 }
 
+static void
+after_burst( void *             _ctx,
+             ulong              in_idx,
+             ulong              frag_cnt,
+             fd_mux_context_t * mux ) {
+  (void)in_idx;
+  (void)frag_cnt;
+  (void)mux;
+
+  fd_net_ctx_t * ctx = (fd_net_ctx_t *)_ctx;
+
+  for( ulong i=0UL; i<ctx->xsk_aio_cnt; i++ ) {
+    if( FD_LIKELY( ctx->tx_unflushed[ i ] ) ) {
+      fd_xsk_aio_tx_flush( ctx->xsk_aio[ i ] );
+      ctx->tx_unflushed[ i ] = 0;
+    }
+  }
+
+  /* Spread outgoing packets over the queues of the tile a burst at a
+     time, so there is still one flush per burst */
+  ctx->tx_queue_idx = fd_ulong_if( ctx->tx_queue_idx+1UL<ctx->xdp_queue_cnt, ctx->tx_queue_idx+1UL, 0UL );
+}
+
 static void
 privileged_init( fd_topo_t *      topo,
                  fd_topo_tile_t * tile,
@@ -376,23 +557,35 @@ privileged_init( fd_topo_t *      topo,
   FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_net_ctx_t ),      sizeof( fd_net_ctx_t ) );
   FD_SCRATCH_ALLOC_APPEND( l, fd_aio_align(),               fd_aio_footprint() );
 
-  /* Initialize XSK and xsk_aio which requires being privileged. */
-  void * xsk = fd_xsk_new( FD_SCRATCH_ALLOC_APPEND( l, fd_xsk_align(), fd_xsk_footprint( FD_NET_MTU, tile->net.xdp_rx_queue_size, tile->net.xdp_rx_queue_size, tile->net.xdp_tx_queue_size, tile->net.xdp_tx_queue_size ) ),
-                           FD_NET_MTU,
-                           tile->net.xdp_rx_queue_size,
-                           tile->net.xdp_rx_queue_size,
-                           tile->net.xdp_tx_queue_size,
-                           tile->net.xdp_tx_queue_size );
-  if( FD_UNLIKELY( !fd_xsk_bind( xsk, tile->net.app_name, tile->net.interface, (uint)tile->kind_id ) ) )
-    FD_LOG_ERR(( "failed to bind xsk for net tile %lu", tile->kind_id ));
-
-  ctx->xsk = fd_xsk_join( xsk );
-  if( FD_UNLIKELY( !ctx->xsk ) ) FD_LOG_ERR(( "fd_xsk_join failed" ));
-
-  ctx->xsk_aio = fd_xsk_aio_new( FD_SCRATCH_ALLOC_APPEND( l, fd_xsk_aio_align(), fd_xsk_aio_footprint( tile->net.xdp_tx_queue_size, tile->net.xdp_aio_depth ) ),
-                                 tile->net.xdp_tx_queue_size,
-                                 tile->net.xdp_aio_depth );
-  if( FD_UNLIKELY( !ctx->xsk_aio ) ) FD_LOG_ERR(( "fd_xsk_aio_new failed" ));
+  if( FD_UNLIKELY( !tile->net.xdp_queue_cnt || tile->net.xdp_queue_cnt>NET_XDP_QUEUES_PER_TILE_MAX ) )
+    FD_LOG_ERR(( "net tile %lu has invalid xdp_queue_cnt %lu", tile->kind_id, tile->net.xdp_queue_cnt ));
+
+  /* Initialize XSKs and xsk_aios which requires being privileged. */
+  ctx->xsk_cnt = tile->net.xdp_queue_cnt;
+  for( ulong i=0UL; i<ctx->xsk_cnt; i++ ) {
+    uint queue_id = (uint)fd_net_xdp_queue_id( tile->kind_id, tile->net.xdp_queue_cnt, i );
+
+    void * xsk = fd_xsk_new( FD_SCRATCH_ALLOC_APPEND( l, fd_xsk_align(), fd_xsk_footprint( FD_NET_MTU, tile->net.xdp_rx_queue_size, tile->net.xdp_rx_queue_size, tile->net.xdp_tx_queue_size, tile->net.xdp_tx_queue_size ) ),
+                             FD_NET_MTU,
+                             tile->net.xdp_rx_queue_size,
+                             tile->net.xdp_rx_queue_size,
+                             tile->net.xdp_tx_queue_size,
+                             tile->net.xdp_tx_queue_size );
+    if( FD_UNLIKELY( !fd_xsk_bind( xsk, tile->net.app_name, tile->net.interface, queue_id ) ) )
+      FD_LOG_ERR(( "failed to bind xsk for net tile %lu queue %u", tile->kind_id, queue_id ));
+    if( FD_UNLIKELY( !fd_xsk_set_busy_poll( xsk, tile->net.busy_poll_usecs, tile->net.busy_poll_budget ) ) )
+      FD_LOG_ERR(( "fd_xsk_set_busy_poll failed" ));
+    if( FD_UNLIKELY( !fd_xsk_set_adaptive_wakeup( xsk, tile->net.adaptive_wakeup ) ) )
+      FD_LOG_ERR(( "fd_xsk_set_adaptive_wakeup failed" ));
+
+    ctx->xsk[ i ] = fd_xsk_join( xsk );
+    if( FD_UNLIKELY( !ctx->xsk[ i ] ) ) FD_LOG_ERR(( "fd_xsk_join failed" ));
+
+    ctx->xsk_aio[ i ] = fd_xsk_aio_new( FD_SCRATCH_ALLOC_APPEND( l, fd_xsk_aio_align(), fd_xsk_aio_footprint( tile->net.xdp_tx_queue_size, tile->net.xdp_aio_depth ) ),
+                                        tile->net.xdp_tx_queue_size,
+                                        tile->net.xdp_aio_depth );
+    if( FD_UNLIKELY( !ctx->xsk_aio[ i ] ) ) FD_LOG_ERR(( "fd_xsk_aio_new failed" ));
+  }
 
   /* Networking tile at index 0 also binds to loopback (only queue 0 available on lo) */
   ctx->lo_xsk     = NULL;
@@ -406,6 +599,9 @@ privileged_init( fd_topo_t *      topo,
                                 tile->net.xdp_tx_queue_size );
     if( FD_UNLIKELY( !fd_xsk_bind( lo_xsk, tile->net.app_name, "lo", (uint)tile->kind_id ) ) )
       FD_LOG_ERR(( "failed to bind lo_xsk for net tile %lu", tile->kind_id ));
+    /* No busy polling on loopback, it has no device queue to poll */
+    if( FD_UNLIKELY( !fd_xsk_set_adaptive_wakeup( lo_xsk, tile->net.adaptive_wakeup ) ) )
+      FD_LOG_ERR(( "fd_xsk_set_adaptive_wakeup failed" ));
 
     ctx->lo_xsk = fd_xsk_join( lo_xsk );
     if( FD_UNLIKELY( !ctx->lo_xsk ) ) FD_LOG_ERR(( "fd_xsk_join failed" ));
@@ -434,19 +630,42 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->round_robin_cnt = fd_topo_tile_name_cnt( topo, tile->name );
   ctx->round_robin_id  = tile->kind_id;
 
-  ctx->xsk_aio_cnt = 1;
-  ctx->xsk_aio[ 0 ] = fd_xsk_aio_join( init_ctx->xsk_aio, init_ctx->xsk );
-  if( FD_UNLIKELY( !ctx->xsk_aio[ 0 ] ) ) FD_LOG_ERR(( "fd_xsk_aio_join failed" ));
-  fd_xsk_aio_set_rx( ctx->xsk_aio[ 0 ], net_rx_aio );
-  ctx->tx = fd_xsk_aio_get_tx( init_ctx->xsk_aio );
+  ctx->xdp_queue_cnt = init_ctx->xsk_cnt;
+  ctx->xdp_queue0    = fd_net_xdp_queue_id( tile->kind_id, init_ctx->xsk_cnt, 0UL );
+  for( ulong i=0UL; i<init_ctx->xsk_cnt; i++ ) {
+    ctx->xsk[ i ]     = init_ctx->xsk[ i ];
+    ctx->xsk_aio[ i ] = fd_xsk_aio_join( init_ctx->xsk_aio[ i ], init_ctx->xsk[ i ] );
+    if( FD_UNLIKELY( !ctx->xsk_aio[ i ] ) ) FD_LOG_ERR(( "fd_xsk_aio_join failed" ));
+    fd_xsk_aio_set_rx( ctx->xsk_aio[ i ], net_rx_aio );
+  }
+  ctx->xsk_aio_cnt = init_ctx->xsk_cnt;
+  ctx->tx = fd_xsk_aio_get_tx( init_ctx->xsk_aio[ 0 ] );
+  ctx->lo_xsk_aio_idx = 0UL; /* interface is lo */
   if( FD_UNLIKELY( init_ctx->lo_xsk ) ) {
-    ctx->xsk_aio[ 1 ] = fd_xsk_aio_join( init_ctx->lo_xsk_aio, init_ctx->lo_xsk );
-    if( FD_UNLIKELY( !ctx->xsk_aio[ 1 ] ) ) FD_LOG_ERR(( "fd_xsk_aio_join failed" ));
-    fd_xsk_aio_set_rx( ctx->xsk_aio[ 1 ], net_rx_aio );
-    ctx->lo_tx = fd_xsk_aio_get_tx( init_ctx->lo_xsk_aio );
-    ctx->xsk_aio_cnt = 2;
+    ulong lo_idx = ctx->xsk_aio_cnt;
+    ctx->xsk[ lo_idx ]     = init_ctx->lo_xsk;
+    ctx->xsk_aio[ lo_idx ] = fd_xsk_aio_join( init_ctx->lo_xsk_aio, init_ctx->lo_xsk );
+    if( FD_UNLIKELY( !ctx->xsk_aio[ lo_idx ] ) ) FD_LOG_ERR(( "fd_xsk_aio_join failed" ));
+    fd_xsk_aio_set_rx( ctx->xsk_aio[ lo_idx ], net_rx_aio );
+    ctx->lo_xsk_aio_idx = lo_idx;
+    ctx->xsk_aio_cnt++;
   }
 
+  ctx->shred_coalesce_max = tile->net.shred_coalesce_max;
+  ctx->shred_batch        = NULL;
+  if( FD_UNLIKELY( ctx->shred_coalesce_max>FD_NET_SHRED_BATCH_MAX ) )
+    FD_LOG_ERR(( "net tile shred_coalesce_max %lu too large", ctx->shred_coalesce_max ));
+  if( FD_UNLIKELY( ctx->shred_coalesce_max>1UL &&
+                   topo->links[ tile->out_link_id_primary ].mtu<FD_NET_SHRED_BATCH_MTU( ctx->shred_coalesce_max ) ) )
+    FD_LOG_ERR(( "net tile out link mtu %lu too small for shred batches", topo->links[ tile->out_link_id_primary ].mtu ));
+
+  ctx->flow_steering = tile->net.flow_steering;
+  ctx->rx_steer      = 0;
+  ctx->rx_queue_id   = 0UL;
+
+  ctx->tx_queue_idx  = 0UL;
+  for( ulong i=0UL; i<NET_XSK_MAX; i++ ) ctx->tx_unflushed[ i ] = 0;
+
   ctx->src_ip_addr = tile->net.src_ip_addr;
   memcpy( ctx->src_mac_addr, tile->net.src_mac_addr, 6UL );
 
@@ -489,12 +708,21 @@ populate_allowed_seccomp( void *               scratch,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_net_init_ctx_t * init_ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_net_init_ctx_t ), sizeof( fd_net_init_ctx_t ) );
 
-  /* A bit of a hack, if there is no loopback XSK for this tile, we still need to pass
-     two "allow" FD arguments to the net policy, so we just make them both the same. */
-  int allow_fd2 = init_ctx->lo_xsk ? init_ctx->lo_xsk->xsk_fd : init_ctx->xsk->xsk_fd;
-  FD_TEST( init_ctx->xsk->xsk_fd >= 0 && allow_fd2 >= 0 );
+  /* A bit of a hack, the net policy takes a fixed number of XSK "allow"
+     FD arguments, if this tile has fewer XSKs (fewer queues or no
+     loopback XSK), we just repeat the first one. */
+  FD_STATIC_ASSERT( NET_XDP_QUEUES_PER_TILE_MAX==4, update_net_seccomp_policy );
+  int xsk_fd[ NET_XDP_QUEUES_PER_TILE_MAX ];
+  for( ulong i=0UL; i<NET_XDP_QUEUES_PER_TILE_MAX; i++ ) {
+    xsk_fd[ i ] = init_ctx->xsk[ fd_ulong_if( i<init_ctx->xsk_cnt, i, 0UL ) ]->xsk_fd;
+    FD_TEST( xsk_fd[ i ] >= 0 );
+  }
+  int lo_xsk_fd = init_ctx->lo_xsk ? init_ctx->lo_xsk->xsk_fd : xsk_fd[ 0 ];
+  FD_TEST( lo_xsk_fd >= 0 );
   int netlink_fd = fd_ip_netlink_get( init_ctx->ip )->fd;
-  populate_sock_filter_policy_net( out_cnt, out, (uint)fd_log_private_logfile_fd(), (uint)init_ctx->xsk->xsk_fd, (uint)allow_fd2, (uint)netlink_fd );
+  populate_sock_filter_policy_net( out_cnt, out, (uint)fd_log_private_logfile_fd(),
+                                   (uint)xsk_fd[ 0 ], (uint)xsk_fd[ 1 ], (uint)xsk_fd[ 2 ], (uint)xsk_fd[ 3 ],
+                                   (uint)lo_xsk_fd, (uint)netlink_fd );
   return sock_filter_policy_net_instr_cnt;
 }
 
@@ -505,13 +733,14 @@ populate_allowed_fds( void * scratch,
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_net_init_ctx_t * init_ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_net_init_ctx_t ), sizeof( fd_net_init_ctx_t ) );
 
-  if( FD_UNLIKELY( out_fds_cnt < 5 ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+  if( FD_UNLIKELY( out_fds_cnt < 4UL+init_ctx->xsk_cnt ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
 
   ulong out_cnt = 0;
   out_fds[ out_cnt++ ] = 2; /* stderr */
   if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
     out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
-  out_fds[ out_cnt++ ] = init_ctx->xsk->xsk_fd;
+  for( ulong i=0UL; i<init_ctx->xsk_cnt; i++ )
+    out_fds[ out_cnt++ ] = init_ctx->xsk[ i ]->xsk_fd;
   if( FD_UNLIKELY( init_ctx->lo_xsk ) )
     out_fds[ out_cnt++ ] = init_ctx->lo_xsk->xsk_fd;
   out_fds[ out_cnt++ ] = fd_ip_netlink_get( init_ctx->ip )->fd;
@@ -522,12 +751,15 @@ fd_topo_run_tile_t fd_tile_net = {
   .name                     = "net",
   .mux_flags                = FD_MUX_FLAG_MANUAL_PUBLISH | FD_MUX_FLAG_COPY,
   .burst                    = 1UL,
+  .burst_frag_max           = NET_TX_BURST_MAX,
   .mux_ctx                  = mux_ctx,
   .mux_before_credit        = before_credit,
   .mux_before_frag          = before_frag,
   .mux_during_frag          = during_frag,
   .mux_after_frag           = after_frag,
+  .mux_after_burst          = after_burst,
   .mux_during_housekeeping  = during_housekeeping,
+  .mux_metrics_write        = metrics_write,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
@@ -0,0 +1,40 @@
+#ifndef HEADER_fd_src_app_fdctl_run_tiles_net_h
+#define HEADER_fd_src_app_fdctl_run_tiles_net_h
+
+#include "tiles.h"
+
+/* fd_net_xdp_queue_id returns the network device queue serviced by the
+   XSK of index i in [0,xdp_queue_cnt) of net tile net_tile_idx, when
+   every net tile services xdp_queue_cnt queues.  Net tile k services
+   the queues [k*xdp_queue_cnt,(k+1)*xdp_queue_cnt), so the net tiles
+   together service each of the queues [0,net_tile_cnt*xdp_queue_cnt)
+   exactly once. */
+
+FD_FN_CONST static inline ulong
+fd_net_xdp_queue_id( ulong net_tile_idx,
+                     ulong xdp_queue_cnt,
+                     ulong i ) {
+  return net_tile_idx*xdp_queue_cnt + i;
+}
+
+/* fd_net_rx_sig returns the netmux sig the net tile publishes an
+   incoming packet with.  Downstream tiles partition packets on the
+   hash of the sig (a QUIC tile handles the packets with hash %
+   quic_tile_cnt equal to its index).  The hash is that of the source
+   address and port of the packet, unless steer is set, in which case it
+   is queue_id, the network device queue the NIC delivered the packet
+   on, so the NIC's RSS alone decides which QUIC tile handles a flow. */
+
+FD_FN_CONST static inline ulong
+fd_net_rx_sig( uint   src_ip,
+               ushort src_port,
+               ulong  proto,
+               ulong  hdr_sz,
+               int    steer,
+               ulong  queue_id ) {
+  ulong sig = fd_disco_netmux_sig( src_ip, src_port, 0U, proto, hdr_sz );
+  if( FD_LIKELY( steer ) ) sig = fd_disco_netmux_sig_set_hash( sig, queue_id );
+  return sig;
+}
+
+#endif /* HEADER_fd_src_app_fdctl_run_tiles_net_h */
@@ -44,6 +44,14 @@ typedef struct {
   fd_pack_t *  pack;
   fd_txn_p_t * cur_spot;
 
+  /* Transactions that have been fully received but not yet inserted
+     into pack.  They are inserted together with
+     fd_pack_insert_txn_batch when the batch fills up or right before
+     we need them to schedule a microblock. */
+  ulong        insert_batch_cnt;
+  fd_txn_p_t * insert_batch[ FD_PACK_INSERT_BATCH_MAX ];
+  ulong        insert_batch_expires[ FD_PACK_INSERT_BATCH_MAX ];
+
   /* The leader slot we are currently packing for, or ULONG_MAX if we
      are not the leader. */
   ulong  leader_slot;
@@ -115,6 +123,26 @@ metrics_write( void * _ctx ) {
   FD_MHIST_COPY( PACK, INSERT_TRANSACTION_DURATION_SECONDS,  ctx->insert_duration   );
 }
 
+static inline void
+insert_batch_flush( fd_pack_ctx_t * ctx ) {
+  ulong cnt = ctx->insert_batch_cnt;
+  if( FD_UNLIKELY( !cnt ) ) return;
+
+  int result[ FD_PACK_INSERT_BATCH_MAX ];
+  long insert_duration = -fd_tickcount();
+  fd_pack_insert_txn_batch( ctx->pack, ctx->insert_batch, ctx->insert_batch_expires, cnt, result );
+  insert_duration      += fd_tickcount();
+
+  /* The histogram is per transaction, so attribute an equal share of
+     the batch to each of them. */
+  ulong per_txn = (ulong)insert_duration/cnt;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ctx->insert_result[ result[ i ] + FD_PACK_INSERT_RETVAL_OFF ]++;
+    fd_histf_sample( ctx->insert_duration, per_txn );
+  }
+  ctx->insert_batch_cnt = 0UL;
+}
+
 static inline void
 before_credit( void * _ctx,
                fd_mux_context_t * mux ) {
@@ -166,39 +194,61 @@ after_credit( void *             _ctx,
   /* Have I sent the max allowed microblocks? Nothing to do. */
   if( FD_UNLIKELY( ctx->slot_microblock_cnt>=ctx->slot_max_microblocks ) ) return;
 
-  /* Is it time to schedule the next microblock? For each banking
-     thread, if it's not busy... */
+  /* Is it time to schedule the next microblock? Find all the banking
+     threads that aren't busy... */
+  ulong ready_mask = 0UL;
   for( ulong i=0UL; i<ctx->bank_cnt; i++ ) {
-    if( FD_LIKELY( (fd_fseq_query( ctx->bank_current[i] )==ctx->bank_expect[i]) & (ctx->bank_ready_at[i]<now) ) ) { /* optimize for the case we send a microblock */
+    if( FD_LIKELY( (fd_fseq_query( ctx->bank_current[i] )==ctx->bank_expect[i]) & (ctx->bank_ready_at[i]<now) ) ) {
       fd_pack_microblock_complete( ctx->pack, i );
-      /* TODO: record metrics for expire */
-      fd_pack_expire_before( ctx->pack, fd_ulong_min( (ulong)(fd_log_wallclock()-LONG_MIN), TRANSACTION_LIFETIME_NS )-TRANSACTION_LIFETIME_NS );
-
-      void * microblock_dst = fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
-      long schedule_duration = -fd_tickcount();
-      ulong schedule_cnt = fd_pack_schedule_next_microblock( ctx->pack, CUS_PER_MICROBLOCK, VOTE_FRACTION, i, microblock_dst );
-      schedule_duration      += fd_tickcount();
-      fd_histf_sample( ctx->schedule_duration, (ulong)schedule_duration );
-
-      if( FD_LIKELY( schedule_cnt ) ) {
-        ulong tspub  = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
-        ulong chunk  = ctx->out_chunk;
-        ulong msg_sz = schedule_cnt*sizeof(fd_txn_p_t);
-        fd_microblock_bank_trailer_t * trailer = (fd_microblock_bank_trailer_t*)((uchar*)microblock_dst+msg_sz);
-        trailer->bank = ctx->leader_bank;
-
-        ulong sig = fd_disco_poh_sig( ctx->leader_slot, POH_PKT_TYPE_MICROBLOCK, i );
-        fd_mux_publish( mux, sig, chunk, msg_sz+sizeof(fd_microblock_bank_trailer_t), 0UL, 0UL, tspub );
-        ctx->bank_expect[ i ] = *mux->seq-1UL;
-        ctx->bank_ready_at[i] = now + MICROBLOCK_DURATION_NS;
-        ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, msg_sz+sizeof(fd_microblock_bank_trailer_t), ctx->out_chunk0, ctx->out_wmark );
-        ctx->slot_microblock_cnt++;
-
-        /* We have set burst to 1 below, so we might have no credits
-           after publishing here.  We need to wait til the next credit
-           loop check to publish another microblock. */
-        break;
-      }
+      ready_mask |= 1UL<<i;
+    }
+  }
+  if( FD_UNLIKELY( !ready_mask ) ) return;
+
+  insert_batch_flush( ctx );
+
+  /* TODO: record metrics for expire */
+  fd_pack_expire_before( ctx->pack, fd_ulong_min( (ulong)(fd_log_wallclock()-LONG_MIN), TRANSACTION_LIFETIME_NS )-TRANSACTION_LIFETIME_NS );
+
+  /* If several banking threads are free at once, plan a microblock for
+     each of them in one pass.  We can only publish one microblock per
+     credit check, so the rest are picked up by the next calls to
+     fd_pack_schedule_next_microblock without rescanning. */
+  if( FD_UNLIKELY( fd_ulong_popcnt( ready_mask )>1 ) ) {
+    long schedule_duration = -fd_tickcount();
+    fd_pack_schedule_lookahead( ctx->pack, CUS_PER_MICROBLOCK, VOTE_FRACTION, ready_mask );
+    schedule_duration      += fd_tickcount();
+    fd_histf_sample( ctx->schedule_duration, (ulong)schedule_duration );
+  }
+
+  /* ... and send one of them a microblock. */
+  for( ulong m=ready_mask; m; m=fd_ulong_pop_lsb( m ) ) {
+    ulong i = (ulong)fd_ulong_find_lsb( m );
+    /* optimize for the case we send a microblock */
+    void * microblock_dst = fd_chunk_to_laddr( ctx->out_mem, ctx->out_chunk );
+    long schedule_duration = -fd_tickcount();
+    ulong schedule_cnt = fd_pack_schedule_next_microblock( ctx->pack, CUS_PER_MICROBLOCK, VOTE_FRACTION, i, microblock_dst );
+    schedule_duration      += fd_tickcount();
+    fd_histf_sample( ctx->schedule_duration, (ulong)schedule_duration );
+
+    if( FD_LIKELY( schedule_cnt ) ) {
+      ulong tspub  = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+      ulong chunk  = ctx->out_chunk;
+      ulong msg_sz = schedule_cnt*sizeof(fd_txn_p_t);
+      fd_microblock_bank_trailer_t * trailer = (fd_microblock_bank_trailer_t*)((uchar*)microblock_dst+msg_sz);
+      trailer->bank = ctx->leader_bank;
+
+      ulong sig = fd_disco_poh_sig( ctx->leader_slot, POH_PKT_TYPE_MICROBLOCK, i );
+      fd_mux_publish( mux, sig, chunk, msg_sz+sizeof(fd_microblock_bank_trailer_t), 0UL, 0UL, tspub );
+      ctx->bank_expect[ i ] = *mux->seq-1UL;
+      ctx->bank_ready_at[i] = now + MICROBLOCK_DURATION_NS;
+      ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, msg_sz+sizeof(fd_microblock_bank_trailer_t), ctx->out_chunk0, ctx->out_wmark );
+      ctx->slot_microblock_cnt++;
+
+      /* We have set burst to 1 below, so we might have no credits
+         after publishing here.  We need to wait til the next credit
+         loop check to publish another microblock. */
+      break;
     }
   }
 }
@@ -323,11 +373,9 @@ after_frag( void *             _ctx,
     ctx->slot_end_ns = ctx->_slot_end_ns;
   } else {
     /* Normal transaction case */
-    long insert_duration = -fd_tickcount();
-    int result = fd_pack_insert_txn_fini( ctx->pack, ctx->cur_spot, (ulong)(fd_log_wallclock()-LONG_MIN) );
-    insert_duration      += fd_tickcount();
-    ctx->insert_result[ result + FD_PACK_INSERT_RETVAL_OFF ]++;
-    fd_histf_sample( ctx->insert_duration, (ulong)insert_duration );
+    ctx->insert_batch        [ ctx->insert_batch_cnt   ] = ctx->cur_spot;
+    ctx->insert_batch_expires[ ctx->insert_batch_cnt++ ] = (ulong)(fd_log_wallclock()-LONG_MIN);
+    if( FD_UNLIKELY( ctx->insert_batch_cnt==FD_PACK_INSERT_BATCH_MAX ) ) insert_batch_flush( ctx );
 
     ctx->cur_spot = NULL;
   }
@@ -355,6 +403,7 @@ unprivileged_init( fd_topo_t *      topo,
   if( FD_UNLIKELY( !ctx->pack ) ) FD_LOG_ERR(( "fd_pack_new failed" ));
 
   ctx->cur_spot = NULL;
+  ctx->insert_batch_cnt = 0UL;
   ctx->leader_slot = ULONG_MAX;
   ctx->slot_microblock_cnt = 0UL;
 
@@ -261,7 +261,6 @@ during_frag( void * _ctx,
              int *  opt_filter ) {
   (void)in_idx;
   (void)seq;
-  (void)sig;
   (void)opt_filter;
 
   fd_quic_ctx_t * ctx = (fd_quic_ctx_t *)_ctx;
@@ -270,6 +269,8 @@ during_frag( void * _ctx,
     FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->in_chunk0, ctx->in_wmark ));
 
   uchar * src = (uchar *)fd_chunk_to_laddr( ctx->in_mem, chunk );
+  /* Start fetching the conn lookup state while the packet is copied */
+  if( FD_LIKELY( fd_disco_netmux_sig_proto( sig )==DST_PROTO_TPU_QUIC ) ) fd_quic_prefetch_rx( ctx->quic, src, sz );
   fd_memcpy( ctx->buffer, src, sz ); /* TODO: Eliminate copy... fd_aio needs refactoring */
 }
 
@@ -586,6 +587,7 @@ unprivileged_init( fd_topo_t *      topo,
   FD_TEST( fd_keyguard_client_join( fd_keyguard_client_new( ctx->keyguard_client,
                                                             sign_out->mcache,
                                                             sign_out->dcache,
+                                                            sign_out->mtu,
                                                             sign_in->mcache,
                                                             sign_in->dcache ) ) );
 
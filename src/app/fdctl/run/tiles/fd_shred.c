@@ -40,8 +40,11 @@
 
    From bank: Every FEC set triggers at least two mcache entries (one
    for parity and one for data), so at most, we have ceil(mcache
-   depth/2) FEC sets exposed.  This means we need to decompose dcache
-   into at least ceil(mcache depth/2)+1 FEC sets.
+   depth/2) FEC sets exposed.  On top of those, up to
+   FD_SHRED_SIGN_INFLIGHT_MAX FEC sets have been made but not sent yet,
+   because the sign tile has not returned the signature of their Merkle
+   root yet.  This means we need to decompose dcache into at least
+   ceil(mcache depth/2)+1+FD_SHRED_SIGN_INFLIGHT_MAX FEC sets.
 
    From the network: The FEC resolver doesn't use a cyclic order, but it
    does promise that once it returns an FEC set, it will return at least
@@ -53,11 +56,12 @@
    shred to all its destinations as soon as we get it, we don't need
    that functionality, so we set partial_depth=1.
 
-   Adding these up, we get 2*ceil(mcache_depth/2)+3+fec_resolver_depth
-   FEC sets, which is no more than mcache_depth+4+fec_resolver_depth.
-   Each FEC is paired with 4 fd_shred34_t structs, so that means we need
-   to decompose the dcache into 4*mcache_depth + 4*fec_resolver_depth +
-   16 fd_shred34_t structs. */
+   Adding these up, we get 2*ceil(mcache_depth/2)+3+fec_resolver_depth+
+   FD_SHRED_SIGN_INFLIGHT_MAX FEC sets, which is no more than
+   mcache_depth+4+fec_resolver_depth+FD_SHRED_SIGN_INFLIGHT_MAX.  Each
+   FEC is paired with 4 fd_shred34_t structs, so that means we need to
+   decompose the dcache into 4*mcache_depth + 4*fec_resolver_depth +
+   4*FD_SHRED_SIGN_INFLIGHT_MAX + 16 fd_shred34_t structs. */
 
 
 /* The memory this tile uses is a bit complicated and has some logical
@@ -100,6 +104,7 @@ FD_STATIC_ASSERT( 34*DCACHE_ENTRIES_PER_FEC_SET >= FD_REEDSOL_DATA_SHREDS_MAX+FD
 FD_STATIC_ASSERT( sizeof(fd_shred34_t) == FD_SHRED_STORE_MTU, shred_34 );
 
 FD_STATIC_ASSERT( sizeof(fd_entry_batch_meta_t)==24UL, poh_shred_mtu );
+FD_STATIC_ASSERT( FD_NET_SHRED_BATCH_MAX<=FD_FEC_RESOLVER_BURST_MAX, net_shred_batch );
 
 /* Part 2: Shred destinations */
 struct __attribute__((packed)) fd_shred_dest_wire {
@@ -152,9 +157,26 @@ typedef struct {
   ulong send_fec_set_idx;
   ulong tsorig;  /* timestamp of the last packet in compressed form */
 
-  /* Includes Ethernet, IP, UDP headers */
+  /* The FEC sets made from microblocks are signed asynchronously: the
+     Merkle root of a new FEC set is sent to the sign tile, and the FEC
+     set is sent out when the signature comes back (in after_credit),
+     while the tile keeps shredding.  sign_pending holds the FEC sets
+     waiting on a signature, in the order they were requested (which is
+     the order the sign tile answers in): the oldest is at
+     sign_pending[ sign_pending_head ]. */
+  uchar pending_root[ FD_SHREDDER_MERKLE_ROOT_SZ ]; /* root of the FEC set made in during_frag */
+  struct {
+    ulong fec_set_idx;
+    ulong tsorig;
+  } sign_pending[ FD_SHRED_SIGN_INFLIGHT_MAX ];
+  ulong sign_pending_head;
+  ulong sign_pending_cnt;
+
+  /* The shred, or if shred_is_batch, the fd_net_shred_batch_t of
+     shreds received from the network, without network headers */
+  int   shred_is_batch;
   ulong shred_buffer_sz;
-  uchar shred_buffer[ FD_NET_MTU ];
+  uchar shred_buffer[ FD_NET_SHRED_BATCH_MTU( FD_NET_SHRED_BATCH_MAX ) ] __attribute__((aligned(8)));
 
   fd_wksp_t * net_in_mem;
   ulong       net_in_chunk0;
@@ -216,7 +238,7 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
 
   ulong fec_resolver_footprint = fd_fec_resolver_footprint( tile->shred.fec_resolver_depth, 1UL, tile->shred.depth,
                                                             128UL * tile->shred.fec_resolver_depth );
-  ulong fec_set_cnt = tile->shred.depth + tile->shred.fec_resolver_depth + 4UL;
+  ulong fec_set_cnt = tile->shred.depth + tile->shred.fec_resolver_depth + 4UL + FD_SHRED_SIGN_INFLIGHT_MAX;
 
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_shred_ctx_t),          sizeof(fd_shred_ctx_t)                  );
@@ -270,7 +292,8 @@ before_frag( void * ctx,
   (void)seq;
 
   if( FD_LIKELY( in_idx==NET_IN_IDX ) ) {
-    *opt_filter = fd_disco_netmux_sig_proto( sig )!=DST_PROTO_SHRED;
+    ulong proto = fd_disco_netmux_sig_proto( sig );
+    *opt_filter = (proto!=DST_PROTO_SHRED) & (proto!=DST_PROTO_SHRED_BATCH);
   } else if( FD_LIKELY( in_idx==POH_IN_IDX ) ) {
     *opt_filter = fd_disco_poh_sig_pkt_type( sig )!=POH_PKT_TYPE_MICROBLOCK;
   }
@@ -364,8 +387,9 @@ during_frag( void * _ctx,
     if( FD_UNLIKELY( last_in_batch )) {
       fd_shredder_init_batch( ctx->shredder, ctx->pending_batch.raw, sizeof(ulong)+ctx->pending_batch.pos, target_slot, entry_meta );
 
-      /* We sized this so it fits in one FEC set */
-      FD_TEST( fd_shredder_next_fec_set( ctx->shredder, out ) );
+      /* We sized this so it fits in one FEC set.  It is signed once we
+         know we weren't overrun (see after_frag). */
+      FD_TEST( fd_shredder_next_fec_set_unsigned( ctx->shredder, out, ctx->pending_root ) );
       fd_shredder_fini_batch( ctx->shredder );
 
       d_rcvd_join( d_rcvd_new( d_rcvd_delete( d_rcvd_leave( out->data_shred_rcvd   ) ) ) );
@@ -387,6 +411,17 @@ during_frag( void * _ctx,
        retransmitting garbage.  Instead we copy it locally, sadly, and
        only give it to the FEC resolver when we know it won't be overrun
        anymore. */
+    if( FD_LIKELY( fd_disco_netmux_sig_proto( sig )==DST_PROTO_SHRED_BATCH ) ) {
+      /* A batch of shreds already stripped of their headers, copied
+         with a single memcpy.  The batch is validated in after_frag. */
+      if( FD_UNLIKELY( chunk<ctx->net_in_chunk0 || chunk>ctx->net_in_wmark || sz>sizeof(ctx->shred_buffer) || sz<sizeof(fd_net_shred_batch_t) ) )
+        FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->net_in_chunk0, ctx->net_in_wmark ));
+      fd_memcpy( ctx->shred_buffer, fd_chunk_to_laddr_const( ctx->net_in_mem, chunk ), sz );
+      ctx->shred_buffer_sz = sz;
+      ctx->shred_is_batch  = 1;
+      return;
+    }
+
     if( FD_UNLIKELY( chunk<ctx->net_in_chunk0 || chunk>ctx->net_in_wmark || sz>FD_NET_MTU ) )
       FD_LOG_ERR(( "chunk %lu %lu corrupt, not in range [%lu,%lu]", chunk, sz, ctx->net_in_chunk0, ctx->net_in_wmark ));
     uchar const * dcache_entry = fd_chunk_to_laddr_const( ctx->net_in_mem, chunk );
@@ -394,6 +429,7 @@ during_frag( void * _ctx,
     FD_TEST( hdr_sz < sz ); /* Should be ensured by the net tile */
     fd_memcpy( ctx->shred_buffer, dcache_entry+hdr_sz, sz-hdr_sz );
     ctx->shred_buffer_sz = sz-hdr_sz;
+    ctx->shred_is_batch  = 0;
   }
 }
 
@@ -438,84 +474,73 @@ send_shred( fd_shred_ctx_t *      ctx,
   ctx->net_out_chunk = fd_dcache_compact_next( ctx->net_out_chunk, pkt_sz, ctx->net_out_chunk0, ctx->net_out_wmark );
 }
 
-static void
-after_frag( void *             _ctx,
-            ulong              in_idx,
-            ulong              seq,
-            ulong *            opt_sig,
-            ulong *            opt_chunk,
-            ulong *            opt_sz,
-            ulong *            opt_tsorig,
-            int *              opt_filter,
-            fd_mux_context_t * mux ) {
-  (void)in_idx;
-  (void)seq;
-  (void)opt_sig;
-  (void)opt_chunk;
-  (void)opt_sz;
-  (void)opt_tsorig;
-  (void)opt_filter;
+/* parse_net_shred parses the shred buf[0,sz) received from the network
+   and looks up the leader of its slot.  Returns the shred and sets
+   *slot_leader on success, or returns NULL if the shred is malformed or
+   the leader of its slot is not known. */
 
-  fd_shred_ctx_t * ctx = (fd_shred_ctx_t *)_ctx;
+static inline fd_shred_t const *
+parse_net_shred( fd_shred_ctx_t *     ctx,
+                 uchar const *        buf,
+                 ulong                sz,
+                 fd_pubkey_t const ** slot_leader ) {
+  fd_shred_t const * shred = fd_shred_parse( buf, sz );
+  if( FD_UNLIKELY( !shred ) ) return NULL;
 
-  if( FD_UNLIKELY( in_idx==CONTACT_IN_IDX ) ) {
-    finalize_new_cluster_contact_info( ctx );
-    return;
-  }
+  fd_epoch_leaders_t const * lsched = fd_stake_ci_get_lsched_for_slot( ctx->stake_ci, shred->slot );
+  if( FD_UNLIKELY( !lsched ) ) return NULL;
 
-  if( FD_UNLIKELY( in_idx==STAKE_IN_IDX ) ) {
-    fd_stake_ci_stake_msg_fini( ctx->stake_ci );
-    return;
-  }
+  *slot_leader = fd_epoch_leaders_get( lsched, shred->slot );
+  if( FD_UNLIKELY( !*slot_leader ) ) return NULL;
 
-  if( FD_UNLIKELY( (in_idx==POH_IN_IDX) & (ctx->send_fec_set_idx==ULONG_MAX) ) ) {
-    /* Entry from PoH that didn't trigger a new FEC set to be made */
-    return;
-  }
-
-  const ulong fanout = 200UL;
-  fd_shred_dest_idx_t _dests[ 200*(FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX) ];
-
-  if( FD_LIKELY( in_idx==NET_IN_IDX ) ) {
-    uchar * shred_buffer    = ctx->shred_buffer;
-    ulong   shred_buffer_sz = ctx->shred_buffer_sz;
-
-    fd_shred_t const * shred = fd_shred_parse( shred_buffer, shred_buffer_sz );
-    if( FD_UNLIKELY( !shred ) ) return;
-
-    fd_epoch_leaders_t const * lsched = fd_stake_ci_get_lsched_for_slot( ctx->stake_ci, shred->slot );
-    if( FD_UNLIKELY( !lsched ) ) return;
+  return shred;
+}
 
-    fd_pubkey_t const * slot_leader = fd_epoch_leaders_get( lsched, shred->slot );
-    if( FD_UNLIKELY( !slot_leader ) ) return;
+/* process_net_shred gives shred, of sz bytes, which was received from
+   the network and parsed by parse_net_shred, to the FEC resolver, and
+   relays it to our children in the turbine tree if it is a new valid
+   shred.  Returns 1 if the shred completed an FEC set, in which case
+   ctx->send_fec_set_idx is the index of the FEC set, and 0 otherwise. */
+
+static int
+process_net_shred( fd_shred_ctx_t *      ctx,
+                   fd_shred_t const *    shred,
+                   ulong                 sz,
+                   fd_pubkey_t const *   slot_leader,
+                   fd_shred_dest_idx_t * _dests ) {
+  fd_fec_set_t const * out_fec_set[ 1 ];
+  fd_shred_t   const * out_shred[ 1 ];
+  int rv = fd_fec_resolver_add_shred( ctx->resolver, shred, sz, slot_leader->uc, out_fec_set, out_shred );
+
+  if( (rv==FD_FEC_RESOLVER_SHRED_OKAY) | (rv==FD_FEC_RESOLVER_SHRED_COMPLETES) ) {
+    /* Relay this shred */
+    ulong fanout = 200UL;
+    ulong max_dest_cnt[1];
+    fd_shred_dest_t * sdest = fd_stake_ci_get_sdest_for_slot( ctx->stake_ci, shred->slot );
+    if( FD_UNLIKELY( !sdest ) ) return 0;
+    fd_shred_dest_idx_t * dests = fd_shred_dest_compute_children( sdest, &shred, 1UL, _dests, 1UL, fanout, fanout, max_dest_cnt );
+    if( FD_UNLIKELY( !dests ) ) return 0;
+
+    for( ulong j=0UL; j<*max_dest_cnt; j++ ) send_shred( ctx, *out_shred, sdest, dests[ j ], ctx->tsorig );
+  }
+  if( FD_LIKELY( rv!=FD_FEC_RESOLVER_SHRED_COMPLETES ) ) return 0;
 
-    fd_fec_set_t const * out_fec_set[ 1 ];
-    fd_shred_t   const * out_shred[ 1 ];
-    int rv = fd_fec_resolver_add_shred( ctx->resolver, shred, shred_buffer_sz, slot_leader->uc, out_fec_set, out_shred );
+  FD_TEST( ctx->fec_sets <= *out_fec_set );
+  ctx->send_fec_set_idx = (ulong)(*out_fec_set - ctx->fec_sets);
+  return 1;
+}
 
-    if( (rv==FD_FEC_RESOLVER_SHRED_OKAY) | (rv==FD_FEC_RESOLVER_SHRED_COMPLETES) ) {
-      /* Relay this shred */
-      ulong fanout = 200UL;
-      ulong max_dest_cnt[1];
-      fd_shred_dest_t * sdest = fd_stake_ci_get_sdest_for_slot( ctx->stake_ci, shred->slot );
-      if( FD_UNLIKELY( !sdest ) ) return;
-      fd_shred_dest_idx_t * dests = fd_shred_dest_compute_children( sdest, &shred, 1UL, _dests, 1UL, fanout, fanout, max_dest_cnt );
-      if( FD_UNLIKELY( !dests ) ) return;
+/* send_fec_set sends the full FEC set ctx->send_fec_set_idx, which was
+   either completed by a shred from the network (in_idx==NET_IN_IDX) or
+   is a microblock we shredded ourself, to the blockstore and on the
+   network (skipping any shreds we already sent). */
 
-      for( ulong j=0UL; j<*max_dest_cnt; j++ ) send_shred( ctx, *out_shred, sdest, dests[ j ], ctx->tsorig );
-    }
-    if( FD_LIKELY( rv!=FD_FEC_RESOLVER_SHRED_COMPLETES ) ) return;
-
-    FD_TEST( ctx->fec_sets <= *out_fec_set );
-    ctx->send_fec_set_idx = (ulong)(*out_fec_set - ctx->fec_sets);
-  } else {
-    /* We know we didn't get overrun, so advance the index */
-    ctx->shredder_fec_set_idx = (ctx->shredder_fec_set_idx+1UL)%ctx->shredder_max_fec_set_idx;
-  }
-  /* If this was the shred that completed an FEC set or this was a
-     microblock we shredded ourself, we now have a full FEC set that we
-     need to send to the blockstore and on the network (skipping any
-     shreds we already sent). */
+static void
+send_fec_set( fd_shred_ctx_t *      ctx,
+              ulong                 in_idx,
+              fd_shred_dest_idx_t * _dests,
+              fd_mux_context_t *    mux ) {
+  const ulong fanout = 200UL;
 
   fd_fec_set_t * set = ctx->fec_sets + ctx->send_fec_set_idx;
   fd_shred34_t * s34 = ctx->shred34 + 4UL*ctx->send_fec_set_idx;
@@ -565,6 +590,139 @@ after_frag( void *             _ctx,
   for( ulong i=0UL; i<k; i++ ) for( ulong j=0UL; j<*max_dest_cnt; j++ ) send_shred( ctx, new_shreds[ i ], sdest, dests[ j*out_stride+i ], ctx->tsorig );
 }
 
+/* send_signed_fec_set writes signature, which the sign tile returned
+   for the oldest FEC set waiting on a signature, to the shreds of the
+   FEC set and sends it. */
+
+static void
+send_signed_fec_set( fd_shred_ctx_t *      ctx,
+                     uchar const *         signature,
+                     fd_shred_dest_idx_t * _dests,
+                     fd_mux_context_t *    mux ) {
+  ulong head = ctx->sign_pending_head;
+  ctx->send_fec_set_idx  = ctx->sign_pending[ head ].fec_set_idx;
+  ctx->tsorig            = ctx->sign_pending[ head ].tsorig;
+  ctx->sign_pending_head = (head+1UL) % FD_SHRED_SIGN_INFLIGHT_MAX;
+  ctx->sign_pending_cnt--;
+
+  fd_shredder_sign_fec_set( ctx->fec_sets + ctx->send_fec_set_idx, signature );
+  send_fec_set( ctx, POH_IN_IDX, _dests, mux );
+}
+
+static void
+after_credit( void *             _ctx,
+              fd_mux_context_t * mux ) {
+  fd_shred_ctx_t * ctx = (fd_shred_ctx_t *)_ctx;
+
+  if( FD_LIKELY( !ctx->sign_pending_cnt ) ) return;
+
+  uchar signature[ FD_ED25519_SIG_SZ ];
+  if( FD_LIKELY( !fd_keyguard_client_sign_poll( ctx->keyguard_client, signature ) ) ) return;
+
+  fd_shred_dest_idx_t _dests[ FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX ]; /* one destination per shred */
+  send_signed_fec_set( ctx, signature, _dests, mux );
+}
+
+static void
+after_frag( void *             _ctx,
+            ulong              in_idx,
+            ulong              seq,
+            ulong *            opt_sig,
+            ulong *            opt_chunk,
+            ulong *            opt_sz,
+            ulong *            opt_tsorig,
+            int *              opt_filter,
+            fd_mux_context_t * mux ) {
+  (void)in_idx;
+  (void)seq;
+  (void)opt_sig;
+  (void)opt_chunk;
+  (void)opt_sz;
+  (void)opt_tsorig;
+  (void)opt_filter;
+
+  fd_shred_ctx_t * ctx = (fd_shred_ctx_t *)_ctx;
+
+  if( FD_UNLIKELY( in_idx==CONTACT_IN_IDX ) ) {
+    finalize_new_cluster_contact_info( ctx );
+    return;
+  }
+
+  if( FD_UNLIKELY( in_idx==STAKE_IN_IDX ) ) {
+    fd_stake_ci_stake_msg_fini( ctx->stake_ci );
+    return;
+  }
+
+  if( FD_UNLIKELY( (in_idx==POH_IN_IDX) & (ctx->send_fec_set_idx==ULONG_MAX) ) ) {
+    /* Entry from PoH that didn't trigger a new FEC set to be made */
+    return;
+  }
+
+  fd_shred_dest_idx_t _dests[ 200*(FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX) ];
+
+  if( FD_LIKELY( in_idx==NET_IN_IDX ) ) {
+    if( FD_LIKELY( ctx->shred_is_batch ) ) {
+      fd_net_shred_batch_t const * batch = (fd_net_shred_batch_t const *)ctx->shred_buffer;
+      ulong cnt = batch->cnt;
+      FD_TEST( cnt<=FD_NET_SHRED_BATCH_MAX ); /* Should be ensured by the net tile */
+
+      /* Parse the shreds of the batch, and let the FEC resolver hash
+         the ones process_net_shred will give it all at once. */
+      fd_shred_t const *  burst       [ FD_NET_SHRED_BATCH_MAX ];
+      ulong               burst_sz    [ FD_NET_SHRED_BATCH_MAX ];
+      fd_pubkey_t const * burst_leader[ FD_NET_SHRED_BATCH_MAX ];
+      ulong burst_cnt = 0UL;
+      for( ulong i=0UL; i<cnt; i++ ) {
+        ulong off = batch->off[ i     ];
+        ulong end = batch->off[ i+1UL ];
+        FD_TEST( (off<=end) & (end<=ctx->shred_buffer_sz) ); /* Should be ensured by the net tile */
+        fd_shred_t const * shred = parse_net_shred( ctx, ctx->shred_buffer+off, end-off, burst_leader+burst_cnt );
+        if( FD_UNLIKELY( !shred ) ) continue;
+        burst   [ burst_cnt   ] = shred;
+        burst_sz[ burst_cnt++ ] = end-off;
+      }
+      fd_fec_resolver_buffer_burst( ctx->resolver, burst, burst_cnt );
+
+      /* Each shred of the batch can complete an FEC set */
+      for( ulong i=0UL; i<burst_cnt; i++ ) {
+        if( FD_UNLIKELY( process_net_shred( ctx, burst[ i ], burst_sz[ i ], burst_leader[ i ], _dests ) ) ) send_fec_set( ctx, in_idx, _dests, mux );
+      }
+      fd_fec_resolver_buffer_burst( ctx->resolver, NULL, 0UL );
+      return;
+    }
+
+    fd_pubkey_t const * slot_leader;
+    fd_shred_t const * shred = parse_net_shred( ctx, ctx->shred_buffer, ctx->shred_buffer_sz, &slot_leader );
+    if( FD_UNLIKELY( !shred ) ) return;
+    if( FD_LIKELY( !process_net_shred( ctx, shred, ctx->shred_buffer_sz, slot_leader, _dests ) ) ) return;
+  } else {
+    /* We know we didn't get overrun, so request the signature of the
+       FEC set and advance the index.  The FEC set is sent when the
+       signature comes back. */
+    ulong tsorig = ctx->tsorig;
+    if( FD_UNLIKELY( ctx->sign_pending_cnt==FD_SHRED_SIGN_INFLIGHT_MAX ) ) {
+      /* No room for another FEC set, wait for the oldest one */
+      uchar signature[ FD_ED25519_SIG_SZ ];
+      while( !fd_keyguard_client_sign_poll( ctx->keyguard_client, signature ) ) FD_SPIN_PAUSE();
+      send_signed_fec_set( ctx, signature, _dests, mux );
+    }
+
+    fd_keyguard_client_sign_req( ctx->keyguard_client, ctx->pending_root, FD_SHREDDER_MERKLE_ROOT_SZ );
+    ulong tail = (ctx->sign_pending_head+ctx->sign_pending_cnt) % FD_SHRED_SIGN_INFLIGHT_MAX;
+    ctx->sign_pending[ tail ].fec_set_idx = ctx->shredder_fec_set_idx;
+    ctx->sign_pending[ tail ].tsorig      = tsorig;
+    ctx->sign_pending_cnt++;
+
+    ctx->shredder_fec_set_idx = (ctx->shredder_fec_set_idx+1UL)%ctx->shredder_max_fec_set_idx;
+    return;
+  }
+  /* If this was the shred that completed an FEC set, we now have a full
+     FEC set that we need to send to the blockstore and on the network
+     (skipping any shreds we already sent). */
+
+  send_fec_set( ctx, in_idx, _dests, mux );
+}
+
 static inline void
 populate_packet_header_template( eth_ip_udp_t * pkt,
                                  ulong          shred_payload_sz,
@@ -645,7 +803,7 @@ unprivileged_init( fd_topo_t *      topo,
 
   ulong fec_resolver_footprint = fd_fec_resolver_footprint( tile->shred.fec_resolver_depth, 1UL, shred_store_mcache_depth,
                                                             128UL * tile->shred.fec_resolver_depth );
-  ulong fec_set_cnt            = shred_store_mcache_depth + tile->shred.fec_resolver_depth + 4UL;
+  ulong fec_set_cnt            = shred_store_mcache_depth + tile->shred.fec_resolver_depth + 4UL + FD_SHRED_SIGN_INFLIGHT_MAX;
 
   if( FD_UNLIKELY( tile->out_link_id_primary == ULONG_MAX ) ) FD_LOG_ERR(( "shred tile has no primary output link" ));
   void * store_out_dcache = topo->links[ tile->out_link_id_primary ].dcache;
@@ -717,10 +875,11 @@ unprivileged_init( fd_topo_t *      topo,
   NONNULL( fd_keyguard_client_join( fd_keyguard_client_new( ctx->keyguard_client,
                                                             sign_out->mcache,
                                                             sign_out->dcache,
+                                                            sign_out->mtu,
                                                             sign_in->mcache,
                                                             sign_in->dcache ) ) );
 
-  fd_fec_set_t * resolver_sets = fec_sets + (shred_store_mcache_depth+1UL)/2UL + 1UL;
+  fd_fec_set_t * resolver_sets = fec_sets + (shred_store_mcache_depth+1UL)/2UL + 1UL + FD_SHRED_SIGN_INFLIGHT_MAX;
   ctx->shredder = NONNULL( fd_shredder_join     ( fd_shredder_new     ( _shredder, fd_shred_signer, ctx->keyguard_client, (ushort)expected_shred_version ) ) );
   ctx->resolver = NONNULL( fd_fec_resolver_join ( fd_fec_resolver_new ( _resolver, tile->shred.fec_resolver_depth, 1UL,
                                                                          (shred_store_mcache_depth+3UL)/2UL,
@@ -778,12 +937,16 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->store_out_chunk  = ctx->store_out_chunk0;
 
   ctx->shredder_fec_set_idx = 0UL;
-  ctx->shredder_max_fec_set_idx = (shred_store_mcache_depth+1UL)/2UL + 1UL;
+  ctx->shredder_max_fec_set_idx = (shred_store_mcache_depth+1UL)/2UL + 1UL + FD_SHRED_SIGN_INFLIGHT_MAX;
 
   ctx->send_fec_set_idx    = ULONG_MAX;
 
+  ctx->sign_pending_head = 0UL;
+  ctx->sign_pending_cnt  = 0UL;
+
+  ctx->shred_is_batch   = 0;
   ctx->shred_buffer_sz  = 0UL;
-  fd_memset( ctx->shred_buffer, 0xFF, FD_NET_MTU );
+  fd_memset( ctx->shred_buffer, 0xFF, sizeof(ctx->shred_buffer) );
 
   ctx->src_ip_addr = tile->shred.ip_addr;
   fd_memcpy( ctx->src_mac_addr, tile->shred.src_mac_addr, 6UL );
@@ -829,15 +992,26 @@ lazy( fd_topo_tile_t * tile ) {
   return 128L * 300L;
 }
 
+/* With coalescing on, a batch of shreds from the net tile can complete
+   an FEC set per shred, so the tile can publish that many times as
+   much as for a single shred. */
+
+static ulong
+tile_burst( fd_topo_tile_t const * tile ) {
+  return 4UL*fd_ulong_max( tile->shred.shred_coalesce_max, 1UL );
+}
+
 fd_topo_run_tile_t fd_tile_shred = {
   .name                     = "shred",
   .mux_flags                = FD_MUX_FLAG_MANUAL_PUBLISH | FD_MUX_FLAG_COPY,
   .burst                    = 4UL,
   .mux_ctx                  = mux_ctx,
+  .mux_after_credit         = after_credit,
   .mux_before_frag          = before_frag,
   .mux_during_frag          = during_frag,
   .mux_after_frag           = after_frag,
   .lazy                     = lazy,
+  .tile_burst               = tile_burst,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
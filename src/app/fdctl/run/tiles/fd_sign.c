@@ -14,13 +14,21 @@ typedef struct {
   ulong            seq;
   fd_frag_meta_t * mcache;
   uchar *          data;
+  ulong            chunk;
+  ulong            wmark;
 } fd_sign_out_ctx_t;
 
+/* Clients can have several requests in flight, each in its own slot of
+   the request dcache.  The chunk of a request frag is relative to the
+   start of the dcache data region, and so is the chunk of the response
+   frag, which the signature is written to. */
+
 typedef struct {
   uchar             _data[ FD_KEYGUARD_SIGN_REQ_MTU ];
 
   ulong             in_role [ MAX_IN ];
   uchar *           in_data[ MAX_IN ];
+  ulong             in_wmark[ MAX_IN ];
 
   fd_sign_out_ctx_t out[ MAX_IN ];
 
@@ -62,19 +70,22 @@ during_frag( void * _ctx,
              int *  opt_filter ) {
   (void)seq;
   (void)sig;
-  (void)chunk;
   (void)sz;
   (void)opt_filter;
 
   fd_sign_ctx_t * ctx = (fd_sign_ctx_t *)_ctx;
   FD_TEST( in_idx<MAX_IN );
 
+  if( FD_UNLIKELY( chunk>ctx->in_wmark[ in_idx ] ) )
+    FD_LOG_CRIT(( "chunk %lu corrupt, not in range [0,%lu]", chunk, ctx->in_wmark[ in_idx ] ));
+  uchar const * data = fd_chunk_to_laddr_const( ctx->in_data[ in_idx ], chunk );
+
   switch( ctx->in_role[ in_idx ] ) {
     case FD_KEYGUARD_ROLE_LEADER:
-      fd_memcpy( ctx->_data, ctx->in_data[ in_idx ], 32UL );
+      fd_memcpy( ctx->_data, data, 32UL );
       break;
     case FD_KEYGUARD_ROLE_TLS:
-      fd_memcpy( ctx->_data, ctx->in_data[ in_idx ], 130UL );
+      fd_memcpy( ctx->_data, data, 130UL );
       break;
     default:
       FD_LOG_CRIT(( "unexpected link role %lu", ctx->in_role[ in_idx ] ));
@@ -103,27 +114,31 @@ after_frag( void *             _ctx,
 
   FD_TEST( in_idx<MAX_IN );
 
+  fd_sign_out_ctx_t * out = ctx->out + in_idx;
+  uchar * signature = fd_chunk_to_laddr( out->data, out->chunk );
+
   switch( ctx->in_role[ in_idx ] ) {
     case FD_KEYGUARD_ROLE_LEADER: {
       if( FD_UNLIKELY( !fd_keyguard_payload_authorize( ctx->_data, 32UL, FD_KEYGUARD_ROLE_LEADER ) ) ) {
         FD_LOG_EMERG(( "fd_keyguard_payload_authorize failed" ));
       }
-      fd_ed25519_sign( ctx->out[ in_idx ].data, ctx->_data, 32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+      fd_ed25519_sign( signature, ctx->_data, 32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
       break;
     }
     case FD_KEYGUARD_ROLE_TLS: {
       if( FD_UNLIKELY( !fd_keyguard_payload_authorize( ctx->_data, 130UL, FD_KEYGUARD_ROLE_TLS ) ) ) {
         FD_LOG_EMERG(( "fd_keyguard_payload_authorize failed" ));
       }
-      fd_ed25519_sign( ctx->out[ in_idx ].data, ctx->_data, 130UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+      fd_ed25519_sign( signature, ctx->_data, 130UL, ctx->public_key, ctx->private_key, ctx->sha512 );
       break;
     }
     default:
       FD_LOG_CRIT(( "unexpected link role %lu", ctx->in_role[ in_idx ] ));
   }
 
-  fd_mcache_publish( ctx->out[ in_idx ].mcache, 128UL, ctx->out[ in_idx ].seq, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL );
-  ctx->out[ in_idx ].seq = fd_seq_inc( ctx->out[ in_idx ].seq, 1UL );
+  fd_mcache_publish( out->mcache, 128UL, out->seq, 0UL, out->chunk, 64UL, 0UL, 0UL, 0UL );
+  out->seq   = fd_seq_inc( out->seq, 1UL );
+  out->chunk = fd_dcache_compact_next( out->chunk, 64UL, 0UL, out->wmark );
 }
 
 static void
@@ -157,11 +172,14 @@ unprivileged_init( fd_topo_t *      topo,
     fd_topo_link_t * in_link = &topo->links[ tile->in_link_id[ i ] ];
     fd_topo_link_t * out_link = &topo->links[ tile->out_link_id[ i ] ];
 
-    ctx->in_data[ i ] = in_link->dcache;
+    ctx->in_data [ i ] = in_link->dcache;
+    ctx->in_wmark[ i ] = fd_dcache_compact_wmark( in_link->dcache, in_link->dcache, in_link->mtu );
 
     ctx->out[ i ].mcache = out_link->mcache;
     ctx->out[ i ].data   = out_link->dcache;
     ctx->out[ i ].seq    = 0UL;
+    ctx->out[ i ].chunk  = fd_dcache_compact_chunk0( out_link->dcache, out_link->dcache );
+    ctx->out[ i ].wmark  = fd_dcache_compact_wmark ( out_link->dcache, out_link->dcache, out_link->mtu );
 
     if( !strcmp( in_link->name, "shred_sign" ) ) {
       ctx->in_role[ i ] = FD_KEYGUARD_ROLE_LEADER;
@@ -9,7 +9,13 @@
 
 /* The verify tile is a wrapper around the mux tile, that also verifies
    incoming transaction signatures match the data being signed.
-   Non-matching transactions are filtered out of the frag stream. */
+   Non-matching transactions are filtered out of the frag stream.
+
+   Signatures are verified in batches across transactions: the tile
+   reads frags from the mux in bursts, queues up each transaction in
+   after_frag and verifies and publishes the whole batch in after_burst
+   (or earlier, if the batch fills up).  Transactions are published in
+   the order they were received. */
 
 FD_FN_CONST static inline ulong
 scratch_align( void ) {
@@ -22,9 +28,7 @@ scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
   l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) );
-  for( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
-    l = FD_LAYOUT_APPEND( l, fd_sha512_align(), fd_sha512_footprint() );
-  }
+  l = FD_LAYOUT_APPEND( l, fd_sha512_align(), fd_sha512_footprint() );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -73,6 +77,27 @@ during_frag( void * _ctx,
   fd_memcpy( dst, src, sz );
 }
 
+/* verify_batch_flush verifies the signatures of all the queued txns
+   and publishes the ones that pass.  The ones that fail or are
+   duplicates were let through after_frag, so they are accounted as
+   filtered here. */
+
+static inline void
+verify_batch_flush( fd_verify_ctx_t *  ctx,
+                    fd_mux_context_t * mux ) {
+  int   res[ VERIFY_BATCH_TXN_MAX ];
+  ulong txn_cnt = fd_txn_verify_batch_fini( ctx, res );
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_verify_batch_txn_t const * txn = ctx->batch_txn + i;
+    if( FD_UNLIKELY( res[ i ]!=FD_TXN_VERIFY_SUCCESS ) ) {
+      fd_mux_filter_deferred( mux, txn->sz );
+      continue;
+    }
+    ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
+    fd_mux_publish( mux, txn->tag, txn->chunk, txn->sz, 0UL, txn->tsorig, tspub );
+  }
+}
+
 static inline void
 after_frag( void *             _ctx,
             ulong              in_idx,
@@ -86,8 +111,7 @@ after_frag( void *             _ctx,
   (void)in_idx;
   (void)seq;
   (void)opt_sig;
-  (void)opt_tsorig;
-  (void)mux;
+  (void)opt_chunk;
 
   fd_verify_ctx_t * ctx = (fd_verify_ctx_t *)_ctx;
 
@@ -117,17 +141,34 @@ after_frag( void *             _ctx,
     FD_LOG_ERR( ("txn is invalid: payload_sz = %x, recent_blockhash_off = %x", payload_sz, recent_blockhash_off ) );
   }
 
-  int res = fd_txn_verify( ctx, udp_payload, payload_sz, txn, opt_sig );
+  if( FD_UNLIKELY( !fd_txn_verify_batch_has_room( ctx, txn ) ) ) verify_batch_flush( ctx, mux );
+
+  int res = fd_txn_verify_batch_add( ctx, udp_payload, payload_sz, txn, ctx->out_chunk, *opt_sz, *opt_tsorig );
   if( FD_UNLIKELY( res != FD_TXN_VERIFY_SUCCESS ) ) {
     *opt_filter = 1;
     return;
   }
 
+  /* The txn stays in the dcache, unpublished, until the batch is
+     verified.  The mux doesn't publish anything itself (we're
+     MANUAL_PUBLISH) so the filter flag only affects diagnostics, and
+     verify_batch_flush corrects them if the txn is dropped. */
+
   *opt_filter = 0;
-  *opt_chunk = ctx->out_chunk;
   ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, *opt_sz, ctx->out_chunk0, ctx->out_wmark );
 }
 
+static void
+after_burst( void *             _ctx,
+             ulong              in_idx,
+             ulong              frag_cnt,
+             fd_mux_context_t * mux ) {
+  (void)in_idx;
+  (void)frag_cnt;
+
+  verify_batch_flush( (fd_verify_ctx_t *)_ctx, mux );
+}
+
 static void
 unprivileged_init( fd_topo_t *      topo,
                    fd_topo_tile_t * tile,
@@ -137,14 +178,15 @@ unprivileged_init( fd_topo_t *      topo,
   fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, FD_TCACHE_FOOTPRINT( VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) ), VERIFY_TCACHE_DEPTH, VERIFY_TCACHE_MAP_CNT ) );
   if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
 
+  ctx->batch_txn_cnt = 0UL;
+  ctx->batch_sig_cnt = 0UL;
+
   ctx->round_robin_cnt = fd_topo_tile_name_cnt( topo, tile->name );
   ctx->round_robin_idx = tile->kind_id;
 
-  for ( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
-    fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_sha512_t ), sizeof( fd_sha512_t ) ) ) );
-    if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
-    ctx->sha[i] = sha;
-  }
+  fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_sha512_t ), sizeof( fd_sha512_t ) ) ) );
+  if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
+  ctx->sha = sha;
 
   ctx->tcache_depth   = fd_tcache_depth       ( tcache );
   ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
@@ -152,6 +194,11 @@ unprivileged_init( fd_topo_t *      topo,
   ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
   ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
 
+  ulong shared_tcache_obj_id = fd_pod_query_ulong( topo->props, "verify_tcache", ULONG_MAX );
+  FD_TEST( shared_tcache_obj_id!=ULONG_MAX );
+  ctx->shared_tcache = fd_tcache_shared_join( fd_topo_obj_laddr( topo, shared_tcache_obj_id ) );
+  if( FD_UNLIKELY( !ctx->shared_tcache ) ) FD_LOG_ERR(( "fd_tcache_shared_join failed" ));
+
   for( ulong i=0; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
 
@@ -203,12 +250,14 @@ populate_allowed_fds( void * scratch,
 
 fd_topo_run_tile_t fd_tile_verify = {
   .name                     = "verify",
-  .mux_flags                = FD_MUX_FLAG_COPY, /* must copy frags for tile isolation and security */
-  .burst                    = 1UL,
+  .mux_flags                = FD_MUX_FLAG_COPY | FD_MUX_FLAG_MANUAL_PUBLISH, /* must copy frags for tile isolation and security */
+  .burst                    = VERIFY_BATCH_TXN_MAX,
+  .burst_frag_max           = VERIFY_BATCH_TXN_MAX,
   .mux_ctx                  = mux_ctx,
   .mux_before_frag          = before_frag,
   .mux_during_frag          = during_frag,
   .mux_after_frag           = after_frag,
+  .mux_after_burst          = after_burst,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
@@ -6,10 +6,26 @@
 #define VERIFY_TCACHE_DEPTH   16UL
 #define VERIFY_TCACHE_MAP_CNT 64UL
 
+/* VERIFY_SHARED_TCACHE_SET_CNT is the number of sets of the tcache
+   shared by all the verify tiles, which holds the tags of the
+   VERIFY_SHARED_TCACHE_SET_CNT*FD_TCACHE_SHARED_WAY_CNT (~512K) txns
+   verified most recently (approximately, see fd_tcache_shared.h). */
+
+#define VERIFY_SHARED_TCACHE_SET_CNT (1UL<<16)
+
+/* VERIFY_BATCH_TXN_MAX is the max number of txns whose signatures are
+   verified together, see fd_txn_verify_batch_add.  Every txn has at
+   least one signature, so this is also bounded by the number of
+   signatures fd_ed25519_verify_batch_multi_msg can take. */
+
+#define VERIFY_BATCH_TXN_MAX  FD_ED25519_VERIFY_BATCH_MAX
+
 #define FD_TXN_VERIFY_SUCCESS  0
 #define FD_TXN_VERIFY_FAILED  -1
 #define FD_TXN_VERIFY_DEDUP   -2
 
+FD_STATIC_ASSERT( FD_TXN_ACTUAL_SIG_MAX<=FD_ED25519_VERIFY_BATCH_MAX, verify_batch );
+
 /* fd_verify_in_ctx_t is a context object for each in (producer) mcache
    connected to the verify tile. */
 
@@ -19,9 +35,31 @@ typedef struct {
   ulong       wmark;
 } fd_verify_in_ctx_t;
 
+/* fd_verify_batch_txn_t describes a txn whose signatures are waiting
+   to be verified in a batch.  chunk, sz and tsorig are for the tile to
+   publish the txn with once it is verified. */
+
+typedef struct {
+  ulong tag;     /* ha dedup tag */
+  ulong sig_cnt; /* Number of signatures of the txn in the batch */
+  ulong chunk;
+  ulong sz;
+  ulong tsorig;
+} fd_verify_batch_txn_t;
+
 typedef struct {
-  /* TODO switch to fd_sha512_batch_t? */
-  fd_sha512_t * sha[ FD_TXN_ACTUAL_SIG_MAX ];
+  fd_sha512_t * sha; /* Only used for messages too large to hash in a batch */
+
+  /* Txns waiting to have their signatures verified together, in the
+     order they were added, and their signatures */
+  ulong                 batch_txn_cnt;
+  ulong                 batch_sig_cnt;
+  fd_verify_batch_txn_t batch_txn   [ VERIFY_BATCH_TXN_MAX ];
+  uchar const *         batch_msg   [ FD_ED25519_VERIFY_BATCH_MAX ];
+  ulong                 batch_msg_sz[ FD_ED25519_VERIFY_BATCH_MAX ];
+  uchar const *         batch_sig   [ FD_ED25519_VERIFY_BATCH_MAX ];
+  uchar const *         batch_pub   [ FD_ED25519_VERIFY_BATCH_MAX ];
+  int                   batch_err   [ FD_ED25519_VERIFY_BATCH_MAX ];
 
   ulong round_robin_idx;
   ulong round_robin_cnt;
@@ -32,6 +70,9 @@ typedef struct {
   ulong * tcache_ring;
   ulong * tcache_map;
 
+  /* Shared with the other verify tiles, NULL if there is none */
+  fd_tcache_shared_t * shared_tcache;
+
   fd_verify_in_ctx_t in[ 32 ];
 
   fd_wksp_t * out_mem;
@@ -70,6 +111,12 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
     return FD_TXN_VERIFY_DEDUP;
   }
 
+  /* The local tcache only catches duplicates that arrive at this verify
+     tile.  Also check the cache shared with the other verify tiles. */
+  if( FD_LIKELY( ctx->shared_tcache ) && FD_UNLIKELY( fd_tcache_shared_query( ctx->shared_tcache, ha_dedup_tag ) ) ) {
+    return FD_TXN_VERIFY_DEDUP;
+  }
+
   /* Verify signatures */
   int res = fd_ed25519_verify_batch_single_msg( msg, msg_sz, signatures, pubkeys, ctx->sha, signature_cnt );
   if( FD_UNLIKELY( res != FD_ED25519_SUCCESS ) ) {
@@ -83,8 +130,136 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
     return FD_TXN_VERIFY_DEDUP;
   }
 
+  /* Likewise for a dup verified by another verify tile at the same time */
+  if( FD_LIKELY( ctx->shared_tcache ) && FD_UNLIKELY( fd_tcache_shared_insert( ctx->shared_tcache, ha_dedup_tag ) ) ) {
+    return FD_TXN_VERIFY_DEDUP;
+  }
+
   *opt_sig = ha_dedup_tag;
   return FD_TXN_VERIFY_SUCCESS;
 }
 
+/* fd_txn_verify_batch_{add,fini} split fd_txn_verify in two so that
+   the signatures of many txns can be verified together, which is
+   faster than verifying them one txn at a time as most txns only have
+   one signature.  Results are the same as calling fd_txn_verify on each
+   of the txns in the order they were added.
+
+   fd_txn_verify_batch_add does the ha dedup check of the txn and, if it
+   is not a duplicate, queues its signatures to be verified and returns
+   FD_TXN_VERIFY_SUCCESS.  Otherwise it returns FD_TXN_VERIFY_DEDUP and
+   the txn is not queued.  The payload must not be modified until the
+   batch is finished.  chunk, sz and tsorig are stored with the txn
+   for the caller.  The txn comes from memory the producer controls, so
+   a txn with no signatures, more than FD_TXN_ACTUAL_SIG_MAX signatures
+   or more than fit in the batch (fd_txn_verify_batch_has_room was
+   checked on a txn that changed since) is not queued and
+   FD_TXN_VERIFY_FAILED is returned.
+
+   fd_txn_verify_batch_fini verifies all the queued signatures, writes
+   the result of each queued txn to res[i] (FD_TXN_VERIFY_SUCCESS,
+   FD_TXN_VERIFY_FAILED or FD_TXN_VERIFY_DEDUP) and inserts the ones
+   that succeeded into the ha dedup tcaches.  Returns the number of
+   queued txns, which are ctx->batch_txn[i] for i in [0,cnt), and empties
+   the batch (the txn descriptions stay valid until the next add). */
+
+static inline int
+fd_txn_verify_batch_has_room( fd_verify_ctx_t const * ctx,
+                              fd_txn_t const *        txn ) {
+  return ctx->batch_sig_cnt + txn->signature_cnt <= FD_ED25519_VERIFY_BATCH_MAX;
+}
+
+static inline int
+fd_txn_verify_batch_add( fd_verify_ctx_t * ctx,
+                         uchar const *     udp_payload,
+                         ushort const      payload_sz,
+                         fd_txn_t const *  txn,
+                         ulong             chunk,
+                         ulong             sz,
+                         ulong             tsorig ) {
+
+  /* We do not want to deref any non-data field from the txn struct more than once */
+  ulong  signature_cnt = txn->signature_cnt;
+  ushort signature_off = txn->signature_off;
+  ushort acct_addr_off = txn->acct_addr_off;
+  ushort message_off   = txn->message_off;
+
+  uchar const * signatures = udp_payload + signature_off;
+  uchar const * pubkeys = udp_payload + acct_addr_off;
+  uchar const * msg = udp_payload + message_off;
+  ulong msg_sz = (ulong)payload_sz - message_off;
+
+  /* A txn with no signatures would pass without anything verified */
+  if( FD_UNLIKELY( (!signature_cnt) | (signature_cnt>FD_TXN_ACTUAL_SIG_MAX) ) ) {
+    return FD_TXN_VERIFY_FAILED;
+  }
+  if( FD_UNLIKELY( ctx->batch_sig_cnt+signature_cnt>FD_ED25519_VERIFY_BATCH_MAX ) ) {
+    return FD_TXN_VERIFY_FAILED;
+  }
+
+  /* See fd_txn_verify */
+  ulong ha_dedup_tag = *((ulong *)signatures);
+  int ha_dup;
+  FD_FN_UNUSED ulong tcache_map_idx = 0; /* ignored */
+  FD_TCACHE_QUERY( ha_dup, tcache_map_idx, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+  if( FD_UNLIKELY( ha_dup ) ) {
+    return FD_TXN_VERIFY_DEDUP;
+  }
+  if( FD_LIKELY( ctx->shared_tcache ) && FD_UNLIKELY( fd_tcache_shared_query( ctx->shared_tcache, ha_dedup_tag ) ) ) {
+    return FD_TXN_VERIFY_DEDUP;
+  }
+
+  ulong sig_idx = ctx->batch_sig_cnt;
+  for( ulong i=0UL; i<signature_cnt; i++ ) {
+    ctx->batch_msg   [ sig_idx+i ] = msg;
+    ctx->batch_msg_sz[ sig_idx+i ] = msg_sz;
+    ctx->batch_sig   [ sig_idx+i ] = signatures + 64UL*i;
+    ctx->batch_pub   [ sig_idx+i ] = pubkeys    + 32UL*i;
+  }
+  ctx->batch_sig_cnt = sig_idx + signature_cnt;
+
+  fd_verify_batch_txn_t * batch_txn = ctx->batch_txn + ctx->batch_txn_cnt++;
+  batch_txn->tag     = ha_dedup_tag;
+  batch_txn->sig_cnt = signature_cnt;
+  batch_txn->chunk   = chunk;
+  batch_txn->sz      = sz;
+  batch_txn->tsorig  = tsorig;
+  return FD_TXN_VERIFY_SUCCESS;
+}
+
+static inline ulong
+fd_txn_verify_batch_fini( fd_verify_ctx_t * ctx,
+                          int *             res ) {
+  ulong txn_cnt = ctx->batch_txn_cnt;
+  if( FD_UNLIKELY( !txn_cnt ) ) return 0UL;
+
+  fd_ed25519_verify_batch_multi_msg( ctx->batch_msg, ctx->batch_msg_sz, ctx->batch_sig, ctx->batch_pub,
+                                     ctx->sha, ctx->batch_sig_cnt, ctx->batch_err );
+
+  int const * err = ctx->batch_err;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_verify_batch_txn_t const * batch_txn = ctx->batch_txn + i;
+
+    int ok = 1;
+    for( ulong j=0UL; j<batch_txn->sig_cnt; j++ ) ok &= err[ j ]==FD_ED25519_SUCCESS;
+    err += batch_txn->sig_cnt;
+
+    if( FD_UNLIKELY( !ok ) ) {
+      res[ i ] = FD_TXN_VERIFY_FAILED;
+      continue;
+    }
+
+    /* Txns later in the batch might be duplicates of earlier ones, as
+       in fd_txn_verify, the insert catches this. */
+    int ha_dup;
+    FD_TCACHE_INSERT( ha_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, batch_txn->tag );
+    if( FD_LIKELY( ctx->shared_tcache && !ha_dup ) ) ha_dup = fd_tcache_shared_insert( ctx->shared_tcache, batch_txn->tag );
+    res[ i ] = fd_int_if( ha_dup, FD_TXN_VERIFY_DEDUP, FD_TXN_VERIFY_SUCCESS );
+  }
+
+  ctx->batch_txn_cnt = 0UL;
+  ctx->batch_sig_cnt = 0UL;
+  return txn_cnt;
+}
+
 #endif /* HEADER_fd_src_app_fdctl_run_tiles_verify_h */
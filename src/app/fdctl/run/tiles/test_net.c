@@ -0,0 +1,87 @@
+#include "fd_net.h"
+#include "../../../../waltz/xdp/fd_xdp_redirect_prog.h"
+
+/* With flow steering, the queue id is published as the 8 bit sig hash */
+
+FD_STATIC_ASSERT( FD_XDP_XSKS_MAP_CNT<=256UL, queue_id );
+
+/* test_queue_mapping checks that, for every queue count that passes
+   config validation, the net tiles together bind each network device
+   queue exactly once, each to a contiguous range of queues. */
+
+static void
+test_queue_mapping( void ) {
+  static uchar bound[ FD_XDP_XSKS_MAP_CNT ];
+
+  for( ulong net_tile_cnt=1UL; net_tile_cnt<=64UL; net_tile_cnt++ ) {
+    for( ulong queues_per_tile=1UL; queues_per_tile<=NET_XDP_QUEUES_PER_TILE_MAX; queues_per_tile++ ) {
+      ulong queue_cnt = net_tile_cnt*queues_per_tile;
+      if( queue_cnt>FD_XDP_XSKS_MAP_CNT ) continue;
+
+      fd_memset( bound, 0, sizeof(bound) );
+      for( ulong k=0UL; k<net_tile_cnt; k++ ) {
+        ulong queue0 = fd_net_xdp_queue_id( k, queues_per_tile, 0UL );
+        for( ulong i=0UL; i<queues_per_tile; i++ ) {
+          ulong queue_id = fd_net_xdp_queue_id( k, queues_per_tile, i );
+          FD_TEST( queue_id==queue0+i );
+          FD_TEST( queue_id<queue_cnt );
+          FD_TEST( !bound[ queue_id ] );
+          bound[ queue_id ] = 1;
+        }
+      }
+      for( ulong q=0UL; q<queue_cnt; q++ ) FD_TEST( bound[ q ] );
+    }
+  }
+}
+
+/* test_rx_sig checks which QUIC tile gets the packets of a flow.
+   Without steering it depends on the source address and port only,
+   whatever the queue.  With steering it depends on the queue only, and
+   when the queue count is a multiple of the QUIC tile count (as config
+   validation requires), every QUIC tile gets the same number of
+   queues. */
+
+static void
+test_rx_sig( fd_rng_t * rng ) {
+  for( ulong queue_cnt=1UL; queue_cnt<=FD_XDP_XSKS_MAP_CNT; queue_cnt++ ) {
+    for( ulong quic_tile_cnt=1UL; quic_tile_cnt<=16UL; quic_tile_cnt++ ) {
+      if( queue_cnt%quic_tile_cnt ) continue;
+
+      ulong quic_queue_cnt[ 16 ] = {0};
+      for( ulong q=0UL; q<queue_cnt; q++ ) {
+        uint   src_ip   = fd_rng_uint  ( rng );
+        ushort src_port = fd_rng_ushort( rng );
+
+        ulong sig   = fd_net_rx_sig( src_ip, src_port, DST_PROTO_TPU_QUIC, 42UL, 0, q );
+        ulong sig_q = fd_net_rx_sig( src_ip, src_port, DST_PROTO_TPU_QUIC, 42UL, 1, q );
+
+        FD_TEST( sig==fd_disco_netmux_sig( src_ip, src_port, 0U, DST_PROTO_TPU_QUIC, 42UL ) );
+        FD_TEST( fd_disco_netmux_sig_hash( sig )==((fd_uint_hash( src_ip )+src_port) & 0xFFUL) );
+
+        FD_TEST( fd_disco_netmux_sig_hash  ( sig_q )==q                  );
+        FD_TEST( fd_disco_netmux_sig_proto ( sig_q )==DST_PROTO_TPU_QUIC );
+        FD_TEST( fd_disco_netmux_sig_hdr_sz( sig_q )==42UL               );
+
+        quic_queue_cnt[ fd_disco_netmux_sig_hash( sig_q ) % quic_tile_cnt ]++;
+      }
+      for( ulong t=0UL; t<quic_tile_cnt; t++ ) FD_TEST( quic_queue_cnt[ t ]==queue_cnt/quic_tile_cnt );
+    }
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_queue_mapping();
+  test_rx_sig( rng );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -126,19 +126,22 @@ setup_verify_ctx( fd_verify_ctx_t * ctx, void ** mem ) {
   ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
   fd_tcache_reset( ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt );
 
+  ctx->shared_tcache = NULL;
+
+  ctx->batch_txn_cnt = 0UL;
+  ctx->batch_sig_cnt = 0UL;
+
   /* ctx->sha */
-  uchar * _sha = aligned_alloc( FD_SHA512_ALIGN, sizeof(fd_sha512_t)*FD_TXN_ACTUAL_SIG_MAX );
-  for ( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
-    fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha + i*sizeof(fd_sha512_t) ) );
-    if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
-    ctx->sha[i] = sha;
-  }
+  uchar * _sha = aligned_alloc( FD_SHA512_ALIGN, sizeof(fd_sha512_t) );
+  fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+  if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
+  ctx->sha = sha;
 }
 
 static void
 free_verify_ctx( fd_verify_ctx_t * ctx, void * mem ) {
   free(mem);
-  free(ctx->sha[0]); // all sha allocated in a single malloc, the first one has the address
+  free(ctx->sha);
 }
 
 static void
@@ -265,6 +268,179 @@ test_verify_invalid_dedup_success( void ) {
   free_verify_ctx( ctx, mem );
 }
 
+static void
+test_verify_batch( void ) {
+  fd_verify_ctx_t ctx[1];
+  void *          mem = NULL;
+  uchar           out_buf[ 4 ][ FD_TXN_MAX_SZ ];
+  uchar *         payload   [ 4 ];
+  ulong           payload_sz[ 4 ];
+  int             res[ VERIFY_BATCH_TXN_MAX ];
+
+  FD_LOG_NOTICE(( "test_verify_batch" ));
+  setup_verify_ctx( ctx, &mem );
+
+  payload[ 0 ] = load_test_txn( valid_txn_1sig,        sizeof(valid_txn_1sig),        &payload_sz[ 0 ] );
+  payload[ 1 ] = load_test_txn( invalid_txn_2sigs,     sizeof(invalid_txn_2sigs),     &payload_sz[ 1 ] );
+  payload[ 2 ] = load_test_txn( valid_txn_2sigs,       sizeof(valid_txn_2sigs),       &payload_sz[ 2 ] );
+  payload[ 3 ] = load_test_txn( invalid_txn_same_1sig, sizeof(invalid_txn_same_1sig), &payload_sz[ 3 ] );
+  fd_txn_t * txn[ 4 ];
+  for( ulong i=0UL; i<4UL; i++ ) {
+    txn[ i ] = (fd_txn_t *)out_buf[ i ];
+    FD_TEST( fd_txn_parse( payload[ i ], payload_sz[ i ], out_buf[ i ], NULL ) );
+  }
+
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==0UL );
+
+  /* Results are per txn, in order, and a bad signature only fails its
+     own txn.  A duplicate within the same batch (the valid 1 sig txn
+     twice, or the invalid txn with the same first signature) is
+     caught when the batch is finished. */
+
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 3 ], (ushort)payload_sz[ 3 ], txn[ 3 ], 3UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 0 ], (ushort)payload_sz[ 0 ], txn[ 0 ], 0UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 1 ], (ushort)payload_sz[ 1 ], txn[ 1 ], 1UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 2 ], (ushort)payload_sz[ 2 ], txn[ 2 ], 2UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 0 ], (ushort)payload_sz[ 0 ], txn[ 0 ], 0UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( ctx->batch_sig_cnt==7UL );
+
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==5UL );
+  FD_TEST( res[ 0 ]==FD_TXN_VERIFY_FAILED  ); FD_TEST( ctx->batch_txn[ 0 ].chunk==3UL );
+  FD_TEST( res[ 1 ]==FD_TXN_VERIFY_SUCCESS ); FD_TEST( ctx->batch_txn[ 1 ].chunk==0UL );
+  FD_TEST( res[ 2 ]==FD_TXN_VERIFY_FAILED  ); FD_TEST( ctx->batch_txn[ 2 ].chunk==1UL );
+  FD_TEST( res[ 3 ]==FD_TXN_VERIFY_SUCCESS ); FD_TEST( ctx->batch_txn[ 3 ].chunk==2UL );
+  FD_TEST( res[ 4 ]==FD_TXN_VERIFY_DEDUP   );
+  FD_TEST( ctx->batch_txn[ 1 ].tag==*(ulong *)(payload[ 0 ]+txn[ 0 ]->signature_off) );
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==0UL );
+
+  /* Txns that verified (and anything sharing their first signature)
+     are now deduped on add */
+
+  for( ulong i=0UL; i<4UL; i++ ) {
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload[ i ], (ushort)payload_sz[ i ], txn[ i ], 0UL, 0UL, 0UL )==FD_TXN_VERIFY_DEDUP );
+  }
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==0UL );
+
+  /* A full batch */
+
+  fd_tcache_reset( ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt );
+  ulong cnt = 0UL;
+  while( fd_txn_verify_batch_has_room( ctx, txn[ 2 ] ) ) {
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload[ 2 ], (ushort)payload_sz[ 2 ], txn[ 2 ], cnt, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+    cnt++;
+  }
+  FD_TEST( cnt==FD_ED25519_VERIFY_BATCH_MAX/2UL );
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==cnt );
+  FD_TEST( res[ 0 ]==FD_TXN_VERIFY_SUCCESS );
+  for( ulong i=1UL; i<cnt; i++ ) FD_TEST( res[ i ]==FD_TXN_VERIFY_DEDUP );
+
+  for( ulong i=0UL; i<4UL; i++ ) free( payload[ i ] );
+  free_verify_ctx( ctx, mem );
+}
+
+static void
+test_verify_batch_bad_sig_cnt( void ) {
+  fd_verify_ctx_t ctx[1];
+  void *          mem = NULL;
+  uchar           out_buf[FD_TXN_MAX_SZ];
+  fd_txn_t *      txn = (fd_txn_t *)out_buf;
+  ulong           payload_sz;
+  int             res[ VERIFY_BATCH_TXN_MAX ];
+
+  FD_LOG_NOTICE(( "test_verify_batch_bad_sig_cnt" ));
+  setup_verify_ctx( ctx, &mem );
+
+  uchar * payload = load_test_txn( valid_txn_2sigs, sizeof(valid_txn_2sigs), &payload_sz );
+  FD_TEST( fd_txn_parse( payload, payload_sz, out_buf, NULL ) );
+
+  /* The producer can rewrite the txn after it was parsed.  A signature
+     count that is 0 or too large fails the txn without queuing
+     anything. */
+
+  uchar bad_sig_cnt[] = { 0, (uchar)(FD_TXN_ACTUAL_SIG_MAX+1UL), (uchar)(FD_ED25519_VERIFY_BATCH_MAX+1UL), 255 };
+  for( ulong i=0UL; i<sizeof(bad_sig_cnt); i++ ) {
+    txn->signature_cnt = bad_sig_cnt[ i ];
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload, (ushort)payload_sz, txn, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_FAILED );
+    FD_TEST( ctx->batch_txn_cnt==0UL );
+    FD_TEST( ctx->batch_sig_cnt==0UL );
+  }
+  FD_TEST( !fd_txn_verify_batch_has_room( ctx, txn ) );
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==0UL );
+
+  /* Nor can a txn that grew since has_room was checked overflow the
+     batch */
+
+  uchar      out_buf1[FD_TXN_MAX_SZ];
+  fd_txn_t * txn1 = (fd_txn_t *)out_buf1;
+  ulong      payload1_sz;
+  uchar *    payload1 = load_test_txn( valid_txn_1sig, sizeof(valid_txn_1sig), &payload1_sz );
+  FD_TEST( fd_txn_parse( payload1, payload1_sz, out_buf1, NULL ) );
+
+  txn->signature_cnt = 2;
+  for( ulong i=0UL; i<FD_ED25519_VERIFY_BATCH_MAX-1UL; i++ ) {
+    FD_TEST( fd_txn_verify_batch_add( ctx, payload1, (ushort)payload1_sz, txn1, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  }
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload, (ushort)payload_sz, txn, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_FAILED );
+  FD_TEST( ctx->batch_sig_cnt==FD_ED25519_VERIFY_BATCH_MAX-1UL );
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==FD_ED25519_VERIFY_BATCH_MAX-1UL );
+
+  /* The txn is still fine with its real signature count */
+
+  FD_TEST( fd_txn_verify_batch_add( ctx, payload, (ushort)payload_sz, txn, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_fini( ctx, res )==1UL );
+  FD_TEST( res[ 0 ]==FD_TXN_VERIFY_SUCCESS );
+
+  free( payload1 );
+  free( payload );
+  free_verify_ctx( ctx, mem );
+}
+
+static uchar __attribute__((aligned(FD_TCACHE_SHARED_ALIGN))) shared_tcache_mem[ FD_TCACHE_SHARED_FOOTPRINT( 64UL ) ];
+
+static void
+test_verify_shared_tcache( void ) {
+  fd_verify_ctx_t ctx[2];
+  void *          mem[2] = { NULL, NULL };
+  uchar           out_buf[FD_TXN_MAX_SZ];
+  fd_txn_t *      txn = (fd_txn_t *)out_buf;
+  ulong           payload_sz;
+  ulong           opt_sig;
+  int             res[ VERIFY_BATCH_TXN_MAX ];
+
+  FD_LOG_NOTICE(( "test_verify_shared_tcache" ));
+
+  /* Two verify tiles sharing a tcache */
+  fd_tcache_shared_t * shared_tcache = fd_tcache_shared_join( fd_tcache_shared_new( shared_tcache_mem, 64UL, 42UL ) );
+  FD_TEST( shared_tcache );
+  for( ulong i=0UL; i<2UL; i++ ) {
+    setup_verify_ctx( ctx+i, mem+i );
+    ctx[i].shared_tcache = shared_tcache;
+  }
+
+  uchar * payload = load_test_txn( valid_txn_1sig, sizeof(valid_txn_1sig), &payload_sz );
+  FD_TEST( fd_txn_parse( payload, payload_sz, out_buf, NULL ) );
+
+  /* A txn verified by one tile is deduped by the other */
+  FD_TEST( fd_txn_verify( ctx+0, payload, (ushort)payload_sz, txn, &opt_sig )==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify( ctx+1, payload, (ushort)payload_sz, txn, &opt_sig )==FD_TXN_VERIFY_DEDUP   );
+  FD_TEST( fd_txn_verify_batch_add( ctx+1, payload, (ushort)payload_sz, txn, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_DEDUP );
+
+  /* Both tiles verify the same txn at the same time (it is queued in
+     both batches before either finishes), only the first to finish
+     passes it on */
+  fd_tcache_shared_reset( shared_tcache );
+  for( ulong i=0UL; i<2UL; i++ ) {
+    fd_tcache_reset( ctx[i].tcache_ring, ctx[i].tcache_depth, ctx[i].tcache_map, ctx[i].tcache_map_cnt );
+    FD_TEST( fd_txn_verify_batch_add( ctx+i, payload, (ushort)payload_sz, txn, 0UL, 0UL, 0UL )==FD_TXN_VERIFY_SUCCESS );
+  }
+  FD_TEST( fd_txn_verify_batch_fini( ctx+1, res )==1UL ); FD_TEST( res[ 0 ]==FD_TXN_VERIFY_SUCCESS );
+  FD_TEST( fd_txn_verify_batch_fini( ctx+0, res )==1UL ); FD_TEST( res[ 0 ]==FD_TXN_VERIFY_DEDUP   );
+
+  free( payload );
+  for( ulong i=0UL; i<2UL; i++ ) free_verify_ctx( ctx+i, mem[i] );
+  fd_tcache_shared_delete( fd_tcache_shared_leave( shared_tcache ) );
+}
+
 int
 main( int     argc,
       char ** argv ) {
@@ -273,6 +449,9 @@ main( int     argc,
   test_verify_success();
   test_verify_invalid_sigs_success();
   test_verify_invalid_dedup_success();
+  test_verify_batch();
+  test_verify_batch_bad_sig_cnt();
+  test_verify_shared_tcache();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -1,5 +1,5 @@
 $(call add-hdrs,fd_aes.h)
-$(call add-objs,fd_aes fd_aes_ref,fd_ballet)
+$(call add-objs,fd_aes fd_aes_ref fd_aes_gcm_batch,fd_ballet)
 ifdef FD_HAS_AESNI
 $(call add-asms,fd_aesni fd_aesni_gcm,fd_ballet)
 endif
@@ -65,6 +65,27 @@ fd_aes_256_gcm_init( fd_aes_gcm_t * aes_gcm,
   fd_aes_gcm_init( aes_gcm, key, 32UL, iv );
 }
 
+/* fd_aes_gcm_init_key does the part of fd_aes_gcm_init that only
+   depends on the key (the AES key expansion and the GHASH table
+   precomputation, which is most of the cost of fd_aes_gcm_init).
+   fd_aes_gcm_setiv does the rest, starting a new message with the
+   given iv.  A fd_aes_gcm_t is single use after fd_aes_gcm_init, but
+   can be reused for any number of messages under the same key by
+   calling fd_aes_gcm_setiv before each (e.g. initialize the key once
+   per session and set the per-message nonce as the iv).  Like
+   fd_aes_gcm_init, fd_aes_gcm_init_key only supports key_sz in
+   {16,24,32} and a fd_aes_gcm_t initialized with it must be given an iv
+   before use.  A fd_aes_gcm_t can be copied by value. */
+
+void
+fd_aes_gcm_init_key( fd_aes_gcm_t * aes_gcm,
+                     uchar const *  key,
+                     ulong          key_sz );
+
+void
+fd_aes_gcm_setiv( fd_aes_gcm_t * aes_gcm,
+                  uchar const    iv[ static 12 ] );
+
 /* fd_aes_gcm_aead_{encrypt,decrypt} implements the AES-GCM AEAD cipher
    c points to the ciphertext buffer.  p points to the plaintext buffer.
    sz is the length of the p and c buffers.  p,c,sz do not have align-
@@ -104,6 +125,42 @@ fd_aes_gcm_aead_decrypt( fd_aes_gcm_t * aes_gcm,
                          ulong          aad_sz,
                          uchar const    tag[ static 16 ] );
 
+/* fd_aes_gcm_aead_decrypt_batch decrypts and authenticates batch_cnt
+   independent messages, like fd_aes_gcm_aead_decrypt does for one.
+   For i in [0,batch_cnt), message i is decrypted with gcm[i] (which
+   must have been initialized with fd_aes_gcm_init_key or
+   fd_aes_gcm_init) and iv[i] (12 bytes), from c[i] to p[i] (sz[i]
+   bytes), with additional data aad[i] (aad_sz[i] bytes) and expected
+   tag tag[i] (16 bytes).  On return, ok[i] is 1 if message i was
+   authentic and 0 if not.  The plaintext of a message that failed is
+   unspecified.  p[i] may be equal to c[i] but must not otherwise
+   overlap any input.
+
+   The same gcm may appear multiple times in a batch.  Any per-message
+   state in the gcm objects (i.e. the iv set by fd_aes_gcm_setiv) is
+   clobbered, so a gcm must be given a new iv before any other use.
+   The tag comparison is constant time.
+
+   On targets with AES-NI, up to FD_AES_GCM_BATCH_MAX messages are
+   processed at a time with their AES and GHASH computations
+   interleaved, which is considerably faster than decrypting small
+   messages (e.g. QUIC packets) one at a time.  Other targets fall back
+   to fd_aes_gcm_aead_decrypt.  Any batch_cnt is supported. */
+
+#define FD_AES_GCM_BATCH_MAX (8UL)
+
+void
+fd_aes_gcm_aead_decrypt_batch( fd_aes_gcm_t * const gcm   [],
+                               uchar const *  const iv    [],
+                               uchar const *  const c     [],
+                               uchar *        const p     [],
+                               ulong const          sz    [],
+                               uchar const *  const aad   [],
+                               ulong const          aad_sz[],
+                               uchar const *  const tag   [],
+                               ulong                batch_cnt,
+                               int                  ok    [] );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_aes_fd_aes_gcm_h */
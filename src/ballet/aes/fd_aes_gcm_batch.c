@@ -0,0 +1,360 @@
+#include "fd_aes_gcm.h"
+
+#if FD_HAS_AESNI && FD_HAS_AVX
+
+#include <immintrin.h>
+
+/* fd_aes_gcm_batch implements AES-GCM decryption of up to
+   FD_AES_GCM_BATCH_MAX independent messages at a time.
+
+   The single message implementation is built for long messages.  For
+   messages the size of a network packet, a large fraction of the
+   blocks are handled by the byte-at-a-time tail code, and the GHASH
+   chain (one multiplication per block, each depending on the previous)
+   leaves the multiplier idle most of the time.  Here:
+
+   - GHASH uses the aggregated reduction method: up to 8 blocks of a
+     message are multiplied by H^8..H^1 independently and reduced once.
+     The powers of H come from the Htable computed by fd_gcm_init_avx,
+     so no per call key setup is needed.
+
+   - Groups of 8 full blocks are decrypted one message at a time with
+     the round keys in registers and the GHASH of the group stitched in.
+
+   - Everything else (the AAD, the last partial group of each message
+     and E(K,J0)) is small, so it is done for all messages in lockstep:
+     GHASH chains of different messages overlap and the leftover AES
+     blocks of all messages are pooled and encrypted 8 at a time.
+
+   The GHASH arithmetic follows fd_ghash_avx.S (byte reversed blocks
+   times "twisted" powers of H, reduced modulo the bit reflected GCM
+   polynomial). */
+
+/* fd_gcm_batch_Hpow returns the twisted H^k, k in [1,8], from an
+   Htable initialized by fd_gcm_init_avx (laid out as H^1, H^2, salt,
+   H^3, H^4, salt, ...). */
+
+static inline __m128i
+fd_gcm_batch_Hpow( fd_gcm128_t const * Htable,
+                   ulong               k ) {
+  return _mm_loadu_si128( (__m128i const *)( Htable + 3UL*((k-1UL)>>1) + ((k-1UL)&1UL) ) );
+}
+
+/* fd_gcm_batch_mul_acc accumulates the unreduced product of x and the
+   twisted h into (lo,mid,hi). */
+
+#define FD_GCM_BATCH_MUL_ACC( lo, mid, hi, x, h ) do {                   \
+    __m128i _x = (x); __m128i _h = (h);                                   \
+    (lo)  = _mm_xor_si128( (lo),  _mm_clmulepi64_si128( _x, _h, 0x00 ) ); \
+    (hi)  = _mm_xor_si128( (hi),  _mm_clmulepi64_si128( _x, _h, 0x11 ) ); \
+    (mid) = _mm_xor_si128( (mid), _mm_clmulepi64_si128( _x, _h, 0x01 ) ); \
+    (mid) = _mm_xor_si128( (mid), _mm_clmulepi64_si128( _x, _h, 0x10 ) ); \
+  } while(0)
+
+/* fd_gcm_batch_reduce returns the reduction of the 256-bit product
+   (lo,mid,hi). */
+
+static inline __m128i
+fd_gcm_batch_reduce( __m128i lo,
+                     __m128i mid,
+                     __m128i hi ) {
+  lo = _mm_xor_si128( lo, _mm_slli_si128( mid, 8 ) );
+  hi = _mm_xor_si128( hi, _mm_srli_si128( mid, 8 ) );
+
+  __m128i t = _mm_xor_si128( _mm_xor_si128( _mm_slli_epi64( lo, 57 ), _mm_slli_epi64( lo, 62 ) ),
+                             _mm_slli_epi64( lo, 63 ) );
+  lo = _mm_xor_si128( lo, _mm_slli_si128( t, 8 ) );
+  hi = _mm_xor_si128( hi, _mm_srli_si128( t, 8 ) );
+
+  t  = _mm_srli_epi64( lo, 1 );
+  hi = _mm_xor_si128( hi, lo );
+  lo = _mm_xor_si128( lo, t );
+  t  = _mm_srli_epi64( t, 5 );
+  lo = _mm_xor_si128( lo, t );
+  lo = _mm_srli_epi64( lo, 1 );
+  return _mm_xor_si128( lo, hi );
+}
+
+/* fd_gcm_batch_load loads the sz in [1,16] bytes at p as a zero padded
+   block. */
+
+static inline __m128i
+fd_gcm_batch_load( uchar const * p,
+                   ulong         sz ) {
+  if( FD_LIKELY( sz==16UL ) ) return _mm_loadu_si128( (__m128i const *)p );
+  uchar buf[ 16 ] __attribute__((aligned(16))) = {0};
+  fd_memcpy( buf, p, sz );
+  return _mm_load_si128( (__m128i const *)buf );
+}
+
+/* fd_gcm_batch_rk returns round key r of key */
+
+static inline __m128i
+fd_gcm_batch_rk( fd_aes_key_t const * key,
+                 int                  r ) {
+  return _mm_loadu_si128( (__m128i const *)( key->rd_key + 4*r ) );
+}
+
+/* fd_gcm_batch_aes8 encrypts the 8 blocks blk with key.  key->rounds
+   is the number of aesenc rounds in the aesni key schedule (9, 11 or 13
+   for 128, 192 or 256 bit keys), followed by an aesenclast round. */
+
+static inline void
+fd_gcm_batch_aes8( __m128i              blk[ 8 ],
+                   fd_aes_key_t const * key ) {
+  int     rounds = key->rounds;
+  __m128i rk     = fd_gcm_batch_rk( key, 0 );
+  for( ulong i=0UL; i<8UL; i++ ) blk[i] = _mm_xor_si128( blk[i], rk );
+  for( int r=1; r<=rounds; r++ ) {
+    rk = fd_gcm_batch_rk( key, r );
+    for( ulong i=0UL; i<8UL; i++ ) blk[i] = _mm_aesenc_si128( blk[i], rk );
+  }
+  rk = fd_gcm_batch_rk( key, rounds+1 );
+  for( ulong i=0UL; i<8UL; i++ ) blk[i] = _mm_aesenclast_si128( blk[i], rk );
+}
+
+/* fd_gcm_batch_aes8_multikey encrypts blk[i] with key[i] for i in
+   [0,8).  round_max is the max rounds of the keys. */
+
+static inline void
+fd_gcm_batch_aes8_multikey( __m128i                    blk[ 8 ],
+                            fd_aes_key_t const * const key[ 8 ],
+                            int                        round_max ) {
+  for( ulong i=0UL; i<8UL; i++ ) blk[i] = _mm_xor_si128( blk[i], fd_gcm_batch_rk( key[i], 0 ) );
+  for( int r=1; r<=round_max; r++ ) {
+    for( ulong i=0UL; i<8UL; i++ ) {
+      __m128i rk = fd_gcm_batch_rk( key[i], r );
+      blk[i] = r<=key[i]->rounds ? _mm_aesenc_si128( blk[i], rk ) : blk[i];
+    }
+  }
+  for( ulong i=0UL; i<8UL; i++ ) blk[i] = _mm_aesenclast_si128( blk[i], fd_gcm_batch_rk( key[i], key[i]->rounds+1 ) );
+}
+
+/* fd_gcm_batch_xor_store stores the sz in [1,16] bytes of ks^c to p */
+
+static inline void
+fd_gcm_batch_xor_store( uchar *       p,
+                        uchar const * c,
+                        ulong         sz,
+                        __m128i       ks ) {
+  if( FD_LIKELY( sz==16UL ) ) {
+    _mm_storeu_si128( (__m128i *)p, _mm_xor_si128( ks, _mm_loadu_si128( (__m128i const *)c ) ) );
+  } else {
+    uchar buf[ 16 ] __attribute__((aligned(16)));
+    _mm_store_si128( (__m128i *)buf, _mm_xor_si128( ks, fd_gcm_batch_load( c, sz ) ) );
+    fd_memcpy( p, buf, sz );
+  }
+}
+
+/* fd_gcm_batch_ghash returns the GHASH state X updated with the m in
+   [1,8] byte reversed blocks b, with a single reduction. */
+
+static inline __m128i
+fd_gcm_batch_ghash( __m128i             X,
+                    fd_gcm128_t const * Htable,
+                    __m128i const       b[ 8 ],
+                    ulong               m ) {
+  __m128i lo  = _mm_setzero_si128();
+  __m128i mid = _mm_setzero_si128();
+  __m128i hi  = _mm_setzero_si128();
+  FD_GCM_BATCH_MUL_ACC( lo, mid, hi, _mm_xor_si128( X, b[0] ), fd_gcm_batch_Hpow( Htable, m ) );
+  for( ulong k=1UL; k<m; k++ ) FD_GCM_BATCH_MUL_ACC( lo, mid, hi, b[k], fd_gcm_batch_Hpow( Htable, m-k ) );
+  return fd_gcm_batch_reduce( lo, mid, hi );
+}
+
+/* fd_gcm_batch_pool_t gathers single blocks of keystream to compute
+   for any of the messages, so that they can be computed 8 at a time.
+   A block with a NULL p is E(K,J0) of message msg, for the tag. */
+
+struct fd_gcm_batch_pool {
+  __m128i              blk[ 8 ];
+  fd_aes_key_t const * key[ 8 ];
+  uchar *              p  [ 8 ];
+  uchar const *        c  [ 8 ];
+  ulong                sz [ 8 ];
+  ulong                msg[ 8 ];
+  ulong                cnt;
+  int                  round_max;
+};
+
+typedef struct fd_gcm_batch_pool fd_gcm_batch_pool_t;
+
+static inline void
+fd_gcm_batch_pool_flush( fd_gcm_batch_pool_t * pool,
+                         __m128i               ek0[ FD_AES_GCM_BATCH_MAX ] ) {
+  ulong cnt = pool->cnt;
+  if( FD_UNLIKELY( !cnt ) ) return;
+  for( ulong k=cnt; k<8UL; k++ ) { pool->blk[k] = pool->blk[0]; pool->key[k] = pool->key[0]; }
+  fd_gcm_batch_aes8_multikey( pool->blk, pool->key, pool->round_max );
+  for( ulong k=0UL; k<cnt; k++ ) {
+    if( !pool->p[k] ) ek0[ pool->msg[k] ] = pool->blk[k];
+    else              fd_gcm_batch_xor_store( pool->p[k], pool->c[k], pool->sz[k], pool->blk[k] );
+  }
+  pool->cnt = 0UL;
+}
+
+static inline void
+fd_gcm_batch_pool_add( fd_gcm_batch_pool_t * pool,
+                       __m128i               ek0[ FD_AES_GCM_BATCH_MAX ],
+                       __m128i               blk,
+                       fd_aes_key_t const *  key,
+                       uchar *               p,
+                       uchar const *         c,
+                       ulong                 sz,
+                       ulong                 msg ) {
+  ulong k = pool->cnt;
+  pool->blk[k] = blk; pool->key[k] = key; pool->p[k] = p; pool->c[k] = c; pool->sz[k] = sz; pool->msg[k] = msg;
+  pool->round_max = fd_int_max( pool->round_max, key->rounds );
+  pool->cnt = k+1UL;
+  if( pool->cnt==8UL ) fd_gcm_batch_pool_flush( pool, ek0 );
+}
+
+static void
+fd_aes_gcm_aead_decrypt_batch_aesni( fd_aes_gcm_t * const gcm   [],
+                                     uchar const *  const iv    [],
+                                     uchar const *  const c     [],
+                                     uchar *        const p     [],
+                                     ulong const          sz    [],
+                                     uchar const *  const aad   [],
+                                     ulong const          aad_sz[],
+                                     uchar const *  const tag   [],
+                                     ulong                cnt,
+                                     int                  ok    [] ) {
+
+  __m128i const bswap = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+  __m128i const one   = _mm_set_epi32( 0, 0, 0, 1 );
+
+  __m128i X       [ FD_AES_GCM_BATCH_MAX ]; /* byte reversed GHASH state */
+  __m128i ctr     [ FD_AES_GCM_BATCH_MAX ]; /* byte reversed J0, i.e. the counter is the low dword */
+  __m128i j0      [ FD_AES_GCM_BATCH_MAX ];
+  __m128i ek0     [ FD_AES_GCM_BATCH_MAX ]; /* E(K,J0) */
+  ulong   aad_blk [ FD_AES_GCM_BATCH_MAX ];
+  ulong   bulk_sz [ FD_AES_GCM_BATCH_MAX ]; /* bytes of ciphertext done in groups of 8 blocks */
+  ulong   tail_blk[ FD_AES_GCM_BATCH_MAX ]; /* remaining ciphertext blocks plus the length block */
+
+  ulong aad_max  = 0UL;
+  ulong tail_max = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    X       [i] = _mm_setzero_si128();
+    uchar j0b[ 16 ] = { [15]=1 };
+    fd_memcpy( j0b, iv[i], 12UL );
+    j0      [i] = _mm_loadu_si128( (__m128i const *)j0b );
+    ctr     [i] = _mm_shuffle_epi8( j0[i], bswap );
+    aad_blk [i] = (aad_sz[i]+15UL)>>4;
+    bulk_sz [i] = sz[i] & ~127UL;
+    tail_blk[i] = ((sz[i]-bulk_sz[i]+15UL)>>4) + 1UL;
+    aad_max     = fd_ulong_max( aad_max,  aad_blk [i] );
+    tail_max    = fd_ulong_max( tail_max, tail_blk[i] );
+  }
+
+  /* GHASH the AAD of all messages in lockstep */
+
+  __m128i b[ 8 ];
+  for( ulong j=0UL; j<aad_max; j+=8UL ) {
+    for( ulong i=0UL; i<cnt; i++ ) {
+      if( j>=aad_blk[i] ) continue;
+      ulong m = fd_ulong_min( aad_blk[i]-j, 8UL );
+      for( ulong k=0UL; k<m; k++ ) {
+        ulong off = (j+k)<<4;
+        b[k] = _mm_shuffle_epi8( fd_gcm_batch_load( aad[i]+off, fd_ulong_min( aad_sz[i]-off, 16UL ) ), bswap );
+      }
+      X[i] = fd_gcm_batch_ghash( X[i], gcm[i]->Htable, b, m );
+    }
+  }
+
+  /* Groups of 8 full blocks, one message at a time, with the GHASH of
+     a group stitched with its decryption (the ciphertext of a group is
+     loaded before the plaintext is stored, so p may alias c). */
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_aes_key_t const * key    = &gcm[i]->key;
+    fd_gcm128_t const *  Htable = gcm[i]->Htable;
+    for( ulong off=0UL; off<bulk_sz[i]; off+=128UL ) {
+      __m128i ks[ 8 ];
+      for( ulong k=0UL; k<8UL; k++ ) {
+        ctr[i] = _mm_add_epi32( ctr[i], one ); /* mod 2^32 like GCM inc32 */
+        ks[k]  = _mm_shuffle_epi8( ctr[i], bswap );
+        b [k]  = _mm_loadu_si128( (__m128i const *)( c[i]+off+(k<<4) ) );
+      }
+      fd_gcm_batch_aes8( ks, key );
+      for( ulong k=0UL; k<8UL; k++ ) {
+        _mm_storeu_si128( (__m128i *)( p[i]+off+(k<<4) ), _mm_xor_si128( ks[k], b[k] ) );
+        b[k] = _mm_shuffle_epi8( b[k], bswap );
+      }
+      X[i] = fd_gcm_batch_ghash( X[i], Htable, b, 8UL );
+    }
+  }
+
+  /* GHASH the remaining ciphertext blocks and the length block of all
+     messages in lockstep (before decrypting them, so p may alias c) */
+
+  for( ulong j=0UL; j<tail_max; j+=8UL ) {
+    for( ulong i=0UL; i<cnt; i++ ) {
+      if( j>=tail_blk[i] ) continue;
+      ulong m = fd_ulong_min( tail_blk[i]-j, 8UL );
+      for( ulong k=0UL; k<m; k++ ) {
+        if( FD_LIKELY( j+k<tail_blk[i]-1UL ) ) {
+          ulong off = bulk_sz[i] + ((j+k)<<4);
+          b[k] = _mm_shuffle_epi8( fd_gcm_batch_load( c[i]+off, fd_ulong_min( sz[i]-off, 16UL ) ), bswap );
+        } else {
+          b[k] = _mm_set_epi64x( (long)(aad_sz[i]<<3), (long)(sz[i]<<3) );
+        }
+      }
+      X[i] = fd_gcm_batch_ghash( X[i], gcm[i]->Htable, b, m );
+    }
+  }
+
+  /* E(K,J0) and the keystream of the remaining blocks of all messages,
+     8 blocks at a time */
+
+  fd_gcm_batch_pool_t pool[1];
+  pool->cnt       = 0UL;
+  pool->round_max = 0;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_aes_key_t const * key = &gcm[i]->key;
+    fd_gcm_batch_pool_add( pool, ek0, j0[i], key, NULL, NULL, 0UL, i );
+    for( ulong off=bulk_sz[i]; off<sz[i]; off+=16UL ) {
+      ctr[i] = _mm_add_epi32( ctr[i], one );
+      fd_gcm_batch_pool_add( pool, ek0, _mm_shuffle_epi8( ctr[i], bswap ), key, p[i]+off, c[i]+off, fd_ulong_min( sz[i]-off, 16UL ), i );
+    }
+  }
+  fd_gcm_batch_pool_flush( pool, ek0 );
+
+  /* Tag check (constant time) */
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    __m128i t    = _mm_xor_si128( _mm_shuffle_epi8( X[i], bswap ), ek0[i] );
+    __m128i diff = _mm_xor_si128( t, _mm_loadu_si128( (__m128i const *)tag[i] ) );
+    ok[i] = _mm_testz_si128( diff, diff );
+  }
+}
+
+#endif /* FD_HAS_AESNI && FD_HAS_AVX */
+
+void
+fd_aes_gcm_aead_decrypt_batch( fd_aes_gcm_t * const gcm   [],
+                               uchar const *  const iv    [],
+                               uchar const *  const c     [],
+                               uchar *        const p     [],
+                               ulong const          sz    [],
+                               uchar const *  const aad   [],
+                               ulong const          aad_sz[],
+                               uchar const *  const tag   [],
+                               ulong                batch_cnt,
+                               int                  ok    [] ) {
+
+# if FD_HAS_AESNI && FD_HAS_AVX
+  if( FD_LIKELY( batch_cnt>1UL ) ) {
+    for( ulong i=0UL; i<batch_cnt; i+=FD_AES_GCM_BATCH_MAX ) {
+      ulong n = fd_ulong_min( batch_cnt-i, FD_AES_GCM_BATCH_MAX );
+      fd_aes_gcm_aead_decrypt_batch_aesni( gcm+i, iv+i, c+i, p+i, sz+i, aad+i, aad_sz+i, tag+i, n, ok+i );
+    }
+    return;
+  }
+# endif
+
+  for( ulong i=0UL; i<batch_cnt; i++ ) {
+    fd_aes_gcm_setiv( gcm[i], iv[i] );
+    ok[i] = fd_aes_gcm_aead_decrypt( gcm[i], c[i], p[i], sz[i], aad[i], aad_sz[i], tag[i] );
+  }
+}
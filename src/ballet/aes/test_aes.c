@@ -464,6 +464,10 @@ test_aes_128_gcm_unroll( void ) {
       0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
       0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
 
+  /* Same key for every message, only the iv is set per message */
+  fd_aes_gcm_t gcm_keyed[1];
+  fd_aes_gcm_init_key( gcm_keyed, key, 16UL );
+
   for( ulong j=1; j<sizeof(plaintext); j++ ) {
 
     uchar result[ 2048 ];
@@ -480,7 +484,151 @@ test_aes_128_gcm_unroll( void ) {
     if( FD_UNLIKELY( !ok || 0!=memcmp( result, plaintext, j ) ) )
       FD_LOG_ERR(( "FAIL: AES-128-GCM unroll decrypt (AES-NI) for sz %lu (decrypt fail)", j ));
 
+    uchar tag2[ 16 ];
+    fd_aes_gcm_setiv( gcm_keyed, iv );
+    fd_aes_gcm_aead_encrypt( gcm_keyed, result, plaintext, j, aad, sizeof(aad), tag2 );
+    if( FD_UNLIKELY( 0!=memcmp( result, fixture_aes_128_gcm_unroll, j ) || 0!=memcmp( tag, tag2, 16UL ) ) )
+      FD_LOG_ERR(( "FAIL: AES-128-GCM unroll encrypt (AES-NI) for sz %lu (setiv encrypt fail)", j ));
+
+    fd_aes_gcm_setiv( gcm_keyed, iv );
+    ok = fd_aes_gcm_aead_decrypt( gcm_keyed, fixture_aes_128_gcm_unroll, result, j, aad, sizeof(aad), tag );
+    if( FD_UNLIKELY( !ok || 0!=memcmp( result, plaintext, j ) ) )
+      FD_LOG_ERR(( "FAIL: AES-128-GCM unroll decrypt (AES-NI) for sz %lu (setiv decrypt fail)", j ));
+
+  }
+}
+
+/* AES-GCM batch tests ************************************************/
+
+#define BATCH_TEST_MAX (19UL) /* exercise a partial sub batch */
+#define BATCH_MSG_MAX  (1600UL)
+
+static void
+test_aes_gcm_batch( fd_rng_t * rng ) {
+
+  static uchar pt  [ BATCH_TEST_MAX ][ BATCH_MSG_MAX ];
+  static uchar ct  [ BATCH_TEST_MAX ][ BATCH_MSG_MAX ];
+  static uchar out [ BATCH_TEST_MAX ][ BATCH_MSG_MAX ];
+  static uchar aadb[ BATCH_TEST_MAX ][ 64 ];
+  static uchar ivb [ BATCH_TEST_MAX ][ 12 ];
+  static uchar tagb[ BATCH_TEST_MAX ][ 16 ];
+  static fd_aes_gcm_t gcm_mem[ BATCH_TEST_MAX ];
+
+  fd_aes_gcm_t * gcm   [ BATCH_TEST_MAX ];
+  uchar const *  iv    [ BATCH_TEST_MAX ];
+  uchar const *  c     [ BATCH_TEST_MAX ];
+  uchar *        p     [ BATCH_TEST_MAX ];
+  ulong          sz    [ BATCH_TEST_MAX ];
+  uchar const *  aad   [ BATCH_TEST_MAX ];
+  ulong          aad_sz[ BATCH_TEST_MAX ];
+  uchar const *  tag   [ BATCH_TEST_MAX ];
+  int            ok    [ BATCH_TEST_MAX ];
+
+  for( ulong iter=0UL; iter<4096UL; iter++ ) {
+    ulong batch_cnt = fd_rng_ulong_roll( rng, BATCH_TEST_MAX+1UL );
+    for( ulong i=0UL; i<batch_cnt; i++ ) {
+
+      /* Random key (16 or 32 bytes), sometimes shared with the previous
+         message of the batch */
+
+      if( i && fd_rng_uint_roll( rng, 4U )==0U ) {
+        gcm[i] = gcm[i-1UL];
+      } else {
+        uchar key[ 32 ];
+        for( ulong b=0UL; b<32UL; b++ ) key[b] = fd_rng_uchar( rng );
+        fd_aes_gcm_init_key( &gcm_mem[i], key, fd_rng_uint_roll( rng, 2U ) ? 16UL : 32UL );
+        gcm[i] = &gcm_mem[i];
+      }
+
+      sz    [i] = fd_rng_ulong_roll( rng, BATCH_MSG_MAX+1UL );
+      aad_sz[i] = fd_rng_ulong_roll( rng, 65UL );
+      for( ulong b=0UL; b<sz[i];     b++ ) pt  [i][b] = fd_rng_uchar( rng );
+      for( ulong b=0UL; b<aad_sz[i]; b++ ) aadb[i][b] = fd_rng_uchar( rng );
+      for( ulong b=0UL; b<12UL;      b++ ) ivb [i][b] = fd_rng_uchar( rng );
+
+      fd_aes_gcm_t enc[1] = { *gcm[i] };
+      fd_aes_gcm_setiv( enc, ivb[i] );
+      fd_aes_gcm_aead_encrypt( enc, ct[i], pt[i], sz[i], aadb[i], aad_sz[i], tagb[i] );
+
+      /* Corrupt some messages */
+
+      switch( fd_rng_uint_roll( rng, 8U ) ) {
+      case 0U:                 tagb[i][ fd_rng_ulong_roll( rng, 16UL      ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U )); break;
+      case 1U: if( sz[i]     ) ct  [i][ fd_rng_ulong_roll( rng, sz[i]     ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U )); break;
+      case 2U: if( aad_sz[i] ) aadb[i][ fd_rng_ulong_roll( rng, aad_sz[i] ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U )); break;
+      default: break;
+      }
+
+      /* Sometimes decrypt in place */
+
+      int in_place = !fd_rng_uint_roll( rng, 4U );
+      if( in_place ) fd_memcpy( out[i], ct[i], sz[i] );
+      iv [i] = ivb [i];
+      c  [i] = in_place ? out[i] : ct[i];
+      p  [i] = out [i];
+      aad[i] = aadb[i];
+      tag[i] = tagb[i];
+      ok [i] = -1;
+    }
+
+    fd_aes_gcm_aead_decrypt_batch( gcm, iv, c, p, sz, aad, aad_sz, tag, batch_cnt, ok );
+
+    for( ulong i=0UL; i<batch_cnt; i++ ) {
+      uchar ref[ BATCH_MSG_MAX ];
+      fd_aes_gcm_t dec[1] = { *gcm[i] };
+      fd_aes_gcm_setiv( dec, ivb[i] );
+      int ref_ok = fd_aes_gcm_aead_decrypt( dec, ct[i], ref, sz[i], aadb[i], aad_sz[i], tagb[i] );
+      if( FD_UNLIKELY( ok[i]!=ref_ok ) )
+        FD_LOG_ERR(( "FAIL: AES-GCM batch decrypt (iter %lu msg %lu of %lu, sz %lu aad_sz %lu): ok %d expected %d",
+                     iter, i, batch_cnt, sz[i], aad_sz[i], ok[i], ref_ok ));
+      if( FD_UNLIKELY( ok[i] && ( 0!=memcmp( out[i], ref, sz[i] ) || 0!=memcmp( out[i], pt[i], sz[i] ) ) ) )
+        FD_LOG_ERR(( "FAIL: AES-GCM batch decrypt (iter %lu msg %lu of %lu, sz %lu aad_sz %lu): bad plaintext",
+                     iter, i, batch_cnt, sz[i], aad_sz[i] ));
+    }
   }
+
+  /* Benchmark decrypting packet sized messages one at a time vs
+     batched */
+
+  static ulong const bench_sz[] = { 64UL, 256UL, 512UL, 768UL, 1200UL };
+  ulong pkt_cnt  = FD_AES_GCM_BATCH_MAX;
+  ulong iter_cnt = 1UL<<14;
+  for( ulong s=0UL; s<sizeof(bench_sz)/sizeof(bench_sz[0]); s++ ) {
+    ulong pkt_sz = bench_sz[s];
+    uchar key[ 16 ] = {0};
+    for( ulong i=0UL; i<pkt_cnt; i++ ) {
+      key[0] = (uchar)i;
+      fd_aes_gcm_init_key( &gcm_mem[i], key, 16UL );
+      fd_aes_gcm_t enc[1] = { gcm_mem[i] };
+      fd_aes_gcm_setiv( enc, ivb[i] );
+      fd_aes_gcm_aead_encrypt( enc, ct[i], pt[i], pkt_sz, aadb[i], 32UL, tagb[i] );
+      gcm[i] = &gcm_mem[i]; iv[i] = ivb[i]; c[i] = ct[i]; p[i] = out[i]; sz[i] = pkt_sz;
+      aad[i] = aadb[i]; aad_sz[i] = 32UL; tag[i] = tagb[i];
+    }
+
+    long dt = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+      for( ulong i=0UL; i<pkt_cnt; i++ ) {
+        fd_aes_gcm_setiv( gcm[i], iv[i] );
+        ok[i] = fd_aes_gcm_aead_decrypt( gcm[i], c[i], p[i], sz[i], aad[i], aad_sz[i], tag[i] );
+      }
+      FD_COMPILER_MFENCE();
+    }
+    dt += fd_log_wallclock();
+    for( ulong i=0UL; i<pkt_cnt; i++ ) FD_TEST( ok[i] );
+    FD_LOG_NOTICE(( "~%6.3f Gbps / core (%4lu B messages, one at a time)", (double)(8UL*pkt_sz*pkt_cnt*iter_cnt)/(double)dt, pkt_sz ));
+
+    dt = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+      fd_aes_gcm_aead_decrypt_batch( gcm, iv, c, p, sz, aad, aad_sz, tag, pkt_cnt, ok );
+      FD_COMPILER_MFENCE();
+    }
+    dt += fd_log_wallclock();
+    for( ulong i=0UL; i<pkt_cnt; i++ ) FD_TEST( ok[i] );
+    FD_LOG_NOTICE(( "~%6.3f Gbps / core (%4lu B messages, batches of %lu)", (double)(8UL*pkt_sz*pkt_cnt*iter_cnt)/(double)dt, pkt_sz, pkt_cnt ));
+  }
+
+  FD_LOG_INFO(( "OK: AES-GCM batch decrypt" ));
 }
 
 /* Main ***************************************************************/
@@ -498,6 +646,10 @@ main( int     argc,
   //test_aes_128_gcm();
   test_aes_128_gcm_unroll();
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  test_aes_gcm_batch( rng );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
   return 0;
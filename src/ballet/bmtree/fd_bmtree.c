@@ -67,6 +67,75 @@ fd_bmtree_hash_leaf( fd_bmtree_node_t * node,
   return node;
 }
 
+#if FD_HAS_AVX
+
+/* fd_bmtree_private_merge_msg writes `prefix|a->hash|b->hash` (the
+   message hashed by fd_bmtree_private_merge below) to mem and returns
+   its size.  mem must be 32-byte aligned and have room for 96 bytes
+   (the stores below spill garbage past the end of the message). */
+
+static inline ulong
+fd_bmtree_private_merge_msg( uchar *                  mem,
+                             fd_bmtree_node_t const * a,
+                             fd_bmtree_node_t const * b,
+                             ulong                    hash_sz,
+                             ulong                    prefix_sz ) {
+  __m256i avx_pre = _mm256_load_si256 ( (__m256i const *)fd_bmtree_node_prefix );
+  __m256i avx_a   = _mm256_loadu_si256( (__m256i const *)a           );
+  __m256i avx_b   = _mm256_loadu_si256( (__m256i const *)b           );
+
+  _mm256_store_si256(  (__m256i *)(mem),                     avx_pre );
+  _mm256_storeu_si256( (__m256i *)(mem+prefix_sz),           avx_a   );
+  _mm256_storeu_si256( (__m256i *)(mem+prefix_sz+hash_sz),   avx_b   );
+
+  return prefix_sz+2UL*hash_sz;
+}
+
+#else
+
+static inline ulong
+fd_bmtree_private_merge_msg( uchar *                  mem,
+                             fd_bmtree_node_t const * a,
+                             fd_bmtree_node_t const * b,
+                             ulong                    hash_sz,
+                             ulong                    prefix_sz ) {
+  fd_memcpy( mem,                   fd_bmtree_node_prefix, prefix_sz );
+  fd_memcpy( mem+prefix_sz,         a->hash,               hash_sz   );
+  fd_memcpy( mem+prefix_sz+hash_sz, b->hash,               hash_sz   );
+  return prefix_sz+2UL*hash_sz;
+}
+
+#endif
+
+fd_bmtree_node_t *
+fd_bmtree_hash_leaves_batch( fd_bmtree_node_t *   node,
+                             void const * const * data,
+                             ulong const *        data_sz,
+                             ulong                prefix_sz,
+                             ulong                cnt ) {
+
+  /* fd_sha256_batch wants each message contiguous, so the prefix and
+     the data get copied together.  Leaves too large for the scratch
+     (none in practice for shreds) take the streaming path. */
+
+  uchar scratch[ FD_BMTREE_BATCH_MAX ][ 2048UL ] __attribute__((aligned(64)));
+  uchar sha_mem[ FD_SHA256_BATCH_FOOTPRINT ]     __attribute__((aligned(FD_SHA256_BATCH_ALIGN)));
+
+  fd_sha256_batch_t * batch = fd_sha256_batch_init( sha_mem );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    ulong msg_sz = prefix_sz + data_sz[ i ];
+    if( FD_UNLIKELY( msg_sz>sizeof(scratch[ i ]) ) ) {
+      fd_bmtree_hash_leaf( node+i, data[ i ], data_sz[ i ], prefix_sz );
+      continue;
+    }
+    fd_memcpy( scratch[ i ],           fd_bmtree_leaf_prefix, prefix_sz    );
+    fd_memcpy( scratch[ i ]+prefix_sz, data[ i ],             data_sz[ i ] );
+    fd_sha256_batch_add( batch, scratch[ i ], msg_sz, node[ i ].hash );
+  }
+  fd_sha256_batch_fini( batch );
+  return node;
+}
+
 /* bmtree_merge computes `SHA-256(prefix|a->hash|b->hash)` and writes
    the full hash into node->hash (which can then be truncated as
    necessary).  prefix is the first prefix_sz bytes of
@@ -116,17 +185,9 @@ fd_bmtree_private_merge( fd_bmtree_node_t       * node,
 
 # if FD_HAS_AVX
 
-  __m256i avx_pre = _mm256_load_si256 ( (__m256i const *)fd_bmtree_node_prefix );
-  __m256i avx_a   = _mm256_loadu_si256( (__m256i const *)a           );
-  __m256i avx_b   = _mm256_loadu_si256( (__m256i const *)b           );
-
   uchar mem[96] __attribute__((aligned(32)));
 
-  _mm256_store_si256(  (__m256i *)(mem),                     avx_pre );
-  _mm256_storeu_si256( (__m256i *)(mem+prefix_sz),           avx_a   );
-  _mm256_storeu_si256( (__m256i *)(mem+prefix_sz+hash_sz),   avx_b   );
-
-  fd_sha256_hash( mem, prefix_sz+2UL*hash_sz, node );
+  fd_sha256_hash( mem, fd_bmtree_private_merge_msg( mem, a, b, hash_sz, prefix_sz ), node );
 
   /* Consider FD_HAS_SSE only variant? */
 
@@ -379,22 +440,31 @@ fd_bmtree_from_proof( fd_bmtree_node_t const * leaf,
 
 
 /* TODO: Make robust */
-#define HAS(inc_idx) (ipfset_test( state->inclusion_proofs_valid[(inc_idx)/64UL], (inc_idx)%64UL ) )
-
-int
-fd_bmtree_commitp_insert_with_proof( fd_bmtree_commit_t *     state,
-                                     ulong                    idx,
-                                     fd_bmtree_node_t const * new_leaf,
-                                     uchar            const * proof,
-                                     ulong                    proof_depth,
-                                     fd_bmtree_node_t       * opt_root ) {
+#define HAS_IN(state,inc_idx) (ipfset_test( (state)->inclusion_proofs_valid[(inc_idx)/64UL], (inc_idx)%64UL ) )
+#define HAS(inc_idx) HAS_IN( state, inc_idx )
+
+/* fd_bmtree_private_commitp_insert does the work of
+   fd_bmtree_commitp_insert_with_proof.  path is indexed [0,path_cnt)
+   with path_cnt>=1, where path[0] is the new leaf and path[l] for l>0
+   is the node at layer l on the branch from the leaf, already derived
+   from path[l-1] and the proof by the caller.  Nodes past path_cnt are
+   derived here as needed. */
+
+static int
+fd_bmtree_private_commitp_insert( fd_bmtree_commit_t *     state,
+                                  ulong                    idx,
+                                  fd_bmtree_node_t const * path,
+                                  ulong                    path_cnt,
+                                  uchar            const * proof,
+                                  ulong                    proof_depth,
+                                  fd_bmtree_node_t       * opt_root ) {
   ulong inc_idx = 2UL * idx;
   ulong inclusion_proof_sz = state->inclusion_proof_sz;
   ulong hash_sz = state->hash_sz;
 
   if( FD_UNLIKELY( inc_idx >= inclusion_proof_sz ) ) return 0;
 
-  state->node_buf[ 0 ] = *new_leaf;
+  state->node_buf[ 0 ] = path[ 0 ];
 
   ulong layer=0UL;
   for( ; layer<proof_depth; layer++ ) {
@@ -407,6 +477,7 @@ fd_bmtree_commitp_insert_with_proof( fd_bmtree_commit_t *     state,
     ulong parent_idx = fd_ulong_insert_lsb( inc_idx, (int)layer+2, (2UL<<layer)-1UL );
 
     if( HAS(sibling_idx) & HAS(inc_idx) ) state->node_buf[ layer+1UL ] = state->inclusion_proofs[ parent_idx ];
+    else if( layer+1UL<path_cnt )         state->node_buf[ layer+1UL ] = path[ layer+1UL ];
     else {
       fd_bmtree_node_t sibling;
       fd_memcpy( sibling.hash, proof+hash_sz*layer, hash_sz );
@@ -458,6 +529,111 @@ fd_bmtree_commitp_insert_with_proof( fd_bmtree_commit_t *     state,
   return 1;
 }
 
+int
+fd_bmtree_commitp_insert_with_proof( fd_bmtree_commit_t *     state,
+                                     ulong                    idx,
+                                     fd_bmtree_node_t const * new_leaf,
+                                     uchar            const * proof,
+                                     ulong                    proof_depth,
+                                     fd_bmtree_node_t       * opt_root ) {
+  return fd_bmtree_private_commitp_insert( state, idx, new_leaf, 1UL, proof, proof_depth, opt_root );
+}
+
+ulong
+fd_bmtree_verify_proofs_batch( fd_bmtree_commit_t * const * state,
+                               ulong const *                idx,
+                               fd_bmtree_node_t const *     leaf,
+                               uchar const * const *        proof,
+                               ulong const *                proof_depth,
+                               fd_bmtree_node_t *           opt_root,
+                               ulong                        cnt ) {
+
+  /* path[ i ][ l ] is the node at layer l on the branch from leaf i,
+     valid for l in [0,path_cnt[ i ]).  These get derived in lockstep,
+     one fd_sha256_batch per layer, for as long as the insert would
+     have to hash to derive them.  Then the inserts themselves run in
+     order with the derived nodes, so they only have to compare and
+     cache. */
+
+  fd_bmtree_node_t path    [ FD_BMTREE_BATCH_MAX ][ 64UL ];
+  ulong            path_cnt[ FD_BMTREE_BATCH_MAX ];
+  ulong            inc_idx [ FD_BMTREE_BATCH_MAX ];
+  ulong            dup     [ FD_BMTREE_BATCH_MAX ];
+  uchar            msg     [ FD_BMTREE_BATCH_MAX ][ 96UL ] __attribute__((aligned(32)));
+  uchar            sha_mem [ FD_SHA256_BATCH_FOOTPRINT ]   __attribute__((aligned(FD_SHA256_BATCH_ALIGN)));
+
+  ulong active = 0UL; /* Bit i set if branch i still needs hashing */
+  for( ulong i=0UL; i<cnt; i++ ) {
+    path    [ i ][ 0 ] = leaf[ i ];
+    path_cnt[ i ]      = 1UL;
+    inc_idx [ i ]      = 2UL * idx[ i ];
+    active |= 1UL<<i;
+  }
+
+  for( ulong layer=0UL; active; layer++ ) {
+    fd_sha256_batch_t * batch  = fd_sha256_batch_init( sha_mem );
+    ulong               hashed = 0UL; /* Bit i set if branch i is hashed (not shared) at this layer */
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      if( !fd_ulong_extract_bit( active, (int)i ) ) continue;
+
+      fd_bmtree_commit_t const * st = state[ i ];
+      ulong hash_sz     = st->hash_sz;
+      ulong sibling_idx = inc_idx[ i ] ^ (2UL<<layer);
+
+      /* Leave the rest of the branch to the insert if the proof is
+         exhausted, the branch leaves the cached part of the tree or the
+         node and its sibling are both cached already (so the insert
+         either rejects or takes the cached parent). */
+      if( (layer>=proof_depth[ i ]) | (layer>=63UL) |
+          ((inc_idx[ i ]|(2UL<<layer))>=st->inclusion_proof_sz) ||
+          (HAS_IN( st, inc_idx[ i ] ) & HAS_IN( st, sibling_idx )) ) {
+        active = fd_ulong_clear_bit( active, (int)i );
+        continue;
+      }
+
+      /* Sibling shreds in a burst share the upper part of their
+         branches.  Hash each distinct pair of children in a tree once
+         per layer. */
+      uchar const * sibling = proof[ i ] + hash_sz*layer;
+      ulong j;
+      for( j=0UL; j<i; j++ ) {
+        if( fd_ulong_extract_bit( hashed, (int)j ) && state[ j ]==st && inc_idx[ j ]==inc_idx[ i ] &&
+            fd_memeq( path[ j ][ layer ].hash, path[ i ][ layer ].hash, hash_sz ) &&
+            fd_memeq( proof[ j ] + hash_sz*layer, sibling, hash_sz ) ) break;
+      }
+      dup[ i ] = j;
+      if( j<i ) continue;
+
+      fd_bmtree_node_t sib;
+      fd_memcpy( sib.hash, sibling, hash_sz );
+      fd_bmtree_node_t const * tmp_l = fd_ptr_if( 0UL==(inc_idx[ i ] & (2UL<<layer)), path[ i ]+layer, &sib );
+      fd_bmtree_node_t const * tmp_r = fd_ptr_if( 0UL==(inc_idx[ i ] & (2UL<<layer)), &sib, path[ i ]+layer );
+
+      ulong msg_sz = fd_bmtree_private_merge_msg( msg[ i ], tmp_l, tmp_r, hash_sz, st->prefix_sz );
+      fd_sha256_batch_add( batch, msg[ i ], msg_sz, path[ i ][ layer+1UL ].hash );
+      hashed |= 1UL<<i;
+    }
+
+    fd_sha256_batch_fini( batch );
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      if( !fd_ulong_extract_bit( active, (int)i ) ) continue;
+      if( dup[ i ]<i ) path[ i ][ layer+1UL ] = path[ dup[ i ] ][ layer+1UL ];
+      path_cnt[ i ] = layer+2UL;
+      inc_idx [ i ] = fd_ulong_insert_lsb( inc_idx[ i ], (int)layer+2, (2UL<<layer)-1UL );
+    }
+  }
+
+  ulong ok = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    int res = fd_bmtree_private_commitp_insert( state[ i ], idx[ i ], path[ i ], path_cnt[ i ], proof[ i ], proof_depth[ i ],
+                                                opt_root ? opt_root+i : NULL );
+    ok |= ((ulong)res)<<i;
+  }
+  return ok;
+}
+
 uchar *
 fd_bmtree_commitp_fini( fd_bmtree_commit_t * state, ulong leaf_cnt ) {
   ulong inclusion_proof_sz = state->inclusion_proof_sz;
@@ -159,6 +159,21 @@ typedef struct fd_bmtree_node fd_bmtree_node_t;
    node.  U.B. if `node` and `data` overlap. */
 fd_bmtree_node_t * fd_bmtree_hash_leaf( fd_bmtree_node_t * node, void const * data, ulong data_sz, ulong prefix_sz );
 
+/* FD_BMTREE_BATCH_MAX is the maximum number of leaves or proofs that
+   can be given to one call of the batch functions below. */
+#define FD_BMTREE_BATCH_MAX (16UL)
+
+/* fd_bmtree_hash_leaves_batch computes fd_bmtree_hash_leaf( node+i,
+   data[ i ], data_sz[ i ], prefix_sz ) for i in [0,cnt), spreading the
+   hashing over the lanes of fd_sha256_batch.  cnt must be in
+   [0,FD_BMTREE_BATCH_MAX].  Returns node. */
+fd_bmtree_node_t *
+fd_bmtree_hash_leaves_batch( fd_bmtree_node_t *   node,      /* Indexed [0,cnt) */
+                             void const * const * data,      /* Indexed [0,cnt) */
+                             ulong const *        data_sz,   /* Indexed [0,cnt) */
+                             ulong                prefix_sz,
+                             ulong                cnt );
+
 /* A fd_bmtree_commit_t stores intermediate state used to compute the
    root of a binary Merkle tree built incrementally.  It can be used for
    two different typed of calculations:
@@ -457,6 +472,37 @@ fd_bmtree_commitp_insert_with_proof( fd_bmtree_commit_t *     state,
                                      ulong                    proof_depth,
                                      fd_bmtree_node_t       * opt_root );
 
+/* fd_bmtree_verify_proofs_batch is the batched version of
+   fd_bmtree_commitp_insert_with_proof.  It has the same result
+   (including the return value, the cached nodes and what gets written
+   to opt_root+i) as
+
+     for( ulong i=0UL; i<cnt; i++ )
+       fd_bmtree_commitp_insert_with_proof( state[ i ], idx[ i ], leaf+i,
+                                            proof[ i ], proof_depth[ i ],
+                                            opt_root ? opt_root+i : NULL );
+
+   but walks the cnt proofs toward the root in lockstep, doing the
+   hashing for each layer with one fd_sha256_batch.  Branches stop
+   hashing where the proof-based calc they are inserted into already
+   has the node and its sibling cached, and branches inserted into the
+   same calc that reach the same pair of children (e.g. sibling shreds
+   of an FEC set) hash that pair only once.  The states need not be
+   distinct.  cnt must be in [0,FD_BMTREE_BATCH_MAX].  opt_root is
+   either NULL or indexed [0,cnt).
+
+   Returns a bit set with bit i set if insert i succeeded and clear if
+   it failed. */
+
+ulong
+fd_bmtree_verify_proofs_batch( fd_bmtree_commit_t * const * state,       /* Indexed [0,cnt) */
+                               ulong const *                idx,         /* Indexed [0,cnt) */
+                               fd_bmtree_node_t const *     leaf,        /* Indexed [0,cnt) */
+                               uchar const * const *        proof,       /* Indexed [0,cnt) */
+                               ulong const *                proof_depth, /* Indexed [0,cnt) */
+                               fd_bmtree_node_t *           opt_root,
+                               ulong                        cnt );
+
 /* fd_bmtree_commitp_fini finalizes a proof-based calc.  Returns the
    root of the tree if it can conclusively determine that the entire
    tree is correct for a commitment of leaf_cnt leaf nodes and NULL
@@ -130,6 +130,150 @@ test_inclusion( ulong leaf_cnt ) {
 }
 
 
+/* Check fd_bmtree_verify_proofs_batch against the same inserts done one
+   at a time.  Two trees are filled in concurrently so that batches mix
+   branches from different calcs, and the batches also include repeated
+   leaves, truncated proofs and corrupted leaves and proofs. */
+
+static void
+test_verify_batch( ulong      leaf_cnt,
+                   fd_rng_t * rng ) {
+  ulong const prefix_sz = FD_BMTREE_LONG_PREFIX_SZ;
+  ulong const layers    = 9UL;
+  ulong depth     = fd_bmtree_depth( leaf_cnt );
+  ulong footprint = fd_ulong_align_up( fd_bmtree_commit_footprint( layers ), FD_BMTREE_COMMIT_ALIGN );
+  FD_TEST( 6UL*footprint<=MEMORY_SZ );
+
+  static uchar proofs[ 2 ][ 256 ][ 8*20 ];
+  fd_bmtree_node_t leaves[ 2 ][ 256 ];
+  uchar            roots [ 2 ][ 32  ];
+
+  fd_bmtree_commit_t * ref[ 2 ];
+  fd_bmtree_commit_t * bat[ 2 ];
+  for( ulong t=0UL; t<2UL; t++ ) {
+    fd_bmtree_commit_t * tree = fd_bmtree_commit_init( memory+(3UL*t)*footprint, 20UL, prefix_sz, layers );
+    for( ulong i=0UL; i<leaf_cnt; i++ ) {
+      fd_memset( leaves[ t ][ i ].hash, 0, 32UL );
+      FD_STORE( ulong, leaves[ t ][ i ].hash,   i );
+      FD_STORE( ulong, leaves[ t ][ i ].hash+8, t );
+    }
+    FD_TEST( fd_bmtree_commit_append( tree, leaves[ t ], leaf_cnt )==tree );
+    fd_memcpy( roots[ t ], fd_bmtree_commit_fini( tree ), 32UL );
+    for( ulong i=0UL; i<leaf_cnt; i++ ) FD_TEST( (int)depth-1==fd_bmtree_get_proof( tree, proofs[ t ][ i ], i ) );
+
+    ref[ t ] = fd_bmtree_commit_init( memory+(3UL*t+1UL)*footprint, 20UL, prefix_sz, layers );
+    bat[ t ] = fd_bmtree_commit_init( memory+(3UL*t+2UL)*footprint, 20UL, prefix_sz, layers );
+  }
+
+  for( ulong iter=0UL; iter<4UL*leaf_cnt/FD_BMTREE_BATCH_MAX+2UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, FD_BMTREE_BATCH_MAX+1UL );
+
+    fd_bmtree_commit_t * state      [ FD_BMTREE_BATCH_MAX ];
+    ulong                idx        [ FD_BMTREE_BATCH_MAX ];
+    fd_bmtree_node_t     leaf       [ FD_BMTREE_BATCH_MAX ];
+    uchar                proof_mem  [ FD_BMTREE_BATCH_MAX ][ 8*20 ];
+    uchar const *        proof      [ FD_BMTREE_BATCH_MAX ];
+    ulong                proof_depth[ FD_BMTREE_BATCH_MAX ];
+    fd_bmtree_node_t     root       [ FD_BMTREE_BATCH_MAX ];
+    fd_bmtree_node_t     ref_root   [ 1 ];
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong t = fd_rng_ulong_roll( rng, 2UL );
+      state      [ i ] = bat[ t ];
+      idx        [ i ] = fd_rng_ulong_roll( rng, leaf_cnt );
+      leaf       [ i ] = leaves[ t ][ idx[ i ] ];
+      proof      [ i ] = proof_mem[ i ];
+      proof_depth[ i ] = fd_ulong_if( fd_rng_uint_roll( rng, 4U )>0U, depth-1UL, fd_rng_ulong_roll( rng, depth ) );
+      fd_memcpy( proof_mem[ i ], proofs[ t ][ idx[ i ] ], (depth-1UL)*20UL );
+
+      switch( fd_rng_uint_roll( rng, 16U ) ) {
+        case 0U: leaf[ i ].hash[ 1 ]++; break;
+        case 1U: if( depth>1UL ) proof_mem[ i ][ fd_rng_ulong_roll( rng, (depth-1UL)*20UL ) ]++; break;
+        default: break;
+      }
+    }
+
+    ulong ok = fd_bmtree_verify_proofs_batch( state, idx, leaf, proof, proof_depth, root, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_bmtree_commit_t * r = ref[ state[ i ]==bat[ 1 ] ];
+      int res = fd_bmtree_commitp_insert_with_proof( r, idx[ i ], leaf+i, proof[ i ], proof_depth[ i ], ref_root );
+      FD_TEST( res==fd_ulong_extract_bit( ok, (int)i ) );
+      if( res ) FD_TEST( fd_memeq( root+i, ref_root, 32UL ) );
+    }
+    FD_TEST( !(ok>>cnt) );
+  }
+
+  /* Fill in whatever is missing with valid leaves.  Both calcs then
+     have to agree on the root, and on it being the real one unless a
+     corrupted leaf got in early. */
+
+  for( ulong t=0UL; t<2UL; t++ ) {
+    for( ulong i=0UL; i<leaf_cnt; i+=FD_BMTREE_BATCH_MAX ) {
+      ulong cnt = fd_ulong_min( leaf_cnt-i, FD_BMTREE_BATCH_MAX );
+      fd_bmtree_commit_t * state      [ FD_BMTREE_BATCH_MAX ];
+      ulong                idx        [ FD_BMTREE_BATCH_MAX ];
+      uchar const *        proof      [ FD_BMTREE_BATCH_MAX ];
+      ulong                proof_depth[ FD_BMTREE_BATCH_MAX ];
+      for( ulong j=0UL; j<cnt; j++ ) {
+        state[ j ] = bat[ t ]; idx[ j ] = i+j; proof[ j ] = proofs[ t ][ i+j ]; proof_depth[ j ] = depth-1UL;
+      }
+      ulong ok = fd_bmtree_verify_proofs_batch( state, idx, leaves[ t ]+i, proof, proof_depth, NULL, cnt );
+      for( ulong j=0UL; j<cnt; j++ ) {
+        int res = fd_bmtree_commitp_insert_with_proof( ref[ t ], i+j, leaves[ t ]+i+j, proofs[ t ][ i+j ], depth-1UL, NULL );
+        FD_TEST( res==fd_ulong_extract_bit( ok, (int)j ) );
+      }
+    }
+    uchar * ref_root = fd_bmtree_commitp_fini( ref[ t ], leaf_cnt );
+    uchar * bat_root = fd_bmtree_commitp_fini( bat[ t ], leaf_cnt );
+    FD_TEST( !ref_root==!bat_root );
+    if( ref_root ) {
+      FD_TEST( fd_memeq( ref_root, bat_root,   32UL ) );
+      FD_TEST( fd_memeq( ref_root, roots[ t ], 20UL ) );
+    }
+  }
+}
+
+/* Check fd_bmtree_hash_leaves_batch against fd_bmtree_hash_leaf and
+   compare their throughput for shred sized leaves. */
+
+static void
+test_hash_leaves_batch( fd_rng_t * rng ) {
+  static uchar data[ FD_BMTREE_BATCH_MAX ][ 4096 ];
+  for( ulong i=0UL; i<FD_BMTREE_BATCH_MAX; i++ )
+    for( ulong j=0UL; j<4096UL; j++ ) data[ i ][ j ] = fd_rng_uchar( rng );
+
+  void const *     msg    [ FD_BMTREE_BATCH_MAX ];
+  ulong            msg_sz [ FD_BMTREE_BATCH_MAX ];
+  fd_bmtree_node_t node   [ FD_BMTREE_BATCH_MAX ];
+  fd_bmtree_node_t ref[1];
+
+  for( ulong iter=0UL; iter<1000UL; iter++ ) {
+    ulong cnt       = fd_rng_ulong_roll( rng, FD_BMTREE_BATCH_MAX+1UL );
+    ulong prefix_sz = fd_ulong_if( fd_rng_uint_roll( rng, 2U )>0U, FD_BMTREE_LONG_PREFIX_SZ, FD_BMTREE_SHORT_PREFIX_SZ );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      msg   [ i ] = data[ i ] + fd_rng_ulong_roll( rng, 64UL );
+      msg_sz[ i ] = fd_rng_ulong_roll( rng, 4032UL );
+    }
+    FD_TEST( fd_bmtree_hash_leaves_batch( node, msg, msg_sz, prefix_sz, cnt )==node );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_bmtree_hash_leaf( ref, msg[ i ], msg_sz[ i ], prefix_sz );
+      FD_TEST( fd_memeq( ref, node+i, 32UL ) );
+    }
+  }
+
+  ulong bench_cnt = 100000UL;
+  for( ulong i=0UL; i<FD_BMTREE_BATCH_MAX; i++ ) { msg[ i ] = data[ i ]; msg_sz[ i ] = 1115UL; }
+
+  long dt = -fd_log_wallclock();
+  for( ulong rem=bench_cnt; rem; rem-- ) fd_bmtree_hash_leaf( node+(rem%FD_BMTREE_BATCH_MAX), msg[ 0 ], msg_sz[ 0 ], FD_BMTREE_LONG_PREFIX_SZ );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "hash_leaf:          %.3f ns/leaf @ %lu B", (double)((float)dt / (float)bench_cnt), msg_sz[ 0 ] ));
+
+  dt = -fd_log_wallclock();
+  for( ulong rem=bench_cnt/FD_BMTREE_BATCH_MAX; rem; rem-- ) fd_bmtree_hash_leaves_batch( node, msg, msg_sz, FD_BMTREE_LONG_PREFIX_SZ, FD_BMTREE_BATCH_MAX );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "hash_leaves_batch:  %.3f ns/leaf @ %lu B", (double)((float)dt / (float)bench_cnt), msg_sz[ 0 ] ));
+}
 
 int
 main( int     argc,
@@ -150,6 +294,11 @@ main( int     argc,
 
   for( ulong leaf_cnt=1UL; leaf_cnt<=256UL; leaf_cnt++ ) test_inclusion( leaf_cnt );
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong leaf_cnt=1UL; leaf_cnt<=256UL; leaf_cnt++ ) test_verify_batch( leaf_cnt, rng );
+  test_hash_leaves_batch( rng );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   for( ulong leaf_cnt=2UL; leaf_cnt<10000000UL; leaf_cnt++ ) {
     ulong depth = 1UL;
     ulong nodes = 1UL;
@@ -100,6 +100,16 @@ fd_ed25519_verify( uchar const   msg[], /* msg_sz */
                    uchar const   public_key[ 32 ],
                    fd_sha512_t * sha );
 
+/* FD_ED25519_VERIFY_BATCH_MAX is the max number of signatures that
+   fd_ed25519_verify_batch_{single,multi}_msg verify in one call.
+   FD_ED25519_VERIFY_BATCH_MSG_MAX is the largest message size for which
+   they batch the SHA-512 computation (larger messages are fine but are
+   hashed one at a time).  The latter matches the max size of a Solana
+   transaction, which is by far the most common user. */
+
+#define FD_ED25519_VERIFY_BATCH_MAX     (16UL)
+#define FD_ED25519_VERIFY_BATCH_MSG_MAX (1232UL)
+
 /* fd_ed25519_verify_batch_single_msg verifies a batch of signatures
    over a single message, according to the ED25519 standard.
 
@@ -114,10 +124,13 @@ fd_ed25519_verify( uchar const   msg[], /* msg_sz */
    that holds the public keys to use to verify these signatures.
    Each public key is 64-byte long.
 
-   shas is an array of handles of a local join to sha512 calculators.
+   sha is a handle of a local join to a sha512 calculator.  The SHA-512
+   computations of the signatures are done with the fd_sha512_batch API
+   (i.e. in parallel on targets with wide vector support), sha is only
+   used if msg_sz is larger than FD_ED25519_VERIFY_BATCH_MSG_MAX.
 
-   batch_sz is the size of signatures, pubkeys and shas.
-   batch_sz must be greater than zero.
+   batch_sz is the number of signatures and pubkeys, in
+   [1,FD_ED25519_VERIFY_BATCH_MAX].
 
    See fd_ed25519_verify for more details. */
 
@@ -126,9 +139,50 @@ fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
                                     ulong const   msg_sz,
                                     uchar const   signatures[ 64 ], /* 64 * batch_sz */
                                     uchar const   pubkeys[ 32 ],    /* 32 * batch_sz */
-                                    fd_sha512_t * shas[ 1 ],               /* batch_sz */
+                                    fd_sha512_t * sha,
                                     uchar const   batch_sz );
 
+/* fd_ed25519_verify_batch_multi_msg verifies a batch of batch_sz
+   signatures, each over its own message, according to the ED25519
+   standard.  It is meant for verifying the signatures of many
+   transactions at once, as most transactions have only one signature
+   and fd_ed25519_verify_batch_single_msg cannot batch across them.
+
+   For i in [0,batch_sz), msg[i] is assumed to point to the first byte
+   of a msg_sz[i] byte memory region which holds the i-th message,
+   sig[i] to the first byte of a 64-byte memory region which holds its
+   signature and public_key[i] to the first byte of a 32-byte memory
+   region which holds the public key to verify it with.  Signatures can
+   share messages and public keys (e.g. a multi-signature transaction
+   has one msg[i] entry per signature, all pointing to the same
+   message).
+
+   sha is a handle of a local join to a sha512 calculator, used for
+   messages larger than FD_ED25519_VERIFY_BATCH_MSG_MAX.  batch_sz is
+   in [1,FD_ED25519_VERIFY_BATCH_MAX], otherwise FD_ED25519_ERR_SIG is
+   returned and err is not written.
+
+   On return, err[i] holds the result of verifying the i-th signature,
+   which is exactly what fd_ed25519_verify would return for it.  Under
+   the hood, the SHA-512 computations of the signatures are done with
+   the fd_sha512_batch API (i.e. in parallel on targets with wide vector
+   support) rather than one at a time.  Each signature is still checked
+   individually (there is no random linear combination), so a bad
+   signature does not affect the result of any other.
+
+   Does no other input argument checking.  Returns FD_ED25519_SUCCESS
+   if all the signatures verified successfully or the FD_ED25519_ERR_*
+   code of the first one that did not. */
+
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msg       [], /* batch_sz, msg_sz[i] bytes each */
+                                   ulong const         msg_sz    [], /* batch_sz */
+                                   uchar const * const sig       [], /* batch_sz, 64 bytes each */
+                                   uchar const * const public_key[], /* batch_sz, 32 bytes each */
+                                   fd_sha512_t *       sha,
+                                   ulong               batch_sz,
+                                   int                 err       [] ); /* batch_sz */
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
@@ -232,33 +232,22 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
                                         ulong const   msg_sz,
                                         uchar const   signatures[ static 64 ], /* 64 * batch_sz */
                                         uchar const   pubkeys[ static 32 ],    /* 32 * batch_sz */
-                                        fd_sha512_t * shas[ 1 ],               /* batch_sz */
+                                        fd_sha512_t * sha,
                                         uchar const   batch_sz ) {
-#define MAX 16
+#define MAX FD_ED25519_VERIFY_BATCH_MAX
   if( FD_UNLIKELY( batch_sz == 0 || batch_sz > MAX ) ) {
     return FD_ED25519_ERR_SIG;
   }
 
-#if 0
-  /* Naive */
-  for( uchar i=0; i<batch_sz; i++ ) {
-    int res = fd_ed25519_verify( msg, msg_sz, &signatures[ i*64 ], &pubkeys[ i*32 ], shas[0] );
-    if( FD_UNLIKELY( res != FD_ED25519_SUCCESS ) ) {
-      return res;
-    }
-  }
-  return FD_ED25519_SUCCESS;
-#else
-
   fd_ed25519_point_t R     [MAX];
   fd_ed25519_point_t Aprime[MAX];
-  uchar              k     [MAX * 32];
+  uchar              k     [MAX][ 64 ] __attribute__((aligned(64)));
 
   /* The first batch_sz points are the R_j, the last are A'_j.
      Scalars will be stored accordingly. */
 
   /* First, we validate scalars, decompress public keys and points R_j,
-     check low order points, and compute k_j.
+     check low order points.
      TODO: optimize, this is 20% of the total time. */
   for( int j=0; j<batch_sz; j++ ) {
 
@@ -284,30 +273,128 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
     if( FD_UNLIKELY( fd_ed25519_affine_is_small_order(&R[j]) ) ) {
       return FD_ED25519_ERR_SIG;
     }
+  }
 
-    /* Compute scalars k_j */
-    uchar _k[ 64 ];
-    fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( shas[j] ),
-                    r, 32UL ), public_key, 32UL ), msg, msg_sz ), _k );
-    fd_curve25519_scalar_reduce( &k[32*j], _k );
+  /* Compute scalars k_j = SHA512(R_j || A_j || M), in parallel.  The
+     batch API hashes contiguous buffers, so we gather the inputs. */
+  if( FD_LIKELY( msg_sz<=FD_ED25519_VERIFY_BATCH_MSG_MAX ) ) {
+    uchar hin[ MAX ][ 64UL+FD_ED25519_VERIFY_BATCH_MSG_MAX ] __attribute__((aligned(64)));
+    uchar _batch[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+    fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+    for( int j=0; j<batch_sz; j++ ) {
+      fd_memcpy( hin[j],      signatures + 64*j, 32UL   );
+      fd_memcpy( hin[j]+32UL, pubkeys + 32*j,    32UL   );
+      fd_memcpy( hin[j]+64UL, msg,               msg_sz );
+      fd_sha512_batch_add( batch, hin[j], 64UL+msg_sz, k[j] );
+    }
+    fd_sha512_batch_fini( batch );
+  } else {
+    for( int j=0; j<batch_sz; j++ ) {
+      fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                      signatures + 64*j, 32UL ), pubkeys + 32*j, 32UL ), msg, msg_sz ), k[j] );
+    }
   }
 
   fd_ed25519_point_t res[1];
   for( uchar j=0; j<batch_sz; j++ ) {
     uchar const * S = signatures + 32 + 64*j;
 
+    fd_curve25519_scalar_reduce( k[j], k[j] );
     fd_ed25519_point_neg( &Aprime[j], &Aprime[j] );
-    fd_ed25519_double_scalar_mul_base( res, &k[32*j], &Aprime[j], S );
+    fd_ed25519_double_scalar_mul_base( res, k[j], &Aprime[j], S );
     if( FD_UNLIKELY( !fd_ed25519_point_eq_z1( res, &R[j] ) ) ) {
       return FD_ED25519_ERR_MSG;
     }
 
   }
   return FD_ED25519_SUCCESS;
-#endif
 #undef MAX
 }
 
+int
+fd_ed25519_verify_batch_multi_msg( uchar const * const msg       [],
+                                   ulong const         msg_sz    [],
+                                   uchar const * const sig       [],
+                                   uchar const * const public_key[],
+                                   fd_sha512_t *       sha,
+                                   ulong               batch_sz,
+                                   int                 err       [] ) {
+  if( FD_UNLIKELY( batch_sz==0UL || batch_sz>FD_ED25519_VERIFY_BATCH_MAX ) ) {
+    return FD_ED25519_ERR_SIG;
+  }
+
+  /* The hash input of signature j is R_j || A_j || M_j.  These are not
+     contiguous in general (and the batch API hashes contiguous
+     buffers), so we gather them here. */
+
+  uchar              hin   [ FD_ED25519_VERIFY_BATCH_MAX ][ 64UL+FD_ED25519_VERIFY_BATCH_MSG_MAX ] __attribute__((aligned(64)));
+  uchar              k     [ FD_ED25519_VERIFY_BATCH_MAX ][ 64 ] __attribute__((aligned(64)));
+  fd_ed25519_point_t R     [ FD_ED25519_VERIFY_BATCH_MAX ];
+  fd_ed25519_point_t Aprime[ FD_ED25519_VERIFY_BATCH_MAX ];
+
+  uchar _batch[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+  fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+
+  /* First, do the same checks as fd_ed25519_verify on each signature
+     and queue up k_j = SHA512(R_j || A_j || M_j) for the ones that
+     pass. */
+
+  for( ulong j=0UL; j<batch_sz; j++ ) {
+    uchar const * r = sig[ j ];
+    uchar const * S = sig[ j ] + 32;
+
+    err[ j ] = FD_ED25519_SUCCESS;
+
+    if( FD_UNLIKELY( !fd_curve25519_scalar_validate( S ) ) ) {
+      err[ j ] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+
+    int res = fd_ed25519_point_frombytes_2x( &Aprime[ j ], public_key[ j ], &R[ j ], r );
+    if( FD_UNLIKELY( res ) ) {
+      err[ j ] = res == 1 ? FD_ED25519_ERR_PUBKEY : FD_ED25519_ERR_SIG;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( &Aprime[ j ] ) ) ) {
+      err[ j ] = FD_ED25519_ERR_PUBKEY;
+      continue;
+    }
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( &R[ j ] ) ) ) {
+      err[ j ] = FD_ED25519_ERR_SIG;
+      continue;
+    }
+
+    ulong sz = msg_sz[ j ];
+    if( FD_LIKELY( sz<=FD_ED25519_VERIFY_BATCH_MSG_MAX ) ) {
+      fd_memcpy( hin[ j ],      r,               32UL );
+      fd_memcpy( hin[ j ]+32UL, public_key[ j ], 32UL );
+      fd_memcpy( hin[ j ]+64UL, msg[ j ],        sz   );
+      fd_sha512_batch_add( batch, hin[ j ], 64UL+sz, k[ j ] );
+    } else {
+      fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                      r, 32UL ), public_key[ j ], 32UL ), msg[ j ], sz ), k[ j ] );
+    }
+  }
+
+  fd_sha512_batch_fini( batch );
+
+  /* Then check the group equation of each signature that is still in
+     the running.  See fd_ed25519_verify for details. */
+
+  int first_err = FD_ED25519_SUCCESS;
+  for( ulong j=0UL; j<batch_sz; j++ ) {
+    if( FD_LIKELY( err[ j ]==FD_ED25519_SUCCESS ) ) {
+      fd_ed25519_point_t Rcmp[1];
+      fd_curve25519_scalar_reduce( k[ j ], k[ j ] );
+      fd_ed25519_point_neg( &Aprime[ j ], &Aprime[ j ] );
+      fd_ed25519_double_scalar_mul_base( Rcmp, k[ j ], &Aprime[ j ], sig[ j ]+32 );
+      if( FD_UNLIKELY( !fd_ed25519_point_eq_z1( Rcmp, &R[ j ] ) ) ) err[ j ] = FD_ED25519_ERR_MSG;
+    }
+    first_err = fd_int_if( first_err==FD_ED25519_SUCCESS, err[ j ], first_err );
+  }
+  return first_err;
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
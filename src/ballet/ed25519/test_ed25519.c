@@ -927,9 +927,7 @@ test_verify( fd_rng_t *    rng,
     uchar _pubs[   32*16 ]; uchar * pubs = _pubs;
     uchar _sigs[   64*16 ]; uchar * sigs = _sigs;
     uchar _prv2[   32 ]; uchar * prv2 = _prv2;
-    fd_sha512_t * _shas[ 16 ]; fd_sha512_t ** shas = _shas;
     for( ulong j=0; j<16; j++ ) {
-      _shas[j] = sha;
       fd_rng_b256( rng, prv2 );
       fd_ed25519_public_from_private( &pubs[32*j], prv2, sha );
       fd_ed25519_sign( &sigs[64*j], msg, sz, &pubs[32*j], prv2, sha );
@@ -937,13 +935,13 @@ test_verify( fd_rng_t *    rng,
     for( uchar batch=1; batch<=12; batch=(uchar)(batch*2) ) {
 
       // FD_TEST( fd_ed25519_verify( msg, sz, sigs, pubs, sha )==FD_ED25519_SUCCESS );
-      FD_TEST( fd_ed25519_verify_batch_single_msg( msg, sz, sigs, pubs, shas, batch )==FD_ED25519_SUCCESS );
+      FD_TEST( fd_ed25519_verify_batch_single_msg( msg, sz, sigs, pubs, sha, batch )==FD_ED25519_SUCCESS );
 
       long dt = fd_log_wallclock();
       for( ulong rem=iter/batch; rem; rem-- ) {
         FD_COMPILER_FORGET( sigs ); FD_COMPILER_FORGET( msg ); FD_COMPILER_FORGET( sz  );
-        FD_COMPILER_FORGET( pubs ); FD_COMPILER_FORGET( shas ); FD_COMPILER_FORGET( batch );
-        fd_ed25519_verify_batch_single_msg( msg, sz, sigs, pubs, shas, batch );
+        FD_COMPILER_FORGET( pubs ); FD_COMPILER_FORGET( sha ); FD_COMPILER_FORGET( batch );
+        fd_ed25519_verify_batch_single_msg( msg, sz, sigs, pubs, sha, batch );
       }
       dt = fd_log_wallclock() - dt;
       char cstr[128];
@@ -1048,16 +1046,14 @@ test_cctv_batch( fd_rng_t * rng, fd_sha512_t * sha ) {
   uchar _pubs[   32*16 ]; uchar * pubs = _pubs;
   uchar _sigs[   64*16 ]; uchar * sigs = _sigs;
   uchar _prv2[   32 ]; uchar * prv2 = _prv2;
-  fd_sha512_t * _shas[ 16 ]; fd_sha512_t ** shas = _shas;
 
   /* generate 16 valid signatures */
   for( ulong j=0; j<16; j++ ) {
-    _shas[j] = sha;
     fd_rng_b256( rng, prv2 );
     fd_ed25519_public_from_private( &pubs[32*j], prv2, sha );
     fd_ed25519_sign( &sigs[64*j], msg, msg_sz, &pubs[32*j], prv2, sha );
   }
-  FD_TEST( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, shas, 16 )==FD_ED25519_SUCCESS );
+  FD_TEST( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, sha, 16 )==FD_ED25519_SUCCESS );
 
   for( fd_ed25519_verify_cctv_t const * proof = ed25519_verify_cctvs;
        proof->msg;
@@ -1070,17 +1066,136 @@ test_cctv_batch( fd_rng_t * rng, fd_sha512_t * sha ) {
     fd_memcpy( &sigs[64], proof->sig, 64 );
     fd_memcpy( &pubs[32], proof->pub, 32 );
 
-    int actual = ( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, shas, 2 )
+    int actual = ( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, sha, 2 )
                      == FD_ED25519_SUCCESS );
     FD_TEST_CUSTOM( actual == proof->ok, fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_cctv_batch(2) id=%d", proof->tc_id ) );
 
-    actual = ( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, shas, 4 )
+    actual = ( fd_ed25519_verify_batch_single_msg( msg, msg_sz, sigs, pubs, sha, 4 )
                      == FD_ED25519_SUCCESS );
     FD_TEST_CUSTOM( actual == proof->ok, fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_cctv_batch(4) id=%d", proof->tc_id ) );
   }
   FD_LOG_NOTICE(( "fd_ed25519_verify_cctv_batch: ok" ));
 }
 
+void
+test_verify_batch_multi_msg( fd_rng_t *    rng,
+                             fd_sha512_t * sha ) {
+# define BATCH_MAX FD_ED25519_VERIFY_BATCH_MAX
+# define MSG_MAX   (FD_ED25519_VERIFY_BATCH_MSG_MAX+256UL) /* exercise the unbatched path too */
+  static uchar _msgs[ BATCH_MAX ][ MSG_MAX ];
+  uchar         _pubs[ BATCH_MAX ][ 32 ];
+  uchar         _sigs[ BATCH_MAX ][ 64 ];
+  uchar         _prv [ 32 ];
+  ulong         msg_sz[ BATCH_MAX ];
+  uchar const * msg   [ BATCH_MAX ];
+  uchar const * sig   [ BATCH_MAX ];
+  uchar const * pub   [ BATCH_MAX ];
+  int           err   [ BATCH_MAX ];
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+    msg[ j ] = _msgs[ j ]; sig[ j ] = _sigs[ j ]; pub[ j ] = _pubs[ j ];
+    for( ulong b=0UL; b<MSG_MAX; b++ ) _msgs[ j ][ b ] = fd_rng_uchar( rng );
+  }
+
+  /* Compare against fd_ed25519_verify with randomly corrupted
+     signatures, messages and public keys, in batches of every size */
+
+  for( ulong iter=0UL; iter<256UL; iter++ ) {
+    ulong batch_sz = 1UL+fd_rng_ulong_roll( rng, BATCH_MAX );
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      msg_sz[ j ] = fd_rng_ulong_roll( rng, MSG_MAX+1UL );
+      fd_ed25519_public_from_private( _pubs[ j ], fd_rng_b256( rng, _prv ), sha );
+      fd_ed25519_sign( _sigs[ j ], _msgs[ j ], msg_sz[ j ], _pubs[ j ], _prv, sha );
+
+      uint r = fd_rng_uint( rng );
+      if( !(r & 7U) ) { ulong idx = fd_rng_ulong_roll( rng, 512UL ); _sigs[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); } r >>= 3;
+      if( !(r & 7U) ) { ulong idx = fd_rng_ulong_roll( rng, 256UL ); _pubs[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); } r >>= 3;
+      if( !(r & 7U) && msg_sz[ j ] ) { ulong idx = fd_rng_ulong_roll( rng, 8UL*msg_sz[ j ] ); _msgs[ j ][ idx>>3 ] ^= (uchar)(1UL<<(idx&7UL)); }
+    }
+
+    int res = fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, batch_sz, err );
+    int expected_res = FD_ED25519_SUCCESS;
+    for( ulong j=0UL; j<batch_sz; j++ ) {
+      int expected = fd_ed25519_verify( msg[ j ], msg_sz[ j ], sig[ j ], pub[ j ], sha );
+      FD_TEST( err[ j ]==expected );
+      if( expected_res==FD_ED25519_SUCCESS ) expected_res = expected;
+    }
+    FD_TEST( res==expected_res );
+  }
+
+  /* Batches that are empty or too big are rejected without touching
+     err */
+
+  err[ 0 ] = 42;
+  FD_TEST( fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, 0UL,           err )==FD_ED25519_ERR_SIG );
+  FD_TEST( fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, BATCH_MAX+1UL, err )==FD_ED25519_ERR_SIG );
+  FD_TEST( err[ 0 ]==42 );
+
+  /* Every cctv vector gives the same result in any position of a batch
+     of otherwise good signatures */
+
+  for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+    msg_sz[ j ] = 128UL;
+    fd_ed25519_public_from_private( _pubs[ j ], fd_rng_b256( rng, _prv ), sha );
+    fd_ed25519_sign( _sigs[ j ], _msgs[ j ], msg_sz[ j ], _pubs[ j ], _prv, sha );
+  }
+  for( fd_ed25519_verify_cctv_t const * proof = ed25519_verify_cctvs; proof->msg; proof++ ) {
+    ulong j = fd_rng_ulong_roll( rng, BATCH_MAX );
+    uchar const * good_msg = msg[ j ]; ulong good_msg_sz = msg_sz[ j ];
+    uchar const * good_sig = sig[ j ]; uchar const * good_pub = pub[ j ];
+    msg[ j ] = proof->msg; msg_sz[ j ] = proof->msg_sz; sig[ j ] = proof->sig; pub[ j ] = proof->pub;
+    fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, BATCH_MAX, err );
+    for( ulong i=0UL; i<BATCH_MAX; i++ ) FD_TEST( (err[ i ]==FD_ED25519_SUCCESS)==( i==j ? proof->ok : 1 ) );
+    msg[ j ] = good_msg; msg_sz[ j ] = good_msg_sz; sig[ j ] = good_sig; pub[ j ] = good_pub;
+  }
+
+  /* fd_ed25519_verify_batch_single_msg, with short and long messages
+     (the latter are not hashed in a batch) */
+
+  for( ulong sz=100UL; sz<MSG_MAX; sz+=FD_ED25519_VERIFY_BATCH_MSG_MAX ) {
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+      fd_ed25519_public_from_private( _pubs[ j ], fd_rng_b256( rng, _prv ), sha );
+      fd_ed25519_sign( _sigs[ j ], _msgs[ 0 ], sz, _pubs[ j ], _prv, sha );
+    }
+    FD_TEST( fd_ed25519_verify_batch_single_msg( _msgs[ 0 ], sz, _sigs[ 0 ], _pubs[ 0 ], sha, (uchar)BATCH_MAX )==FD_ED25519_SUCCESS );
+    _sigs[ BATCH_MAX-1UL ][ 0 ] ^= (uchar)1;
+    FD_TEST( fd_ed25519_verify_batch_single_msg( _msgs[ 0 ], sz, _sigs[ 0 ], _pubs[ 0 ], sha, (uchar)BATCH_MAX )!=FD_ED25519_SUCCESS );
+    FD_TEST( fd_ed25519_verify_batch_single_msg( _msgs[ 0 ], sz, _sigs[ 0 ], _pubs[ 0 ], sha, (uchar)(BATCH_MAX-1UL) )==FD_ED25519_SUCCESS );
+  }
+
+  /* Bench against verifying the same signatures one at a time */
+
+  ulong iter = 1000UL;
+  for( ulong sz=256UL; sz<=1024UL; sz+=256UL ) {
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+      msg_sz[ j ] = sz;
+      fd_ed25519_public_from_private( _pubs[ j ], fd_rng_b256( rng, _prv ), sha );
+      fd_ed25519_sign( _sigs[ j ], _msgs[ j ], sz, _pubs[ j ], _prv, sha );
+    }
+    FD_TEST( fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, BATCH_MAX, err )==FD_ED25519_SUCCESS );
+
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_MFENCE();
+      for( ulong j=0UL; j<BATCH_MAX; j++ ) fd_ed25519_verify( msg[ j ], msg_sz[ j ], sig[ j ], pub[ j ], sha );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify(x%lu %lu)", BATCH_MAX, sz ), iter*BATCH_MAX, dt );
+
+    dt = fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      FD_COMPILER_MFENCE();
+      fd_ed25519_verify_batch_multi_msg( msg, msg_sz, sig, pub, sha, BATCH_MAX, err );
+    }
+    dt = fd_log_wallclock() - dt;
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_..._verify_multi(%lu / %lu)", sz, BATCH_MAX ), iter*BATCH_MAX, dt );
+  }
+  FD_LOG_NOTICE(( "fd_ed25519_verify_batch_multi_msg: ok" ));
+# undef MSG_MAX
+# undef BATCH_MAX
+}
+
 /**********************************************************************/
 
 int
@@ -1118,6 +1233,8 @@ main( int     argc,
   test_cctv       ( sha );
   test_cctv_batch ( rng, sha );
 
+  test_verify_batch_multi_msg( rng, sha );
+
   fd_sha512_delete( fd_sha512_leave( sha ) );
   fd_rng_delete( fd_rng_leave( rng ) );
   FD_LOG_NOTICE(( "pass" ));
@@ -5,6 +5,7 @@ $(call make-unit-test,test_compute_budget_program,test_compute_budget_program,fd
 $(call make-unit-test,test_est_tbl,test_est_tbl,fd_ballet fd_util)
 $(call make-unit-test,test_pack,test_pack,fd_disco fd_ballet fd_util)
 $(call make-unit-test,test_pack_bitset,test_pack_bitset,fd_ballet fd_util)
+$(call make-unit-test,bench_pack,bench_pack,fd_disco fd_ballet fd_util)
 $(call run-unit-test,test_compute_budget_program,)
 $(call run-unit-test,test_est_tbl,)
 $(call run-unit-test,test_pack,)
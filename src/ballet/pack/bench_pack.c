@@ -0,0 +1,389 @@
+#include "../fd_ballet.h"
+#include "fd_pack.h"
+#include "fd_pack_cost.h"
+#include "fd_compute_budget_program.h"
+#include "../txn/fd_txn.h"
+#include "../../util/net/fd_pcap.h"
+#include "../../disco/metrics/fd_metrics.h"
+
+/* bench_pack drives a pack object the way the pack tile does and
+   reports how it performs, so that pack_depth and bank_tile_cnt can be
+   sized from data rather than guessed.
+
+   Transactions come either from a pcap (--pcap), where the UDP payload
+   of each packet is a serialized transaction as sent to the TPU UDP
+   port, or from a synthetic generator.  Packets that don't parse are
+   skipped.  The synthetic generator makes transactions that each lock
+   --write-cnt writable and --read-cnt readonly accounts.  Each account
+   is, with probability --hot-frac, drawn from a pool of --hot-cnt hot
+   accounts with Zipf(--zipf-s) popularity, and is otherwise unique.
+
+   Banks are simulated: a microblock keeps its bank busy for --cu-ns ns
+   per CU it contains, and a bank that gets an empty microblock polls
+   again every --poll-ns until something changes.  Transactions arrive
+   at --txn-rate per second of simulated time and a block ends every
+   --slot-ns.  With --insert-batch greater than 1, the transactions that
+   arrive between two schedule calls are inserted with
+   fd_pack_insert_txn_batch, at most --insert-batch at a time, instead
+   of one at a time with fd_pack_insert_txn_fini.  With --lookahead 1,
+   the microblocks of all the banks that are free at the same time are
+   planned together with fd_pack_schedule_lookahead, like the pack tile
+   does.  All of pack's work is timed against the wallclock, and none of
+   the simulated time is.
+
+   Output:
+     insert    ns/txn      wallclock per fd_pack_insert_txn_{init,fini}
+                           (or per transaction in a batch insert)
+     schedule  ns/mblk     wallclock per non-empty microblock, including
+                           the empty schedule calls in between
+     CUs/block             CUs scheduled per simulated block
+     bank idle             fraction of simulated bank time not spent
+                           executing a microblock */
+
+#if FD_HAS_HOSTED
+
+#include <math.h>
+#include <stdio.h>
+
+#define HOT_MAX  (1UL<<20)
+#define ACCT_MAX (32UL)
+
+static fd_txn_p_t   out[ MAX_TXN_PER_MICROBLOCK ];
+static fd_txn_p_t * batch        [ FD_PACK_INSERT_BATCH_MAX ];
+static ulong        batch_expires[ FD_PACK_INSERT_BATCH_MAX ];
+static int          batch_res    [ FD_PACK_INSERT_BATCH_MAX ];
+static double       hot_cdf[ HOT_MAX ];
+
+static uchar metrics_scratch[ FD_METRICS_FOOTPRINT( 0, 0 ) ] __attribute__((aligned(FD_METRICS_ALIGN)));
+
+struct bench_src {
+  /* pcap source */
+  FILE *           file;
+  fd_pcap_iter_t * iter;
+
+  /* synthetic source */
+  fd_rng_t * rng;
+  ulong      rem;
+  ulong      seq;
+  ulong      hot_cnt;
+  float      hot_frac;
+  ulong      write_cnt;
+  ulong      read_cnt;
+};
+typedef struct bench_src bench_src_t;
+
+/* Encodes a compact-u16.  Values used here are all < 0x4000. */
+static uchar *
+put_cu16( uchar * p,
+          ulong   v ) {
+  if( v<0x80UL ) { *p++ = (uchar)v; return p; }
+  *p++ = (uchar)(0x80UL | (v&0x7FUL));
+  *p++ = (uchar)(v>>7);
+  return p;
+}
+
+static void
+synth_acct( bench_src_t * src,
+            uchar *       addr ) {
+  if( fd_rng_float_c( src->rng )<src->hot_frac ) {
+    double u  = fd_rng_double_c( src->rng );
+    ulong  lo = 0UL;
+    ulong  hi = src->hot_cnt-1UL;
+    while( lo<hi ) { ulong m = (lo+hi)/2UL; if( hot_cdf[ m ]<u ) lo = m+1UL; else hi = m; }
+    memset( addr, 'H', FD_TXN_ACCT_ADDR_SZ );
+    FD_STORE( ulong, addr, lo );
+  } else {
+    memset( addr, 'C', FD_TXN_ACCT_ADDR_SZ );
+    FD_STORE( ulong, addr,     fd_rng_ulong( src->rng ) );
+    FD_STORE( ulong, addr+8UL, fd_rng_ulong( src->rng ) );
+  }
+}
+
+/* synth_txn serializes a legacy transaction with one signer,
+   write_cnt writable and read_cnt readonly accounts, a
+   SetComputeUnitLimit, a SetComputeUnitPrice, and one instruction to a
+   program that references every account.  Returns the payload size. */
+static ulong
+synth_txn( bench_src_t * src,
+           uchar *       payload ) {
+  ulong acct_cnt = 1UL + src->write_cnt + 2UL + src->read_cnt;
+  uchar accts[ ACCT_MAX ][ FD_TXN_ACCT_ADDR_SZ ];
+
+  src->seq++;
+  memset( accts[0], 'S', FD_TXN_ACCT_ADDR_SZ );
+  FD_STORE( ulong, accts[0], src->seq );
+  for( ulong i=1UL; i<acct_cnt; i++ ) {
+    if( i==1UL+src->write_cnt     ) { fd_memcpy( accts[i], FD_COMPUTE_BUDGET_PROGRAM_ID, FD_TXN_ACCT_ADDR_SZ ); continue; }
+    if( i==1UL+src->write_cnt+1UL ) { memset( accts[i], 'P', FD_TXN_ACCT_ADDR_SZ );                            continue; }
+    int dup;
+    do {
+      synth_acct( src, accts[i] );
+      dup = 0;
+      for( ulong j=0UL; j<i; j++ ) dup |= !memcmp( accts[i], accts[j], FD_TXN_ACCT_ADDR_SZ );
+    } while( dup );
+  }
+
+  uchar * p = payload;
+  *p++ = (uchar)1;                                         /* signature_cnt */
+  memset( p, 0, FD_TXN_SIGNATURE_SZ ); FD_STORE( ulong, p, src->seq ); p += FD_TXN_SIGNATURE_SZ;
+  *p++ = (uchar)1;                                         /* signature_cnt again, in the message header */
+  *p++ = (uchar)0;                                         /* readonly_signed_cnt */
+  *p++ = (uchar)(2UL+src->read_cnt);                       /* readonly_unsigned_cnt */
+  p = put_cu16( p, acct_cnt );
+  fd_memcpy( p, accts, acct_cnt*FD_TXN_ACCT_ADDR_SZ ); p += acct_cnt*FD_TXN_ACCT_ADDR_SZ;
+  memset( p, 'B', FD_TXN_BLOCKHASH_SZ ); p += FD_TXN_BLOCKHASH_SZ;
+
+  uchar cbp_idx  = (uchar)(1UL+src->write_cnt);
+  /* Mostly small CU requests with the occasional large one */
+  uint  cu_limit = 1000U + fd_rng_uint_roll( src->rng, fd_rng_uint_roll( src->rng, 16U ) ? 20000U : 200000U );
+  ulong cu_price = fd_rng_ulong_roll( src->rng, 100000UL );
+
+  p = put_cu16( p, 3UL );                                  /* instr_cnt */
+  *p++ = cbp_idx; p = put_cu16( p, 0UL ); p = put_cu16( p, 5UL );
+  *p++ = (uchar)2; FD_STORE( uint,  p, cu_limit ); p += sizeof(uint);
+  *p++ = cbp_idx; p = put_cu16( p, 0UL ); p = put_cu16( p, 9UL );
+  *p++ = (uchar)3; FD_STORE( ulong, p, cu_price ); p += sizeof(ulong);
+  *p++ = (uchar)(cbp_idx+1); p = put_cu16( p, acct_cnt );
+  for( ulong i=0UL; i<acct_cnt; i++ ) *p++ = (uchar)i;
+  p = put_cu16( p, 8UL ); FD_STORE( ulong, p, src->seq ); p += sizeof(ulong);
+
+  return (ulong)(p-payload);
+}
+
+/* bench_src_next stores the next transaction from src in slot, parsed.
+   Returns 1 on success and 0 if src is exhausted. */
+static int
+bench_src_next( bench_src_t * src,
+                fd_txn_p_t *  slot ) {
+  if( src->iter ) {
+    uchar hdr[ 128 ];
+    for(;;) {
+      ulong hdr_sz = sizeof(hdr);
+      ulong pld_sz = FD_TPU_MTU;
+      long  ts;
+      if( FD_UNLIKELY( !fd_pcap_iter_next_split( src->iter, hdr, &hdr_sz, slot->payload, &pld_sz, &ts ) ) ) return 0;
+      if( FD_LIKELY( fd_txn_parse( slot->payload, pld_sz, TXN(slot), NULL ) ) ) { slot->payload_sz = pld_sz; return 1; }
+    }
+  }
+
+  if( FD_UNLIKELY( !src->rem ) ) return 0;
+  src->rem--;
+  slot->payload_sz = synth_txn( src, slot->payload );
+  FD_TEST( fd_txn_parse( slot->payload, slot->payload_sz, TXN(slot), NULL ) );
+  return 1;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _pcap         = fd_env_strip_cmdline_cstr  ( &argc, &argv, "--pcap",          NULL, NULL      );
+  ulong        txn_cnt       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--txn-cnt",       NULL, 20000UL   );
+  ulong        pack_depth    = fd_env_strip_cmdline_ulong ( &argc, &argv, "--depth",         NULL, 4096UL    );
+  ulong        bank_cnt      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--bank-cnt",      NULL, 4UL       );
+  ulong        max_txn       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--max-txn",       NULL, 31UL      );
+  ulong        mblk_cus      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--mblk-cus",      NULL, 1500000UL );
+  float        vote_frac     = fd_env_strip_cmdline_float ( &argc, &argv, "--vote-frac",     NULL, 0.25f     );
+  ulong        hot_cnt       = fd_env_strip_cmdline_ulong ( &argc, &argv, "--hot-cnt",       NULL, 1024UL    );
+  double       zipf_s        = fd_env_strip_cmdline_double( &argc, &argv, "--zipf-s",        NULL, 1.0       );
+  float        hot_frac      = fd_env_strip_cmdline_float ( &argc, &argv, "--hot-frac",      NULL, 0.5f      );
+  ulong        write_cnt     = fd_env_strip_cmdline_ulong ( &argc, &argv, "--write-cnt",     NULL, 2UL       );
+  ulong        read_cnt      = fd_env_strip_cmdline_ulong ( &argc, &argv, "--read-cnt",      NULL, 4UL       );
+  double       txn_rate      = fd_env_strip_cmdline_double( &argc, &argv, "--txn-rate",      NULL, 4000.0    );
+  double       cu_ns         = fd_env_strip_cmdline_double( &argc, &argv, "--cu-ns",         NULL, 25.0      );
+  long         poll_ns       = fd_env_strip_cmdline_long  ( &argc, &argv, "--poll-ns",       NULL, 2000L     );
+  long         slot_ns       = fd_env_strip_cmdline_long  ( &argc, &argv, "--slot-ns",       NULL, 400000000L);
+  uint         seed          = fd_env_strip_cmdline_uint  ( &argc, &argv, "--seed",          NULL, 0U        );
+  ulong        insert_batch  = fd_env_strip_cmdline_ulong ( &argc, &argv, "--insert-batch",  NULL, 1UL       );
+  int          lookahead     = fd_env_strip_cmdline_int   ( &argc, &argv, "--lookahead",     NULL, 0         );
+
+  if( FD_UNLIKELY( (!bank_cnt) | (bank_cnt>FD_PACK_MAX_BANK_TILES)            ) ) FD_LOG_ERR(( "--bank-cnt out of range" ));
+  if( FD_UNLIKELY( (!max_txn)  | (max_txn>MAX_TXN_PER_MICROBLOCK)             ) ) FD_LOG_ERR(( "--max-txn out of range" ));
+  if( FD_UNLIKELY( (!hot_cnt)  | (hot_cnt>HOT_MAX)                            ) ) FD_LOG_ERR(( "--hot-cnt out of range" ));
+  if( FD_UNLIKELY( (!insert_batch) | (insert_batch>FD_PACK_INSERT_BATCH_MAX)  ) ) FD_LOG_ERR(( "--insert-batch out of range" ));
+  if( FD_UNLIKELY( (1UL+write_cnt+2UL+read_cnt>ACCT_MAX)                      ) ) FD_LOG_ERR(( "--write-cnt plus --read-cnt too large" ));
+  if( FD_UNLIKELY( !((txn_rate>0.0) & (cu_ns>=0.0) & (poll_ns>0L) & (slot_ns>0L)) ) ) FD_LOG_ERR(( "invalid timing parameters" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, seed, 0UL ) );
+  fd_metrics_register( (ulong *)fd_metrics_new( metrics_scratch, 0UL, 0UL ) );
+
+  bench_src_t src[1] = {{ 0 }};
+  if( _pcap ) {
+    FD_LOG_NOTICE(( "Replaying --pcap %s", _pcap ));
+    src->file = fopen( _pcap, "r" );
+    if( FD_UNLIKELY( !src->file ) ) FD_LOG_ERR(( "fopen failed" ));
+    src->iter = fd_pcap_iter_new( src->file );
+    if( FD_UNLIKELY( !src->iter ) ) FD_LOG_ERR(( "fd_pcap_iter_new failed" ));
+  } else {
+    FD_LOG_NOTICE(( "Synthetic load (--txn-cnt %lu --hot-cnt %lu --zipf-s %g --hot-frac %g --write-cnt %lu --read-cnt %lu)",
+                    txn_cnt, hot_cnt, zipf_s, (double)hot_frac, write_cnt, read_cnt ));
+    double norm = 0.0;
+    for( ulong i=0UL; i<hot_cnt; i++ ) { norm += pow( (double)(i+1UL), -zipf_s ); hot_cdf[ i ] = norm; }
+    for( ulong i=0UL; i<hot_cnt; i++ ) hot_cdf[ i ] /= norm;
+    src->rng       = rng;
+    src->rem       = txn_cnt;
+    src->hot_cnt   = hot_cnt;
+    src->hot_frac  = hot_frac;
+    src->write_cnt = write_cnt;
+    src->read_cnt  = read_cnt;
+  }
+
+  FD_LOG_NOTICE(( "Pack (--depth %lu --bank-cnt %lu --max-txn %lu --mblk-cus %lu --vote-frac %g --insert-batch %lu --lookahead %i)",
+                  pack_depth, bank_cnt, max_txn, mblk_cus, (double)vote_frac, insert_batch, lookahead ));
+  FD_LOG_NOTICE(( "Simulation (--txn-rate %g --cu-ns %g --poll-ns %li --slot-ns %li)",
+                  txn_rate, cu_ns, poll_ns, slot_ns ));
+
+  ulong       footprint = fd_pack_footprint( pack_depth, bank_cnt, max_txn );
+  ulong       page_cnt  = (footprint+FD_SHMEM_HUGE_PAGE_SZ)/FD_SHMEM_NORMAL_PAGE_SZ; /* Leave room for wksp overhead */
+  fd_wksp_t * wksp      = fd_wksp_new_anonymous( FD_SHMEM_NORMAL_PAGE_SZ, page_cnt, fd_log_cpu_id(), "bench_pack", 0UL );
+  FD_TEST( wksp );
+  void * _pack = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 1UL );
+  FD_TEST( _pack );
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( _pack, pack_depth, bank_cnt, max_txn, ULONG_MAX, rng ) );
+  FD_TEST( pack );
+
+  long bank_free[ FD_PACK_MAX_BANK_TILES ] = { 0L };
+  long bank_busy = 0L;
+
+  long  now         = 0L;
+  long  block_end   = slot_ns;
+  long  next_arrive = 0L;
+  ulong arrived     = 0UL;
+  ulong accepted    = 0UL;
+  int   src_done    = 0;
+  int   drain_block = 0; /* current block started after src_done */
+  int   stalled     = 0;
+
+  long  insert_ns   = 0L;
+  long  sched_ns    = 0L;
+  ulong mblk_cnt    = 0UL;
+  ulong sched_txn   = 0UL;
+  ulong block_cnt   = 0UL;
+  ulong block_cus   = 0UL;
+  ulong total_cus   = 0UL;
+
+  for(;;) {
+    /* Run the bank that frees up first */
+    ulong bank = 0UL;
+    for( ulong b=1UL; b<bank_cnt; b++ ) bank = fd_ulong_if( bank_free[ b ]<bank_free[ bank ], b, bank );
+    now = fd_long_max( now, bank_free[ bank ] );
+
+    while( FD_UNLIKELY( now>=block_end ) ) {
+      fd_pack_end_block( pack );
+      block_cnt++;
+      total_cus += block_cus;
+      /* Once nothing new is arriving, a whole block in which nothing
+         got scheduled means what's left in pack never will be (too
+         expensive for a block, a duplicate signature, etc.). */
+      stalled   |= drain_block & !block_cus;
+      drain_block = src_done;
+      block_cus  = 0UL;
+      block_end += slot_ns;
+    }
+    if( FD_UNLIKELY( stalled ) ) break;
+
+    ulong batch_cnt = 0UL;
+    while( !src_done && next_arrive<=now ) {
+      /* Don't count producing the transaction as insert time */
+      long t0 = fd_log_wallclock();
+      fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+      long t1 = fd_log_wallclock();
+      if( FD_UNLIKELY( !bench_src_next( src, slot ) ) ) {
+        fd_pack_insert_txn_cancel( pack, slot );
+        src_done = 1;
+        break;
+      }
+      if( insert_batch>1UL ) {
+        insert_ns += t1-t0;
+        batch[ batch_cnt++ ] = slot;
+        if( batch_cnt==insert_batch ) {
+          long t2 = fd_log_wallclock();
+          fd_pack_insert_txn_batch( pack, batch, batch_expires, batch_cnt, batch_res );
+          insert_ns += fd_log_wallclock()-t2;
+          for( ulong i=0UL; i<batch_cnt; i++ ) accepted += (ulong)(batch_res[ i ]>=0);
+          batch_cnt = 0UL;
+        }
+      } else {
+        long t2 = fd_log_wallclock();
+        int res = fd_pack_insert_txn_fini( pack, slot, 0UL );
+        insert_ns += (t1-t0) + (fd_log_wallclock()-t2);
+        accepted  += (ulong)(res>=0);
+      }
+      arrived++;
+      next_arrive = (long)((double)arrived*1e9/txn_rate);
+    }
+    if( batch_cnt ) {
+      long t2 = fd_log_wallclock();
+      fd_pack_insert_txn_batch( pack, batch, batch_expires, batch_cnt, batch_res );
+      insert_ns += fd_log_wallclock()-t2;
+      for( ulong i=0UL; i<batch_cnt; i++ ) accepted += (ulong)(batch_res[ i ]>=0);
+    }
+
+    if( FD_UNLIKELY( src_done && !fd_pack_avail_txn_cnt( pack ) ) ) break;
+
+    long t0 = fd_log_wallclock();
+    if( lookahead ) {
+      ulong free_mask = 0UL;
+      for( ulong b=0UL; b<bank_cnt; b++ ) {
+        if( bank_free[ b ]>now ) continue;
+        fd_pack_microblock_complete( pack, b );
+        free_mask |= 1UL<<b;
+      }
+      fd_pack_schedule_lookahead( pack, mblk_cus, vote_frac, free_mask );
+    }
+    fd_pack_microblock_complete( pack, bank );
+    ulong cnt = fd_pack_schedule_next_microblock( pack, mblk_cus, vote_frac, bank, out );
+    sched_ns += fd_log_wallclock() - t0;
+
+    if( FD_LIKELY( cnt ) ) {
+      ulong cus = 0UL;
+      for( ulong i=0UL; i<cnt; i++ ) { uint flags = 0U; cus += fd_pack_compute_cost( out+i, &flags ); }
+      long dur = (long)((double)cus*cu_ns);
+      bank_free[ bank ] = now + dur;
+      bank_busy        += dur;
+      block_cus        += cus;
+      sched_txn        += cnt;
+      mblk_cnt++;
+    } else {
+      /* Nothing in pack changes until a transaction arrives, another
+         bank finishes, or the block ends, so skip the polls that would
+         happen before then. */
+      long wake = fd_long_min( block_end, src_done ? LONG_MAX : next_arrive );
+      for( ulong b=0UL; b<bank_cnt; b++ ) if( (b!=bank) & (bank_free[ b ]>now) ) wake = fd_long_min( wake, bank_free[ b ] );
+      bank_free[ bank ] = now + poll_ns*fd_long_max( 1L, (wake-now+poll_ns-1L)/poll_ns );
+    }
+  }
+  total_cus += block_cus;
+  block_cnt += (ulong)(!!block_cus);
+
+  FD_LOG_NOTICE(( "txns: %lu arrived, %lu accepted, %lu scheduled in %lu microblocks (%.3f txn/mblk), %lu never scheduled",
+                  arrived, accepted, sched_txn, mblk_cnt, (double)sched_txn/(double)fd_ulong_max( mblk_cnt, 1UL ),
+                  fd_pack_avail_txn_cnt( pack ) ));
+  FD_LOG_NOTICE(( "insert    %10.3f ns/txn",  (double)insert_ns/(double)fd_ulong_max( arrived,  1UL ) ));
+  FD_LOG_NOTICE(( "schedule  %10.3f ns/mblk", (double)sched_ns /(double)fd_ulong_max( mblk_cnt, 1UL ) ));
+  FD_LOG_NOTICE(( "CUs/block %10.0f over %lu blocks", (double)total_cus/(double)fd_ulong_max( block_cnt, 1UL ), block_cnt ));
+  FD_LOG_NOTICE(( "bank idle %10.3f", 1.0 - (double)bank_busy/((double)bank_cnt*(double)fd_long_max( now, 1L )) ));
+
+  fd_wksp_free_laddr( fd_pack_delete( fd_pack_leave( pack ) ) );
+  fd_wksp_delete_anonymous( wksp );
+  if( src->file ) fclose( src->file );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
@@ -72,6 +72,8 @@ FD_STATIC_ASSERT( offsetof( fd_pack_ord_txn_t, txn->payload )==0UL, fd_pack_ord_
 #define FD_ORD_TXN_ROOT_PENDING_VOTE    2
 #define FD_ORD_TXN_ROOT_DELAY_END_BLOCK 3
 #define FD_ORD_TXN_ROOT_DELAY_BANK_BASE 4 /* [4, 4+FD_PACK_MAX_BANK_TILES) */
+#define FD_ORD_TXN_ROOT_STAGED_BASE     (FD_ORD_TXN_ROOT_DELAY_BANK_BASE+(int)FD_PACK_MAX_BANK_TILES)
+                                          /* [66, 66+FD_PACK_MAX_BANK_TILES) */
 
 #define FD_PACK_IN_USE_WRITABLE    (0x8000000000000000UL)
 #define FD_PACK_IN_USE_BIT_CLEARED (0x4000000000000000UL)
@@ -145,9 +147,35 @@ struct fd_pack_bitset_acct_mapping {
   /* bit is in [0, FD_PACK_BITSET_MAX) U
      { FD_PACK_BITSET_FIRST_INSTANCE, FD_PACK_BITSET_SLOWPATH }. */
   ushort              bit;
+
+  /* write_cnt counts the number of transactions that have write-locked
+     this account since it was inserted into the map, i.e. since the
+     last time no pending transaction referenced it.  It's used to
+     decide which accounts are hot enough to get one of the last few
+     bits.  Saturates rather than wrapping.  Fits in what would
+     otherwise be padding. */
+  ushort              write_cnt;
 };
 typedef struct fd_pack_bitset_acct_mapping fd_pack_bitset_acct_mapping_t;
 
+/* When bits are plentiful, any account referenced by at least two
+   pending transactions gets one.  Once fewer than
+   FD_PACK_BITSET_HOT_RESERVE bits remain, only accounts that have been
+   write-locked at least FD_PACK_BITSET_HOT_WRITE_CNT times get one.
+   Without this, a burst of cold accounts that happen to be referenced
+   twice exhausts the bitset, and the accounts that actually cause
+   contention end up on the slow path, where every conflict check costs
+   a hash map probe per account.
+
+   An account that was pushed to the slow path is promoted lazily: the
+   next transaction that references it after a bit is available (and
+   the account is hot enough) reserves a bit for it.  Transactions
+   inserted before the promotion don't have the bit set, but that only
+   means the bitset may miss a conflict for them, which is the
+   direction of error the slow path already catches. */
+#define FD_PACK_BITSET_HOT_RESERVE   (FD_PACK_BITSET_MAX/8UL)
+#define FD_PACK_BITSET_HOT_WRITE_CNT ((ushort)2)
+
 /* Table of special addresses that are not allowed to be written to.  We
    immediately reject and refuse to pack any transaction that tries to
    write to one of these accounts.  Because we reject any writes to any
@@ -299,7 +327,9 @@ struct fd_pack_private {
 
   ulong      pending_txn_cnt;
   ulong      microblock_cnt; /* How many microblocks have we
-                                generated in this block? */
+                                generated in this block?  Staged
+                                microblocks count once they are
+                                returned. */
   fd_rng_t * rng;
 
   ulong      cumulative_block_cost;
@@ -378,6 +408,23 @@ struct fd_pack_private {
   fd_pack_addr_use_t * use_by_bank    [ FD_PACK_MAX_BANK_TILES ];
   ulong                use_by_bank_cnt[ FD_PACK_MAX_BANK_TILES ];
 
+  /* staged: An array of size max_txn_per_microblock for each banking
+     tile.  Holds the pool indices of transactions that have been
+     planned into the next microblock for that banking tile but not yet
+     returned to the caller.  Addressed staged[i][j] where i is in [0,
+     bank_tile_cnt) and j is in [0, staged_cnt[i]).  Transactions in
+     staged[i] are not in any treap (their root is
+     FD_ORD_TXN_ROOT_STAGED_BASE+i), but they still count towards
+     pending_txn_cnt, are still in the expiration queue and signature
+     map, and still hold their references in acct_to_bitset.  Their
+     accounts are already marked as in use by bank tile i in
+     acct_in_use and use_by_bank[i], and their cost has already been
+     charged to the block.  staged_vote_cnt[i] is the number of votes in
+     staged[i]. */
+  ulong * staged         [ FD_PACK_MAX_BANK_TILES ];
+  ulong   staged_cnt     [ FD_PACK_MAX_BANK_TILES ];
+  ulong   staged_vote_cnt[ FD_PACK_MAX_BANK_TILES ];
+
   fd_histf_t txn_per_microblock [ 1 ];
   fd_histf_t vote_per_microblock[ 1 ];
   /* bitset_avail: a stack of which bits are not currently reserved and
@@ -413,13 +460,14 @@ fd_pack_footprint( ulong pack_depth,
 
   l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, FD_PACK_ALIGN,      sizeof(fd_pack_t)                               );
-  l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+1UL           ) ); /* pool           */
+  l = FD_LAYOUT_APPEND( l, trp_pool_align (),  trp_pool_footprint ( pack_depth+FD_PACK_INSERT_BATCH_MAX ) ); /* pool           */
   l = FD_LAYOUT_APPEND( l, expq_align     (),  expq_footprint     ( pack_depth+1UL           ) ); /* expiration prq */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz           ) ); /* acct_in_use    */
   l = FD_LAYOUT_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn               ) ); /* writer_costs   */
   l = FD_LAYOUT_APPEND( l, sig2txn_align  (),  sig2txn_footprint  ( lg_depth                 ) ); /* signature_map  */
   l = FD_LAYOUT_APPEND( l, 32UL,               sizeof(fd_pack_addr_use_t)*max_acct_in_flight   ); /* use_by_bank    */
   l = FD_LAYOUT_APPEND( l, bitset_map_align(), bitset_map_footprint( lg_acct_in_trp          ) ); /* acct_to_bitset */
+  l = FD_LAYOUT_APPEND( l, alignof(ulong),     sizeof(ulong)*bank_tile_cnt*max_txn_per_microblock ); /* staged   */
   return FD_LAYOUT_FINI( l, FD_PACK_ALIGN );
 }
 
@@ -443,15 +491,16 @@ fd_pack_new( void *     mem,
 
   FD_SCRATCH_ALLOC_INIT( l, mem );
   fd_pack_t * pack    = FD_SCRATCH_ALLOC_APPEND( l,  FD_PACK_ALIGN,       sizeof(fd_pack_t)                             );
-  /* The pool has one extra element that is used between insert_init and
-     cancel/fini. */
-  void * _pool        = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),    trp_pool_footprint ( pack_depth+1UL         ) );
+  /* The pool has FD_PACK_INSERT_BATCH_MAX extra elements that are used
+     between insert_init and cancel/fini/insert_txn_batch. */
+  void * _pool        = FD_SCRATCH_ALLOC_APPEND( l,  trp_pool_align(),    trp_pool_footprint ( pack_depth+FD_PACK_INSERT_BATCH_MAX ) );
   void * _expq        = FD_SCRATCH_ALLOC_APPEND( l,  expq_align(),        expq_footprint     ( pack_depth+1UL         ) );
   void * _uses        = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_uses_tbl_sz         ) );
   void * _writer_cost = FD_SCRATCH_ALLOC_APPEND( l,  acct_uses_align(),   acct_uses_footprint( lg_max_txn             ) );
   void * _sig_map     = FD_SCRATCH_ALLOC_APPEND( l,  sig2txn_align(),     sig2txn_footprint  ( lg_depth               ) );
   void * _use_by_bank = FD_SCRATCH_ALLOC_APPEND( l,  32UL,                sizeof(fd_pack_addr_use_t)*max_acct_in_flight );
   void * _acct_bitset = FD_SCRATCH_ALLOC_APPEND( l,  bitset_map_align(),  bitset_map_footprint( lg_acct_in_trp        ) );
+  void * _staged      = FD_SCRATCH_ALLOC_APPEND( l,  alignof(ulong),      sizeof(ulong)*bank_tile_cnt*max_txn_per_microblock );
 
   pack->pack_depth                  = pack_depth;
   pack->bank_tile_cnt               = bank_tile_cnt;
@@ -466,10 +515,10 @@ fd_pack_new( void *     mem,
   pack->outstanding_microblock_mask = 0UL;
 
 
-  trp_pool_new(  _pool,        pack_depth+1UL );
+  trp_pool_new(  _pool,        pack_depth+FD_PACK_INSERT_BATCH_MAX );
 
   fd_pack_ord_txn_t * pool = trp_pool_join( _pool );
-  treap_seed( pool, pack_depth+1UL, fd_rng_ulong( rng ) );
+  treap_seed( pool, pack_depth+FD_PACK_INSERT_BATCH_MAX, fd_rng_ulong( rng ) );
   (void)trp_pool_leave( pool );
 
 
@@ -491,6 +540,11 @@ fd_pack_new( void *     mem,
   for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->use_by_bank[i]=use_by_bank + i*(FD_TXN_ACCT_ADDR_MAX*max_txn_per_microblock+1UL);
   for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->use_by_bank_cnt[i]=0UL;
 
+  ulong * staged = (ulong *)_staged;
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->staged[i]         =staged + i*max_txn_per_microblock;
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->staged_cnt[i]     =0UL;
+  for( ulong i=0UL; i<bank_tile_cnt; i++ ) pack->staged_vote_cnt[i]=0UL;
+
   fd_histf_new( pack->txn_per_microblock,  FD_MHIST_MIN( PACK, TOTAL_TRANSACTIONS_PER_MICROBLOCK_COUNT ),
                                            FD_MHIST_MAX( PACK, TOTAL_TRANSACTIONS_PER_MICROBLOCK_COUNT ) );
   fd_histf_new( pack->vote_per_microblock, FD_MHIST_MIN( PACK, VOTES_PER_MICROBLOCK_COUNT ),
@@ -523,7 +577,7 @@ fd_pack_join( void * mem ) {
   int lg_acct_in_trp = fd_ulong_find_msb( fd_ulong_pow2_up( 2UL*max_acct_in_treap  ) );
 
 
-  pack->pool          = trp_pool_join(   FD_SCRATCH_ALLOC_APPEND( l, trp_pool_align(),   trp_pool_footprint ( pack_depth+1UL ) ) );
+  pack->pool          = trp_pool_join(   FD_SCRATCH_ALLOC_APPEND( l, trp_pool_align(),   trp_pool_footprint ( pack_depth+FD_PACK_INSERT_BATCH_MAX ) ) );
   pack->expiration_q  = expq_join    (   FD_SCRATCH_ALLOC_APPEND( l, expq_align(),       expq_footprint     ( pack_depth+1UL ) ) );
   pack->acct_in_use   = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_uses_tbl_sz ) ) );
   pack->writer_costs  = acct_uses_join(  FD_SCRATCH_ALLOC_APPEND( l, acct_uses_align(),  acct_uses_footprint( lg_max_txn     ) ) );
@@ -596,6 +650,40 @@ fd_pack_can_fee_payer_afford( fd_acct_addr_t const * acct_addr,
 
 
 
+/* fd_pack_bitset_acquire returns a bit to represent the account
+   described by q, removing it from bitset_avail, or
+   FD_PACK_BITSET_SLOWPATH if none can be spared for it.  See the
+   comment above FD_PACK_BITSET_HOT_RESERVE. */
+static inline ushort
+fd_pack_bitset_acquire( fd_pack_t                           * pack,
+                        fd_pack_bitset_acct_mapping_t const * q ) {
+  ulong avail = pack->bitset_avail_cnt;
+  int   grant = (avail>FD_PACK_BITSET_HOT_RESERVE) | ((avail>0UL) & (q->write_cnt>=FD_PACK_BITSET_HOT_WRITE_CNT));
+  if( FD_UNLIKELY( !grant ) ) return FD_PACK_BITSET_SLOWPATH;
+  pack->bitset_avail_cnt = avail-1UL;
+  return pack->bitset_avail[ avail ];
+}
+
+/* fd_pack_write_cost_capped returns 1 if the transaction with the
+   specified account addresses and compute estimate writes to an account
+   that has already had so much write cost scheduled in the current
+   block that the transaction can't fit, and 0 otherwise.  The write
+   cost for an account only increases until the next call to
+   fd_pack_end_block, so once this returns 1 for a transaction, it will
+   keep returning 1 until then. */
+static inline int
+fd_pack_write_cost_capped( fd_pack_t            * pack,
+                           fd_txn_t       const * txn,
+                           fd_acct_addr_t const * accts,
+                           ulong                  compute_est ) {
+  for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+      iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+    fd_pack_addr_use_t * in_wcost_table = acct_uses_query( pack->writer_costs, accts[fd_txn_acct_iter_idx( iter )], NULL );
+    if( in_wcost_table && in_wcost_table->total_cost+compute_est > FD_PACK_MAX_WRITE_COST_PER_ACCT ) return 1;
+  }
+  return 0;
+}
+
 fd_txn_p_t * fd_pack_insert_txn_init(   fd_pack_t * pack                   ) { return trp_pool_ele_acquire( pack->pool )->txn; }
 void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { trp_pool_ele_release( pack->pool, (fd_pack_ord_txn_t*)txn ); }
 
@@ -604,20 +692,22 @@ void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn ) { t
                            return FD_PACK_INSERT_REJECT_ ## reason; \
                          } while( 0 )
 
-int
-fd_pack_insert_txn_fini( fd_pack_t  * pack,
-                         fd_txn_p_t * txnp,
-                         ulong        expires_at ) {
+/* fd_pack_insert_estimated_txn does everything fd_pack_insert_txn_fini
+   does after fd_pack_estimate_rewards_and_compute has succeeded for
+   ord.  Returns the same values as fd_pack_insert_txn_fini.  ord is
+   released back to the pool if it is rejected. */
+static int
+fd_pack_insert_estimated_txn( fd_pack_t         * pack,
+                              fd_pack_ord_txn_t * ord,
+                              ulong               expires_at ) {
 
-  fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)txnp;
+  fd_txn_p_t * txnp = ord->txn;
 
   fd_txn_t * txn   = TXN(txnp);
   uchar * payload  = txnp->payload;
 
   fd_acct_addr_t const * accts = fd_txn_get_acct_addrs( txn, payload );
 
-  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) REJECT( ESTIMATION_FAIL );
-
   ord->expires_at = expires_at;
 
   int writes_to_sysvar = 0;
@@ -679,12 +769,17 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
       q->first_instance           = ord;
       q->first_instance_was_write = 1;
       q->bit                      = FD_PACK_BITSET_FIRST_INSTANCE;
-    } else if( FD_UNLIKELY( q->bit == FD_PACK_BITSET_FIRST_INSTANCE ) ) {
-      q->bit = pack->bitset_avail[ pack->bitset_avail_cnt ];
-      pack->bitset_avail_cnt = fd_ulong_if( !!pack->bitset_avail_cnt, pack->bitset_avail_cnt-1UL, 0UL );
-
-      FD_PACK_BITSET_SETN( q->first_instance->rw_bitset, q->bit );
-      if( q->first_instance_was_write ) FD_PACK_BITSET_SETN( q->first_instance->w_bitset, q->bit );
+      q->write_cnt                = (ushort)1;
+    } else {
+      q->write_cnt = (ushort)fd_uint_min( (uint)q->write_cnt+1U, (uint)USHORT_MAX );
+      if( FD_UNLIKELY( q->bit == FD_PACK_BITSET_FIRST_INSTANCE ) ) {
+        q->bit = fd_pack_bitset_acquire( pack, q );
+
+        FD_PACK_BITSET_SETN( q->first_instance->rw_bitset, q->bit );
+        if( q->first_instance_was_write ) FD_PACK_BITSET_SETN( q->first_instance->w_bitset, q->bit );
+      } else if( FD_UNLIKELY( q->bit == FD_PACK_BITSET_SLOWPATH ) ) {
+        q->bit = fd_pack_bitset_acquire( pack, q );
+      }
     }
 
     q->ref_cnt++;
@@ -705,12 +800,14 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
       q->first_instance           = ord;
       q->first_instance_was_write = 0;
       q->bit                      = FD_PACK_BITSET_FIRST_INSTANCE;
+      q->write_cnt                = (ushort)0;
     } else if( FD_UNLIKELY( q->bit == FD_PACK_BITSET_FIRST_INSTANCE ) ) {
-      q->bit = pack->bitset_avail[ pack->bitset_avail_cnt ];
-      pack->bitset_avail_cnt = fd_ulong_if( !!pack->bitset_avail_cnt, pack->bitset_avail_cnt-1UL, 0UL );
+      q->bit = fd_pack_bitset_acquire( pack, q );
 
       FD_PACK_BITSET_SETN( q->first_instance->rw_bitset, q->bit );
       if( q->first_instance_was_write ) FD_PACK_BITSET_SETN( q->first_instance->w_bitset, q->bit );
+    } else if( FD_UNLIKELY( q->bit == FD_PACK_BITSET_SLOWPATH ) ) {
+      q->bit = fd_pack_bitset_acquire( pack, q );
     }
 
     q->ref_cnt++;
@@ -727,29 +824,118 @@ fd_pack_insert_txn_fini( fd_pack_t  * pack,
   if( FD_LIKELY( ord->root == FD_ORD_TXN_ROOT_PENDING_VOTE ) ) {
     treap_ele_insert( pack->pending_votes, ord, pack->pool );
     return replaces ? FD_PACK_INSERT_ACCEPT_VOTE_REPLACE : FD_PACK_INSERT_ACCEPT_VOTE_ADD;
+  } else if( FD_UNLIKELY( fd_pack_write_cost_capped( pack, txn, accts, ord->compute_est ) ) ) {
+    /* It writes to an account that's already at its limit for this
+       block, e.g. during a spike on a single hot account.  Park it
+       until the end of the block rather than making every call to
+       schedule skip over it. */
+    ord->root = FD_ORD_TXN_ROOT_DELAY_END_BLOCK;
+    treap_ele_insert( pack->delay_end_block, ord, pack->pool );
+    return replaces ? FD_PACK_INSERT_ACCEPT_NONVOTE_REPLACE : FD_PACK_INSERT_ACCEPT_NONVOTE_ADD;
   } else {
     treap_ele_insert( pack->pending,       ord, pack->pool );
     return replaces ? FD_PACK_INSERT_ACCEPT_NONVOTE_REPLACE : FD_PACK_INSERT_ACCEPT_NONVOTE_ADD;
   }
 }
+
+int
+fd_pack_insert_txn_fini( fd_pack_t  * pack,
+                         fd_txn_p_t * txnp,
+                         ulong        expires_at ) {
+
+  fd_pack_ord_txn_t * ord = (fd_pack_ord_txn_t *)txnp;
+
+  if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) REJECT( ESTIMATION_FAIL );
+
+  return fd_pack_insert_estimated_txn( pack, ord, expires_at );
+}
 #undef REJECT
 
+void
+fd_pack_insert_txn_batch( fd_pack_t          * pack,
+                          fd_txn_p_t * const * txn,
+                          ulong        const * expires_at,
+                          ulong                cnt,
+                          int                * result ) {
+  fd_pack_sig_to_txn_t          * sig_map    = pack->signature_map;
+  fd_pack_bitset_acct_mapping_t * bitset_map = pack->acct_to_bitset;
+  ulong sig_mask    = sig2txn_key_max   ( sig_map    );
+  ulong bitset_mask = bitset_map_key_max( bitset_map );
+
+  /* First pass: estimate all the transactions, which only touches the
+     transactions themselves, and start pulling in the map slots the
+     second pass will probe for each of them.  By the time the second
+     pass gets to a transaction, the slots it needs have had the rest of
+     the first pass to arrive. */
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_txn_p_t        * txnp = txn[ i ];
+    fd_pack_ord_txn_t * ord  = (fd_pack_ord_txn_t *)txnp;
+    if( FD_UNLIKELY( !fd_pack_estimate_rewards_and_compute( txnp, ord ) ) ) {
+      trp_pool_ele_release( pack->pool, ord );
+      result[ i ] = FD_PACK_INSERT_REJECT_ESTIMATION_FAIL;
+      continue;
+    }
+    result[ i ] = 0;
+
+    fd_txn_t * _txn = TXN(txnp);
+    fd_ed25519_sig_t const * sig   = fd_txn_get_signatures( _txn, txnp->payload );
+    fd_acct_addr_t   const * accts = fd_txn_get_acct_addrs( _txn, txnp->payload );
+    __builtin_prefetch( sig_map + (sig2txn_key_hash( sig ) & sig_mask) );
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( _txn, FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      __builtin_prefetch( bitset_map + (bitset_map_key_hash( accts[ fd_txn_acct_iter_idx( iter ) ] ) & bitset_mask) );
+    }
+  }
+
+  /* Second pass: insert in order, so that the result is the same as
+     calling fini on each of them in turn, including for duplicates
+     within the batch. */
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_UNLIKELY( result[ i ]==FD_PACK_INSERT_REJECT_ESTIMATION_FAIL ) ) continue;
+    result[ i ] = fd_pack_insert_estimated_txn( pack, (fd_pack_ord_txn_t *)txn[ i ], expires_at[ i ] );
+  }
+}
+
+/* sched_lane_t: The scheduling state of one microblock being planned
+   for a specific bank tile.  cu_limit and txn_limit are the remaining
+   budget for the microblock, and are decremented as transactions are
+   staged.  cus_scheduled and txns_scheduled accumulate what was
+   staged. */
 typedef struct {
+  ulong bank_tile;
+  ulong cu_limit;
+  ulong txn_limit;
   ulong cus_scheduled;
   ulong txns_scheduled;
-} sched_return_t;
-
-static inline sched_return_t
-fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
-                                  treap_t    * sched_from,
-                                  int          move_delayed,
-                                  ulong        cu_limit,
-                                  ulong        txn_limit,
-                                  ulong        bank_tile,
-                                  fd_txn_p_t * out ) {
+} sched_lane_t;
+
+#define LANE_FULL( lane ) (((lane)->cu_limit<FD_PACK_MIN_TXN_COST) | ((lane)->txn_limit==0UL))
+
+/* fd_pack_schedule_microblock_impl walks sched_from once from highest
+   to lowest priority and stages transactions into the microblocks
+   described by lanes[0, lane_cnt), filling the lanes in order.  A
+   transaction that doesn't fit in what's left of the current lane goes
+   into the first later lane with enough room, if any.  Since
+   all the lanes will execute concurrently with each other and with any
+   outstanding microblocks, a transaction that conflicts with anything
+   already in use can't go into any lane, so it is considered exactly
+   once per call regardless of lane_cnt.  This is what makes planning
+   several microblocks at once cheaper than scheduling them one at a
+   time under heavy write-lock contention.  *shared_cu_limit bounds the
+   total CUs staged across all lanes and is decremented accordingly. */
+static inline void
+fd_pack_schedule_microblock_impl( fd_pack_t    * pack,
+                                  treap_t      * sched_from,
+                                  int            move_delayed,
+                                  sched_lane_t * lanes,
+                                  ulong          lane_cnt,
+                                  ulong        * shared_cu_limit ) {
   /* With the bitset account representation, it's faster to skip a
      transaction close to 20 times than to move it to the delayed heap
-     and then move it back. */
+     and then move it back.  That doesn't apply to transactions that
+     write to an account that has hit its write cost limit for the
+     block though: they'd be skipped on every call until the end of the
+     block, so those are always moved (see below). */
   move_delayed = 0;
 
   fd_pack_ord_txn_t  * pool         = pack->pool;
@@ -761,22 +947,19 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
   FD_PACK_BITSET_COPY( bitset_rw_in_use, pack->bitset_rw_in_use );
   FD_PACK_BITSET_COPY( bitset_w_in_use,  pack->bitset_w_in_use  );
 
-  fd_pack_addr_use_t * use_by_bank     = pack->use_by_bank    [bank_tile];
-  ulong                use_by_bank_cnt = pack->use_by_bank_cnt[bank_tile];
-
   ulong txns_considered = 0UL;
   ulong txns_scheduled  = 0UL;
-  ulong cus_scheduled   = 0UL;
-
-  ulong bank_tile_mask = 1UL << bank_tile;
 
   ulong fast_path = 0UL;
   ulong slow_path = 0UL;
   ulong cu_limit_c = 0UL;
 
+  ulong lane_idx = 0UL;
+  while( (lane_idx<lane_cnt) && LANE_FULL( lanes+lane_idx ) ) lane_idx++;
+
   treap_rev_iter_t prev;
   for( treap_rev_iter_t _cur=treap_rev_iter_init( sched_from, pool );
-      (cu_limit>=FD_PACK_MIN_TXN_COST) & (txn_limit>0) & !treap_rev_iter_done( _cur ); _cur=prev ) {
+      (*shared_cu_limit>=FD_PACK_MIN_TXN_COST) & (lane_idx<lane_cnt) & !treap_rev_iter_done( _cur ); _cur=prev ) {
     prev = treap_rev_iter_next( _cur, pool );
 
     txns_considered++;
@@ -786,16 +969,25 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
     fd_txn_t * txn = TXN(cur->txn);
     fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, cur->txn->payload );
 
-    ulong conflicts = 0UL;
-    int   delay_end_block = 0;
+    /* Lanes fill in order, but a transaction too big for what's left
+       of the current lane can still go into a later one that has the
+       room. */
+    ulong fit_idx = lane_idx;
+    while( (fit_idx<lane_cnt) && (LANE_FULL( lanes+fit_idx ) || (cur->compute_est>lanes[ fit_idx ].cu_limit)) ) fit_idx++;
 
-    if( FD_UNLIKELY( cur->compute_est>cu_limit ) ) {
+    if( FD_UNLIKELY( (fit_idx==lane_cnt) || (cur->compute_est>*shared_cu_limit) ) ) {
       /* Too big to be scheduled at the moment, but might be okay for
          the next microblock, so we don't want to delay it. */
       cu_limit_c++;
       continue;
     }
 
+    sched_lane_t * lane = lanes+fit_idx;
+    ulong bank_tile_mask = 1UL << lane->bank_tile;
+
+    ulong conflicts = 0UL;
+    int   delay_end_block = 0;
+
     if( FD_UNLIKELY( txn->addr_table_adtl_cnt>0UL ) ) {
       /* This transaction reads or writes to additional accounts from
          an address lookup table.  We don't yet know what they are
@@ -846,21 +1038,21 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
     }
 
     if( conflicts==0UL ) {
-      /* Include this transaction in the microblock! */
+      /* Include this transaction in the microblock!  It gets staged
+         here and copied out by fd_pack_pop_staged. */
+      ulong bank_tile = lane->bank_tile;
       txns_scheduled++;
-      cus_scheduled += cur->compute_est;
-      cu_limit -= cur->compute_est;
-      txn_limit--;
+      lane->txns_scheduled++;
+      lane->cus_scheduled += cur->compute_est;
+      lane->cu_limit      -= cur->compute_est;
+      lane->txn_limit--;
+      *shared_cu_limit    -= cur->compute_est;
 
       FD_PACK_BITSET_OR( bitset_rw_in_use, cur->rw_bitset );
       FD_PACK_BITSET_OR( bitset_w_in_use,  cur->w_bitset  );
 
-      fd_memcpy( out->payload, cur->txn->payload, cur->txn->payload_sz                                           );
-      fd_memcpy( TXN(out),     txn,               fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
-      out->payload_sz = cur->txn->payload_sz;
-      out->meta       = cur->txn->meta;
-      out->flags      = cur->txn->flags;
-      out++;
+      fd_pack_addr_use_t * use_by_bank     = pack->use_by_bank    [bank_tile];
+      ulong                use_by_bank_cnt = pack->use_by_bank_cnt[bank_tile];
 
       for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
           iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
@@ -874,21 +1066,6 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
         use->in_use_by = bank_tile_mask | FD_PACK_IN_USE_WRITABLE;
 
         use_by_bank[use_by_bank_cnt++] = *use;
-
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
-        if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
-          ushort bit = q->bit;
-          bitset_map_remove( pack->acct_to_bitset, q );
-          /* There aren't any more references to this transaction in the
-             heap, so it can't cause any conflicts.  That means we
-             actually don't need to record that we are using it, which
-             is good because we want to release the bit. */
-          FD_PACK_BITSET_CLEARN( bitset_rw_in_use, bit );
-          FD_PACK_BITSET_CLEARN( bitset_w_in_use,  bit );
-
-          use->in_use_by |= FD_PACK_IN_USE_BIT_CLEARED;
-          if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
-        }
       }
       for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
           iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
@@ -901,30 +1078,22 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
         if( !use ) { use = acct_uses_insert( acct_in_use, acct_addr ); use->in_use_by = 0UL; }
 
         if( !(use->in_use_by & bank_tile_mask) ) use_by_bank[use_by_bank_cnt++] = *use;
-        use->in_use_by |= bank_tile_mask;
-
-        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
-        if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
-          ushort bit = q->bit;
-          bitset_map_remove( pack->acct_to_bitset, q );
-          FD_PACK_BITSET_CLEARN( bitset_rw_in_use, bit );
-
-          use->in_use_by |= FD_PACK_IN_USE_BIT_CLEARED;
-          if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
-        }
+        /* This transaction holds a reference to the account, so its
+           bitset mapping is live and its bit is now set again.  See
+           fd_pack_microblock_complete. */
+        use->in_use_by = (use->in_use_by | bank_tile_mask) & ~FD_PACK_IN_USE_BIT_CLEARED;
       }
+      pack->use_by_bank_cnt[bank_tile] = use_by_bank_cnt;
 
-      fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
-
-      fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
-      sig2txn_remove( pack->signature_map, in_tbl );
-
-      expq_remove( pack->expiration_q, cur->expq_idx );
       treap_ele_remove( sched_from, cur, pool );
-      trp_pool_ele_release( pool, cur );
-      pack->pending_txn_cnt--;
+      cur->root = FD_ORD_TXN_ROOT_STAGED_BASE + (int)bank_tile;
+      pack->staged[ bank_tile ][ pack->staged_cnt[ bank_tile ]++ ] = trp_pool_idx( pool, cur );
+
+      while( (lane_idx<lane_cnt) && LANE_FULL( lanes+lane_idx ) ) lane_idx++;
 
-    } else if( move_delayed ) {
+    } else if( move_delayed | (delay_end_block & (cur->root==FD_ORD_TXN_ROOT_PENDING)) ) {
+      /* Votes stay where they are since fd_pack_end_block merges
+         delay_end_block into pending, not pending_votes. */
       /* TODO: it would be better if this took a random set bit, but I
          don't know any bit twiddling tricks to get it. */
       int r = fd_ulong_find_lsb( conflicts );
@@ -944,17 +1113,201 @@ fd_pack_schedule_microblock_impl( fd_pack_t  * pack,
   (void)slow_path;
 #endif
 
-  pack->use_by_bank_cnt[bank_tile] = use_by_bank_cnt;
   FD_PACK_BITSET_COPY( pack->bitset_rw_in_use, bitset_rw_in_use );
   FD_PACK_BITSET_COPY( pack->bitset_w_in_use,  bitset_w_in_use  );
+}
+
+/* fd_pack_plan_lanes plans one microblock for each of the lane_cnt bank
+   tiles in bank_tile[], sharing a single pass over each treap between
+   all of them.  Each microblock is subject to the same total_cus and
+   vote_fraction limits that fd_pack_schedule_next_microblock applies
+   to a single microblock, and the block-wide limits are applied across
+   the set.  The caller must ensure none of the bank tiles already have
+   staged transactions and that lane_cnt does not exceed the remaining
+   microblock budget for the block. */
+static void
+fd_pack_plan_lanes( fd_pack_t   * pack,
+                    ulong         total_cus,
+                    float         vote_fraction,
+                    ulong const * bank_tile,
+                    ulong         lane_cnt ) {
+  sched_lane_t nonvote[ FD_PACK_MAX_BANK_TILES ];
+  sched_lane_t vote   [ FD_PACK_MAX_BANK_TILES ];
+
+  /* TODO: Decide if these are exactly how we want to handle limits */
+  ulong block_cus = FD_PACK_MAX_COST_PER_BLOCK      - pack->cumulative_block_cost;
+  ulong vote_cus  = FD_PACK_MAX_VOTE_COST_PER_BLOCK - pack->cumulative_vote_cost;
+
+  total_cus = fd_ulong_min( total_cus, block_cus );
+  ulong lane_vote_cus = fd_ulong_min( (ulong)((float)total_cus * vote_fraction), vote_cus );
+  ulong vote_reserved_txns = fd_ulong_min( lane_vote_cus/FD_PACK_TYPICAL_VOTE_COST,
+                                           (ulong)((float)pack->max_txn_per_microblock * vote_fraction) );
+
+  for( ulong i=0UL; i<lane_cnt; i++ ) {
+    nonvote[ i ] = (sched_lane_t){ .bank_tile = bank_tile[ i ],
+                                   .cu_limit  = total_cus - lane_vote_cus,
+                                   .txn_limit = pack->max_txn_per_microblock - vote_reserved_txns };
+    vote   [ i ] = (sched_lane_t){ .bank_tile = bank_tile[ i ],
+                                   .cu_limit  = lane_vote_cus,
+                                   .txn_limit = vote_reserved_txns };
+  }
 
-  sched_return_t to_return = { .cus_scheduled = cus_scheduled, .txns_scheduled = txns_scheduled };
-  return to_return;
+  /* Try to schedule non-vote transactions */
+  fd_pack_schedule_microblock_impl( pack, pack->pending,       1, nonvote, lane_cnt, &block_cus );
+
+  /* Schedule vote transactions */
+  ulong shared_vote_cus = fd_ulong_min( block_cus, vote_cus );
+  ulong pre_vote_cus    = shared_vote_cus;
+  fd_pack_schedule_microblock_impl( pack, pack->pending_votes, 0, vote,    lane_cnt, &shared_vote_cus );
+  block_cus -= pre_vote_cus - shared_vote_cus;
+  pack->cumulative_vote_cost += pre_vote_cus - shared_vote_cus;
+
+  /* Add any remaining CUs/txns to the non-vote limits */
+  for( ulong i=0UL; i<lane_cnt; i++ ) {
+    nonvote[ i ].cu_limit  += vote[ i ].cu_limit;
+    nonvote[ i ].txn_limit += vote[ i ].txn_limit;
+  }
+
+  /* Fill any remaining space with non-vote transactions */
+  fd_pack_schedule_microblock_impl( pack, pack->pending,       1, nonvote, lane_cnt, &block_cus );
+
+  pack->cumulative_block_cost = FD_PACK_MAX_COST_PER_BLOCK - block_cus;
+
+  for( ulong i=0UL; i<lane_cnt; i++ ) {
+    pack->staged_vote_cnt[ bank_tile[ i ] ] = vote[ i ].txns_scheduled;
+    pack->outstanding_microblock_mask |= 1UL << bank_tile[ i ];
+  }
+}
+
+/* fd_pack_pop_staged copies the transactions staged for bank_tile to
+   out, releases their references to accounts, and frees them.  Returns
+   the number of transactions copied. */
+static ulong
+fd_pack_pop_staged( fd_pack_t  * pack,
+                    ulong        bank_tile,
+                    fd_txn_p_t * out ) {
+  fd_pack_ord_txn_t * pool       = pack->pool;
+  ulong const       * staged     = pack->staged    [ bank_tile ];
+  ulong               staged_cnt = pack->staged_cnt[ bank_tile ];
+
+  FD_PACK_BITSET_DECLARE( bitset_rw_in_use );
+  FD_PACK_BITSET_DECLARE( bitset_w_in_use  );
+  FD_PACK_BITSET_COPY( bitset_rw_in_use, pack->bitset_rw_in_use );
+  FD_PACK_BITSET_COPY( bitset_w_in_use,  pack->bitset_w_in_use  );
+
+  for( ulong j=0UL; j<staged_cnt; j++ ) {
+    fd_pack_ord_txn_t * cur = trp_pool_ele( pool, staged[ j ] );
+
+    fd_txn_t * txn = TXN(cur->txn);
+    fd_acct_addr_t const * acct = fd_txn_get_acct_addrs( txn, cur->txn->payload );
+
+    fd_memcpy( out->payload, cur->txn->payload, cur->txn->payload_sz                                           );
+    fd_memcpy( TXN(out),     txn,               fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+    out->payload_sz = cur->txn->payload_sz;
+    out->meta       = cur->txn->meta;
+    out->flags      = cur->txn->flags;
+    out++;
+
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_WRITABLE & FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+      fd_acct_addr_t acct_addr = acct[fd_txn_acct_iter_idx( iter )];
+
+      fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
+      if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
+        ushort bit = q->bit;
+        bitset_map_remove( pack->acct_to_bitset, q );
+        /* There aren't any more references to this transaction in the
+           heap, so it can't cause any conflicts.  That means we
+           actually don't need to record that we are using it, which
+           is good because we want to release the bit. */
+        FD_PACK_BITSET_CLEARN( bitset_rw_in_use, bit );
+        FD_PACK_BITSET_CLEARN( bitset_w_in_use,  bit );
+
+        fd_pack_addr_use_t * use = acct_uses_query( pack->acct_in_use, acct_addr, NULL );
+        use->in_use_by |= FD_PACK_IN_USE_BIT_CLEARED;
+        if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
+      }
+    }
+    for( fd_txn_acct_iter_t iter=fd_txn_acct_iter_init( txn, FD_TXN_ACCT_CAT_READONLY & FD_TXN_ACCT_CAT_IMM );
+        iter!=fd_txn_acct_iter_end(); iter=fd_txn_acct_iter_next( iter ) ) {
+
+      fd_acct_addr_t acct_addr = acct[fd_txn_acct_iter_idx( iter )];
+
+      if( fd_pack_unwritable_contains( &acct_addr ) ) continue; /* No need to track sysvars because they can't be writable */
+
+      fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, acct_addr, NULL );
+      if( FD_UNLIKELY( !(--q->ref_cnt) ) ) {
+        ushort bit = q->bit;
+        bitset_map_remove( pack->acct_to_bitset, q );
+        FD_PACK_BITSET_CLEARN( bitset_rw_in_use, bit );
+
+        fd_pack_addr_use_t * use = acct_uses_query( pack->acct_in_use, acct_addr, NULL );
+        use->in_use_by |= FD_PACK_IN_USE_BIT_CLEARED;
+        if( FD_LIKELY( bit<FD_PACK_BITSET_MAX ) ) pack->bitset_avail[ ++(pack->bitset_avail_cnt) ] = bit;
+      }
+    }
+
+    fd_ed25519_sig_t const * sig0 = fd_txn_get_signatures( txn, cur->txn->payload );
+
+    fd_pack_sig_to_txn_t * in_tbl = sig2txn_query( pack->signature_map, sig0, NULL );
+    sig2txn_remove( pack->signature_map, in_tbl );
+
+    expq_remove( pack->expiration_q, cur->expq_idx );
+    cur->root = FD_ORD_TXN_ROOT_FREE;
+    trp_pool_ele_release( pool, cur );
+    pack->pending_txn_cnt--;
+  }
+
+  FD_PACK_BITSET_COPY( pack->bitset_rw_in_use, bitset_rw_in_use );
+  FD_PACK_BITSET_COPY( pack->bitset_w_in_use,  bitset_w_in_use  );
+
+  pack->staged_cnt[ bank_tile ] = 0UL;
+  pack->microblock_cnt += (ulong)(staged_cnt>0UL);
+  return staged_cnt;
+}
+
+/* fd_pack_microblocks_left returns how many more microblocks can be
+   planned in this block, counting the ones that are staged but not yet
+   returned as already used. */
+static inline ulong
+fd_pack_microblocks_left( fd_pack_t const * pack ) {
+  ulong used = pack->microblock_cnt;
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) used += (ulong)(pack->staged_cnt[ i ]>0UL);
+  return pack->max_microblocks_per_block - fd_ulong_min( used, pack->max_microblocks_per_block );
+}
+
+/* fd_pack_unstage returns all the staged transactions to the treaps
+   they came from.  Their account uses and costs are not unwound, so
+   this is only appropriate when those are about to be reset anyway, as
+   in fd_pack_end_block.  Staged microblocks haven't been counted in
+   microblock_cnt yet, and the bank tiles they were planned for never
+   got them, so those bank tiles are no longer outstanding. */
+static void
+fd_pack_unstage( fd_pack_t * pack ) {
+  fd_pack_ord_txn_t * pool = pack->pool;
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) {
+    for( ulong j=0UL; j<pack->staged_cnt[ i ]; j++ ) {
+      fd_pack_ord_txn_t * cur = trp_pool_ele( pool, pack->staged[ i ][ j ] );
+      int is_vote = !!(cur->txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE);
+      cur->root = fd_int_if( is_vote, FD_ORD_TXN_ROOT_PENDING_VOTE, FD_ORD_TXN_ROOT_PENDING );
+      treap_ele_insert( fd_ptr_if( is_vote, (treap_t*)pack->pending_votes, (treap_t*)pack->pending ), cur, pool );
+    }
+    if( pack->staged_cnt[ i ] ) pack->outstanding_microblock_mask &= ~(1UL<<i);
+    pack->staged_cnt     [ i ] = 0UL;
+    pack->staged_vote_cnt[ i ] = 0UL;
+  }
 }
 
 void
 fd_pack_microblock_complete( fd_pack_t * pack,
                              ulong       bank_tile ) {
+  /* If the bank tile has a staged microblock, the bank tile was idle
+     when it was planned, and the staged microblock hasn't been returned
+     by fd_pack_schedule_next_microblock yet, so there's nothing to
+     complete.  The account uses recorded in use_by_bank belong to the
+     staged microblock and must not be released. */
+  if( FD_UNLIKELY( pack->staged_cnt[ bank_tile ] ) ) return;
+
   /* Move all the transactions that were delayed until now back into
      pending so they'll be reconsidered. */
   treap_merge( pack->pending, pack->conflicting_with + bank_tile, pack->pool );
@@ -1003,15 +1356,23 @@ fd_pack_microblock_complete( fd_pack_t * pack,
        bits.  If, on the other hand, the microblock scheduled to bank 1
        completes first, bits 0 and 1 will be cleared for accounts C and
        D, while bits 2 and 3 will remain set, which is correct.  Then
-       when bank 0 completes, bits 2 and 3 will be cleared. */
-    if( FD_LIKELY( !use->in_use_by ) ) { /* if in_use_by==0, doesn't include BIT_CLEARED */
-      fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, base[i].key, NULL );
-      FD_TEST( q );
-      FD_PACK_BITSET_CLEARN( bitset_w_in_use,  q->bit );
-      FD_PACK_BITSET_CLEARN( bitset_rw_in_use, q->bit );
+       when bank 0 completes, bits 2 and 3 will be cleared.
+
+       BIT_CLEARED is only unset by scheduling another transaction that
+       uses the account, never by a completion, so if an account is read
+       by microblocks on two banks and the second one to be scheduled
+       releases the last reference, BIT_CLEARED is still set when the
+       last of them completes, even though the account is no longer in
+       the bitset map. */
+    if( FD_LIKELY( !(use->in_use_by & ~FD_PACK_IN_USE_BIT_CLEARED) ) ) {
+      if( FD_LIKELY( !use->in_use_by ) ) { /* if in_use_by==0, doesn't include BIT_CLEARED */
+        fd_pack_bitset_acct_mapping_t * q = bitset_map_query( pack->acct_to_bitset, base[i].key, NULL );
+        FD_TEST( q );
+        FD_PACK_BITSET_CLEARN( bitset_w_in_use,  q->bit );
+        FD_PACK_BITSET_CLEARN( bitset_rw_in_use, q->bit );
+      }
+      acct_uses_remove( pack->acct_in_use, use );
     }
-    use->in_use_by &= ~FD_PACK_IN_USE_BIT_CLEARED;
-    if( FD_LIKELY( !use->in_use_by ) ) acct_uses_remove( pack->acct_in_use, use );
   }
 
   pack->use_by_bank_cnt[bank_tile] = 0UL;
@@ -1032,62 +1393,62 @@ fd_pack_schedule_next_microblock( fd_pack_t *  pack,
                                   ulong        bank_tile,
                                   fd_txn_p_t * out ) {
 
-  /* TODO: Decide if these are exactly how we want to handle limits */
-  total_cus = fd_ulong_min( total_cus, FD_PACK_MAX_COST_PER_BLOCK - pack->cumulative_block_cost );
-  ulong vote_cus = fd_ulong_min( (ulong)((float)total_cus * vote_fraction), FD_PACK_MAX_VOTE_COST_PER_BLOCK - pack->cumulative_vote_cost );
-  ulong vote_reserved_txns = fd_ulong_min( vote_cus/FD_PACK_TYPICAL_VOTE_COST,
-                                           (ulong)((float)pack->max_txn_per_microblock * vote_fraction) );
-
-  if( FD_UNLIKELY( pack->microblock_cnt >= pack->max_microblocks_per_block ) ) {
-    FD_MCNT_INC( PACK, MICROBLOCK_PER_BLOCK_LIMIT, 1UL );
-    return 0UL;
+  if( FD_LIKELY( !pack->staged_cnt[ bank_tile ] ) ) {
+    /* Nothing planned ahead for this bank tile, so plan a single
+       microblock now. */
+    if( FD_UNLIKELY( !fd_pack_microblocks_left( pack ) ) ) {
+      FD_MCNT_INC( PACK, MICROBLOCK_PER_BLOCK_LIMIT, 1UL );
+      return 0UL;
+    }
+    fd_pack_plan_lanes( pack, total_cus, vote_fraction, &bank_tile, 1UL );
   }
 
-  ulong cu_limit  = total_cus - vote_cus;
-  ulong txn_limit = pack->max_txn_per_microblock - vote_reserved_txns;
-  ulong scheduled = 0UL;
-
-  sched_return_t status, status1;
-
-  /* Try to schedule non-vote transactions */
-  status = fd_pack_schedule_microblock_impl( pack, pack->pending,       1, cu_limit, txn_limit,          bank_tile, out+scheduled );
-
-  scheduled += status.txns_scheduled;
-  txn_limit -= status.txns_scheduled;
-  cu_limit  -= status.cus_scheduled;
-  pack->cumulative_block_cost += status.cus_scheduled;
-
+  ulong vote_scheduled = pack->staged_vote_cnt[ bank_tile ];
+  ulong scheduled      = fd_pack_pop_staged( pack, bank_tile, out );
 
-  /* Schedule vote transactions */
-  status1= fd_pack_schedule_microblock_impl( pack, pack->pending_votes, 0, vote_cus, vote_reserved_txns, bank_tile, out+scheduled );
-
-  scheduled                   += status1.txns_scheduled;
-  pack->cumulative_vote_cost  += status1.cus_scheduled;
-  pack->cumulative_block_cost += status1.cus_scheduled;
-  /* Add any remaining CUs/txns to the non-vote limits */
-  txn_limit += vote_reserved_txns - status1.txns_scheduled;
-  cu_limit  += vote_cus - status1.cus_scheduled;
-
-
-  /* Fill any remaining space with non-vote transactions */
-  status = fd_pack_schedule_microblock_impl( pack, pack->pending,       1, cu_limit, txn_limit,          bank_tile, out+scheduled );
-
-  scheduled                   += status.txns_scheduled;
-  pack->cumulative_block_cost += status.cus_scheduled;
-
-  pack->microblock_cnt += (ulong)(scheduled>0UL);
   pack->outstanding_microblock_mask |= 1UL << bank_tile;
 
   /* Update metrics counters */
   FD_MGAUGE_SET( PACK, AVAILABLE_TRANSACTIONS,      pack->pending_txn_cnt                );
   FD_MGAUGE_SET( PACK, AVAILABLE_VOTE_TRANSACTIONS, treap_ele_cnt( pack->pending_votes ) );
 
-  fd_histf_sample( pack->txn_per_microblock,  scheduled              );
-  fd_histf_sample( pack->vote_per_microblock, status1.txns_scheduled );
+  fd_histf_sample( pack->txn_per_microblock,  scheduled      );
+  fd_histf_sample( pack->vote_per_microblock, vote_scheduled );
 
   return scheduled;
 }
 
+ulong
+fd_pack_schedule_lookahead( fd_pack_t * pack,
+                            ulong       total_cus,
+                            float       vote_fraction,
+                            ulong       bank_tile_mask ) {
+  ulong bank_tile[ FD_PACK_MAX_BANK_TILES ];
+  ulong lane_cnt = 0UL;
+
+  /* Only bank tiles that are idle and that don't already have a staged
+     microblock are eligible. */
+  bank_tile_mask &= fd_ulong_mask_lsb( (int)pack->bank_tile_cnt ) & ~pack->outstanding_microblock_mask;
+  ulong microblocks_left = fd_pack_microblocks_left( pack );
+
+  for( ulong m=bank_tile_mask; m; m=fd_ulong_pop_lsb( m ) ) {
+    ulong i = (ulong)fd_ulong_find_lsb( m );
+    if( FD_UNLIKELY( pack->staged_cnt[ i ] ) ) continue;
+    if( FD_UNLIKELY( lane_cnt>=microblocks_left ) ) {
+      FD_MCNT_INC( PACK, MICROBLOCK_PER_BLOCK_LIMIT, 1UL );
+      break;
+    }
+    bank_tile[ lane_cnt++ ] = i;
+  }
+  if( FD_UNLIKELY( !lane_cnt ) ) return 0UL;
+
+  fd_pack_plan_lanes( pack, total_cus, vote_fraction, bank_tile, lane_cnt );
+
+  ulong planned_cnt = 0UL;
+  for( ulong i=0UL; i<lane_cnt; i++ ) planned_cnt += (ulong)(pack->staged_cnt[ bank_tile[ i ] ]>0UL);
+  return planned_cnt;
+}
+
 ulong fd_pack_avail_txn_cnt( fd_pack_t * pack ) { return pack->pending_txn_cnt; }
 ulong fd_pack_bank_tile_cnt( fd_pack_t * pack ) { return pack->bank_tile_cnt;   }
 
@@ -1116,7 +1477,20 @@ fd_pack_end_block( fd_pack_t * pack ) {
   pack->cumulative_block_cost = 0UL;
   pack->cumulative_vote_cost  = 0UL;
 
+  /* Microblocks that were planned but not yet returned now belong to
+     the next block, so put their transactions back.  The accounts they
+     were holding are released below. */
+  fd_pack_unstage( pack );
+
   for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) treap_merge( pack->pending, pack->conflicting_with+i, pack->pool );
+
+  /* Transactions parked because of the write cost limit are about to
+     be in pending, and delete_transaction relies on root to find them
+     there. */
+  for( treap_fwd_iter_t it=treap_fwd_iter_init( pack->delay_end_block, pack->pool ); !treap_fwd_iter_done( it );
+      it=treap_fwd_iter_next( it, pack->pool ) ) {
+    treap_fwd_iter_ele( it, pack->pool )->root = FD_ORD_TXN_ROOT_PENDING;
+  }
   treap_merge( pack->pending, pack->delay_end_block, pack->pool );
 
   acct_uses_clear( pack->acct_in_use  );
@@ -1159,6 +1533,11 @@ fd_pack_clear_all( fd_pack_t * pack ) {
   release_tree( pack->pending_votes,   pack->pool );
   release_tree( pack->delay_end_block, pack->pool );
   for( ulong i=0UL; i<FD_PACK_MAX_BANK_TILES; i++ ) { release_tree( pack->conflicting_with+i, pack->pool ); }
+  for( ulong i=0UL; i<pack->bank_tile_cnt; i++ ) {
+    for( ulong j=0UL; j<pack->staged_cnt[i]; j++ ) trp_pool_idx_release( pack->pool, pack->staged[i][j] );
+    pack->staged_cnt     [i] = 0UL;
+    pack->staged_vote_cnt[i] = 0UL;
+  }
 
   expq_remove_all( pack->expiration_q );
 
@@ -1196,7 +1575,22 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
     case FD_ORD_TXN_ROOT_PENDING:          root = pack->pending;                                                     break;
     case FD_ORD_TXN_ROOT_PENDING_VOTE:     root = pack->pending_votes;                                               break;
     case FD_ORD_TXN_ROOT_DELAY_END_BLOCK:  root = pack->delay_end_block;                                             break;
-    default:                               root = pack->conflicting_with+(root_idx-FD_ORD_TXN_ROOT_DELAY_BANK_BASE); break;
+    default:
+      if( FD_LIKELY( root_idx<FD_ORD_TXN_ROOT_STAGED_BASE ) ) { root = pack->conflicting_with+(root_idx-FD_ORD_TXN_ROOT_DELAY_BANK_BASE); break; }
+      /* The transaction is staged in a microblock that hasn't been
+         returned yet.  Drop it from the microblock.  The accounts it
+         would have used stay marked as in use until the microblock
+         completes, which is conservative but harmless. */
+      ulong   bank_tile = (ulong)(root_idx-FD_ORD_TXN_ROOT_STAGED_BASE);
+      ulong * staged    = pack->staged[ bank_tile ];
+      ulong   cnt       = pack->staged_cnt[ bank_tile ];
+      ulong   idx       = trp_pool_idx( pack->pool, containing );
+      ulong   j         = 0UL;
+      while( staged[ j ]!=idx ) j++;
+      for( ; j+1UL<cnt; j++ ) staged[ j ] = staged[ j+1UL ];
+      pack->staged_cnt[ bank_tile ] = cnt-1UL;
+      pack->staged_vote_cnt[ bank_tile ] -= (ulong)!!(containing->txn->flags & FD_TXN_P_FLAGS_IS_SIMPLE_VOTE);
+      break;
   }
 
   fd_txn_t * _txn = TXN( containing->txn );
@@ -1246,7 +1640,7 @@ fd_pack_delete_transaction( fd_pack_t              * pack,
     }
   }
   expq_remove( pack->expiration_q, containing->expq_idx );
-  treap_ele_remove( root, containing, pack->pool );
+  if( FD_LIKELY( root ) ) treap_ele_remove( root, containing, pack->pool );
   trp_pool_ele_release( pack->pool, containing );
   sig2txn_remove( pack->signature_map, in_tbl );
   pack->pending_txn_cnt--;
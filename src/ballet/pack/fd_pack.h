@@ -159,8 +159,11 @@ FD_FN_PURE ulong fd_pack_bank_tile_cnt( fd_pack_t * pack );
    finalizes the transaction insert process and makes the newly-inserted
    transaction available for scheduling.  Calling
    fd_pack_insert_txn_cancel aborts the transaction insertion process.
-   The txn pointer passed to _fini or _cancel must come from the most
-   recent call to _init.
+   The txn pointer passed to _fini or _cancel must come from a call to
+   _init that hasn't yet been paired.  At most FD_PACK_INSERT_BATCH_MAX
+   calls to _init may be outstanding (i.e. not yet paired) at any time,
+   so that a batch of transactions can be staged and then passed to
+   fd_pack_insert_txn_batch.
 
    The caller of these methods should not retain any read or write
    interest in the transaction after _fini or _cancel have been called.
@@ -182,6 +185,26 @@ fd_txn_p_t * fd_pack_insert_txn_init  ( fd_pack_t * pack
 int          fd_pack_insert_txn_fini  ( fd_pack_t * pack, fd_txn_p_t * txn, ulong expires_at );
 void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn                   );
 
+#define FD_PACK_INSERT_BATCH_MAX (64UL)
+
+/* fd_pack_insert_txn_batch is equivalent to calling
+   fd_pack_insert_txn_fini( pack, txn[i], expires_at[i] ) for each i in
+   [0, cnt) in order and storing the return value in result[i], but is
+   faster when cnt is more than a few.  Each txn[i] must come from a
+   distinct outstanding call to fd_pack_insert_txn_init, and cnt must be
+   in [0, FD_PACK_INSERT_BATCH_MAX].
+
+   The speedup comes from estimating all the transactions in one pass
+   and prefetching the hash map slots they'll need before any of them
+   are inserted, so the cache misses overlap rather than happening one
+   at a time. */
+void
+fd_pack_insert_txn_batch( fd_pack_t          * pack,
+                          fd_txn_p_t * const * txn,
+                          ulong        const * expires_at,
+                          ulong                cnt,
+                          int                * result );
+
 
 /* fd_pack_schedule_next_microblock schedules transactions to form a
    microblock, which is a set of non-conflicting transactions.
@@ -198,10 +221,42 @@ void         fd_pack_insert_txn_cancel( fd_pack_t * pack, fd_txn_p_t * txn
 
    Returns the number of transactions in the scheduled microblock.  The
    return value may be 0 if there are no eligible transactions at the
-   moment. */
+   moment.
+
+   If a microblock was previously planned for bank_tile by
+   fd_pack_schedule_lookahead, that microblock is returned instead of
+   scheduling a new one, and total_cus and vote_fraction are ignored. */
 
 ulong fd_pack_schedule_next_microblock( fd_pack_t * pack, ulong total_cus, float vote_fraction, ulong bank_tile, fd_txn_p_t * out );
 
+/* fd_pack_schedule_lookahead plans the next microblock for several
+   bank tiles at once.  For each bank tile i in [0, bank_tile_cnt) with
+   bit i set in bank_tile_mask that is idle (i.e. its previous
+   microblock, if any, has been completed with
+   fd_pack_microblock_complete) and doesn't already have a planned
+   microblock, a microblock is planned subject to the same total_cus
+   and vote_fraction limits as fd_pack_schedule_next_microblock.  The
+   planned microblocks don't conflict with each other or with any
+   outstanding microblock.
+
+   All the microblocks are planned in a single pass over the pending
+   transactions, so a high priority transaction that conflicts with
+   something in use is only examined once instead of once per bank
+   tile.  Subsequent calls to fd_pack_schedule_next_microblock for those
+   bank tiles just copy out the planned microblock.  Until then, the
+   bank tile counts as busy, and fd_pack_microblock_complete for it is a
+   no-op.  Planned microblocks that haven't been returned when
+   fd_pack_end_block is called are dissolved and their transactions
+   become available again.  Planned transactions can still be deleted
+   or expired.  A planned microblock counts against the limit on
+   microblocks per block, but is only counted as generated once it is
+   returned by fd_pack_schedule_next_microblock.
+
+   Returns the number of bank tiles for which a non-empty microblock was
+   planned. */
+
+ulong fd_pack_schedule_lookahead( fd_pack_t * pack, ulong total_cus, float vote_fraction, ulong bank_tile_mask );
+
 
 /* fd_pack_microblock_complete signals that the bank_tile with index
    bank_tile has completed its previously scheduled microblock.  This
@@ -618,6 +618,112 @@ void performance_test( int extra_bench ) {
 }
 
 
+/* contention_test measures insert and schedule throughput on a
+   workload that looks more like mainnet than the one in
+   performance_test: every transaction write-locks one of a small set of
+   hot accounts, chosen with a skewed distribution, and reads two
+   accounts from a pool large enough that the cold accounts alone would
+   use up every bit in the bitset.  The pack object is never reset;
+   each round drains it halfway onto 4 bank tiles and refills it, and
+   the set of hot accounts changes every round, so the accounts that
+   matter most are always the ones that show up after the bitset has
+   filled. */
+static void
+contention_test( int extra_bench ) {
+  FD_LOG_NOTICE(( "TEST CONTENTION" ));
+
+#define HOT_CNT   64UL
+#define BANK_CNT   4UL
+#define ROUND_CNT 32UL
+#define WARMUP     4UL
+  /* 1 signer, 1 writable, 2 programs, 2 readonly */
+  make_transaction( 0UL, 500U, 12.0, "A", "BC" );
+  ulong const signer_off = 1UL+FD_TXN_SIGNATURE_SZ;
+  ulong const hot_off    = signer_off + FD_TXN_ACCT_ADDR_SZ;
+  ulong const cold_off   = hot_off    + 3UL*FD_TXN_ACCT_ADDR_SZ;
+
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( FD_SHMEM_GIGANTIC_PAGE_SZ, 1UL, 0UL, "test_pack", 0UL );
+  ulong max_heap_sz = fd_ulong_if( (!!wksp) & extra_bench, 16384UL, 4096UL );
+
+  FD_LOG_NOTICE(( "All columns in units ns/txn except depth and Txn/mblk" ));
+  FD_LOG_NOTICE(( "Depth\tInsert\tSchedule\tTxn/mblk" ));
+
+  for( ulong heap_sz=1024UL; heap_sz<=max_heap_sz; heap_sz*=2UL ) {
+    ulong footprint = fd_pack_footprint( heap_sz, BANK_CNT, 31UL );
+    void * _mem;
+    if( FD_LIKELY( wksp ) ) _mem = fd_wksp_alloc_laddr( wksp, fd_pack_align(), footprint, 4UL );
+    else                    { FD_TEST( footprint<PACK_SCRATCH_SZ ); _mem = pack_scratch; }
+
+    fd_pack_t * pack = fd_pack_join( fd_pack_new( _mem, heap_sz, BANK_CNT, 31UL, ULONG_MAX, rng ) );
+
+    /* Each cold account is referenced by about 4 pending transactions */
+    ulong cold_cnt = heap_sz/2UL;
+
+    long  insert    = 0L;
+    long  schedule  = 0L;
+    ulong ins_cnt   = 0UL;
+    ulong sched_cnt = 0UL;
+    ulong mblk_cnt  = 0UL;
+    ulong sig       = 0UL;
+
+    for( ulong round=0UL; round<ROUND_CNT; round++ ) {
+      int measure = round>=WARMUP;
+
+      ulong to_insert = heap_sz - fd_pack_avail_txn_cnt( pack );
+      if( measure ) insert -= fd_log_wallclock( );
+      for( ulong j=0UL; j<to_insert; j++ ) {
+        uchar * p   = payload_scratch[ 0 ];
+        ulong   hot = round*HOT_CNT + (ulong)( (double)HOT_CNT * pow( fd_rng_double_o( rng ), 2.0 ) );
+        ulong   c0  = fd_rng_ulong_roll( rng, cold_cnt ) | (1UL<<32);
+        ulong   c1  = fd_rng_ulong_roll( rng, cold_cnt ) | (2UL<<32);
+        sig++;
+        memcpy( p+1UL,                          &sig, sizeof(ulong) );
+        memcpy( p+signer_off+1UL,               &sig, sizeof(ulong) );
+        memcpy( p+hot_off,                      &hot, sizeof(ulong) );
+        memcpy( p+cold_off,                     &c0,  sizeof(ulong) );
+        memcpy( p+cold_off+FD_TXN_ACCT_ADDR_SZ, &c1,  sizeof(ulong) );
+
+        fd_txn_p_t * slot       = fd_pack_insert_txn_init( pack );
+        fd_txn_t *   txn        = (fd_txn_t*) txn_scratch[ 0 ];
+        slot->payload_sz        = payload_sz[ 0 ];
+        fd_memcpy( slot->payload, p,   payload_sz[ 0 ]                                                );
+        fd_memcpy( TXN(slot),     txn, fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+        fd_pack_insert_txn_fini( pack, slot, 0UL );
+      }
+      if( measure ) insert += fd_log_wallclock( );
+      ins_cnt += (ulong)measure * to_insert;
+
+      FD_TEST( fd_pack_avail_txn_cnt( pack )==heap_sz );
+
+      ulong idle = 0UL;
+      if( measure ) schedule -= fd_log_wallclock( );
+      for( ulong bank=0UL; fd_pack_avail_txn_cnt( pack )>heap_sz/2UL; bank = (bank+1UL)%BANK_CNT ) {
+        fd_pack_microblock_complete( pack, bank );
+        ulong scheduled = fd_pack_schedule_next_microblock( pack, 1000000UL, 0.0f, bank, outcome.results );
+        sched_cnt += (ulong)measure * scheduled;
+        mblk_cnt  += (ulong)measure * (ulong)(!!scheduled);
+        /* A full round without progress means we've hit a block limit */
+        idle = fd_ulong_if( !!scheduled, 0UL, idle+1UL );
+        if( FD_UNLIKELY( idle>BANK_CNT ) ) { fd_pack_end_block( pack ); idle = 0UL; }
+      }
+      if( measure ) schedule += fd_log_wallclock( );
+    }
+    for( ulong bank=0UL; bank<BANK_CNT; bank++ ) fd_pack_microblock_complete( pack, bank );
+
+    FD_LOG_NOTICE(( "%5lu\t%6.3f\t%8.3f\t%8.3f", heap_sz,
+          (double)insert  /(double)ins_cnt,
+          (double)schedule/(double)sched_cnt,
+          (double)sched_cnt/(double)mblk_cnt ));
+
+    if( FD_LIKELY( wksp ) ) fd_wksp_free_laddr( _mem );
+  }
+  if( FD_LIKELY( wksp ) ) fd_wksp_delete_anonymous( wksp );
+#undef WARMUP
+#undef ROUND_CNT
+#undef BANK_CNT
+#undef HOT_CNT
+}
+
 void heap_overflow_test( void ) {
   FD_LOG_NOTICE(( "TEST HEAP OVERFLOW" ));
   fd_pack_t * pack = init_all( 1024UL, 1UL, 2UL, &outcome );
@@ -678,6 +784,108 @@ test_gap( void ) {
   }
 }
 
+static void
+test_lookahead( void ) {
+  FD_LOG_NOTICE(( "TEST LOOKAHEAD" ));
+  fd_pack_t * pack = init_all( 1024UL, 4UL, 1UL, &outcome );
+
+  ulong i=0UL;
+  ulong r0 = make_transaction( i, 500U, 13.0, "A", "B" ); insert( i++, pack );
+  ulong r1 = make_transaction( i, 500U, 12.0, "A", "C" ); insert( i++, pack );
+  ulong r2 = make_transaction( i, 500U, 11.0, "D", "E" ); insert( i++, pack );
+  ulong r3 = make_transaction( i, 500U, 10.0, "F", "G" ); insert( i++, pack );
+  ulong r4 = make_transaction( i, 500U,  9.0, "H", "B" ); insert( i++, pack );
+
+  /* One microblock per bank tile, planned in one pass.  Transaction 1
+     conflicts with transaction 0, so it gets skipped. */
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0xFUL )==4UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==5UL );
+  /* Planned bank tiles don't get planned again */
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0xFUL )==0UL );
+
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r0, 0UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r2, 1UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r3, 2UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r4, 3UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  /* Bank tile 0 is busy until it completes */
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0x1UL )==0UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r1, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* Planned transactions can be deleted, and unreturned plans are
+     dissolved at the end of the block. */
+  make_transaction( i, 500U, 12.0, "J", "K" ); insert( i++, pack );
+  make_transaction( i, 500U, 11.0, "L", "M" ); insert( i++, pack );
+  for( ulong j=1UL; j<4UL; j++ ) fd_pack_microblock_complete( pack, j );
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0x6UL )==2UL );
+  FD_TEST( fd_pack_delete_transaction( pack, fd_txn_get_signatures( (fd_txn_t *)txn_scratch[i-2UL], payload_scratch[i-2UL] ) ) );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  fd_pack_end_block( pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, 0UL, 3UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+
+  /* A transaction too big for what's left of bank tile 0's microblock
+     goes to bank tile 1 rather than waiting for the next pass. */
+  pack = init_all( 1024UL, 2UL, 4UL, &outcome );
+  i = 0UL;
+  ulong r5 = make_transaction( i, 400000U, 13.0, "A", "B" ); insert( i++, pack );
+  ulong r6 = make_transaction( i, 700000U, 12.0, "C", "D" ); insert( i++, pack );
+  FD_TEST( fd_pack_schedule_lookahead( pack, 1000000UL, 0.0f, 0x3UL )==2UL );
+  schedule_validate_microblock( pack, 1000000UL, 0.0f, 1UL, r5, 0UL, &outcome );
+  schedule_validate_microblock( pack, 1000000UL, 0.0f, 1UL, r6, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
+static void
+test_lookahead_end_block( void ) {
+  FD_LOG_NOTICE(( "TEST LOOKAHEAD END BLOCK" ));
+  init_all( 1024UL, 4UL, 1UL, &outcome );
+  /* At most 3 microblocks per block */
+  fd_pack_t * pack = fd_pack_join( fd_pack_new( pack_scratch, 1024UL, 4UL, 1UL, 3UL, rng ) );
+
+  ulong i=0UL;
+  ulong r0 = make_transaction( i, 500U, 12.0, "A", "E" ); insert( i++, pack );
+  ulong r1 = make_transaction( i, 500U, 11.0, "B", "F" ); insert( i++, pack );
+  ulong r2 = make_transaction( i, 500U, 10.0, "C", "G" ); insert( i++, pack );
+  ulong r3 = make_transaction( i, 500U,  9.0, "D", "H" ); insert( i++, pack );
+
+  /* Planned microblocks count against the limit before they are
+     returned */
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0xFUL )==3UL );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 3UL, outcome.results )==0UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r0, 0UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==3UL );
+
+  /* This conflicts with the transaction planned for bank tile 1 */
+  ulong r4 = make_transaction( i, 500U, 13.0, "B", "I" ); insert( i++, pack );
+
+  /* Ending the block with microblocks still planned for bank tiles 1
+     and 2 puts their transactions back in pending, releases their
+     accounts and makes the bank tiles available again. */
+  fd_pack_end_block( pack );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==4UL );
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0x6UL )==2UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r4, 1UL, &outcome );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r2, 2UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+
+  /* Only the returned microblocks were counted in the new block.
+     Transaction 1 still conflicts with transaction 4. */
+  fd_pack_microblock_complete( pack, 0UL );
+  FD_TEST( fd_pack_schedule_lookahead( pack, 300000UL, 0.0f, 0x9UL )==1UL );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r3, 0UL, &outcome );
+  FD_TEST( fd_pack_schedule_next_microblock( pack, 300000UL, 0.0f, 3UL, outcome.results )==0UL );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
+  fd_pack_end_block( pack );
+  schedule_validate_microblock( pack, 300000UL, 0.0f, 1UL, r1, 1UL, &outcome );
+  FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
+}
+
 static void
 test_limits( void ) {
   FD_LOG_NOTICE(( "TEST LIMITS" ));
@@ -754,8 +962,22 @@ test_limits( void ) {
     schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 0UL, 0UL, 0UL, &outcome );
     FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
 
+    /* Once A is at its limit, more transactions that write A get parked
+       when they are inserted, but others are unaffected. */
+    make_transaction( 1UL, 1000001U, 12.0, "A", "B" );
+    insert( 1UL, pack );
+    make_transaction( 2UL, 1000001U, 10.0, "C", "B" );
+    insert( 2UL, pack );
+    schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==2UL );
+
+    /* Parked transactions can still be deleted */
+    FD_TEST( fd_pack_delete_transaction( pack, (fd_ed25519_sig_t const *)(payload_scratch[ 1 ]+1UL) ) );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==1UL );
+
     fd_pack_end_block( pack );
     schedule_validate_microblock( pack, FD_PACK_MAX_COST_PER_BLOCK, 0.0f, 1UL, 0UL, 0UL, &outcome );
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==0UL );
   }
 
 
@@ -839,6 +1061,83 @@ test_reject_writes_to_sysvars( void ) {
 }
 
 
+static void
+test_insert_batch( void ) {
+  FD_LOG_NOTICE(( "TEST INSERT BATCH" ));
+#define DISTINCT_CNT 40UL
+#define INSERT_CNT   48UL
+
+  /* Unique priorities so that the schedule order doesn't depend on how
+     ties are broken. */
+  for( ulong j=0UL; j<DISTINCT_CNT; j++ ) {
+    char writes[ 2 ] = { (char)('A'+(j%5UL)), '\0' };
+    char reads [ 2 ] = { (char)('a'+(j%3UL)), '\0' };
+    make_transaction( j, 500U, 1.0+(double)((j*7UL)%DISTINCT_CNT)/4.0, writes, reads );
+  }
+  /* Make one of them fail estimation */
+  fd_txn_t * bad = (fd_txn_t *)txn_scratch[ 5 ];
+  payload_scratch[ 5 ][ bad->instr[ 0 ].data_off ] = (uchar)0xFF;
+
+  /* The pack is smaller than the number of distinct transactions, so
+     some inserts replace others or are rejected for priority, and
+     k*13%40 repeats for k>=40, so there are duplicates within the
+     batch. */
+  int   seq_result[ INSERT_CNT ];
+  int   bat_result[ INSERT_CNT ];
+  ulong seq_sched [ INSERT_CNT ];
+  ulong bat_sched [ INSERT_CNT ];
+  ulong seq_sched_cnt = 0UL;
+  ulong bat_sched_cnt = 0UL;
+
+  for( ulong pass=0UL; pass<2UL; pass++ ) {
+    fd_pack_t * pack = init_all( 16UL, 1UL, 4UL, &outcome );
+
+    fd_txn_p_t * batch  [ INSERT_CNT ];
+    ulong        expires[ INSERT_CNT ];
+    for( ulong k=0UL; k<INSERT_CNT; k++ ) {
+      ulong j = (k*13UL)%DISTINCT_CNT;
+      fd_txn_p_t * slot = fd_pack_insert_txn_init( pack );
+      fd_txn_t   * txn  = (fd_txn_t*) txn_scratch[ j ];
+      slot->payload_sz  = payload_sz[ j ];
+      fd_memcpy( slot->payload, payload_scratch[ j ], payload_sz[ j ]                                                );
+      fd_memcpy( TXN(slot),     txn,                  fd_txn_footprint( txn->instr_cnt, txn->addr_table_lookup_cnt ) );
+      if( pass==0UL ) seq_result[ k ] = fd_pack_insert_txn_fini( pack, slot, k );
+      else          { batch[ k ] = slot; expires[ k ] = k; }
+    }
+    if( pass==1UL ) {
+      /* In two batches, to check that state carries across calls */
+      fd_pack_insert_txn_batch( pack, batch,       expires,       32UL,            bat_result       );
+      fd_pack_insert_txn_batch( pack, batch+32UL,  expires+32UL,  INSERT_CNT-32UL, bat_result+32UL  );
+    }
+
+    FD_TEST( fd_pack_avail_txn_cnt( pack )==16UL );
+
+    ulong * sched     = pass ? bat_sched      : seq_sched;
+    ulong * sched_cnt = pass ? &bat_sched_cnt : &seq_sched_cnt;
+    while( fd_pack_avail_txn_cnt( pack ) ) {
+      fd_pack_microblock_complete( pack, 0UL );
+      ulong cnt = fd_pack_schedule_next_microblock( pack, 1000000UL, 0.0f, 0UL, outcome.results );
+      FD_TEST( cnt );
+      for( ulong t=0UL; t<cnt; t++ ) sched[ (*sched_cnt)++ ] = FD_LOAD( ulong, outcome.results[ t ].payload+1UL );
+    }
+    fd_pack_microblock_complete( pack, 0UL );
+  }
+
+  ulong dup_cnt = 0UL;
+  for( ulong k=0UL; k<INSERT_CNT; k++ ) {
+    FD_TEST( seq_result[ k ]==bat_result[ k ] );
+    dup_cnt += (ulong)(seq_result[ k ]==FD_PACK_INSERT_REJECT_DUPLICATE);
+  }
+  FD_TEST( seq_result[ 25 ]==FD_PACK_INSERT_REJECT_ESTIMATION_FAIL ); /* 25*13%40==5 */
+  FD_TEST( dup_cnt );
+  FD_TEST( seq_sched_cnt==bat_sched_cnt );
+  for( ulong t=0UL; t<seq_sched_cnt; t++ ) FD_TEST( seq_sched[ t ]==bat_sched[ t ] );
+
+#undef INSERT_CNT
+#undef DISTINCT_CNT
+}
+
+
 
 int
 main( int     argc,
@@ -857,9 +1156,13 @@ main( int     argc,
   test_delete();
   test_expiration();
   test_gap();
+  test_lookahead();
+  test_lookahead_end_block();
   test_limits();
   test_reject_writes_to_sysvars();
+  test_insert_batch();
   performance_test( extra_benchmark );
+  contention_test( extra_benchmark );
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
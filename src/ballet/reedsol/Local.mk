@@ -12,6 +12,8 @@ $(call add-objs,fd_reedsol_recover_32,fd_reedsol)
 $(call add-objs,fd_reedsol_recover_64,fd_reedsol)
 $(call add-objs,fd_reedsol_recover_128,fd_reedsol)
 $(call add-objs,fd_reedsol_recover_256,fd_reedsol)
+$(call add-objs,fd_reedsol_recover_data,fd_reedsol)
 $(call add-objs,fd_reedsol_pi,fd_reedsol)
 $(call make-unit-test,test_reedsol,test_reedsol,fd_reedsol fd_util)
+$(call make-unit-test,bench_reedsol,bench_reedsol,fd_reedsol fd_util)
 $(call make-fuzz-test,fuzz_reedsol,fuzz_reedsol,fd_reedsol fd_util)
@@ -0,0 +1,112 @@
+#include "fd_reedsol_private.h"
+#include <stdio.h>
+
+/* bench_reedsol reports the throughput of Reed-Solomon encode, full
+   recover and data-only recover for each data shred count, using the
+   Galois Field arithmetic backend the library was compiled with.  Each
+   FEC set has as many parity shreds as data shreds (capped at
+   FD_REEDSOL_PARITY_SHREDS_MAX), and the recover benchmarks erase the
+   first --erase-frac of the data shreds, replacing them with parity.
+   Throughput is the number of data bytes covered per second.
+
+   To compare backends, build with EXTRA_CPPFLAGS=
+   -DFD_REEDSOL_ARITH_IMPL=n for n in 0 (generic), 1 (AVX), 2 (GFNI)
+   or 3 (AVX-512 and GFNI), provided the target supports it. */
+
+#if FD_REEDSOL_ARITH_IMPL==0
+#define BACKEND_NAME "generic"
+#elif FD_REEDSOL_ARITH_IMPL==1
+#define BACKEND_NAME "avx"
+#elif FD_REEDSOL_ARITH_IMPL==2
+#define BACKEND_NAME "gfni"
+#else
+#define BACKEND_NAME "avx512-gfni"
+#endif
+
+#define SHRED_SZ_MAX (2048UL)
+
+static uchar mem[ FD_REEDSOL_FOOTPRINT ] __attribute__((aligned(FD_REEDSOL_ALIGN)));
+static uchar truth[ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ][ SHRED_SZ_MAX ];
+static uchar work [ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ][ SHRED_SZ_MAX ];
+
+static void
+encode( ulong shred_sz,
+        ulong d_cnt,
+        ulong p_cnt ) {
+  fd_reedsol_t * rs = fd_reedsol_encode_init( mem, shred_sz );
+  for( ulong i=0UL; i<d_cnt; i++ ) fd_reedsol_encode_add_data_shred(   rs, truth[ i       ] );
+  for( ulong i=0UL; i<p_cnt; i++ ) fd_reedsol_encode_add_parity_shred( rs, truth[ d_cnt+i ] );
+  fd_reedsol_encode_fini( rs );
+}
+
+static int
+recover( ulong shred_sz,
+         ulong d_cnt,
+         ulong p_cnt,
+         ulong e_cnt,
+         int   data_only ) {
+  fd_reedsol_t * rs = fd_reedsol_recover_init( mem, shred_sz );
+  for( ulong i=0UL; i<d_cnt+p_cnt; i++ ) {
+    if( i<e_cnt ) fd_reedsol_recover_add_erased_shred( rs, i<d_cnt, work[ i ] );
+    else          fd_reedsol_recover_add_rcvd_shred  ( rs, i<d_cnt, truth[ i ] );
+  }
+  return data_only ? fd_reedsol_recover_data_fini( rs ) : fd_reedsol_recover_fini( rs );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong  shred_sz   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--shred-sz",   NULL, 1019UL );
+  ulong  iter_cnt   = fd_env_strip_cmdline_ulong ( &argc, &argv, "--iter-cnt",   NULL, 2000UL );
+  double erase_frac = fd_env_strip_cmdline_double( &argc, &argv, "--erase-frac", NULL, 0.25   );
+
+  if( FD_UNLIKELY( (shred_sz<32UL) | (shred_sz>SHRED_SZ_MAX) ) ) FD_LOG_ERR(( "--shred-sz must be in [32,%lu]", SHRED_SZ_MAX ));
+  if( FD_UNLIKELY( !iter_cnt                                 ) ) FD_LOG_ERR(( "--iter-cnt must be positive" ));
+  if( FD_UNLIKELY( !((erase_frac>=0.0) & (erase_frac<=1.0))  ) ) FD_LOG_ERR(( "--erase-frac must be in [0,1]" ));
+
+  FD_LOG_NOTICE(( "backend %s (FD_REEDSOL_ARITH_IMPL %i, GF_WIDTH %lu), --shred-sz %lu, --iter-cnt %lu, --erase-frac %.2f",
+                  BACKEND_NAME, FD_REEDSOL_ARITH_IMPL, (ulong)GF_WIDTH, shred_sz, iter_cnt, erase_frac ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong i=0UL; i<FD_REEDSOL_DATA_SHREDS_MAX; i++ )
+    for( ulong j=0UL; j<shred_sz; j++ ) truth[ i ][ j ] = fd_rng_uchar( rng );
+
+  printf( "%8s %5s %5s %5s %13s %13s %13s\n", "backend", "data", "par", "erase", "encode GB/s", "recover GB/s", "rec_data GB/s" );
+
+  for( ulong d_cnt=1UL; d_cnt<=FD_REEDSOL_DATA_SHREDS_MAX; d_cnt++ ) {
+    ulong p_cnt = fd_ulong_min( d_cnt, FD_REEDSOL_PARITY_SHREDS_MAX );
+    ulong e_cnt = fd_ulong_min( (ulong)(erase_frac*(double)d_cnt + 0.5), p_cnt );
+    double bytes = (double)(iter_cnt*d_cnt*shred_sz);
+
+    /* The first call of each warms up the instruction cache and, for
+       encode, fills in the parity shreds recover reads. */
+
+    encode( shred_sz, d_cnt, p_cnt );
+    long dt_encode = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iter_cnt; iter++ ) encode( shred_sz, d_cnt, p_cnt );
+    dt_encode += fd_log_wallclock();
+
+    long dt_recover[2];
+    for( int data_only=0; data_only<2; data_only++ ) {
+      int err = recover( shred_sz, d_cnt, p_cnt, e_cnt, data_only );
+      if( FD_UNLIKELY( err!=FD_REEDSOL_SUCCESS ) ) FD_LOG_ERR(( "recover failed (%i-%s)", err, fd_reedsol_strerror( err ) ));
+      for( ulong i=0UL; i<e_cnt; i++ )
+        if( FD_UNLIKELY( memcmp( work[ i ], truth[ i ], shred_sz ) ) ) FD_LOG_ERR(( "recover mismatch at shred %lu", i ));
+
+      dt_recover[ data_only ] = -fd_log_wallclock();
+      for( ulong iter=0UL; iter<iter_cnt; iter++ ) recover( shred_sz, d_cnt, p_cnt, e_cnt, data_only );
+      dt_recover[ data_only ] += fd_log_wallclock();
+    }
+
+    printf( "%8s %5lu %5lu %5lu %13.2f %13.2f %13.2f\n", BACKEND_NAME, d_cnt, p_cnt, e_cnt,
+            bytes/(double)dt_encode, bytes/(double)dt_recover[0], bytes/(double)dt_recover[1] );
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
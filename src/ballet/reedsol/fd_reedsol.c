@@ -10,9 +10,76 @@ FD_IMPORT_BINARY( fd_reedsol_arith_consts_avx_mul, "src/ballet/reedsol/constants
 FD_IMPORT_BINARY( fd_reedsol_arith_consts_gfni_mul, "src/ballet/reedsol/constants/gfni_constants.bin" );
 #endif
 
+#if GF_WIDTH>32
+/* The encode and recover variants process GF_WIDTH bytes of each shred
+   at a time, so they need shred_sz>=GF_WIDTH.  That's more than the 32
+   bytes the API promises to handle, so smaller shreds get copied into
+   zero padded vectors first.  The arithmetic is byte-wise, so the
+   padding doesn't change the result.  Real shreds are never this
+   small. */
+
+static void
+fd_reedsol_private_encode_fini_padded( fd_reedsol_t * rs ) {
+  ulong shred_sz         = rs->shred_sz;
+  ulong data_shred_cnt   = rs->data_shred_cnt;
+  ulong parity_shred_cnt = rs->parity_shred_cnt;
+
+  gf_t    padded[ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ];
+  uchar * parity_shred[ FD_REEDSOL_PARITY_SHREDS_MAX ];
+
+  for( ulong i=0UL; i<data_shred_cnt; i++ ) {
+    padded[ i ] = gf_ldu_partial( rs->encode.data_shred[ i ], shred_sz );
+    rs->encode.data_shred[ i ] = (uchar const *)( padded+i );
+  }
+  for( ulong i=0UL; i<parity_shred_cnt; i++ ) {
+    parity_shred[ i ] = rs->encode.parity_shred[ i ];
+    rs->encode.parity_shred[ i ] = (uchar *)( padded+data_shred_cnt+i );
+  }
+
+  rs->shred_sz = GF_WIDTH;
+  fd_reedsol_encode_fini( rs );
+  rs->shred_sz = shred_sz;
+
+  for( ulong i=0UL; i<parity_shred_cnt; i++ ) gf_stu_partial( parity_shred[ i ], padded[ data_shred_cnt+i ], shred_sz );
+}
+
+static int
+fd_reedsol_private_recover_fini_padded( fd_reedsol_t * rs,
+                                        int            data_only ) {
+  ulong shred_sz       = rs->shred_sz;
+  ulong data_shred_cnt = rs->data_shred_cnt;
+  ulong shred_cnt      = data_shred_cnt + rs->parity_shred_cnt;
+
+  gf_t    padded[ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ];
+  uchar * shred [ FD_REEDSOL_DATA_SHREDS_MAX + FD_REEDSOL_PARITY_SHREDS_MAX ];
+
+  for( ulong i=0UL; i<shred_cnt; i++ ) {
+    shred[ i ] = rs->recover.shred[ i ];
+    padded[ i ] = rs->recover.erased[ i ] ? gf_zero() : gf_ldu_partial( shred[ i ], shred_sz );
+    rs->recover.shred[ i ] = (uchar *)( padded+i );
+  }
+
+  rs->shred_sz = GF_WIDTH;
+  int retval = data_only ? fd_reedsol_recover_data_fini( rs ) : fd_reedsol_recover_fini( rs );
+  rs->shred_sz = shred_sz;
+
+  /* recover_data leaves erased parity shreds untouched */
+  for( ulong i=0UL; i<fd_ulong_if( data_only, data_shred_cnt, shred_cnt ); i++ ) {
+    if( rs->recover.erased[ i ] ) gf_stu_partial( shred[ i ], padded[ i ], shred_sz );
+  }
+  return retval;
+}
+#endif
+
 void
 fd_reedsol_encode_fini( fd_reedsol_t * rs ) {
 
+# if GF_WIDTH>32
+  if( FD_UNLIKELY( rs->shred_sz<GF_WIDTH ) ) { fd_reedsol_private_encode_fini_padded( rs ); return; }
+# endif
+
+  /* The hand-written 32:32 kernel uses 256 bit vectors.  With AVX-512,
+     the generic encode_32 is faster. */
 # if FD_REEDSOL_ARITH_IMPL==2
   if( FD_LIKELY( (rs->data_shred_cnt==32UL) & (rs->parity_shred_cnt==32UL ) ) )
     fd_reedsol_private_encode_32_32( rs->shred_sz, rs->encode.data_shred, rs->encode.parity_shred, rs->scratch );
@@ -34,6 +101,10 @@ fd_reedsol_encode_fini( fd_reedsol_t * rs ) {
 int
 fd_reedsol_recover_fini( fd_reedsol_t * rs ) {
 
+# if GF_WIDTH>32
+  if( FD_UNLIKELY( rs->shred_sz<GF_WIDTH ) ) return fd_reedsol_private_recover_fini_padded( rs, 0 );
+# endif
+
   ulong data_shred_cnt   = rs->data_shred_cnt;
   ulong parity_shred_cnt = rs->parity_shred_cnt;
 
@@ -76,6 +147,22 @@ fd_reedsol_recover_fini( fd_reedsol_t * rs ) {
   return fd_reedsol_private_recover_var_256( rs->shred_sz, rs->recover.shred, data_shred_cnt, parity_shred_cnt, rs->recover.erased );
 }
 
+int
+fd_reedsol_recover_data_fini( fd_reedsol_t * rs ) {
+
+# if GF_WIDTH>32
+  if( FD_UNLIKELY( rs->shred_sz<GF_WIDTH ) ) return fd_reedsol_private_recover_fini_padded( rs, 1 );
+# endif
+
+  ulong data_shred_cnt   = rs->data_shred_cnt;
+  ulong parity_shred_cnt = rs->parity_shred_cnt;
+
+  rs->data_shred_cnt   = 0UL;
+  rs->parity_shred_cnt = 0UL;
+
+  return fd_reedsol_private_recover_data( rs->shred_sz, rs->recover.shred, data_shred_cnt, parity_shred_cnt, rs->recover.erased );
+}
+
 char const *
 fd_reedsol_strerror( int err ) {
   switch( err ) {
@@ -315,6 +315,33 @@ fd_reedsol_recover_abort( fd_reedsol_t * rs ) {
 int
 fd_reedsol_recover_fini( fd_reedsol_t * rs );
 
+/* fd_reedsol_recover_data_fini finishes the in-progress recover
+   operation like fd_reedsol_recover_fini, except that only the erased
+   data shreds are filled in.  The contents of erased parity shreds are
+   left as is, so a caller that needs them can regenerate them with an
+   encode operation once the data shreds are complete.
+
+   Each erased data shred is evaluated directly from the first
+   data_shred_cnt un-erased shreds, which costs about data_shred_cnt
+   multiply-adds per byte per erased data shred.  When only a few data
+   shreds are missing, that is much cheaper than the full recovery,
+   which transforms every shred in the set regardless of how many are
+   erased.  When most of them are missing, fd_reedsol_recover_fini is
+   faster.
+
+   Un-erased shreds past the first data_shred_cnt are ignored rather
+   than checked, so this never returns FD_REEDSOL_ERR_CORRUPT.  Callers
+   must validate the recovered data some other way (e.g. against a
+   Merkle root) if the shreds are untrusted.  Returns FD_REEDSOL_SUCCESS
+   or FD_REEDSOL_ERR_PARTIAL with the same meaning as for
+   fd_reedsol_recover_fini.
+
+   Assumes rs is initialized as a recoverer, rs will not be initialized
+   on return. */
+
+int
+fd_reedsol_recover_data_fini( fd_reedsol_t * rs );
+
 /* Misc APIs */
 
 /* fd_reedsol_strerror converts a FD_REEDSOL_SUCCESS / FD_REEDSOL_ERR_*
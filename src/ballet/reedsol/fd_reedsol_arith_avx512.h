@@ -0,0 +1,86 @@
+#ifndef HEADER_fd_src_ballet_reedsol_fd_reedsol_arith_avx512_h
+#define HEADER_fd_src_ballet_reedsol_fd_reedsol_arith_avx512_h
+
+#ifndef HEADER_fd_src_ballet_reedsol_fd_reedsol_private_h
+#error "Do not include this file directly; use fd_reedsol_private.h"
+#endif
+
+/* Same as fd_reedsol_arith_gfni.h, but on 64 byte AVX-512 vectors, so
+   every encode and recover variant processes twice as many bytes of
+   each shred per instruction.  The multiplication constants are the
+   same vgf2p8affineqb matrices.  Each 32 byte table entry holds the
+   same 8 byte matrix repeated, so a single quadword is broadcast, which
+   the compiler can fold into the multiply as an embedded broadcast. */
+
+#include "../../util/simd/fd_avx512.h"
+
+typedef wwv_t gf_t;
+#define GF_WIDTH WW_FOOTPRINT
+
+FD_PROTOTYPES_BEGIN
+
+#define gf_ldu  wwv_ldu
+#define gf_stu  wwv_stu
+#define gf_zero wwv_zero
+
+extern uchar const fd_reedsol_arith_consts_gfni_mul[]  __attribute__((aligned(128)));
+
+/* gf_ldu_partial loads the sz<=GF_WIDTH bytes at p, zeroing the rest
+   of the vector, and gf_stu_partial stores the first sz bytes of x to
+   p.  Neither touches memory outside [p,p+sz). */
+
+#define gf_ldu_partial( p, sz )    _mm512_maskz_loadu_epi8( fd_ulong_mask_lsb( (int)(sz) ), (p) )
+#define gf_stu_partial( p, x, sz ) _mm512_mask_storeu_epi8( (p), fd_ulong_mask_lsb( (int)(sz) ), (x) )
+
+#define GF_ADD wwv_xor
+#define GF_OR  wwv_or
+
+#define GF_MATRIX( c ) _mm512_set1_epi64( FD_LOAD( long, fd_reedsol_arith_consts_gfni_mul + 32*(c) ) )
+
+/* See fd_reedsol_arith_gfni.h for why older versions of GCC need
+   inline assembly. */
+
+#if !FD_USING_CLANG
+#define GCC_VERSION (__GNUC__*10000 + __GNUC_MINOR__*100 + __GNUC_PATCHLEVEL__)
+#endif
+
+#if FD_USING_CLANG || (GCC_VERSION >= 100000)
+#define GF_MUL( a, c ) (__extension__({                                                 \
+    wwv_t _a = (a);                                                                     \
+    int   _c = (c);                                                                     \
+    /* c is known at compile time, so this is not a runtime branch */                   \
+    ((_c==0) ? wwv_zero() : ((_c==1) ? _a :                                             \
+     _mm512_gf2p8affine_epi64_epi8( _a, GF_MATRIX( _c ), 0 ) ));                        \
+  }))
+
+#define GF_MUL_VAR( a, c ) (_mm512_gf2p8affine_epi64_epi8( (a), GF_MATRIX( c ), 0 ))
+
+#else
+#define GF_MUL( a, c ) (__extension__({                                                 \
+    wwv_t _a = (a);                                                                     \
+    int   _c = (c);                                                                     \
+    wwv_t _product;                                                                     \
+    __asm__( "vgf2p8affineqb $0x0, %[cons], %[vec], %[out]"                             \
+           : [out]"=v"  (_product)                                                      \
+           : [cons]"vm" (GF_MATRIX( _c )),                                              \
+             [vec]"v"   (_a) );                                                         \
+    /* c is known at compile time, so this is not a runtime branch */                   \
+    (_c==0) ? wwv_zero() : ( (_c==1) ? (_a) : _product );                               \
+  }))
+
+#define GF_MUL_VAR( a, c ) (__extension__({                                             \
+    wwv_t _product;                                                                     \
+    __asm__( "vgf2p8affineqb $0x0, %[cons], %[vec], %[out]"                             \
+           : [out]"=v"  (_product)                                                      \
+           : [cons]"vm" (GF_MATRIX( c )),                                               \
+             [vec]"v"   (a) );                                                          \
+    (_product);                                                                         \
+  }))
+
+#endif
+
+#define GF_ANY( x ) (0 != _mm512_test_epi64_mask( (x), (x) ))
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_reedsol_fd_reedsol_arith_avx512_h */
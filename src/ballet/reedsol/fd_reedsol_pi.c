@@ -68,6 +68,25 @@
 
 #include "../../util/simd/fd_sse.h"
 
+#if FD_REEDSOL_ARITH_IMPL==3
+/* Everything below works on 32 byte vectors, so with the AVX-512
+   arithmetic, multiply with the 256 bit form of vgf2p8affineqb instead.
+   The constants are never 0 or 1 here. */
+#undef GF_MUL
+#if FD_USING_CLANG || (GCC_VERSION >= 100000)
+#define GF_MUL( a, c ) (_mm256_gf2p8affine_epi64_epi8( (a), wb_ld( fd_reedsol_arith_consts_gfni_mul + 32*(c) ), 0 ))
+#else
+#define GF_MUL( a, c ) (__extension__({                                        \
+    wb_t _product;                                                             \
+    __asm__( "vgf2p8affineqb $0x0, %[cons], %[vec], %[out]"                    \
+           : [out]"=x"  (_product)                                             \
+           : [cons]"xm" (wb_ld( fd_reedsol_arith_consts_gfni_mul + 32*(c) )),  \
+             [vec]"x"   (a) );                                                 \
+    (_product);                                                                \
+  }))
+#endif
+#endif
+
 #define ws_t __m256i
 #define ws_add(a,b)         _mm256_add_epi16( (a), (b) )
 #define ws_sub(a,b)         _mm256_sub_epi16( (a), (b) )
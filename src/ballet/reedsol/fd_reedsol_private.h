@@ -12,10 +12,16 @@
 
      0 - unaccelerated
      1 - AVX accelerated
-     2 - GFNI accelerated */
+     2 - GFNI accelerated
+     3 - AVX-512 and GFNI accelerated
+
+   The accelerated implementations process a shred 32 bytes at a time
+   (64 bytes for AVX-512), GF_WIDTH bytes in general. */
 
 #ifndef FD_REEDSOL_ARITH_IMPL
-#if FD_HAS_GFNI
+#if FD_HAS_GFNI && FD_HAS_AVX512
+#define FD_REEDSOL_ARITH_IMPL 3
+#elif FD_HAS_GFNI
 #define FD_REEDSOL_ARITH_IMPL 2
 #elif FD_HAS_AVX
 #define FD_REEDSOL_ARITH_IMPL 1
@@ -30,6 +36,8 @@
 #include "fd_reedsol_arith_avx2.h"
 #elif FD_REEDSOL_ARITH_IMPL==2
 #include "fd_reedsol_arith_gfni.h"
+#elif FD_REEDSOL_ARITH_IMPL==3
+#include "fd_reedsol_arith_avx512.h"
 #else
 #error "Unsupported FD_REEDSOL_ARITH_IMPL"
 #endif
@@ -152,6 +160,22 @@ fd_reedsol_private_recover_var_256( ulong           shred_sz,
                                     ulong           parity_shred_cnt,
                                     uchar const *   erased );
 
+/* fd_reedsol_private_recover_data: Like the recover_var_{n} functions,
+   but only recovers the erased data shreds, by evaluating them
+   directly from the first data_shred_cnt un-erased shreds.  Erased
+   parity shreds are left untouched, and the un-erased shreds past the
+   first data_shred_cnt are ignored, so this never returns
+   FD_REEDSOL_ERR_CORRUPT.  The cost is proportional to the number of
+   erased data shreds, so this is the faster option when only a few of
+   them are missing. */
+
+int
+fd_reedsol_private_recover_data( ulong           shred_sz,
+                                 uchar * const * shred,
+                                 ulong           data_shred_cnt,
+                                 ulong           parity_shred_cnt,
+                                 uchar const *   erased );
+
 /* This below functions generate what:
 
      S. -J. Lin, T. Y. Al-Naffouri, Y. S. Han and W. -H. Chung, "Novel
@@ -0,0 +1,132 @@
+#include "fd_reedsol_private.h"
+
+/* fd_reedsol_private_recover_data recovers each erased data shred
+   separately by evaluating the data polynomial P at its position.
+   Shred i is the value of P at the field element i (the points the
+   FFTs in this directory evaluate at), so if S is the set of
+   data_shred_cnt un-erased shreds recovery uses, Lagrange interpolation
+   gives, for an erased data shred e:
+
+     P(e) = sum_{j in S} P(j) * Pi_S(e) / ( (e+j) * Pi_S'(j) )
+
+   where Pi_S(x) = prod_{k in S} (x+k).  gen_pi computes the same
+   products for the complement E of S in [0,n) instead: Pi_E(j) for j
+   in S and 1/Pi_E'(e) for e in E.  Since the product of all (x+k) for
+   k in [0,n) is a linearized polynomial, its derivative is a non-zero
+   constant c, and differentiating Pi_S*Pi_E at j and at e gives
+   Pi_S'(j) = c/Pi_E(j) and Pi_S(e) = c/Pi_E'(e).  The c cancels, so
+   the coefficient of P(j) in P(e) is just
+
+     pi[e] * pi[j] / (e^j)
+
+   That costs data_shred_cnt multiply-adds per byte of each erased
+   data shred, which is much cheaper than the IFFT/FDERIV/FFT over all
+   n positions fd_reedsol_private_recover_var_{n} does when only a few
+   data shreds are missing.  Unlike the FFT approach, this doesn't
+   compute the erased parity shreds and doesn't check the un-erased
+   shreds past the ones in S for consistency. */
+
+/* gf_{log,exp}_tbl: discrete logarithm and exponential tables for the
+   field (x^8+x^4+x^3+x^2+1, generator 2) used only for computing the
+   coefficients.  gf_log_tbl[ 0 ] is unused. */
+
+static uchar const gf_log_tbl[ 256 ] = {0x00,0x00,0x01,0x19,0x02,0x32,0x1a,0xc6,0x03,0xdf,0x33,0xee,0x1b,0x68,0xc7,0x4b,
+                                         0x04,0x64,0xe0,0x0e,0x34,0x8d,0xef,0x81,0x1c,0xc1,0x69,0xf8,0xc8,0x08,0x4c,0x71,
+                                         0x05,0x8a,0x65,0x2f,0xe1,0x24,0x0f,0x21,0x35,0x93,0x8e,0xda,0xf0,0x12,0x82,0x45,
+                                         0x1d,0xb5,0xc2,0x7d,0x6a,0x27,0xf9,0xb9,0xc9,0x9a,0x09,0x78,0x4d,0xe4,0x72,0xa6,
+                                         0x06,0xbf,0x8b,0x62,0x66,0xdd,0x30,0xfd,0xe2,0x98,0x25,0xb3,0x10,0x91,0x22,0x88,
+                                         0x36,0xd0,0x94,0xce,0x8f,0x96,0xdb,0xbd,0xf1,0xd2,0x13,0x5c,0x83,0x38,0x46,0x40,
+                                         0x1e,0x42,0xb6,0xa3,0xc3,0x48,0x7e,0x6e,0x6b,0x3a,0x28,0x54,0xfa,0x85,0xba,0x3d,
+                                         0xca,0x5e,0x9b,0x9f,0x0a,0x15,0x79,0x2b,0x4e,0xd4,0xe5,0xac,0x73,0xf3,0xa7,0x57,
+                                         0x07,0x70,0xc0,0xf7,0x8c,0x80,0x63,0x0d,0x67,0x4a,0xde,0xed,0x31,0xc5,0xfe,0x18,
+                                         0xe3,0xa5,0x99,0x77,0x26,0xb8,0xb4,0x7c,0x11,0x44,0x92,0xd9,0x23,0x20,0x89,0x2e,
+                                         0x37,0x3f,0xd1,0x5b,0x95,0xbc,0xcf,0xcd,0x90,0x87,0x97,0xb2,0xdc,0xfc,0xbe,0x61,
+                                         0xf2,0x56,0xd3,0xab,0x14,0x2a,0x5d,0x9e,0x84,0x3c,0x39,0x53,0x47,0x6d,0x41,0xa2,
+                                         0x1f,0x2d,0x43,0xd8,0xb7,0x7b,0xa4,0x76,0xc4,0x17,0x49,0xec,0x7f,0x0c,0x6f,0xf6,
+                                         0x6c,0xa1,0x3b,0x52,0x29,0x9d,0x55,0xaa,0xfb,0x60,0x86,0xb1,0xbb,0xcc,0x3e,0x5a,
+                                         0xcb,0x59,0x5f,0xb0,0x9c,0xa9,0xa0,0x51,0x0b,0xf5,0x16,0xeb,0x7a,0x75,0x2c,0xd7,
+                                         0x4f,0xae,0xd5,0xe9,0xe6,0xe7,0xad,0xe8,0x74,0xd6,0xf4,0xea,0xa8,0x50,0x58,0xaf};
+static uchar const gf_exp_tbl[ 255 ] = {0x01,0x02,0x04,0x08,0x10,0x20,0x40,0x80,0x1d,0x3a,0x74,0xe8,0xcd,0x87,0x13,0x26,
+                                         0x4c,0x98,0x2d,0x5a,0xb4,0x75,0xea,0xc9,0x8f,0x03,0x06,0x0c,0x18,0x30,0x60,0xc0,
+                                         0x9d,0x27,0x4e,0x9c,0x25,0x4a,0x94,0x35,0x6a,0xd4,0xb5,0x77,0xee,0xc1,0x9f,0x23,
+                                         0x46,0x8c,0x05,0x0a,0x14,0x28,0x50,0xa0,0x5d,0xba,0x69,0xd2,0xb9,0x6f,0xde,0xa1,
+                                         0x5f,0xbe,0x61,0xc2,0x99,0x2f,0x5e,0xbc,0x65,0xca,0x89,0x0f,0x1e,0x3c,0x78,0xf0,
+                                         0xfd,0xe7,0xd3,0xbb,0x6b,0xd6,0xb1,0x7f,0xfe,0xe1,0xdf,0xa3,0x5b,0xb6,0x71,0xe2,
+                                         0xd9,0xaf,0x43,0x86,0x11,0x22,0x44,0x88,0x0d,0x1a,0x34,0x68,0xd0,0xbd,0x67,0xce,
+                                         0x81,0x1f,0x3e,0x7c,0xf8,0xed,0xc7,0x93,0x3b,0x76,0xec,0xc5,0x97,0x33,0x66,0xcc,
+                                         0x85,0x17,0x2e,0x5c,0xb8,0x6d,0xda,0xa9,0x4f,0x9e,0x21,0x42,0x84,0x15,0x2a,0x54,
+                                         0xa8,0x4d,0x9a,0x29,0x52,0xa4,0x55,0xaa,0x49,0x92,0x39,0x72,0xe4,0xd5,0xb7,0x73,
+                                         0xe6,0xd1,0xbf,0x63,0xc6,0x91,0x3f,0x7e,0xfc,0xe5,0xd7,0xb3,0x7b,0xf6,0xf1,0xff,
+                                         0xe3,0xdb,0xab,0x4b,0x96,0x31,0x62,0xc4,0x95,0x37,0x6e,0xdc,0xa5,0x57,0xae,0x41,
+                                         0x82,0x19,0x32,0x64,0xc8,0x8d,0x07,0x0e,0x1c,0x38,0x70,0xe0,0xdd,0xa7,0x53,0xa6,
+                                         0x51,0xa2,0x59,0xb2,0x79,0xf2,0xf9,0xef,0xc3,0x9b,0x2b,0x56,0xac,0x45,0x8a,0x09,
+                                         0x12,0x24,0x48,0x90,0x3d,0x7a,0xf4,0xf5,0xf7,0xf3,0xfb,0xeb,0xcb,0x8b,0x0b,0x16,
+                                         0x2c,0x58,0xb0,0x7d,0xfa,0xe9,0xcf,0x83,0x1b,0x36,0x6c,0xd8,0xad,0x47,0x8e};
+
+FD_FN_UNSANITIZED int
+fd_reedsol_private_recover_data( ulong           shred_sz,
+                                 uchar * const * shred,
+                                 ulong           data_shred_cnt,
+                                 ulong           parity_shred_cnt,
+                                 uchar const *   erased ) {
+  ulong shred_cnt = data_shred_cnt + parity_shred_cnt;
+
+  /* S is the first data_shred_cnt un-erased shreds.  Erased data
+     shreds always come before the last one, so [0,n) with n the
+     smallest supported power of two past it covers everything. */
+  uchar src[ FD_REEDSOL_DATA_SHREDS_MAX ]; ulong src_cnt = 0UL;
+  uchar dst[ FD_REEDSOL_DATA_SHREDS_MAX ]; ulong dst_cnt = 0UL;
+  uchar const * in[ FD_REEDSOL_DATA_SHREDS_MAX ];
+  ulong i = 0UL;
+  for( ; (i<shred_cnt) & (src_cnt<data_shred_cnt); i++ ) {
+    if( !erased[ i ] )             { in[ src_cnt ] = shred[ i ]; src[ src_cnt++ ] = (uchar)i; }
+    else if( i<data_shred_cnt )    dst[ dst_cnt++ ] = (uchar)i;
+  }
+  if( FD_UNLIKELY( src_cnt<data_shred_cnt ) ) return FD_REEDSOL_ERR_PARTIAL;
+  if( FD_UNLIKELY( !dst_cnt                ) ) return FD_REEDSOL_SUCCESS;
+
+  ulong n = fd_ulong_max( fd_ulong_pow2_up( i ), 16UL );
+
+  uchar _erased[ 256 ] W_ATTR;
+  uchar pi     [ 256 ] W_ATTR;
+  memset( _erased, 1, n );
+  for( ulong j=0UL; j<src_cnt; j++ ) _erased[ src[ j ] ] = 0;
+
+  switch( n ) {
+    case  16UL: fd_reedsol_private_gen_pi_16 ( _erased, pi ); break;
+    case  32UL: fd_reedsol_private_gen_pi_32 ( _erased, pi ); break;
+    case  64UL: fd_reedsol_private_gen_pi_64 ( _erased, pi ); break;
+    case 128UL: fd_reedsol_private_gen_pi_128( _erased, pi ); break;
+    default:    fd_reedsol_private_gen_pi_256( _erased, pi ); break;
+  }
+
+  /* coeff[ k ][ j ] is the coefficient of shred src[ j ] in shred
+     dst[ k ].  All the factors are non-zero, so the logs are defined. */
+  uchar coeff[ FD_REEDSOL_DATA_SHREDS_MAX ][ FD_REEDSOL_DATA_SHREDS_MAX ];
+  for( ulong k=0UL; k<dst_cnt; k++ ) {
+    ulong log_pi_e = gf_log_tbl[ pi[ dst[ k ] ] ];
+    for( ulong j=0UL; j<src_cnt; j++ ) {
+      ulong log_c = log_pi_e + gf_log_tbl[ pi[ src[ j ] ] ] + 255UL - gf_log_tbl[ dst[ k ]^src[ j ] ];
+      coeff[ k ][ j ] = gf_exp_tbl[ log_c % 255UL ];
+    }
+  }
+
+  for( ulong shred_pos=0UL; shred_pos<shred_sz; /* advanced manually at end of loop */ ) {
+    for( ulong k=0UL; k<dst_cnt; k++ ) {
+      /* Four independent sums to hide the multiply latency */
+      gf_t out0 = gf_zero(); gf_t out1 = gf_zero(); gf_t out2 = gf_zero(); gf_t out3 = gf_zero();
+      ulong j = 0UL;
+      for( ; j+4UL<=src_cnt; j+=4UL ) {
+        out0 = GF_ADD( out0, GF_MUL_VAR( gf_ldu( in[ j     ] + shred_pos ), coeff[ k ][ j     ] ) );
+        out1 = GF_ADD( out1, GF_MUL_VAR( gf_ldu( in[ j+1UL ] + shred_pos ), coeff[ k ][ j+1UL ] ) );
+        out2 = GF_ADD( out2, GF_MUL_VAR( gf_ldu( in[ j+2UL ] + shred_pos ), coeff[ k ][ j+2UL ] ) );
+        out3 = GF_ADD( out3, GF_MUL_VAR( gf_ldu( in[ j+3UL ] + shred_pos ), coeff[ k ][ j+3UL ] ) );
+      }
+      for( ; j<src_cnt; j++ ) out0 = GF_ADD( out0, GF_MUL_VAR( gf_ldu( in[ j ] + shred_pos ), coeff[ k ][ j ] ) );
+      gf_stu( shred[ dst[ k ] ] + shred_pos, GF_ADD( GF_ADD( out0, out1 ), GF_ADD( out2, out3 ) ) );
+    }
+    shred_pos += GF_WIDTH;
+    shred_pos = fd_ulong_if( ((shred_sz-GF_WIDTH)<shred_pos) & (shred_pos<shred_sz), shred_sz-GF_WIDTH, shred_pos );
+  }
+  return FD_REEDSOL_SUCCESS;
+}
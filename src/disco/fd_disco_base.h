@@ -10,6 +10,7 @@
 #define DST_PROTO_TPU_UDP  (1UL)
 #define DST_PROTO_TPU_QUIC (2UL)
 #define DST_PROTO_SHRED    (3UL)
+#define DST_PROTO_SHRED_BATCH (4UL)
 
 #define POH_PKT_TYPE_MICROBLOCK    (0UL)
 #define POH_PKT_TYPE_BECAME_LEADER (1UL)
@@ -27,6 +28,13 @@
    asserted in fd_shred_tile.c). */
 #define FD_SHRED_STORE_MTU (41792UL)
 
+/* FD_SHRED_SIGN_INFLIGHT_MAX is the max number of FEC sets the shred
+   tile has made from microblocks and is waiting on the sign tile to
+   sign the Merkle root of.  The shred tile keeps shredding while
+   signatures are in flight, so the shred->store dcache needs room for
+   this many more FEC sets. */
+#define FD_SHRED_SIGN_INFLIGHT_MAX (16UL)
+
 /* FD_TPU_DCACHE_MTU is the max size of a dcache entry */
 #define FD_TPU_DCACHE_MTU (FD_TPU_MTU + FD_TXN_MAX_SZ + 2UL)
 /* The literal value of FD_TPU_DCACHE_MTU is used in some of the Rust
@@ -34,6 +42,27 @@
    in the Rust code. */
 FD_STATIC_ASSERT( FD_TPU_DCACHE_MTU==2086UL, tpu_dcache_mtu_check );
 
+/* When shred coalescing is enabled, the net tile publishes a run of
+   consecutive incoming shred packets as a single DST_PROTO_SHRED_BATCH
+   frag rather than one DST_PROTO_SHRED frag per packet.  The frag is an
+   fd_net_shred_batch_t followed by the UDP payloads of the packets (the
+   network headers are stripped): shred i of the batch is bytes
+   [off[i],off[i+1]) of the frag, for i in [0,cnt).  A batch holds at
+   most FD_NET_SHRED_BATCH_MAX shreds, and a batch of up to max shreds
+   is at most FD_NET_SHRED_BATCH_MTU( max ) bytes. */
+
+#define FD_NET_SHRED_BATCH_MAX (16UL)
+
+struct fd_net_shred_batch {
+  ushort cnt;
+  ushort off[ FD_NET_SHRED_BATCH_MAX+1UL ];
+};
+
+typedef struct fd_net_shred_batch fd_net_shred_batch_t;
+
+#define FD_NET_SHRED_BATCH_MTU( max ) (sizeof(fd_net_shred_batch_t) + (max)*FD_NET_MTU)
+FD_STATIC_ASSERT( FD_NET_SHRED_BATCH_MTU( FD_NET_SHRED_BATCH_MAX )<=USHORT_MAX, net_shred_batch_mtu );
+
 #define FD_NETMUX_SIG_MIN_HDR_SZ    ( 42UL) /* The default header size, which means no vlan tags and no IP options. */
 #define FD_NETMUX_SIG_IGNORE_HDR_SZ (102UL) /* Outside the allowable range, but still fits in 4 bits when compressed */
 
@@ -70,6 +99,15 @@ FD_FN_CONST static inline uint  fd_disco_netmux_sig_dst_ip( ulong sig ) { return
    offset. */
 FD_FN_CONST static inline ulong  fd_disco_netmux_sig_hdr_sz( ulong sig ) { return 4UL*((sig>>44UL) & 0xFUL) + 42UL; }
 
+/* fd_disco_netmux_sig_set_hash returns sig with the hash replaced by
+   the low 8 bits of hash, e.g. to partition by the network device queue
+   a packet arrived on rather than by source address. */
+FD_FN_CONST static inline ulong
+fd_disco_netmux_sig_set_hash( ulong sig,
+                              ulong hash ) {
+  return (sig & ((1UL<<56UL)-1UL)) | ((hash&0xFFUL)<<56UL);
+}
+
 FD_FN_CONST static inline ulong
 fd_disco_poh_sig( ulong slot,
                   ulong pkt_type,
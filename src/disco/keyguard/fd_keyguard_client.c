@@ -4,41 +4,67 @@ void *
 fd_keyguard_client_new( void *         shmem,
                       fd_frag_meta_t * request_mcache,
                       uchar *          request_data,
+                      ulong            request_mtu,
                       fd_frag_meta_t * response_mcache,
                       uchar *          response_data ) {
   fd_keyguard_client_t * client = (fd_keyguard_client_t*)shmem;
-  client->request      = request_mcache;
-  client->request_seq  = 0UL;
-  client->request_data = request_data;
+  client->request       = request_mcache;
+  client->request_depth = fd_mcache_depth( request_mcache );
+  client->request_seq   = 0UL;
+  client->request_data  = request_data;
+  client->request_chunk = fd_dcache_compact_chunk0( request_data, request_data );
+  client->request_wmark = fd_dcache_compact_wmark ( request_data, request_data, request_mtu );
 
-  client->response      = response_mcache;
-  client->response_seq  = 0UL;
-  client->response_data = response_data;
+  client->response       = response_mcache;
+  client->response_seq   = 0UL;
+  client->response_data  = response_data;
+  client->response_wmark = fd_dcache_compact_wmark( response_data, response_data, 64UL );
   return shmem;
 }
 
 void
-fd_keyguard_client_sign( fd_keyguard_client_t * client,
-                         uchar *                signature,
-                         uchar const *          sign_data,
-                         ulong                  sign_data_len ) {
-  fd_memcpy( client->request_data, sign_data, sign_data_len );
-
-  fd_mcache_publish( client->request, 128UL, client->request_seq, 0UL, 0UL, sign_data_len, 0UL, 0UL, 0UL );
-  client->request_seq = fd_seq_inc( client->request_seq, 1UL );
-
-  fd_frag_meta_t meta;
-  fd_frag_meta_t const * mline;
-  ulong seq_found;
-  long seq_diff;
-  ulong poll_max = ULONG_MAX;
-  FD_MCACHE_WAIT( &meta, mline, seq_found, seq_diff, poll_max, client->response, 128UL, client->response_seq );
-  if( FD_UNLIKELY( !poll_max ) ) FD_LOG_ERR(( "sign request timed out while polling" ));
+fd_keyguard_client_sign_req( fd_keyguard_client_t * client,
+                             uchar const *          sign_data,
+                             ulong                  sign_data_len ) {
+  if( FD_UNLIKELY( fd_keyguard_client_sign_inflight( client )>=client->request_depth ) )
+    FD_LOG_ERR(( "too many sign requests in flight" ));
+
+  ulong chunk = client->request_chunk;
+  fd_memcpy( fd_chunk_to_laddr( client->request_data, chunk ), sign_data, sign_data_len );
+
+  fd_mcache_publish( client->request, client->request_depth, client->request_seq, 0UL, chunk, sign_data_len, 0UL, 0UL, 0UL );
+  client->request_seq   = fd_seq_inc( client->request_seq, 1UL );
+  client->request_chunk = fd_dcache_compact_next( chunk, sign_data_len, 0UL, client->request_wmark );
+}
+
+int
+fd_keyguard_client_sign_poll( fd_keyguard_client_t * client,
+                              uchar *                signature ) {
+  fd_frag_meta_t const * mline = client->response + fd_mcache_line_idx( client->response_seq, fd_mcache_depth( client->response ) );
+
+  FD_COMPILER_MFENCE();
+  ulong seq_found = fd_frag_meta_seq_query( mline );
+  ulong chunk     = mline->chunk;
+  FD_COMPILER_MFENCE();
+
+  long seq_diff = fd_seq_diff( seq_found, client->response_seq );
+  if( FD_LIKELY( seq_diff<0L ) ) return 0; /* not signed yet */
   if( FD_UNLIKELY( seq_diff ) ) FD_LOG_ERR(( "sign request was overrun while polling" ));
+  if( FD_UNLIKELY( chunk>client->response_wmark ) ) FD_LOG_ERR(( "sign response chunk %lu corrupt", chunk ));
 
-  fd_memcpy( signature, client->response_data, 64UL );
+  fd_memcpy( signature, fd_chunk_to_laddr_const( client->response_data, chunk ), 64UL );
 
   seq_found = fd_frag_meta_seq_query( mline );
   if( FD_UNLIKELY( fd_seq_ne( seq_found, client->response_seq ) ) ) FD_LOG_ERR(( "sign request was overrun while reading" ));
   client->response_seq = fd_seq_inc( client->response_seq, 1UL );
+  return 1;
+}
+
+void
+fd_keyguard_client_sign( fd_keyguard_client_t * client,
+                         uchar *                signature,
+                         uchar const *          sign_data,
+                         ulong                  sign_data_len ) {
+  fd_keyguard_client_sign_req( client, sign_data, sign_data_len );
+  while( !fd_keyguard_client_sign_poll( client, signature ) ) FD_SPIN_PAUSE();
 }
@@ -22,7 +22,15 @@
 
     (d) Each input/output mcache correspond to a single role, and the
         keyguard tile verifies that all incoming requests are
-        specifically formatted for that role. */        
+        specifically formatted for that role.
+
+   Besides the blocking fd_keyguard_client_sign, the client can have
+   several requests in flight at once (fd_keyguard_client_sign_req and
+   fd_keyguard_client_sign_poll), so the caller can keep working while
+   the keyguard tile signs.  The keyguard tile answers the requests of a
+   client in the order they were made.  Each request and response is in
+   its own slot of the data region, given by the chunk of its frag,
+   relative to the start of the data region. */
 
 #include "../fd_disco_base.h"
 
@@ -31,21 +39,31 @@
 
 struct __attribute__((aligned(FD_KEYGUARD_CLIENT_ALIGN))) fd_keyguard_client {
   fd_frag_meta_t * request;
+  ulong            request_depth;
   ulong            request_seq;
   uchar          * request_data;
+  ulong            request_chunk;
+  ulong            request_wmark;
 
   fd_frag_meta_t * response;
   ulong            response_seq;
   uchar          * response_data;
+  ulong            response_wmark;
 };
 typedef struct fd_keyguard_client fd_keyguard_client_t;
 
 FD_PROTOTYPES_BEGIN
 
+/* fd_keyguard_client_new formats shmem as a client sending requests of
+   at most request_mtu bytes on request_mcache and request_data (a local
+   join to the mcache and the data region of a dcache), and receiving
+   the responses on response_mcache and response_data. */
+
 void *
 fd_keyguard_client_new( void *           shmem,
                         fd_frag_meta_t * request_mcache,
                         uchar *          request_data,
+                        ulong            request_mtu,
                         fd_frag_meta_t * response_mcache,
                         uchar *          response_data );
 
@@ -74,7 +92,10 @@ fd_keyguard_client_delete( void * shclient ) { return shclient; }
     will abort the whole program with a critical error.
     
     The response, a 64 byte signature, will be written into the signature
-    buffer, which must be at least this size. */
+    buffer, which must be at least this size.
+
+    There must be no requests made with fd_keyguard_client_sign_req in
+    flight. */
 
 void
 fd_keyguard_client_sign( fd_keyguard_client_t * client,
@@ -82,6 +103,39 @@ fd_keyguard_client_sign( fd_keyguard_client_t * client,
                          uchar const *          sign_data,
                          ulong                  sign_data_len );
 
+/* fd_keyguard_client_sign_inflight returns the number of requests made
+   with fd_keyguard_client_sign_req whose response has not been consumed
+   by fd_keyguard_client_sign_poll yet. */
+
+static inline ulong
+fd_keyguard_client_sign_inflight( fd_keyguard_client_t const * client ) {
+  return (ulong)fd_seq_diff( client->request_seq, client->response_seq );
+}
+
+/* fd_keyguard_client_sign_req sends a remote signing request for the
+   sign_data_len bytes at sign_data, like fd_keyguard_client_sign, but
+   returns without waiting for the response.  The signature is later
+   obtained with fd_keyguard_client_sign_poll.  The request is copied,
+   so sign_data can be reused on return.
+
+   The number of requests in flight must be less than the depth of the
+   request mcache, else the oldest ones could be overrun before the
+   keyguard tile reads them (this is a fatal error). */
+
+void
+fd_keyguard_client_sign_req( fd_keyguard_client_t * client,
+                             uchar const *          sign_data,
+                             ulong                  sign_data_len );
+
+/* fd_keyguard_client_sign_poll checks whether the response to the
+   oldest request in flight has arrived.  If so, writes the 64 byte
+   signature to signature and returns 1.  Otherwise, returns 0 without
+   blocking.  Requests are answered in the order they were made. */
+
+int
+fd_keyguard_client_sign_poll( fd_keyguard_client_t * client,
+                              uchar *                signature );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_disco_keyguard_fd_keyguard_client_h */
@@ -0,0 +1,112 @@
+#include "fd_keyguard_client.h"
+
+#define DEPTH   (128UL)
+#define REQ_MTU (32UL)
+
+static uchar __attribute__((aligned(FD_MCACHE_ALIGN))) req_mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ];
+static uchar __attribute__((aligned(FD_MCACHE_ALIGN))) res_mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ];
+static uchar __attribute__((aligned(FD_DCACHE_ALIGN))) req_dcache_mem[ FD_DCACHE_FOOTPRINT( FD_DCACHE_REQ_DATA_SZ( REQ_MTU, DEPTH, 1UL, 1 ), 0UL ) ];
+static uchar __attribute__((aligned(FD_DCACHE_ALIGN))) res_dcache_mem[ FD_DCACHE_FOOTPRINT( FD_DCACHE_REQ_DATA_SZ( 64UL,    DEPTH, 1UL, 1 ), 0UL ) ];
+
+/* server emulates the sign tile: it answers the requests from seq
+   *_req_seq on in order, up to max of them, with a fake signature made
+   of the request repeated.  Returns the number answered. */
+
+static ulong
+server( fd_frag_meta_t const * req_mcache,
+        uchar const *          req_data,
+        fd_frag_meta_t *       res_mcache,
+        uchar *                res_data,
+        ulong *                _req_seq,
+        ulong *                _res_chunk,
+        ulong                  max ) {
+  ulong res_wmark = fd_dcache_compact_wmark( res_data, res_data, 64UL );
+  ulong cnt       = 0UL;
+  while( cnt<max ) {
+    ulong req_seq = *_req_seq;
+    fd_frag_meta_t const * mline = req_mcache + fd_mcache_line_idx( req_seq, DEPTH );
+    if( fd_seq_ne( fd_frag_meta_seq_query( mline ), req_seq ) ) break;
+
+    uchar const * req = fd_chunk_to_laddr_const( req_data, mline->chunk );
+    FD_TEST( mline->sz==REQ_MTU );
+    uchar * sig = fd_chunk_to_laddr( res_data, *_res_chunk );
+    fd_memcpy( sig,           req, 32UL );
+    fd_memcpy( sig+32UL,      req, 32UL );
+
+    fd_mcache_publish( res_mcache, DEPTH, req_seq, 0UL, *_res_chunk, 64UL, 0UL, 0UL, 0UL );
+    *_res_chunk = fd_dcache_compact_next( *_res_chunk, 64UL, 0UL, res_wmark );
+    *_req_seq   = fd_seq_inc( req_seq, 1UL );
+    cnt++;
+  }
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  fd_frag_meta_t * req_mcache = fd_mcache_join( fd_mcache_new( req_mcache_mem, DEPTH, 0UL, 0UL ) ); FD_TEST( req_mcache );
+  fd_frag_meta_t * res_mcache = fd_mcache_join( fd_mcache_new( res_mcache_mem, DEPTH, 0UL, 0UL ) ); FD_TEST( res_mcache );
+  uchar * req_data = fd_dcache_join( fd_dcache_new( req_dcache_mem, FD_DCACHE_REQ_DATA_SZ( REQ_MTU, DEPTH, 1UL, 1 ), 0UL ) ); FD_TEST( req_data );
+  uchar * res_data = fd_dcache_join( fd_dcache_new( res_dcache_mem, FD_DCACHE_REQ_DATA_SZ( 64UL,    DEPTH, 1UL, 1 ), 0UL ) ); FD_TEST( res_data );
+
+  fd_keyguard_client_t _client[1];
+  fd_keyguard_client_t * client = fd_keyguard_client_join( fd_keyguard_client_new( _client, req_mcache, req_data, REQ_MTU, res_mcache, res_data ) );
+  FD_TEST( client );
+
+  ulong server_seq   = 0UL;
+  ulong server_chunk = 0UL;
+
+  /* Requests are answered in order, with up to a full mcache of them in
+     flight, and the ring of data slots wrapping around */
+
+  uchar sig[ 64 ];
+  ulong req_cnt = 0UL; /* requests made */
+  ulong res_cnt = 0UL; /* responses consumed */
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong r = fd_rng_ulong( rng );
+    ulong burst = fd_ulong_min( r & 31UL, DEPTH-1UL-fd_keyguard_client_sign_inflight( client ) );
+    for( ulong i=0UL; i<burst; i++ ) {
+      uchar msg[ REQ_MTU ];
+      for( ulong j=0UL; j<REQ_MTU; j+=8UL ) FD_STORE( ulong, msg+j, req_cnt*4UL+j/8UL );
+      fd_keyguard_client_sign_req( client, msg, REQ_MTU );
+      req_cnt++;
+    }
+    FD_TEST( fd_keyguard_client_sign_inflight( client )==req_cnt-res_cnt );
+
+    server( req_mcache, req_data, res_mcache, res_data, &server_seq, &server_chunk, (r>>5) & 31UL );
+
+    ulong poll_cnt = (r>>10) & 31UL;
+    for( ulong i=0UL; i<poll_cnt; i++ ) {
+      int ready = fd_keyguard_client_sign_poll( client, sig );
+      FD_TEST( ready==(res_cnt<server_seq) );
+      if( !ready ) break;
+      for( ulong j=0UL; j<64UL; j+=8UL ) FD_TEST( FD_LOAD( ulong, sig+j )==res_cnt*4UL+(j%32UL)/8UL );
+      res_cnt++;
+    }
+  }
+
+  /* Drain */
+
+  server( req_mcache, req_data, res_mcache, res_data, &server_seq, &server_chunk, ULONG_MAX );
+  while( fd_keyguard_client_sign_poll( client, sig ) ) res_cnt++;
+  FD_TEST( res_cnt==req_cnt );
+  FD_TEST( !fd_keyguard_client_sign_inflight( client ) );
+  FD_TEST( !fd_keyguard_client_sign_poll( client, sig ) );
+
+  FD_LOG_NOTICE(( "%lu requests", req_cnt ));
+
+  fd_keyguard_client_delete( fd_keyguard_client_leave( client ) );
+  fd_dcache_delete( fd_dcache_leave( res_data ) );
+  fd_dcache_delete( fd_dcache_leave( req_data ) );
+  fd_mcache_delete( fd_mcache_leave( res_mcache ) );
+  fd_mcache_delete( fd_mcache_leave( req_mcache ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
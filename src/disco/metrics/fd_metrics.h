@@ -4,6 +4,7 @@
 #include "fd_metrics_base.h"
 
 #include "generated/fd_metrics_all.h"
+#include "generated/fd_metrics_net.h"
 #include "generated/fd_metrics_quic.h"
 #include "generated/fd_metrics_pack.h"
 #include "generated/fd_metrics_bank.h"
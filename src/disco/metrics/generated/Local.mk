@@ -1,2 +1,2 @@
-$(call add-hdrs,fd_metrics_all.h fd_metrics_quic.h)
-$(call add-objs,fd_metrics_all fd_metrics_quic fd_metrics_pack fd_metrics_bank,fd_disco)
+$(call add-hdrs,fd_metrics_all.h fd_metrics_net.h fd_metrics_quic.h)
+$(call add-objs,fd_metrics_all fd_metrics_net fd_metrics_quic fd_metrics_pack fd_metrics_bank,fd_disco)
@@ -0,0 +1,9 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+#include "fd_metrics_net.h"
+
+const fd_metrics_meta_t FD_METRICS_NET[FD_METRICS_NET_TOTAL] = {
+    DECLARE_METRIC_COUNTER( NET_TILE, XDP_RX_WAKEUP ),
+    DECLARE_METRIC_COUNTER( NET_TILE, XDP_TX_WAKEUP ),
+    DECLARE_METRIC_COUNTER( NET_TILE, XDP_RX_WAKEUP_SKIPPED ),
+    DECLARE_METRIC_COUNTER( NET_TILE, XDP_TX_WAKEUP_SKIPPED ),
+};
@@ -0,0 +1,27 @@
+/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
+
+#include "../fd_metrics_base.h"
+
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_OFF  (173UL)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_NAME "net_tile_xdp_rx_wakeup"
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_DESC "Number of recvmsg syscalls issued to wake the driver for XDP receive, including busy polls."
+
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_OFF  (174UL)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_NAME "net_tile_xdp_tx_wakeup"
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_DESC "Number of sendto syscalls issued to wake the driver for XDP transmit, including busy polls."
+
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_SKIPPED_OFF  (175UL)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_SKIPPED_NAME "net_tile_xdp_rx_wakeup_skipped"
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_SKIPPED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_RX_WAKEUP_SKIPPED_DESC "Number of XDP receive wakeups skipped by the adaptive wakeup policy because the RX ring was still backlogged."
+
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_SKIPPED_OFF  (176UL)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_SKIPPED_NAME "net_tile_xdp_tx_wakeup_skipped"
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_SKIPPED_TYPE (FD_METRICS_TYPE_COUNTER)
+#define FD_METRICS_COUNTER_NET_TILE_XDP_TX_WAKEUP_SKIPPED_DESC "Number of XDP transmit busy poll wakeups skipped by the adaptive wakeup policy because the driver was draining the TX ring."
+
+
+#define FD_METRICS_NET_TOTAL (4UL)
+extern const fd_metrics_meta_t FD_METRICS_NET[FD_METRICS_NET_TOTAL];
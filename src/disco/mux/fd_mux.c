@@ -96,6 +96,7 @@ fd_mux_tile( fd_cnc_t *              cnc,
              ulong                   out_cnt,
              ulong **                _out_fseq,
              ulong                   burst,
+             ulong                   burst_frag_max,
              ulong                   cr_max,
              long                    lazy,
              fd_rng_t *              rng,
@@ -373,12 +374,32 @@ fd_mux_tile( fd_cnc_t *              cnc,
 
   } while(0);
 
+  burst_frag_max = fd_ulong_if( !!callbacks->after_burst, fd_ulong_max( burst_frag_max, 1UL ), 1UL );
+  ulong burst_cnt    = 0UL; /* number of frags read from in burst_in_idx since the last after_burst */
+  ulong burst_in_idx = 0UL;
+
+  fd_mux_context_t mux = {
+    .mcache = mcache,
+    .depth = depth,
+    .cr_avail = &cr_avail,
+    .seq = &seq,
+    .cr_decrement_amount = fd_ulong_if( out_cnt>0UL, 1UL, 0UL ),
+    .in_accum = NULL,
+  };
+
   FD_LOG_INFO(( "Running mux" ));
   fd_cnc_signal( cnc, FD_CNC_SIGNAL_RUN );
   long then = fd_tickcount();
   long now  = then;
   for(;;) {
 
+    /* Finish any burst that the last iteration left off in */
+
+    if( FD_UNLIKELY( burst_cnt ) ) {
+      if( FD_LIKELY( callbacks->after_burst ) ) callbacks->after_burst( ctx, burst_in_idx, burst_cnt, &mux );
+      burst_cnt = 0UL;
+    }
+
     /* Do housekeeping at a low rate in the background */
 
     if( FD_UNLIKELY( (now-then)>=0L ) ) {
@@ -520,14 +541,6 @@ fd_mux_tile( fd_cnc_t *              cnc,
       now = next;
     }
 
-    fd_mux_context_t mux = {
-      .mcache = mcache,
-      .depth = depth,
-      .cr_avail = &cr_avail,
-      .seq = &seq,
-      .cr_decrement_amount = fd_ulong_if( out_cnt>0UL, 1UL, 0UL ),
-    };
-
     if( FD_LIKELY( callbacks->before_credit ) ) callbacks->before_credit( ctx, &mux );
 
     /* Check if we are backpressured.  If so, count any transition into
@@ -560,6 +573,7 @@ fd_mux_tile( fd_cnc_t *              cnc,
 
     /* Check if this in has any new fragments to mux */
 
+burst_next:;
     ulong                  this_in_seq   = this_in->seq;
     fd_frag_meta_t const * this_in_mline = this_in->mline; /* Already at appropriate line for this_in_seq */
 
@@ -605,6 +619,10 @@ fd_mux_tile( fd_cnc_t *              cnc,
         long next = fd_tickcount();
         fd_histf_sample( hist_filter1_ticks, (ulong)(next - now) );
         now = next;
+        burst_cnt++;
+        burst_in_idx = (ulong)this_in->idx;
+        if( FD_LIKELY( (burst_cnt<burst_frag_max) & (cr_avail>=cr_filt+burst) ) &&
+            fd_frag_meta_seq_query( this_in->mline )==this_in_seq ) goto burst_next;
         continue;
       }
     }
@@ -645,6 +663,7 @@ fd_mux_tile( fd_cnc_t *              cnc,
       /* We have successfully loaded the metadata.  Decide whether it
           is interesting downstream and publish or filter accordingly. */
 
+      mux.in_accum = this_in->accum;
       if( FD_LIKELY( callbacks->after_frag ) ) callbacks->after_frag( ctx, (ulong)this_in->idx, seq_found, &sig, &chunk, &out_sz, &out_tsorig, &filter, &mux );
     }
 
@@ -681,6 +700,15 @@ fd_mux_tile( fd_cnc_t *              cnc,
     fd_histf_sample( hist_ticks, (ulong)(next - now) );
     fd_histf_sample( hist_sz,    sz );
     now = next;
+
+    /* If the tile handles bursts, keep reading from this in while it
+       has frags ready and we have the credits to publish them, without
+       going back around the run loop.  See fd_mux_after_burst_fn. */
+
+    burst_cnt++;
+    burst_in_idx = (ulong)this_in->idx;
+    if( FD_LIKELY( (burst_cnt<burst_frag_max) & (cr_avail>=cr_filt+burst) ) &&
+        fd_frag_meta_seq_query( this_in->mline )==this_in_seq ) goto burst_next;
   }
 
   do {
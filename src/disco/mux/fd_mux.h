@@ -109,6 +109,7 @@ typedef struct {
    ulong *          cr_avail;
    ulong *          seq;
    ulong            cr_decrement_amount;
+   uint *           in_accum; /* diagnostic accumulators of the in of the frag being read */
 } fd_mux_context_t;
 
 /* fd_mux_during_housekeeping_fn is called during the housekeeping routine,
@@ -258,6 +259,40 @@ typedef void (fd_mux_after_frag_fn)( void *             ctx,
                                      int *              opt_filter,
                                      fd_mux_context_t * mux );
 
+/* fd_mux_after_burst_fn is called after the mux has read a run of up
+   to burst_frag_max (see fd_mux_tile) consecutive frags from the same
+   in within one iteration of the run loop.  Setting this callback is
+   what enables reading frags in runs: without it, the mux reads at most
+   one frag per iteration and goes through housekeeping, the credit
+   callbacks and selecting an in again before reading the next.
+
+   The frags in a run are handed to the usual before_frag, during_frag
+   and after_frag callbacks one at a time as they are read, so a tile
+   can batch work by collecting frags in those callbacks (copying out
+   anything it needs in during_frag as usual) and then processing them
+   together here, e.g. verifying a batch of signatures or inserting a
+   batch of tags into a tcache.  in_idx is the in the frags came from
+   and frag_cnt, which is in [1,burst_frag_max], is the number of frags
+   read from it in this run, including those that were filtered.  Frags
+   that were abandoned because the mux was overrun are not counted.
+
+   The mux only continues a run while it has at least burst credits, so
+   burst should cover the worst case number of frags the tile might
+   publish per frag read, wherever it publishes them, and the credits
+   for a whole run are not reserved up front.  A tile that defers
+   publishing to this callback should use FD_MUX_FLAG_MANUAL_PUBLISH
+   and, so that the mux has credits for everything it defers, a burst
+   of at least burst_frag_max.
+
+   The ctx is a user-provided context object from when the mux tile was
+   initialized.  mux should only be used for calling fd_mux_publish to
+   publish a fragment to downstream consumers. */
+
+typedef void (fd_mux_after_burst_fn)( void *             ctx,
+                                      ulong              in_idx,
+                                      ulong              frag_cnt,
+                                      fd_mux_context_t * mux );
+
 /* By convention, tiles may wish to accumulate high traffic metrics
    locally so they don't cause a lot of cache coherency traffic, and
    then periodically publish them to external observers.  This callback
@@ -285,6 +320,7 @@ typedef struct {
   fd_mux_before_frag_fn * before_frag;
   fd_mux_during_frag_fn * during_frag;
   fd_mux_after_frag_fn  * after_frag;
+  fd_mux_after_burst_fn * after_burst;
 
   fd_mux_metrics_write_fn * metrics_write;
 } fd_mux_callbacks_t;
@@ -443,21 +479,22 @@ fd_mux_tile_scratch_footprint( ulong in_cnt,
                                ulong out_cnt );
 
 int
-fd_mux_tile( fd_cnc_t *              cnc,         /* Local join to the mux's command-and-control */
-             ulong                   flags,       /* Any of FD_MUX_FLAG_* specifying how to run the mux */
-             ulong                   in_cnt,      /* Number of input mcaches to multiplex, inputs are indexed [0,in_cnt) */
-             fd_frag_meta_t const ** in_mcache,   /* in_mcache[in_idx] is the local join to input in_idx's mcache */
-             ulong **                in_fseq,     /* in_fseq  [in_idx] is the local join to input in_idx's fseq */
-             fd_frag_meta_t *        mcache,      /* Local join to the mux's frag stream output mcache */
-             ulong                   out_cnt,     /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
-             ulong **                out_fseq,    /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
-             ulong                   burst,       /* The maximum number of frags this tile publishes per input frag */
-             ulong                   cr_max,      /* Maximum number of flow control credits, 0 means use a reasonable default */
-             long                    lazy,        /* Lazyiness, <=0 means use a reasonable default */
-             fd_rng_t *              rng,         /* Local join to the rng this mux should use */
-             void *                  scratch,     /* Tile scratch memory */
-             void *                  ctx,         /* User supplied context to be passed to the read and process functions */
-             fd_mux_callbacks_t *    callbacks ); /* User supplied callbacks to be invoked during mux tile execution */
+fd_mux_tile( fd_cnc_t *              cnc,            /* Local join to the mux's command-and-control */
+             ulong                   flags,          /* Any of FD_MUX_FLAG_* specifying how to run the mux */
+             ulong                   in_cnt,         /* Number of input mcaches to multiplex, inputs are indexed [0,in_cnt) */
+             fd_frag_meta_t const ** in_mcache,      /* in_mcache[in_idx] is the local join to input in_idx's mcache */
+             ulong **                in_fseq,        /* in_fseq  [in_idx] is the local join to input in_idx's fseq */
+             fd_frag_meta_t *        mcache,         /* Local join to the mux's frag stream output mcache */
+             ulong                   out_cnt,        /* Number of reliable consumers, reliable consumers are indexed [0,out_cnt) */
+             ulong **                out_fseq,       /* out_fseq[out_idx] is the local join to reliable consumer out_idx's fseq */
+             ulong                   burst,          /* The maximum number of frags this tile publishes per input frag */
+             ulong                   burst_frag_max, /* The maximum number of frags to read from an in per run loop iteration, see fd_mux_after_burst_fn */
+             ulong                   cr_max,         /* Maximum number of flow control credits, 0 means use a reasonable default */
+             long                    lazy,           /* Lazyiness, <=0 means use a reasonable default */
+             fd_rng_t *              rng,            /* Local join to the rng this mux should use */
+             void *                  scratch,        /* Tile scratch memory */
+             void *                  ctx,            /* User supplied context to be passed to the read and process functions */
+             fd_mux_callbacks_t *    callbacks );    /* User supplied callbacks to be invoked during mux tile execution */
 
 static inline ulong
 fd_mux_advance( fd_mux_context_t * ctx ) {
@@ -486,6 +523,24 @@ fd_mux_publish( fd_mux_context_t * ctx,
   *seqp = fd_seq_inc( seq, 1UL );
 }
 
+/* fd_mux_filter_deferred accounts a frag of sz bytes as filtered
+   rather than published in the diagnostics of the in it came from.
+   This is for FD_MUX_FLAG_MANUAL_PUBLISH tiles that let a frag through
+   after_frag (leaving the filter flag unset) but only decide whether to
+   publish it once a whole batch of frags is processed (see
+   fd_mux_after_burst_fn), and end up not publishing it.  It must be
+   called from the after_frag or after_burst callback of the run the
+   frag was read in, once per frag dropped. */
+static inline void
+fd_mux_filter_deferred( fd_mux_context_t * ctx,
+                        ulong              sz ) {
+  uint * accum = ctx->in_accum;
+  accum[ FD_METRICS_COUNTER_LINK_PUBLISHED_COUNT_OFF      ]--;
+  accum[ FD_METRICS_COUNTER_LINK_PUBLISHED_SIZE_BYTES_OFF ] -= (uint)sz;
+  accum[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF       ]++;
+  accum[ FD_METRICS_COUNTER_LINK_FILTERED_SIZE_BYTES_OFF  ] += (uint)sz;
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_disco_mux_fd_mux_h */
@@ -82,7 +82,7 @@ main( int     argc,
   FD_LOG_NOTICE(( "Run" ));
 
   fd_mux_callbacks_t callbacks = {0};
-  int err = fd_mux_tile( cnc, FD_MUX_FLAG_DEFAULT, in_cnt, in_mcache, in_fseq, mcache, out_cnt, out_fseq, 1UL, cr_max, lazy, rng, scratch, NULL, &callbacks );
+  int err = fd_mux_tile( cnc, FD_MUX_FLAG_DEFAULT, in_cnt, in_mcache, in_fseq, mcache, out_cnt, out_fseq, 1UL, 1UL, cr_max, lazy, rng, scratch, NULL, &callbacks );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_mux_tile failed (%i)", err ));
 
   FD_LOG_NOTICE(( "Fini" ));
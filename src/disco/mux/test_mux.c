@@ -38,6 +38,7 @@ struct test_cfg {
   uchar *     mux_mcache_mem;
   uchar *     mux_scratch_mem;
   ulong       mux_cr_max;
+  ulong       mux_burst_frag_max;
   long        mux_lazy;
   uint        mux_seed;
 
@@ -258,6 +259,18 @@ tx_tile_main( int     argc,
 
 /* MUX tile ***********************************************************/
 
+/* mux_after_burst is a no-op after_burst callback installed when
+   --mux-burst is larger than 1 so the mux reads frags in runs. */
+
+static void
+mux_after_burst( void *             ctx,
+                 ulong              in_idx,
+                 ulong              frag_cnt,
+                 fd_mux_context_t * mux ) {
+  (void)ctx; (void)in_idx; (void)mux;
+  FD_TEST( frag_cnt );
+}
+
 static int
 mux_tile_main( int     argc,
                char ** argv ) {
@@ -287,8 +300,9 @@ mux_tile_main( int     argc,
   fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, cfg->mux_seed, 0UL ) );
 
   fd_mux_callbacks_t callbacks = {0};
+  if( cfg->mux_burst_frag_max>1UL ) callbacks.after_burst = mux_after_burst;
   int err = fd_mux_tile( cnc, FD_MUX_FLAG_DEFAULT, cfg->tx_cnt, tx_mcache, tx_fseq, mux_mcache, cfg->rx_cnt, rx_fseq,
-                         1UL, cfg->mux_cr_max, cfg->mux_lazy, rng, cfg->mux_scratch_mem, NULL, &callbacks );
+                         1UL, cfg->mux_burst_frag_max, cfg->mux_cr_max, cfg->mux_lazy, rng, cfg->mux_scratch_mem, NULL, &callbacks );
   if( FD_UNLIKELY( err ) ) FD_LOG_ERR(( "fd_mux_tile failed (%i)", err ));
 
   fd_rng_delete( fd_rng_leave( rng ) );
@@ -450,6 +464,7 @@ main( int     argc,
   long         tx_lazy    = fd_env_strip_cmdline_long ( &argc, &argv, "--tx-lazy",    NULL, 0L                           );
   ulong        mux_depth  = fd_env_strip_cmdline_ulong( &argc, &argv, "--mux-depth",  NULL, 32768UL                      );
   ulong        mux_cr_max = fd_env_strip_cmdline_ulong( &argc, &argv, "--mux-cr-max", NULL, 0UL /* use default */        );
+  ulong        mux_burst  = fd_env_strip_cmdline_ulong( &argc, &argv, "--mux-burst",  NULL, 1UL                          );
   long         mux_lazy   = fd_env_strip_cmdline_long ( &argc, &argv, "--mux-lazy",   NULL, 0L /* use default */         );
   ulong        rx_cnt     = fd_env_strip_cmdline_ulong( &argc, &argv, "--rx-cnt",     NULL, 2UL                          );
   int          rx_lazy    = fd_env_strip_cmdline_int  ( &argc, &argv, "--rx-lazy",    NULL, 7                            );
@@ -556,6 +571,7 @@ main( int     argc,
   cfg->mux_mcache_mem  = mux_mcache_mem;
   cfg->mux_scratch_mem = mux_scratch_mem;
   cfg->mux_cr_max      = mux_cr_max;
+  cfg->mux_burst_frag_max = mux_burst;
   cfg->mux_lazy        = mux_lazy;
   cfg->mux_seed        = rng_seq++;
 
@@ -611,8 +627,8 @@ main( int     argc,
   for( ulong tile_idx=1UL; tile_idx<tile_cnt; tile_idx++ )
     FD_TEST( fd_cnc_wait( cnc[ tile_idx ], FD_CNC_SIGNAL_BOOT, (long)5e9, NULL )==FD_CNC_SIGNAL_RUN );
 
-  FD_LOG_NOTICE(( "Running (--duration %li ns, --tx-lazy %li ns, --mux-cr-max %lu, --mux-lazy %li ns, --rx-lazy %i)",
-                  duration, tx_lazy, mux_cr_max, mux_lazy, rx_lazy ));
+  FD_LOG_NOTICE(( "Running (--duration %li ns, --tx-lazy %li ns, --mux-cr-max %lu, --mux-burst %lu, --mux-lazy %li ns, --rx-lazy %i)",
+                  duration, tx_lazy, mux_cr_max, mux_burst, mux_lazy, rx_lazy ));
 
   /* FIXME: DO MONITORING WHILE RUNNING */
   fd_log_sleep( duration );
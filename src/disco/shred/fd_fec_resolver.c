@@ -9,6 +9,17 @@
 #define INCLUSION_PROOF_LAYERS 10UL
 #define SHRED_CNT_NOT_SET      (UINT_MAX/2U)
 
+FD_STATIC_ASSERT( FD_FEC_RESOLVER_BURST_MAX<=FD_BMTREE_BATCH_MAX, burst_max );
+
+/* A FEC set is recovered with fd_reedsol_recover_data_fini when at most
+   1/RECOVER_DATA_RATIO of its data shreds are missing, which is about
+   where it stops being faster than fd_reedsol_recover_fini (see
+   test_fec_resolver).  Recovery starts as soon as data_shred_cnt shreds
+   have been received, so at most one parity shred more than the number
+   of missing data shreds has been received at that point. */
+#define RECOVER_DATA_RATIO     4UL
+#define PARITY_SCRATCH_CNT     (FD_REEDSOL_DATA_SHREDS_MAX/RECOVER_DATA_RATIO + 1UL)
+
 typedef union {
   fd_ed25519_sig_t u;
   ulong            l;
@@ -122,6 +133,23 @@ struct __attribute__((aligned(FD_FEC_RESOLVER_ALIGN))) fd_fec_resolver {
   fd_sha512_t   sha512[1];
   fd_reedsol_t  reedsol[1];
 
+  /* parity_scratch: where the parity shreds that were received are
+     re-encoded to when recovering only the missing data shreds.  Like
+     the above, indeterminate outside a call to add_shred. */
+  uchar parity_scratch[ PARITY_SCRATCH_CNT ][ FD_SHRED_MAX_SZ ];
+
+  /* burst_*: the shreds buffered by the last call to
+     fd_fec_resolver_buffer_burst, indexed [0,burst_cnt).  burst_leaf
+     holds the Merkle leaf of each one.  If burst_tree is not NULL, the
+     shred has been inserted into that Merkle tree already, with result
+     burst_ok.  The entries for a tree are reset when it leaves its FEC
+     set. */
+  ulong                burst_cnt;
+  fd_shred_t const *   burst_shred[ FD_FEC_RESOLVER_BURST_MAX ];
+  fd_bmtree_commit_t * burst_tree [ FD_FEC_RESOLVER_BURST_MAX ];
+  int                  burst_ok   [ FD_FEC_RESOLVER_BURST_MAX ];
+  fd_bmtree_node_t     burst_leaf [ FD_FEC_RESOLVER_BURST_MAX ];
+
   /* The footprint for the objects follows the struct and is in the same
      order as the pointers, namely:
        curr_map map
@@ -218,6 +246,7 @@ fd_fec_resolver_new( void         * shmem,
   resolver->partial_depth  = partial_depth;
   resolver->complete_depth = complete_depth;
   resolver->done_depth     = done_depth;
+  resolver->burst_cnt      = 0UL;
   return shmem;
 }
 
@@ -277,6 +306,136 @@ ctx_ll_insert( set_ctx_t * p, set_ctx_t * c ) {
   return c;
 }
 
+/* shred_position validates the fields of shred that determine where
+   it goes in the Merkle tree of its FEC set.  Returns 0 if the shred
+   should be rejected.  Otherwise, returns 1 and writes the index of the
+   shred among the shreds of its type to *_in_type_idx, its index in
+   the Merkle tree to *_shred_idx and the number of bytes after the
+   signature that its leaf covers to *_merkle_protected_sz. */
+static int
+shred_position( fd_shred_t const * shred,
+                ulong *            _in_type_idx,
+                ulong *            _shred_idx,
+                ulong *            _merkle_protected_sz ) {
+  uchar variant       = shred->variant;
+  int   is_data_shred = fd_shred_type( variant )==FD_SHRED_TYPE_MERKLE_DATA;
+
+  if( !is_data_shred ) { /* Roughly 50/50 branch */
+    if( FD_UNLIKELY( (shred->code.data_cnt>FD_REEDSOL_DATA_SHREDS_MAX) | (shred->code.code_cnt>FD_REEDSOL_PARITY_SHREDS_MAX) ) ) return 0;
+    if( FD_UNLIKELY( (shred->code.data_cnt==0UL) | (shred->code.code_cnt==0UL) ) ) return 0;
+  }
+
+  /* For the purposes of the shred header, tree_depth means the number
+     of nodes, counting the leaf but excluding the root.  For bmtree,
+     depth means the number of layers, which counts both. */
+  ulong tree_depth           = fd_shred_merkle_cnt( variant ); /* In [0, 15] */
+  ulong reedsol_protected_sz = 1115UL - 20UL*tree_depth + 0x58UL - 0x40UL; /* Cannot underflow */
+  ulong merkle_protected_sz  = reedsol_protected_sz + fd_ulong_if( is_data_shred, 0UL, 0x59UL - 0x40UL );
+
+  /* in_type_idx is between [0, code.data_cnt) or [0, code.code_cnt),
+     where data_cnt <= FD_REEDSOL_DATA_SHREDS_MAX and code_cnt <=
+     FD_REEDSOL_PARITY_SHREDS_MAX.
+     On the other hand, shred_idx, goes from [0, code.data_cnt +
+     code.code_cnt), with all the data shreds having
+     shred_idx < code.data_cnt and all the parity shreds having
+     shred_idx >= code.data_cnt. */
+  ulong in_type_idx = fd_ulong_if( is_data_shred, shred->idx - shred->fec_set_idx, shred->code.idx );
+  ulong shred_idx   = fd_ulong_if( is_data_shred, in_type_idx, in_type_idx + shred->code.data_cnt  );
+
+  if( FD_UNLIKELY( in_type_idx >= fd_ulong_if( is_data_shred, FD_REEDSOL_DATA_SHREDS_MAX, FD_REEDSOL_PARITY_SHREDS_MAX ) ) ) return 0;
+  /* This, combined with the check on shred->code.data_cnt implies that
+     shred_idx is in [0, DATA_SHREDS_MAX+PARITY_SHREDS_MAX). */
+
+  if( FD_UNLIKELY( fd_bmtree_depth( shred_idx+1UL ) > tree_depth+1UL ) ) return 0;
+
+  *_in_type_idx         = in_type_idx;
+  *_shred_idx           = shred_idx;
+  *_merkle_protected_sz = merkle_protected_sz;
+  return 1;
+}
+
+/* burst_forget drops the results in the buffered burst for shreds
+   that were inserted into tree, which is about to leave its FEC set.
+   Returns tree. */
+static fd_bmtree_commit_t *
+burst_forget( fd_fec_resolver_t  * resolver,
+              fd_bmtree_commit_t * tree ) {
+  for( ulong i=0UL; i<resolver->burst_cnt; i++ ) {
+    if( resolver->burst_tree[ i ]==tree ) resolver->burst_tree[ i ] = NULL;
+  }
+  return tree;
+}
+
+void
+fd_fec_resolver_buffer_burst( fd_fec_resolver_t        * resolver,
+                              fd_shred_t const * const * shred,
+                              ulong                      cnt ) {
+  set_ctx_t * curr_map = resolver->curr_map;
+  set_ctx_t * done_map = resolver->done_map;
+
+  void const *         leaf_data   [ FD_FEC_RESOLVER_BURST_MAX ];
+  ulong                leaf_data_sz[ FD_FEC_RESOLVER_BURST_MAX ];
+  fd_bmtree_commit_t * tree        [ FD_FEC_RESOLVER_BURST_MAX ];
+  ulong                shred_idx   [ FD_FEC_RESOLVER_BURST_MAX ];
+  fd_bmtree_node_t     leaf        [ FD_FEC_RESOLVER_BURST_MAX ];
+  uchar const *        proof       [ FD_FEC_RESOLVER_BURST_MAX ];
+  ulong                proof_depth [ FD_FEC_RESOLVER_BURST_MAX ];
+  ulong                burst_idx   [ FD_FEC_RESOLVER_BURST_MAX ];
+
+  /* Skip the shreds add_shred would reject or ignore before hashing
+     anything.  About half of them are for FEC sets that are done. */
+  ulong burst_cnt = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_shred_t const * s     = shred[ i ];
+    wrapped_sig_t    * w_sig = (wrapped_sig_t *)s->signature;
+    if( FD_UNLIKELY( ctx_map_key_inval( *w_sig ) ) ) continue;
+    if( ctx_map_query( done_map, *w_sig, NULL )    ) continue;
+
+    ulong in_type_idx;
+    ulong merkle_protected_sz;
+    if( FD_UNLIKELY( !shred_position( s, &in_type_idx, shred_idx+burst_cnt, &merkle_protected_sz ) ) ) continue;
+
+    set_ctx_t * ctx = ctx_map_query( curr_map, *w_sig, NULL );
+    if( FD_LIKELY( ctx ) ) {
+      int is_data_shred = fd_shred_type( s->variant )==FD_SHRED_TYPE_MERKLE_DATA;
+      int shred_dup = fd_int_if( is_data_shred, d_rcvd_test( ctx->set->data_shred_rcvd,   in_type_idx ),
+                                                p_rcvd_test( ctx->set->parity_shred_rcvd, in_type_idx ) );
+      if( FD_UNLIKELY( shred_dup ) ) continue;
+    }
+
+    resolver->burst_shred[ burst_cnt ] = s;
+    resolver->burst_tree [ burst_cnt ] = NULL;
+    leaf_data   [ burst_cnt ] = (uchar const *)s + sizeof(fd_ed25519_sig_t);
+    leaf_data_sz[ burst_cnt ] = merkle_protected_sz;
+    tree        [ burst_cnt ] = ctx ? ctx->tree : NULL;
+    burst_cnt++;
+  }
+  resolver->burst_cnt = burst_cnt;
+  if( FD_UNLIKELY( !burst_cnt ) ) return;
+
+  fd_bmtree_hash_leaves_batch( resolver->burst_leaf, leaf_data, leaf_data_sz, FD_BMTREE_LONG_PREFIX_SZ, burst_cnt );
+
+  /* The first shred of an FEC set has to be inserted into a new tree
+     and its root verified with the signature, which add_shred does.
+     The rest only extend a tree that's already verified. */
+  ulong verify_cnt = 0UL;
+  for( ulong i=0UL; i<burst_cnt; i++ ) {
+    if( !tree[ i ] ) continue;
+    tree       [ verify_cnt ] = tree[ i ];
+    shred_idx  [ verify_cnt ] = shred_idx[ i ];
+    leaf       [ verify_cnt ] = resolver->burst_leaf[ i ];
+    proof      [ verify_cnt ] = (uchar const *)fd_shred_merkle_nodes( resolver->burst_shred[ i ] );
+    proof_depth[ verify_cnt ] = fd_shred_merkle_cnt( resolver->burst_shred[ i ]->variant );
+    burst_idx  [ verify_cnt ] = i;
+    verify_cnt++;
+  }
+
+  ulong ok = fd_bmtree_verify_proofs_batch( tree, shred_idx, leaf, proof, proof_depth, NULL, verify_cnt );
+  for( ulong j=0UL; j<verify_cnt; j++ ) {
+    resolver->burst_tree[ burst_idx[ j ] ] = tree[ j ];
+    resolver->burst_ok  [ burst_idx[ j ] ] = fd_ulong_extract_bit( ok, (int)j );
+  }
+}
 
 int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
                                fd_shred_t   const   * shred,
@@ -319,43 +478,28 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
 
   set_ctx_t * ctx = ctx_map_query( curr_map, *w_sig, NULL );
 
-  fd_bmtree_node_t leaf[1];
   uchar variant    = shred->variant;
   uchar shred_type = fd_shred_type( variant );
 
   int is_data_shred = shred_type==FD_SHRED_TYPE_MERKLE_DATA;
 
-  if( !is_data_shred ) { /* Roughly 50/50 branch */
-    if( FD_UNLIKELY( (shred->code.data_cnt>FD_REEDSOL_DATA_SHREDS_MAX) | (shred->code.code_cnt>FD_REEDSOL_PARITY_SHREDS_MAX) ) )
-      return FD_FEC_RESOLVER_SHRED_REJECTED;
-    if( FD_UNLIKELY( (shred->code.data_cnt==0UL) | (shred->code.code_cnt==0UL) ) ) return FD_FEC_RESOLVER_SHRED_REJECTED;
-  }
-
-  /* For the purposes of the shred header, tree_depth means the number
-     of nodes, counting the leaf but excluding the root.  For bmtree,
-     depth means the number of layers, which counts both. */
-  ulong tree_depth           = fd_shred_merkle_cnt( variant ); /* In [0, 15] */
-  ulong reedsol_protected_sz = 1115UL - 20UL*tree_depth + 0x58UL - 0x40UL; /* Cannot underflow */
-  ulong merkle_protected_sz  = reedsol_protected_sz + fd_ulong_if( is_data_shred, 0UL, 0x59UL - 0x40UL );
+  ulong in_type_idx;
+  ulong shred_idx;
+  ulong merkle_protected_sz;
+  if( FD_UNLIKELY( !shred_position( shred, &in_type_idx, &shred_idx, &merkle_protected_sz ) ) ) return FD_FEC_RESOLVER_SHRED_REJECTED;
 
-  fd_bmtree_hash_leaf( leaf, (uchar const *)shred + sizeof(fd_ed25519_sig_t), merkle_protected_sz, FD_BMTREE_LONG_PREFIX_SZ );
+  ulong tree_depth           = fd_shred_merkle_cnt( variant );
+  ulong reedsol_protected_sz = 1115UL - 20UL*tree_depth + 0x58UL - 0x40UL;
 
-  /* in_type_idx is between [0, code.data_cnt) or [0, code.code_cnt),
-     where data_cnt <= FD_REEDSOL_DATA_SHREDS_MAX and code_cnt <=
-     FD_REEDSOL_PARITY_SHREDS_MAX.
-     On the other hand, shred_idx, goes from [0, code.data_cnt +
-     code.code_cnt), with all the data shreds having
-     shred_idx < code.data_cnt and all the parity shreds having
-     shred_idx >= code.data_cnt. */
-  ulong in_type_idx = fd_ulong_if( is_data_shred, shred->idx - shred->fec_set_idx, shred->code.idx );
-  ulong shred_idx   = fd_ulong_if( is_data_shred, in_type_idx, in_type_idx + shred->code.data_cnt  );
-
-  if( FD_UNLIKELY( in_type_idx >= fd_ulong_if( is_data_shred, FD_REEDSOL_DATA_SHREDS_MAX, FD_REEDSOL_PARITY_SHREDS_MAX ) ) )
-    return FD_FEC_RESOLVER_SHRED_REJECTED;
-  /* This, combined with the check on shred->code.data_cnt implies that
-     shred_idx is in [0, DATA_SHREDS_MAX+PARITY_SHREDS_MAX). */
+  /* If the shred was part of the buffered burst, its leaf is already
+     computed, and it may have been inserted into ctx->tree too. */
+  ulong burst_idx = 0UL;
+  while( (burst_idx<resolver->burst_cnt) && (resolver->burst_shred[ burst_idx ]!=shred) ) burst_idx++;
+  int in_burst = burst_idx<resolver->burst_cnt;
 
-  if( FD_UNLIKELY( fd_bmtree_depth( shred_idx+1UL ) > tree_depth+1UL ) ) return FD_FEC_RESOLVER_SHRED_REJECTED;
+  fd_bmtree_node_t leaf[1];
+  if( FD_LIKELY( in_burst ) ) *leaf = resolver->burst_leaf[ burst_idx ];
+  else fd_bmtree_hash_leaf( leaf, (uchar const *)shred + sizeof(fd_ed25519_sig_t), merkle_protected_sz, FD_BMTREE_LONG_PREFIX_SZ );
 
   if( FD_UNLIKELY( !ctx ) ) {
     /* This is the first shred in the FEC set */
@@ -372,7 +516,7 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
       if( FD_UNLIKELY( ctx_map_key_cnt( done_map ) > done_depth ) ) ctx_map_remove( done_map, ctx_ll_remove( done_ll_sentinel->prev ) );
 
       freelist_push_tail( free_list,        victim_ctx->set  );
-      bmtrlist_push_tail( bmtree_free_list, victim_ctx->tree );
+      bmtrlist_push_tail( bmtree_free_list, burst_forget( resolver, victim_ctx->tree ) );
 
       /* Remove from linked list and then from the map */
       ctx_map_remove( curr_map, ctx_ll_remove( victim_ctx ) );
@@ -424,8 +568,12 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
 
     if( FD_UNLIKELY( shred_dup ) ) return FD_FEC_RESOLVER_SHRED_IGNORED;
 
-    fd_shred_merkle_t const * proof = fd_shred_merkle_nodes( shred );
-    int rv = fd_bmtree_commitp_insert_with_proof( ctx->tree, shred_idx, leaf, (uchar const *)proof, tree_depth, NULL );
+    int rv;
+    if( FD_LIKELY( in_burst && resolver->burst_tree[ burst_idx ]==ctx->tree ) ) rv = resolver->burst_ok[ burst_idx ];
+    else {
+      fd_shred_merkle_t const * proof = fd_shred_merkle_nodes( shred );
+      rv = fd_bmtree_commitp_insert_with_proof( ctx->tree, shred_idx, leaf, (uchar const *)proof, tree_depth, NULL );
+    }
     if( !rv ) return FD_FEC_RESOLVER_SHRED_REJECTED;
   }
 
@@ -457,7 +605,7 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
      so we can consider it done either way.  First though, since ctx_map_remove
      can change what's at *ctx, so unpack the values before we do that */
   fd_fec_set_t        * set         = ctx->set;
-  fd_bmtree_commit_t  * tree        = ctx->tree;
+  fd_bmtree_commit_t  * tree        = burst_forget( resolver, ctx->tree );
   ulong                 fec_set_idx = ctx->fec_set_idx;
   ulong                 parity_idx0 = ctx->parity_idx0;
 
@@ -467,6 +615,16 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
   ctx_map_remove( curr_map, ctx_ll_remove( ctx ) );
 
 
+  /* When only a few data shreds are missing (the common case with a
+     little packet loss), it's much cheaper to compute just those and
+     then re-encode the parity than to run the full recovery over the
+     whole set.  The parity shreds we received are re-encoded to scratch
+     and must match, which gives the same consistency guarantee as
+     fd_reedsol_recover_fini. */
+  ulong data_erased_cnt = set->data_shred_cnt - d_rcvd_cnt( set->data_shred_rcvd );
+  ulong parity_rcvd_cnt = p_rcvd_cnt( set->parity_shred_rcvd );
+  int   recover_data    = (data_erased_cnt*RECOVER_DATA_RATIO<=set->data_shred_cnt) & (parity_rcvd_cnt<=PARITY_SCRATCH_CNT);
+
   reedsol = fd_reedsol_recover_init( (void*)reedsol, reedsol_protected_sz );
   for( ulong i=0UL; i<set->data_shred_cnt; i++ ) {
     uchar * rs_payload = set->data_shreds[ i ] + sizeof(fd_ed25519_sig_t);
@@ -479,7 +637,31 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
     else                                           fd_reedsol_recover_add_erased_shred( reedsol, 0, rs_payload );
   }
 
-  if( FD_UNLIKELY( FD_REEDSOL_SUCCESS != fd_reedsol_recover_fini( reedsol ) ) ) {
+  int reedsol_err;
+  if( FD_LIKELY( recover_data ) ) {
+    reedsol_err = fd_reedsol_recover_data_fini( reedsol );
+    if( FD_LIKELY( reedsol_err==FD_REEDSOL_SUCCESS ) ) {
+      reedsol = fd_reedsol_encode_init( (void*)reedsol, reedsol_protected_sz );
+      for( ulong i=0UL; i<set->data_shred_cnt; i++ ) fd_reedsol_encode_add_data_shred( reedsol, set->data_shreds[ i ] + sizeof(fd_ed25519_sig_t) );
+      for( ulong i=0UL, k=0UL; i<set->parity_shred_cnt; i++ ) {
+        if( p_rcvd_test( set->parity_shred_rcvd, i ) ) fd_reedsol_encode_add_parity_shred( reedsol, resolver->parity_scratch[ k++ ]                         );
+        else                                           fd_reedsol_encode_add_parity_shred( reedsol, set->parity_shreds[ i ] + FD_SHRED_CODE_HEADER_SZ );
+      }
+      fd_reedsol_encode_fini( reedsol );
+
+      for( ulong i=0UL, k=0UL; i<set->parity_shred_cnt; i++ ) {
+        if( !p_rcvd_test( set->parity_shred_rcvd, i ) ) continue;
+        if( FD_UNLIKELY( memcmp( resolver->parity_scratch[ k++ ], set->parity_shreds[ i ] + FD_SHRED_CODE_HEADER_SZ, reedsol_protected_sz ) ) ) {
+          reedsol_err = FD_REEDSOL_ERR_CORRUPT;
+          break;
+        }
+      }
+    }
+  } else {
+    reedsol_err = fd_reedsol_recover_fini( reedsol );
+  }
+
+  if( FD_UNLIKELY( FD_REEDSOL_SUCCESS != reedsol_err ) ) {
     /* A few lines up, we already checked to make sure it wasn't the
        insufficient case, so it must be the inconsistent case.  That
        means the leader signed a shred with invalid Reed-Solomon FEC
@@ -490,19 +672,9 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
     bmtrlist_push_tail( bmtree_free_list, tree );
     return FD_FEC_RESOLVER_SHRED_REJECTED;
   }
-  /* Iterate over recovered shreds, add them to the Merkle tree,
-     populate headers and signatures. */
+  /* Iterate over recovered shreds, populate headers and signatures. */
   for( ulong i=0UL; i<set->data_shred_cnt; i++ ) {
-    if( !d_rcvd_test( set->data_shred_rcvd, i ) ) {
-      fd_bmtree_hash_leaf( leaf, set->data_shreds[i]+sizeof(fd_ed25519_sig_t), reedsol_protected_sz, FD_BMTREE_LONG_PREFIX_SZ );
-      if( FD_UNLIKELY( !fd_bmtree_commitp_insert_with_proof( tree, i, leaf, NULL, 0, NULL ) ) ) {
-        freelist_push_tail( free_list,        set  );
-        bmtrlist_push_tail( bmtree_free_list, tree );
-        return FD_FEC_RESOLVER_SHRED_REJECTED;
-      }
-
-      fd_memcpy( set->data_shreds[i], shred, sizeof(fd_ed25519_sig_t) );
-    }
+    if( !d_rcvd_test( set->data_shred_rcvd, i ) ) fd_memcpy( set->data_shreds[i], shred, sizeof(fd_ed25519_sig_t) );
   }
   for( ulong i=0UL; i<set->parity_shred_cnt; i++ ) {
     if( !p_rcvd_test( set->parity_shred_rcvd, i ) ) {
@@ -516,14 +688,41 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
       p_shred->code.data_cnt = (ushort)set->data_shred_cnt;
       p_shred->code.code_cnt = (ushort)set->parity_shred_cnt;
       p_shred->code.idx      = (ushort)i;
+    }
+  }
+
+  /* Then add them to the Merkle tree, hashing the leaves
+     FD_BMTREE_BATCH_MAX at a time.  The Merkle tree index of the i-th
+     parity shred is data_shred_cnt+i. */
+  ulong            missing_idx [ FD_BMTREE_BATCH_MAX ];
+  void const *     missing_data[ FD_BMTREE_BATCH_MAX ];
+  ulong            missing_sz  [ FD_BMTREE_BATCH_MAX ];
+  fd_bmtree_node_t missing_leaf[ FD_BMTREE_BATCH_MAX ];
+  ulong            missing_cnt = 0UL;
+  ulong            total_cnt   = set->data_shred_cnt + set->parity_shred_cnt;
+  for( ulong i=0UL; i<=total_cnt; i++ ) {
+    if( i<total_cnt ) {
+      int   is_data = i<set->data_shred_cnt;
+      ulong j       = fd_ulong_if( is_data, i, i-set->data_shred_cnt );
+      if( fd_int_if( is_data, d_rcvd_test( set->data_shred_rcvd, j ), p_rcvd_test( set->parity_shred_rcvd, j ) ) ) continue;
+
+      uchar * recovered = fd_ptr_if( is_data, set->data_shreds[ j ], set->parity_shreds[ j ] );
+      missing_idx [ missing_cnt ] = i;
+      missing_data[ missing_cnt ] = recovered + sizeof(fd_ed25519_sig_t);
+      missing_sz  [ missing_cnt ] = reedsol_protected_sz + fd_ulong_if( is_data, 0UL, 0x19UL );
+      missing_cnt++;
+      if( missing_cnt<FD_BMTREE_BATCH_MAX ) continue;
+    }
 
-      fd_bmtree_hash_leaf( leaf, set->parity_shreds[i]+ sizeof(fd_ed25519_sig_t), reedsol_protected_sz+0x19UL, FD_BMTREE_LONG_PREFIX_SZ );
-      if( FD_UNLIKELY( !fd_bmtree_commitp_insert_with_proof( tree, set->data_shred_cnt + i, leaf, NULL, 0, NULL ) ) ) {
+    fd_bmtree_hash_leaves_batch( missing_leaf, missing_data, missing_sz, FD_BMTREE_LONG_PREFIX_SZ, missing_cnt );
+    for( ulong k=0UL; k<missing_cnt; k++ ) {
+      if( FD_UNLIKELY( !fd_bmtree_commitp_insert_with_proof( tree, missing_idx[ k ], missing_leaf+k, NULL, 0, NULL ) ) ) {
         freelist_push_tail( free_list,        set  );
         bmtrlist_push_tail( bmtree_free_list, tree );
         return FD_FEC_RESOLVER_SHRED_REJECTED;
       }
     }
+    missing_cnt = 0UL;
   }
 
   /* Check that the whole Merkle tree is consistent. */
@@ -161,6 +161,36 @@ int fd_fec_resolver_add_shred( fd_fec_resolver_t    * resolver,
                                fd_fec_set_t const * * out_fec_set,
                                fd_shred_t   const * * out_shred );
 
+/* FD_FEC_RESOLVER_BURST_MAX is the maximum number of shreds in a burst
+   given to fd_fec_resolver_buffer_burst. */
+#define FD_FEC_RESOLVER_BURST_MAX (16UL)
+
+/* fd_fec_resolver_buffer_burst does the Merkle tree work of adding a
+   burst of shreds ahead of the calls to fd_fec_resolver_add_shred for
+   them, so it can be done for all of them at once.  shred is indexed
+   [0,cnt) with cnt in [0,FD_FEC_RESOLVER_BURST_MAX], and each shred
+   must have passed fd_shred_parse.  The leaves of the shreds that are
+   not obviously duplicates are hashed together, and the inclusion
+   proofs of the ones in FEC sets that are already in progress are
+   verified together, sharing the hashing of the parts of the tree
+   they have in common.
+
+   The burst replaces any previously buffered one.  Until the next call
+   to this function, a call to fd_fec_resolver_add_shred with one of
+   the shred pointers in the burst uses the results instead of doing the
+   work itself, so the shreds must not be modified in the meantime.
+   Passing cnt==0 forgets the buffered burst.
+
+   As long as each shred of the burst is then given to add_shred, in
+   order, the return values are the same as without buffering.  Other
+   uses are safe, but since the shreds are inserted into the Merkle
+   trees of their FEC sets here, which of several inconsistent shreds
+   gets rejected may differ. */
+void
+fd_fec_resolver_buffer_burst( fd_fec_resolver_t        * resolver,
+                              fd_shred_t const * const * shred,
+                              ulong                      cnt );
+
 void * fd_fec_resolver_leave( fd_fec_resolver_t * resolver );
 void * fd_fec_resolver_delete( void * shmem );
 
@@ -107,9 +107,15 @@ fd_shredder_init_batch( fd_shredder_t *               shredder,
 }
 
 
-fd_fec_set_t *
-fd_shredder_next_fec_set( fd_shredder_t * shredder,
-                          fd_fec_set_t * result ) {
+/* fd_shredder_private_next_fec_set produces the next FEC set of the
+   in progress batch.  If root_out is NULL, it signs the Merkle root and
+   writes the signature to all the shreds.  Otherwise, it copies the
+   root to root_out and leaves the signing to the caller. */
+
+static fd_fec_set_t *
+fd_shredder_private_next_fec_set( fd_shredder_t * shredder,
+                                  fd_fec_set_t *  result,
+                                  uchar *         root_out ) {
   uchar const * entry_batch = shredder->entry_batch;
   ulong         offset      = shredder->offset;
   ulong         entry_sz    = shredder->sz;
@@ -213,23 +219,15 @@ fd_shredder_next_fec_set( fd_shredder_t * shredder,
   fd_bmtree_commit_append( bmtree, leaves, data_shred_cnt+parity_shred_cnt );
   uchar * root = fd_bmtree_commit_fini( bmtree );
 
-  /* Sign Merkle Root */
-  shredder->signer( shredder->signer_ctx, root_signature, root );
-
-  /* Write signature and Merkle proof */
+  /* Write Merkle proof */
   for( ulong i=0UL; i<data_shred_cnt; i++ ) {
     fd_shred_t * shred = (fd_shred_t *)data_shreds[ i ];
-    fd_memcpy( shred->signature, root_signature, FD_ED25519_SIG_SZ );
-
     uchar * merkle = data_shreds[ i ] + fd_shred_merkle_off( shred );
     fd_bmtree_get_proof( bmtree, merkle, i );
   }
 
   for( ulong j=0UL; j<parity_shred_cnt; j++ ) {
     fd_shred_t * shred = (fd_shred_t *)parity_shreds[ j ];
-
-    fd_memcpy( shred->signature, root_signature, FD_ED25519_SIG_SZ );
-
     uchar * merkle = parity_shreds[ j ] + fd_shred_merkle_off( shred );
     fd_bmtree_get_proof( bmtree, merkle, data_shred_cnt+j );
   }
@@ -241,9 +239,31 @@ fd_shredder_next_fec_set( fd_shredder_t * shredder,
   result->data_shred_cnt   = data_shred_cnt;
   result->parity_shred_cnt = parity_shred_cnt;
 
+  if( FD_UNLIKELY( root_out ) ) {
+    fd_memcpy( root_out, root, FD_SHREDDER_MERKLE_ROOT_SZ );
+    return result;
+  }
+
+  /* Sign Merkle Root and write signature */
+  shredder->signer( shredder->signer_ctx, root_signature, root );
+  fd_shredder_sign_fec_set( result, root_signature );
+
   return result;
 }
 
+fd_fec_set_t *
+fd_shredder_next_fec_set( fd_shredder_t * shredder,
+                          fd_fec_set_t *  result ) {
+  return fd_shredder_private_next_fec_set( shredder, result, NULL );
+}
+
+fd_fec_set_t *
+fd_shredder_next_fec_set_unsigned( fd_shredder_t * shredder,
+                                   fd_fec_set_t *  result,
+                                   uchar           root[ static FD_SHREDDER_MERKLE_ROOT_SZ ] ) {
+  return fd_shredder_private_next_fec_set( shredder, result, root );
+}
+
 fd_shredder_t * fd_shredder_fini_batch( fd_shredder_t * shredder ) {
   shredder->entry_batch = NULL;
   shredder->sz          = 0UL;
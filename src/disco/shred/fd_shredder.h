@@ -23,6 +23,10 @@
 
 #define FD_SHREDDER_MAGIC (0xF17EDA2547EDDE70UL) /* FIREDAN SHREDDER V0 */
 
+/* FD_SHREDDER_MERKLE_ROOT_SZ is the size of the Merkle root of a FEC
+   set, which is what the leader signs. */
+#define FD_SHREDDER_MERKLE_ROOT_SZ (32UL)
+
 typedef void (fd_shredder_sign_fn)( void * ctx, uchar * sig, uchar const * merkle_root );
 
 
@@ -183,6 +187,24 @@ fd_shredder_t * fd_shredder_init_batch( fd_shredder_t               * shredder,
    without finishing the batch. */
 fd_fec_set_t * fd_shredder_next_fec_set( fd_shredder_t * shredder, fd_fec_set_t * result );
 
+/* fd_shredder_next_fec_set_unsigned is fd_shredder_next_fec_set
+   without the signing: instead of calling the signer, it writes the
+   Merkle root of the FEC set to root, and leaves the signature of the
+   shreds in result unset.  This lets the caller request the signature
+   asynchronously and keep shredding in the meantime.  Once the
+   signature of root is known, the caller must write it to the shreds
+   with fd_shredder_sign_fec_set before using them. */
+fd_fec_set_t * fd_shredder_next_fec_set_unsigned( fd_shredder_t * shredder, fd_fec_set_t * result, uchar root[ static FD_SHREDDER_MERKLE_ROOT_SZ ] );
+
+/* fd_shredder_sign_fec_set writes signature, the signature of the
+   Merkle root of set, to all the data and parity shreds of set. */
+static inline void
+fd_shredder_sign_fec_set( fd_fec_set_t * set,
+                          uchar const    signature[ static FD_ED25519_SIG_SZ ] ) {
+  for( ulong i=0UL; i<set->data_shred_cnt;   i++ ) fd_memcpy( set->data_shreds  [ i ], signature, FD_ED25519_SIG_SZ );
+  for( ulong j=0UL; j<set->parity_shred_cnt; j++ ) fd_memcpy( set->parity_shreds[ j ], signature, FD_ED25519_SIG_SZ );
+}
+
 /* fd_shredder_fini_batch finishes the in process batch.  shredder must
    be a valid local join that is currently in a batch.  Upon return,
    shredder will no longer be in a batch and will be ready to begin a
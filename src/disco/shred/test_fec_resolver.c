@@ -241,6 +241,168 @@ test_rolloff( void ) {
   fd_fec_resolver_delete( fd_fec_resolver_leave( resolver ) );
 }
 
+/* test_burst feeds the same stream of shreds from several interleaved
+   FEC sets, with duplicates and corrupted shreds mixed in, to two
+   resolvers, one shred at a time and in bursts with
+   fd_fec_resolver_buffer_burst.  Both have to give the same results.
+   The resolvers only track two FEC sets at once, so sets also get
+   evicted in the middle of bursts. */
+
+#define BURST_SET_CNT     (4UL)
+#define BURST_STREAM_MAX  (2UL*BURST_SET_CNT*(FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX))
+static uchar burst_corrupt[ BURST_STREAM_MAX ][ 2048UL ];
+
+static void
+test_burst( fd_rng_t * rng ) {
+  signer_ctx_t signer_ctx[ 1 ];
+  signer_ctx_init( signer_ctx, test_private_key );
+
+  FD_TEST( _shredder==fd_shredder_new( _shredder, test_signer, signer_ctx, (ushort)0 ) );
+  fd_shredder_t * shredder = fd_shredder_join( _shredder );           FD_TEST( shredder );
+  uchar const * pubkey = test_private_key+32UL;
+
+  fd_entry_batch_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_entry_batch_meta_t) );
+  meta->block_complete = 1;
+
+  for( ulong i=0UL; i<PERF_TEST_SZ; i++ )  perf_test_entry_batch[ i ] = (uchar)i;
+  FD_TEST( fd_shredder_init_batch( shredder, perf_test_entry_batch, PERF_TEST_SZ, 0UL, meta ) );
+
+  fd_fec_set_t _set[ BURST_SET_CNT ];
+  uchar * ptr = fec_set_memory;
+  for( ulong i=0UL; i<BURST_SET_CNT; i++ ) ptr = allocate_fec_set( _set+i, ptr );
+
+  fd_fec_set_t out_sets[ 2UL ][ 4UL ];
+  for( ulong i=0UL; i<8UL; i++ ) ptr = allocate_fec_set( out_sets[ i/4UL ]+(i%4UL), ptr );
+
+  uchar const * stream[ BURST_STREAM_MAX ];
+  ulong         stream_cnt  = 0UL;
+  ulong         corrupt_cnt = 0UL;
+  for( ulong i=0UL; i<BURST_SET_CNT; i++ ) {
+    fd_fec_set_t * set = fd_shredder_next_fec_set( shredder, _set+i );
+    for( ulong j=0UL; j<set->data_shred_cnt+set->parity_shred_cnt; j++ ) {
+      uchar const * shred = j<set->data_shred_cnt ? set->data_shreds[ j ] : set->parity_shreds[ j-set->data_shred_cnt ];
+      stream[ stream_cnt++ ] = shred;
+      uint r = fd_rng_uint_roll( rng, 8U );
+      if( r==0U ) stream[ stream_cnt++ ] = shred;
+      if( r==1U ) {
+        uchar * bad = burst_corrupt[ corrupt_cnt++ ];
+        fd_memcpy( bad, shred, 2048UL );
+        bad[ 64UL+fd_rng_ulong_roll( rng, 1000UL ) ]++;
+        stream[ stream_cnt++ ] = bad;
+      }
+    }
+  }
+  FD_TEST( fd_shredder_fini_batch( shredder ) );
+
+  for( ulong i=stream_cnt-1UL; i>0UL; i-- ) { /* Shuffle */
+    ulong j = fd_rng_ulong_roll( rng, i+1UL );
+    uchar const * tmp = stream[ i ]; stream[ i ] = stream[ j ]; stream[ j ] = tmp;
+  }
+
+  ulong foot = fd_fec_resolver_footprint( 2UL, 1UL, 1UL, 2UL );
+  fd_fec_resolver_t * serial = fd_fec_resolver_join( fd_fec_resolver_new( resolver_mem,      2UL, 1UL, 1UL, 2UL, out_sets[ 0 ] ) );
+  fd_fec_resolver_t * burst  = fd_fec_resolver_join( fd_fec_resolver_new( resolver_mem+foot, 2UL, 1UL, 1UL, 2UL, out_sets[ 1 ] ) );
+
+  ulong rv_cnt[ 4 ] = { 0UL };
+  for( ulong i=0UL; i<stream_cnt; ) {
+    ulong cnt = fd_ulong_min( 1UL+fd_rng_ulong_roll( rng, FD_FEC_RESOLVER_BURST_MAX ), stream_cnt-i );
+
+    fd_shred_t const * parsed[ FD_FEC_RESOLVER_BURST_MAX ];
+    ulong parsed_cnt = 0UL;
+    for( ulong j=0UL; j<cnt; j++ ) {
+      fd_shred_t const * shred = fd_shred_parse( stream[ i+j ], 2048UL );
+      if( shred ) parsed[ parsed_cnt++ ] = shred;
+    }
+    fd_fec_resolver_buffer_burst( burst, parsed, parsed_cnt );
+
+    for( ulong j=0UL; j<parsed_cnt; j++ ) {
+      fd_fec_set_t const * out_fec  [ 2 ];
+      fd_shred_t   const * out_shred[ 2 ];
+      int rv0 = fd_fec_resolver_add_shred( serial, parsed[ j ], 2048UL, pubkey, out_fec+0, out_shred+0 );
+      int rv1 = fd_fec_resolver_add_shred( burst,  parsed[ j ], 2048UL, pubkey, out_fec+1, out_shred+1 );
+      FD_TEST( rv0==rv1 );
+      rv_cnt[ rv0+2 ]++;
+      if( (rv0==FD_FEC_RESOLVER_SHRED_OKAY) | (rv0==FD_FEC_RESOLVER_SHRED_COMPLETES) ) FD_TEST( fd_memeq( out_shred[ 0 ], out_shred[ 1 ], 2048UL ) );
+      if( rv0==FD_FEC_RESOLVER_SHRED_COMPLETES ) FD_TEST( sets_eq( out_fec[ 0 ], out_fec[ 1 ] ) );
+    }
+    i += cnt;
+  }
+  fd_fec_resolver_buffer_burst( burst, NULL, 0UL );
+  FD_TEST( rv_cnt[ FD_FEC_RESOLVER_SHRED_COMPLETES+2 ] );
+  FD_TEST( rv_cnt[ FD_FEC_RESOLVER_SHRED_REJECTED+2  ] );
+
+  fd_fec_resolver_delete( fd_fec_resolver_leave( burst  ) );
+  fd_fec_resolver_delete( fd_fec_resolver_leave( serial ) );
+}
+
+/* perf_test_burst measures adding every shred of 32:32 FEC sets, one
+   at a time and in bursts of FD_FEC_RESOLVER_BURST_MAX. */
+
+static void
+perf_test_burst( void ) {
+  for( ulong i=0UL; i<PERF_TEST_SZ; i++ )  perf_test_entry_batch[ i ] = (uchar)i;
+
+  fd_entry_batch_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_entry_batch_meta_t) );
+  meta->block_complete = 1;
+
+  signer_ctx_t signer_ctx[ 1 ];
+  signer_ctx_init( signer_ctx, test_private_key );
+
+  FD_TEST( _shredder==fd_shredder_new( _shredder, test_signer, signer_ctx, (ushort)0 ) );
+  fd_shredder_t * shredder = fd_shredder_join( _shredder );           FD_TEST( shredder );
+  uchar const * pubkey = test_private_key+32UL;
+
+  fd_fec_set_t _set[ 2 ];
+  uchar * ptr = fec_set_memory;
+  ptr = allocate_fec_set( _set+0, ptr );
+  ptr = allocate_fec_set( _set+1, ptr );
+
+  fd_fec_set_t out_sets[ 4UL ];
+  for( ulong i=0UL; i<4UL; i++ ) ptr = allocate_fec_set( out_sets+i, ptr );
+
+  /* Two sets, used alternately so that the done map (of depth 1) has
+     always forgotten the one being added */
+  FD_TEST( fd_shredder_init_batch( shredder, perf_test_entry_batch, PERF_TEST_SZ, 0UL, meta ) );
+  fd_fec_set_t * sets[ 2 ];
+  sets[ 0 ] = fd_shredder_next_fec_set( shredder, _set     );
+  sets[ 1 ] = fd_shredder_next_fec_set( shredder, _set+1UL );
+  FD_TEST( fd_shredder_fini_batch( shredder ) );
+  FD_TEST( (sets[ 0 ]->data_shred_cnt==32UL) & (sets[ 0 ]->parity_shred_cnt==32UL) );
+
+  fd_shred_t const * parsed[ 2 ][ 64 ];
+  for( ulong i=0UL; i<2UL; i++ ) for( ulong j=0UL; j<32UL; j++ ) {
+    parsed[ i ][ 2UL*j     ] = fd_shred_parse( sets[ i ]->data_shreds  [ j ], 2048UL );
+    parsed[ i ][ 2UL*j+1UL ] = fd_shred_parse( sets[ i ]->parity_shreds[ j ], 2048UL );
+  }
+
+  fd_fec_set_t const * out_fec[1];
+  fd_shred_t   const * out_shred[1];
+
+  fd_fec_resolver_t * resolver = fd_fec_resolver_join( fd_fec_resolver_new( resolver_mem, 2UL, 1UL, 1UL, 1UL, out_sets ) );
+
+  ulong const iterations = 1000UL;
+  for( ulong use_burst=0UL; use_burst<2UL; use_burst++ ) {
+    ulong completes = 0UL;
+    long  dt        = -fd_log_wallclock();
+    for( ulong iter=0UL; iter<iterations; iter++ ) {
+      for( ulong j=0UL; j<64UL; j+=FD_FEC_RESOLVER_BURST_MAX ) {
+        fd_shred_t const * const * burst = parsed[ iter&1UL ] + j;
+        if( use_burst ) fd_fec_resolver_buffer_burst( resolver, burst, FD_FEC_RESOLVER_BURST_MAX );
+        for( ulong k=0UL; k<FD_FEC_RESOLVER_BURST_MAX; k++ )
+          completes += (ulong)(fd_fec_resolver_add_shred( resolver, burst[ k ], 2048UL, pubkey, out_fec, out_shred )==FD_FEC_RESOLVER_SHRED_COMPLETES);
+      }
+    }
+    dt += fd_log_wallclock();
+    fd_fec_resolver_buffer_burst( resolver, NULL, 0UL );
+    FD_TEST( completes==iterations );
+    FD_LOG_NOTICE(( "%s: %.1f ns/shred", use_burst ? "in bursts  " : "one by one", (double)dt/(64.0*(double)iterations) ));
+  }
+
+  fd_fec_resolver_delete( fd_fec_resolver_leave( resolver ) );
+}
+
 static void
 perf_test( void ) {
   for( ulong i=0UL; i<PERF_TEST_SZ; i++ )  perf_test_entry_batch[ i ] = (uchar)i;
@@ -276,6 +438,71 @@ perf_test( void ) {
 
 }
 
+/* perf_test_recover measures the call that completes a 32:32 FEC set,
+   which is where the missing shreds get recovered, as a function of
+   how many data shreds are missing.  The rest of the set is data shreds
+   followed by as many parity shreds as needed. */
+
+static void
+perf_test_recover( void ) {
+  for( ulong i=0UL; i<PERF_TEST_SZ; i++ )  perf_test_entry_batch[ i ] = (uchar)i;
+
+  fd_entry_batch_meta_t meta[1];
+  fd_memset( meta, 0, sizeof(fd_entry_batch_meta_t) );
+  meta->block_complete = 1;
+
+  signer_ctx_t signer_ctx[ 1 ];
+  signer_ctx_init( signer_ctx, test_private_key );
+
+  FD_TEST( _shredder==fd_shredder_new( _shredder, test_signer, signer_ctx, (ushort)0 ) );
+  fd_shredder_t * shredder = fd_shredder_join( _shredder );           FD_TEST( shredder );
+  uchar const * pubkey = test_private_key+32UL;
+
+  fd_fec_set_t _set[ 2 ];
+  uchar * ptr = fec_set_memory;
+  ptr = allocate_fec_set( _set+0, ptr );
+  ptr = allocate_fec_set( _set+1, ptr );
+
+  fd_fec_set_t out_sets[ 4UL ];
+  for( ulong i=0UL; i<4UL; i++ ) ptr = allocate_fec_set( out_sets+i, ptr );
+
+  /* Two sets, used alternately so that the done map (of depth 1) has
+     always forgotten the one being added */
+  FD_TEST( fd_shredder_init_batch( shredder, perf_test_entry_batch, PERF_TEST_SZ, 0UL, meta ) );
+  fd_fec_set_t * sets[ 2 ];
+  sets[ 0 ] = fd_shredder_next_fec_set( shredder, _set     );
+  sets[ 1 ] = fd_shredder_next_fec_set( shredder, _set+1UL );
+  FD_TEST( fd_shredder_fini_batch( shredder ) );
+  FD_TEST( (sets[ 0 ]->data_shred_cnt==32UL) & (sets[ 0 ]->parity_shred_cnt==32UL) );
+
+  fd_fec_set_t const * out_fec[1];
+  fd_shred_t   const * out_shred[1];
+
+  fd_fec_resolver_t * resolver = fd_fec_resolver_join( fd_fec_resolver_new( resolver_mem, 2UL, 1UL, 1UL, 1UL, out_sets ) );
+
+  ulong const miss_cnt[] = { 0UL, 1UL, 2UL, 4UL, 8UL, 12UL, 16UL, 24UL, 32UL };
+  ulong const iterations = 1000UL;
+  for( ulong k=0UL; k<sizeof(miss_cnt)/sizeof(ulong); k++ ) {
+    ulong m      = miss_cnt[ k ];
+    ulong last_p = fd_ulong_max( m, 1UL ) - 1UL;
+    long  dt     = 0L;
+    for( ulong iter=0UL; iter<iterations; iter++ ) {
+      fd_fec_set_t * set = sets[ iter&1UL ];
+      for( ulong j=m;   j<set->data_shred_cnt; j++ ) ADD_SHRED( resolver, set->data_shreds  [ j ], OKAY );
+      for( ulong j=0UL; j<last_p;              j++ ) ADD_SHRED( resolver, set->parity_shreds[ j ], OKAY );
+
+      fd_shred_t const * parsed = fd_shred_parse( set->parity_shreds[ last_p ], 2048UL );
+      dt -= fd_log_wallclock();
+      int retval = fd_fec_resolver_add_shred( resolver, parsed, 2048UL, pubkey, out_fec, out_shred );
+      dt += fd_log_wallclock();
+      FD_TEST( retval==FD_FEC_RESOLVER_SHRED_COMPLETES );
+      if( FD_UNLIKELY( iter<2UL ) ) FD_TEST( sets_eq( set, *out_fec ) );
+    }
+    FD_LOG_NOTICE(( "%2lu of 32 data shreds missing: %.1f us to complete the FEC set", m, (double)dt/(1000.0*(double)iterations) ));
+  }
+
+  fd_fec_resolver_delete( fd_fec_resolver_leave( resolver ) );
+}
 
 int
 main( int     argc,
@@ -288,6 +515,12 @@ main( int     argc,
   test_one_batch();
   test_rolloff();
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  for( ulong i=0UL; i<16UL; i++ ) test_burst( rng );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  perf_test_recover();
+  perf_test_burst();
 
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
@@ -12,6 +12,9 @@ uchar perf_test_entry_batch[ PERF_TEST_SZ ];
 uchar fec_set_memory_1[ 2048UL * FD_REEDSOL_DATA_SHREDS_MAX   ];
 uchar fec_set_memory_2[ 2048UL * FD_REEDSOL_PARITY_SHREDS_MAX ];
 
+/* Memory for the FEC sets produced by fd_shredder_next_fec_set_unsigned */
+uchar fec_set_memory_3[ 2048UL * (FD_REEDSOL_DATA_SHREDS_MAX+FD_REEDSOL_PARITY_SHREDS_MAX) ];
+
 /* First 32B of what Solana calls the private key is what we call the
    private key, second 32B are what we call the public key. */
 FD_IMPORT_BINARY( test_private_key, "src/disco/shred/fixtures/demo-shreds.key"  );
@@ -24,6 +27,7 @@ FD_IMPORT_BINARY( test_pcap,        "src/disco/shred/fixtures/demo-shreds.pcap"
 FD_IMPORT_BINARY( test_bin,         "src/disco/shred/fixtures/demo-shreds.bin"  );
 
 fd_shredder_t _shredder[ 1 ];
+fd_shredder_t _shredder2[ 1 ];
 
 struct signer_ctx {
   fd_sha512_t sha512[ 1 ];
@@ -138,6 +142,73 @@ test_shredder_pcap( void ) {
   FD_TEST( !fclose( file ) );
 }
 
+/* test_shredder_next_fec_set_unsigned checks that producing FEC sets
+   unsigned and signing them afterwards gives exactly the same shreds as
+   producing them signed */
+
+static void
+test_shredder_next_fec_set_unsigned( void ) {
+  for( ulong i=0UL; i<PERF_TEST_SZ; i++ )  perf_test_entry_batch[ i ] = (uchar)(i*7UL+(i>>11));
+
+  signer_ctx_t signer_ctx[ 1 ];
+  signer_ctx_init( signer_ctx, test_private_key );
+
+  ulong const sizes[] = { 1UL, 1000UL, 9136UL, 31840UL, 63679UL, 100000UL, 318400UL, 1000000UL };
+
+  for( ulong s=0UL; s<sizeof(sizes)/sizeof(ulong); s++ ) {
+    ulong sz = sizes[ s ];
+
+    fd_entry_batch_meta_t meta[1];
+    fd_memset( meta, 0, sizeof(fd_entry_batch_meta_t) );
+    meta->block_complete = (int)(s&1UL);
+    meta->parent_offset  = s+1UL;
+
+    fd_shredder_t * signed_ = fd_shredder_join( fd_shredder_new( _shredder,  test_signer, signer_ctx, (ushort)s ) ); FD_TEST( signed_ );
+    fd_shredder_t * lazy    = fd_shredder_join( fd_shredder_new( _shredder2, test_signer, signer_ctx, (ushort)s ) ); FD_TEST( lazy    );
+
+    /* Two batches in the same slot, so the second one starts at
+       non-zero shred indices */
+    for( ulong b=0UL; b<2UL; b++ ) {
+      FD_TEST( fd_shredder_init_batch( signed_, perf_test_entry_batch+b, sz, 3UL, meta ) );
+      FD_TEST( fd_shredder_init_batch( lazy,    perf_test_entry_batch+b, sz, 3UL, meta ) );
+
+      ulong total = 0UL;
+      for(;;) {
+        fd_fec_set_t _set[ 1 ];
+        for( ulong j=0UL; j<FD_REEDSOL_DATA_SHREDS_MAX;   j++ ) _set->data_shreds[   j ] = fec_set_memory_1 + 2048UL*j;
+        for( ulong j=0UL; j<FD_REEDSOL_PARITY_SHREDS_MAX; j++ ) _set->parity_shreds[ j ] = fec_set_memory_2 + 2048UL*j;
+        fd_fec_set_t _set3[ 1 ];
+        for( ulong j=0UL; j<FD_REEDSOL_DATA_SHREDS_MAX;   j++ ) _set3->data_shreds[   j ] = fec_set_memory_3 + 2048UL*j;
+        for( ulong j=0UL; j<FD_REEDSOL_PARITY_SHREDS_MAX; j++ ) _set3->parity_shreds[ j ] = fec_set_memory_3 + 2048UL*(FD_REEDSOL_DATA_SHREDS_MAX+j);
+
+        uchar root[ FD_SHREDDER_MERKLE_ROOT_SZ ];
+        uchar signature[ FD_ED25519_SIG_SZ ];
+        fd_fec_set_t * set  = fd_shredder_next_fec_set( signed_, _set );
+        fd_fec_set_t * set3 = fd_shredder_next_fec_set_unsigned( lazy, _set3, root );
+        FD_TEST( !set==!set3 );
+        if( !set ) break;
+        total++;
+
+        test_signer( signer_ctx, signature, root );
+        FD_TEST( fd_memeq( signature, set->data_shreds[ 0 ], FD_ED25519_SIG_SZ ) );
+        fd_shredder_sign_fec_set( set3, signature );
+
+        FD_TEST( set3->data_shred_cnt  ==set->data_shred_cnt   );
+        FD_TEST( set3->parity_shred_cnt==set->parity_shred_cnt );
+        for( ulong j=0UL; j<set->data_shred_cnt;   j++ ) FD_TEST( fd_memeq( set->data_shreds[ j ],   set3->data_shreds[ j ],   FD_SHRED_MIN_SZ ) );
+        for( ulong j=0UL; j<set->parity_shred_cnt; j++ ) FD_TEST( fd_memeq( set->parity_shreds[ j ], set3->parity_shreds[ j ], FD_SHRED_MAX_SZ ) );
+      }
+      FD_TEST( total );
+
+      FD_TEST( fd_shredder_fini_batch( signed_ ) );
+      FD_TEST( fd_shredder_fini_batch( lazy    ) );
+    }
+
+    fd_shredder_delete( fd_shredder_leave( signed_ ) );
+    fd_shredder_delete( fd_shredder_leave( lazy    ) );
+  }
+}
+
 #endif /* FD_HAS_HOSTED */
 
 
@@ -276,6 +347,7 @@ main( int     argc,
 
 #if FD_HAS_HOSTED
   test_shredder_pcap();
+  test_shredder_next_fec_set_unsigned();
 #endif
 
   FD_LOG_NOTICE(( "pass" ));
@@ -7,7 +7,34 @@ main( int     argc,
 
   fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
 
-  /* This is currently just a stub in anticipation of future tests */
+  /* netmux sig fields round trip, and replacing the hash (e.g. by the
+     net tile with flow steering) leaves the other fields alone */
+
+  for( ulong iter=0UL; iter<1000000UL; iter++ ) {
+    uint   src_ip   = fd_rng_uint  ( rng );
+    ushort src_port = fd_rng_ushort( rng );
+    uint   dst_ip   = fd_rng_uint  ( rng );
+    ulong  proto    = fd_rng_ulong_roll( rng, DST_PROTO_SHRED_BATCH+1UL );
+    ulong  hdr_sz   = 42UL + 4UL*fd_rng_ulong_roll( rng, 14UL );
+
+    ulong sig = fd_disco_netmux_sig( src_ip, src_port, dst_ip, proto, hdr_sz );
+    FD_TEST( fd_disco_netmux_sig_proto ( sig )==proto  );
+    FD_TEST( fd_disco_netmux_sig_dst_ip( sig )==dst_ip );
+    FD_TEST( fd_disco_netmux_sig_hdr_sz( sig )==hdr_sz );
+    FD_TEST( fd_disco_netmux_sig_hash  ( sig )==((fd_uint_hash( src_ip )+src_port) & 0xFFUL) );
+
+    ulong hash = fd_rng_ulong( rng );
+    ulong sig2 = fd_disco_netmux_sig_set_hash( sig, hash );
+    FD_TEST( fd_disco_netmux_sig_hash  ( sig2 )==(hash & 0xFFUL) );
+    FD_TEST( fd_disco_netmux_sig_proto ( sig2 )==proto  );
+    FD_TEST( fd_disco_netmux_sig_dst_ip( sig2 )==dst_ip );
+    FD_TEST( fd_disco_netmux_sig_hdr_sz( sig2 )==hdr_sz );
+  }
+
+  /* A full shred batch of max size packets fits in a frag */
+
+  FD_TEST( FD_NET_SHRED_BATCH_MTU( 1UL )>=sizeof(fd_net_shred_batch_t)+FD_NET_MTU );
+  FD_TEST( FD_NET_SHRED_BATCH_MTU( FD_NET_SHRED_BATCH_MAX )<=USHORT_MAX );
 
   fd_rng_delete( fd_rng_leave( rng ) );
 
@@ -134,6 +134,12 @@ typedef struct {
       ulong  xdp_rx_queue_size;
       ulong  xdp_tx_queue_size;
       ulong  xdp_aio_depth;
+      ulong  xdp_queue_cnt;
+      int    flow_steering;
+      ulong  shred_coalesce_max;
+      uint   busy_poll_usecs;
+      uint   busy_poll_budget;
+      int    adaptive_wakeup;
       uint   src_ip_addr;
       uchar  src_mac_addr[6];
 
@@ -181,6 +187,7 @@ typedef struct {
       char   identity_key_path[ PATH_MAX ];
       ushort shred_listen_port;
       ulong  expected_shred_version;
+      ulong  shred_coalesce_max;
     } shred;
 
     struct {
@@ -234,6 +241,7 @@ typedef struct {
 
   ulong                         mux_flags;
   ulong                         burst;
+  ulong                         burst_frag_max;
   ulong                         rlimit_file_cnt;
   void * (*mux_ctx           )( void * scratch );
 
@@ -243,9 +251,11 @@ typedef struct {
   fd_mux_before_frag_fn         * mux_before_frag;
   fd_mux_during_frag_fn         * mux_during_frag;
   fd_mux_after_frag_fn          * mux_after_frag;
+  fd_mux_after_burst_fn         * mux_after_burst;
   fd_mux_metrics_write_fn       * mux_metrics_write;
 
   long  (*lazy                    )( fd_topo_tile_t * tile );
+  ulong (*tile_burst              )( fd_topo_tile_t const * tile ); /* If set, the burst of this tile, in place of burst */
   ulong (*populate_allowed_seccomp)( void * scratch, ulong out_cnt, struct sock_filter * out );
   ulong (*populate_allowed_fds    )( void * scratch, ulong out_fds_sz, int * out_fds );
   ulong (*scratch_align           )( void );
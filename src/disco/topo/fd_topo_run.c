@@ -146,6 +146,7 @@ fd_topo_run_tile( fd_topo_t *          topo,
     .before_frag         = tile_run->mux_before_frag,
     .during_frag         = tile_run->mux_during_frag,
     .after_frag          = tile_run->mux_after_frag,
+    .after_burst         = tile_run->mux_after_burst,
     .metrics_write       = tile_run->mux_metrics_write,
   };
 
@@ -155,6 +156,9 @@ fd_topo_run_tile( fd_topo_t *          topo,
   long lazy = 0L;
   if( FD_UNLIKELY( tile_run->lazy ) ) lazy = tile_run->lazy( tile_mem );
 
+  ulong burst = tile_run->burst;
+  if( FD_UNLIKELY( tile_run->tile_burst ) ) burst = tile_run->tile_burst( tile );
+
   fd_rng_t rng[1];
   fd_mux_tile( tile->cnc,
                tile_run->mux_flags,
@@ -164,7 +168,8 @@ fd_topo_run_tile( fd_topo_t *          topo,
                tile->out_link_id_primary == ULONG_MAX ? NULL : topo->links[ tile->out_link_id_primary ].mcache,
                out_cnt_reliable,
                out_fseq,
-               tile_run->burst,
+               burst,
+               tile_run->burst_frag_max,
                0,
                lazy,
                fd_rng_join( fd_rng_new( rng, 0, 0UL ) ),
@@ -0,0 +1,112 @@
+#include "fd_tcache_shared.h"
+
+ulong
+fd_tcache_shared_align( void ) {
+  return FD_TCACHE_SHARED_ALIGN;
+}
+
+ulong
+fd_tcache_shared_footprint( ulong set_cnt ) {
+  if( FD_UNLIKELY( (!set_cnt) | (!fd_ulong_is_pow2( set_cnt )) ) ) return 0UL; /* Invalid set_cnt */
+  if( FD_UNLIKELY( set_cnt>((ULONG_MAX-256UL)/(FD_TCACHE_SHARED_WAY_CNT*sizeof(ulong))) ) ) return 0UL; /* overflow */
+  return FD_TCACHE_SHARED_FOOTPRINT( set_cnt );
+}
+
+void *
+fd_tcache_shared_new( void * shmem,
+                      ulong  set_cnt,
+                      ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_tcache_shared_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_tcache_shared_footprint( set_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad set_cnt (%lu)", set_cnt ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint ); /* All slots FD_TCACHE_TAG_NULL */
+
+  fd_tcache_shared_t * tcache = (fd_tcache_shared_t *)shmem;
+
+  tcache->set_cnt = set_cnt;
+  tcache->seed    = seed;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tcache->magic ) = FD_TCACHE_SHARED_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_tcache_shared_t *
+fd_tcache_shared_join( void * shtcache ) {
+
+  if( FD_UNLIKELY( !shtcache ) ) {
+    FD_LOG_WARNING(( "NULL shtcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shtcache, fd_tcache_shared_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shtcache" ));
+    return NULL;
+  }
+
+  fd_tcache_shared_t * tcache = (fd_tcache_shared_t *)shtcache;
+  if( FD_UNLIKELY( tcache->magic!=FD_TCACHE_SHARED_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return tcache;
+}
+
+void *
+fd_tcache_shared_leave( fd_tcache_shared_t const * tcache ) {
+
+  if( FD_UNLIKELY( !tcache ) ) {
+    FD_LOG_WARNING(( "NULL tcache" ));
+    return NULL;
+  }
+
+  return (void *)tcache;
+}
+
+void *
+fd_tcache_shared_delete( void * shtcache ) {
+
+  if( FD_UNLIKELY( !shtcache ) ) {
+    FD_LOG_WARNING(( "NULL shtcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shtcache, fd_tcache_shared_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shtcache" ));
+    return NULL;
+  }
+
+  fd_tcache_shared_t * tcache = (fd_tcache_shared_t *)shtcache;
+  if( FD_UNLIKELY( tcache->magic!=FD_TCACHE_SHARED_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tcache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shtcache;
+}
+
+void
+fd_tcache_shared_reset( fd_tcache_shared_t * tcache ) {
+  fd_memset( fd_tcache_shared_private_set( tcache, 0UL ), 0, tcache->set_cnt*FD_TCACHE_SHARED_WAY_CNT*sizeof(ulong) );
+}
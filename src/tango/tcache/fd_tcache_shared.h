@@ -0,0 +1,204 @@
+#ifndef HEADER_fd_src_tango_tcache_fd_tcache_shared_h
+#define HEADER_fd_src_tango_tcache_fd_tcache_shared_h
+
+/* A fd_tcache_shared_t is a cache of recently observed unique 64-bit
+   tags, like fd_tcache_t, that can be queried and inserted into
+   concurrently by many threads (e.g. all the verify tiles of a
+   validator, so that a duplicate arriving at one tile is caught if any
+   tile has already seen it).  It is lock free: inserts are done with a
+   single CAS in the common case.
+
+   The tradeoff relative to fd_tcache_t is that history is approximate.
+   The cache is a set associative hash table: a tag hashes (with a seed
+   fixed at creation) to one of set_cnt sets of FD_TCACHE_SHARED_WAY_CNT
+   slots (one cache line), so tags only contend with the other tags of
+   their set.  When a set is full, a new tag evicts a pseudo randomly
+   chosen (but deterministic for the tag) slot of the set rather than
+   the oldest tag in the cache.  With set_cnt*WAY_CNT much larger than
+   the window over which duplicates typically arrive, this is rarely
+   noticeable.  Concretely:
+
+   - A query or insert never reports a tag as a duplicate unless it was
+     inserted before (up to 64-bit tag collisions, as for fd_tcache_t).
+
+   - An insert can report a tag as new even if it was inserted before,
+     if the earlier insert was evicted.  Concurrent inserts of the same
+     tag are serialized by the CAS on the slot the tag goes to, so
+     exactly one of them reports it as new.
+
+   So this should be used as a filter in front of the authoritative
+   deduplication (e.g. to avoid doing expensive work on traffic that is
+   obviously duplicated) and not as a replacement for it.
+
+   Like fd_tcache_t, the tags are assumed to not be FD_TCACHE_TAG_NULL.
+   Unlike fd_tcache_t, tags do not need to be IID random (they are
+   hashed), which matters if they are chosen by an adversary. */
+
+#include "fd_tcache.h"
+
+/* FD_TCACHE_SHARED_WAY_CNT is the number of slots in a set.  A set is
+   a cache line, so a query or insert typically touches one cache line. */
+
+#define FD_TCACHE_SHARED_WAY_CNT (8UL)
+
+/* FD_TCACHE_SHARED_{ALIGN,FOOTPRINT} specify the alignment and
+   footprint needed for a shared tcache with set_cnt sets.  set_cnt is
+   assumed to be valid (i.e. a positive integer power of 2 such that the
+   footprint does not overflow).  These are provided to facilitate
+   compile time declarations. */
+
+#define FD_TCACHE_SHARED_ALIGN (128UL)
+#define FD_TCACHE_SHARED_FOOTPRINT( set_cnt )                                        \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                                  \
+    FD_TCACHE_SHARED_ALIGN, 128UL + (set_cnt)*FD_TCACHE_SHARED_WAY_CNT*sizeof(ulong) ), \
+    FD_TCACHE_SHARED_ALIGN )
+
+#define FD_TCACHE_SHARED_MAGIC (0xf17eda2c37c5a4e0UL) /* firedancer tcshar ver 0 */
+
+/* fd_tcache_shared_t is an opaque handle of a shared tcache object.
+   Details are exposed here to facilitate inlining of the query and
+   insert operations. */
+
+struct __attribute__((aligned(FD_TCACHE_SHARED_ALIGN))) fd_tcache_shared_private {
+  ulong magic;   /* ==FD_TCACHE_SHARED_MAGIC */
+  ulong set_cnt; /* Number of sets, a positive integer power of 2 */
+  ulong seed;    /* Seed of the tag hash */
+
+  /* Padding to 128 here */
+
+  /* set_cnt*WAY_CNT ulong (sets): slot w of set s is at
+     [s*WAY_CNT+w].  In each set, the non-null tags occupy a prefix of
+     the slots (slots go from null to a tag and then only from one tag
+     to another). */
+};
+
+typedef struct fd_tcache_shared_private fd_tcache_shared_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_tcache_shared_{align,footprint} return the required alignment and
+   footprint of a memory region suitable for use as a shared tcache with
+   set_cnt sets.  footprint returns 0 if set_cnt is invalid. */
+
+FD_FN_CONST ulong
+fd_tcache_shared_align( void );
+
+FD_FN_CONST ulong
+fd_tcache_shared_footprint( ulong set_cnt );
+
+/* fd_tcache_shared_new formats an unused memory region for use as a
+   shared tcache with set_cnt sets (so that it holds up to
+   set_cnt*FD_TCACHE_SHARED_WAY_CNT tags).  seed is the seed of the hash
+   used to pick the set of a tag (arbitrary, but should be unpredictable
+   to anyone choosing tags).  Returns shmem on success (the cache is
+   empty) and NULL on failure (logs details).  Reasons for failure
+   include obviously bad shmem or bad set_cnt. */
+
+void *
+fd_tcache_shared_new( void * shmem,
+                      ulong  set_cnt,
+                      ulong  seed );
+
+/* fd_tcache_shared_{join,leave,delete} follow the usual conventions.
+   Any number of threads can be joined at the same time. */
+
+fd_tcache_shared_t *
+fd_tcache_shared_join( void * shtcache );
+
+void *
+fd_tcache_shared_leave( fd_tcache_shared_t const * tcache );
+
+void *
+fd_tcache_shared_delete( void * shtcache );
+
+/* Accessors.  Assume tcache is a current local join. */
+
+FD_FN_PURE static inline ulong fd_tcache_shared_set_cnt( fd_tcache_shared_t const * tcache ) { return tcache->set_cnt; }
+FD_FN_PURE static inline ulong fd_tcache_shared_seed   ( fd_tcache_shared_t const * tcache ) { return tcache->seed;    }
+
+/* fd_tcache_shared_private_{hash,set} return the hash of tag and the
+   set it maps to.  The low bits of the hash select the set and the high
+   bits the slot to evict when the set is full. */
+
+FD_FN_PURE static inline ulong
+fd_tcache_shared_private_hash( fd_tcache_shared_t const * tcache,
+                               ulong                      tag ) {
+  return fd_ulong_hash( tag ^ tcache->seed );
+}
+
+FD_FN_PURE static inline ulong *
+fd_tcache_shared_private_set( fd_tcache_shared_t * tcache,
+                              ulong                hash ) {
+  return (ulong *)((ulong)tcache + 128UL) + (hash & (tcache->set_cnt-1UL))*FD_TCACHE_SHARED_WAY_CNT;
+}
+
+/* fd_tcache_shared_query returns 1 if tag is currently in the cache and
+   0 if not.  Assumes tag is not null.  The result is a snapshot: the
+   tag might be inserted (or evicted) by other threads at any time. */
+
+static inline int
+fd_tcache_shared_query( fd_tcache_shared_t const * tcache,
+                        ulong                      tag ) {
+  ulong const * set = fd_tcache_shared_private_set( (fd_tcache_shared_t *)tcache, fd_tcache_shared_private_hash( tcache, tag ) );
+  int found = 0;
+  for( ulong way=0UL; way<FD_TCACHE_SHARED_WAY_CNT; way++ ) found |= FD_VOLATILE_CONST( set[ way ] )==tag;
+  return found;
+}
+
+/* fd_tcache_shared_insert inserts tag into the cache.  Returns 1 if tag
+   was already in the cache (the cache is unchanged) and 0 if it was
+   inserted (possibly evicting another tag).  Assumes tag is not null.
+
+   Two threads inserting the same tag first look for it in the same
+   slots in the same order, and then both CAS it into the same slot (the
+   first null slot of the set or, if the set is full, the slot picked by
+   the hash of the tag), so only one of them can succeed and the other
+   sees the tag there.  Requires FD_HAS_ATOMIC for concurrent use. */
+
+static inline int
+fd_tcache_shared_insert( fd_tcache_shared_t * tcache,
+                         ulong                tag ) {
+  ulong   hash = fd_tcache_shared_private_hash( tcache, tag );
+  ulong * set  = fd_tcache_shared_private_set( tcache, hash );
+
+  for( ulong way=0UL; way<FD_TCACHE_SHARED_WAY_CNT; way++ ) {
+    ulong cur = FD_VOLATILE_CONST( set[ way ] );
+    if( FD_UNLIKELY( cur==tag ) ) return 1;
+    if( FD_LIKELY( fd_tcache_tag_is_null( cur ) ) ) {
+#     if FD_HAS_ATOMIC
+      cur = FD_ATOMIC_CAS( &set[ way ], FD_TCACHE_TAG_NULL, tag );
+#     else
+      set[ way ] = tag;
+#     endif
+      if( FD_LIKELY( fd_tcache_tag_is_null( cur ) ) ) return 0; /* inserted */
+      if( cur==tag ) return 1;                                  /* lost a race with an insert of the same tag */
+      /* lost a race with an insert of a different tag, keep looking */
+    }
+  }
+
+  /* The set is full, evict */
+
+  ulong * slot = set + (hash >> (64-3));
+  FD_STATIC_ASSERT( FD_TCACHE_SHARED_WAY_CNT==8UL, update_evict_slot );
+  for(;;) {
+    ulong cur = FD_VOLATILE_CONST( *slot );
+    if( FD_UNLIKELY( cur==tag ) ) return 1;
+#   if FD_HAS_ATOMIC
+    if( FD_LIKELY( FD_ATOMIC_CAS( slot, cur, tag )==cur ) ) return 0;
+#   else
+    *slot = tag;
+    return 0;
+#   endif
+    FD_SPIN_PAUSE();
+  }
+}
+
+/* fd_tcache_shared_reset empties the cache.  Assumes no other thread is
+   using it concurrently. */
+
+void
+fd_tcache_shared_reset( fd_tcache_shared_t * tcache );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_tcache_fd_tcache_shared_h */
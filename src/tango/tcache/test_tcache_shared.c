@@ -0,0 +1,186 @@
+#include "../fd_tango.h"
+
+FD_STATIC_ASSERT( FD_TCACHE_SHARED_ALIGN           ==128UL, unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_SHARED_FOOTPRINT(   1UL)==256UL, unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_SHARED_FOOTPRINT(   2UL)==256UL, unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_SHARED_FOOTPRINT(   4UL)==384UL, unit_test );
+
+FD_STATIC_ASSERT( FD_TCACHE_SHARED_WAY_CNT*sizeof(ulong)==64UL, unit_test );
+
+#define SET_MAX (1UL<<12)
+#define TAG_MAX (1UL<<14)
+#define MT_TAG_CNT (1024UL)
+#define TILE_MAX   (16UL)
+
+static uchar __attribute__((aligned(FD_TCACHE_SHARED_ALIGN))) shmem[ FD_TCACHE_SHARED_FOOTPRINT( SET_MAX ) ];
+
+static ulong tag_seq[ TAG_MAX ];
+
+/* Per tile results of the concurrent insert test */
+
+static int mt_res[ TILE_MAX ][ MT_TAG_CNT ];
+
+/* set_tag_cnt[s] is the number of tags in tag_seq[0,tag_cnt) that map
+   to set s.  Tags in sets that did not overflow are never evicted. */
+
+static ulong set_tag_cnt[ SET_MAX ];
+
+static void
+count_set_tags( fd_tcache_shared_t * tcache,
+                ulong                tag_cnt ) {
+  ulong set_cnt = fd_tcache_shared_set_cnt( tcache );
+  for( ulong s=0UL; s<set_cnt; s++ ) set_tag_cnt[ s ] = 0UL;
+  for( ulong i=0UL; i<tag_cnt; i++ ) set_tag_cnt[ fd_tcache_shared_private_hash( tcache, tag_seq[ i ] ) & (set_cnt-1UL) ]++;
+}
+
+static int
+tag_overflowed( fd_tcache_shared_t * tcache,
+                ulong                tag ) {
+  ulong set_cnt = fd_tcache_shared_set_cnt( tcache );
+  return set_tag_cnt[ fd_tcache_shared_private_hash( tcache, tag ) & (set_cnt-1UL) ]>FD_TCACHE_SHARED_WAY_CNT;
+}
+
+static int
+insert_main( int     argc,
+             char ** argv ) {
+  fd_tcache_shared_t * tcache = (fd_tcache_shared_t *)argv;
+  ulong tile_idx = (ulong)argc;
+  for( ulong i=0UL; i<MT_TAG_CNT; i++ ) mt_res[ tile_idx ][ i ] = fd_tcache_shared_insert( tcache, tag_seq[ i ] );
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong set_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--set-cnt", NULL, 256UL  );
+  ulong seed    = fd_env_strip_cmdline_ulong( &argc, &argv, "--seed",    NULL, 1234UL );
+
+  if( FD_UNLIKELY( set_cnt>SET_MAX ) ) FD_LOG_ERR(( "Increase unit test SET_MAX to support this large --set-cnt" ));
+
+  FD_LOG_NOTICE(( "Testing with --set-cnt %lu --seed %lu", set_cnt, seed ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Test procurement */
+
+  FD_TEST( fd_tcache_shared_align()==FD_TCACHE_SHARED_ALIGN );
+  FD_TEST( fd_tcache_shared_footprint( 0UL     )==0UL ); /* zero set_cnt     */
+  FD_TEST( fd_tcache_shared_footprint( 3UL     )==0UL ); /* non-pow2 set_cnt */
+  FD_TEST( fd_tcache_shared_footprint( 1UL<<62 )==0UL ); /* overflow         */
+  for( ulong lg=0UL; lg<=12UL; lg++ ) FD_TEST( fd_tcache_shared_footprint( 1UL<<lg )==FD_TCACHE_SHARED_FOOTPRINT( 1UL<<lg ) );
+
+  FD_TEST( fd_tcache_shared_new( NULL,      set_cnt, seed )==NULL ); /* null        */
+  FD_TEST( fd_tcache_shared_new( shmem+1UL, set_cnt, seed )==NULL ); /* misaligned  */
+  FD_TEST( fd_tcache_shared_new( shmem,     3UL,     seed )==NULL ); /* bad set_cnt */
+
+  void * shtcache = fd_tcache_shared_new( shmem, set_cnt, seed ); FD_TEST( shtcache==shmem );
+
+  FD_TEST( fd_tcache_shared_join( NULL          )==NULL ); /* null       */
+  FD_TEST( fd_tcache_shared_join( (void *)0x1UL )==NULL ); /* misaligned */
+
+  fd_tcache_shared_t * tcache = fd_tcache_shared_join( shtcache ); FD_TEST( tcache );
+
+  FD_TEST( fd_tcache_shared_set_cnt( tcache )==set_cnt );
+  FD_TEST( fd_tcache_shared_seed   ( tcache )==seed    );
+
+  /* Unique non-null tags */
+
+  for( ulong i=0UL; i<TAG_MAX; i++ ) tag_seq[ i ] = (i<<32) | (ulong)(fd_rng_uint( rng ) | 1U);
+
+  /* Tags that were never inserted are never reported as duplicates, and
+     a tag just inserted is always reported as a duplicate.  Filling the
+     cache to capacity and beyond evicts tags, but whatever is in the
+     cache is a tag that was inserted. */
+
+  ulong cap = set_cnt*FD_TCACHE_SHARED_WAY_CNT;
+  ulong ins_cnt = fd_ulong_min( 4UL*cap, TAG_MAX/2UL );
+  for( ulong i=0UL; i<ins_cnt; i++ ) {
+    ulong tag = tag_seq[ i ];
+    FD_TEST( !fd_tcache_shared_query( tcache, tag ) );
+    FD_TEST( !fd_tcache_shared_insert( tcache, tag ) );
+    FD_TEST(  fd_tcache_shared_query( tcache, tag ) );
+    FD_TEST(  fd_tcache_shared_insert( tcache, tag ) );
+  }
+  for( ulong i=ins_cnt; i<TAG_MAX; i++ ) FD_TEST( !fd_tcache_shared_query( tcache, tag_seq[ i ] ) );
+
+  ulong hit_cnt = 0UL;
+  for( ulong i=0UL; i<ins_cnt; i++ ) hit_cnt += (ulong)fd_tcache_shared_query( tcache, tag_seq[ i ] );
+  FD_TEST( hit_cnt<=cap );
+  FD_LOG_NOTICE(( "%lu of %lu inserted tags still present (capacity %lu)", hit_cnt, ins_cnt, cap ));
+
+  /* Inserting well beyond capacity fills every set */
+
+  ulong sets_full = 1UL;
+  ulong * sets = fd_tcache_shared_private_set( tcache, 0UL );
+  for( ulong s=0UL; s<cap; s++ ) sets_full &= (ulong)!fd_tcache_tag_is_null( sets[ s ] );
+  if( ins_cnt>=4UL*cap ) FD_TEST( sets_full ); /* Overwhelmingly likely with random hashes */
+
+  /* Reset empties the cache */
+
+  fd_tcache_shared_reset( tcache );
+  for( ulong i=0UL; i<TAG_MAX; i++ ) FD_TEST( !fd_tcache_shared_query( tcache, tag_seq[ i ] ) );
+
+  /* Tags in sets that never overflowed are never evicted */
+
+  ulong few = cap/2UL;
+  count_set_tags( tcache, few );
+  for( ulong i=0UL; i<few; i++ ) FD_TEST( !fd_tcache_shared_insert( tcache, tag_seq[ i ] ) );
+  for( ulong i=0UL; i<few; i++ ) if( !tag_overflowed( tcache, tag_seq[ i ] ) ) FD_TEST( fd_tcache_shared_query( tcache, tag_seq[ i ] ) );
+  for( ulong i=few; i<TAG_MAX; i++ ) FD_TEST( !fd_tcache_shared_query( tcache, tag_seq[ i ] ) );
+
+  fd_tcache_shared_reset( tcache );
+
+  /* Concurrent inserts of the same tags from all tiles: for every tag,
+     exactly one tile sees it as new (unless it was evicted in the
+     meantime, which can only happen in sets that overflowed). */
+
+  ulong tile_cnt = fd_ulong_min( fd_tile_cnt(), TILE_MAX );
+  if( tile_cnt>1UL ) {
+    FD_LOG_NOTICE(( "Testing concurrent inserts from %lu tiles", tile_cnt ));
+
+    fd_tile_exec_t * exec[ TILE_MAX ];
+    for( ulong t=1UL; t<tile_cnt; t++ ) exec[ t ] = fd_tile_exec_new( t, insert_main, (int)t, (char **)tcache );
+    insert_main( 0, (char **)tcache );
+    for( ulong t=1UL; t<tile_cnt; t++ ) fd_tile_exec_delete( exec[ t ], NULL );
+
+    count_set_tags( tcache, MT_TAG_CNT );
+    for( ulong i=0UL; i<MT_TAG_CNT; i++ ) {
+      if( tag_overflowed( tcache, tag_seq[ i ] ) ) continue;
+      FD_TEST( fd_tcache_shared_query( tcache, tag_seq[ i ] ) );
+      ulong new_cnt = 0UL;
+      for( ulong t=0UL; t<tile_cnt; t++ ) new_cnt += (ulong)!mt_res[ t ][ i ];
+      FD_TEST( new_cnt==1UL );
+    }
+  } else {
+    FD_LOG_WARNING(( "skip: concurrent insert test needs at least 2 tiles" ));
+  }
+
+  /* Benchmark single threaded insert throughput with a mix of new and
+     duplicate tags */
+
+  fd_tcache_shared_reset( tcache );
+  ulong iter_cnt = 1UL<<22;
+  long dt = -fd_log_wallclock();
+  ulong dup_cnt = 0UL;
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) dup_cnt += (ulong)fd_tcache_shared_insert( tcache, tag_seq[ iter & (TAG_MAX-1UL) ] );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "%.3f ns/insert (%lu dup)", (double)dt/(double)iter_cnt, dup_cnt ));
+
+  /* Test destruction */
+
+  FD_TEST( fd_tcache_shared_leave( NULL   )==NULL     ); /* null */
+  FD_TEST( fd_tcache_shared_leave( tcache )==shtcache ); /* ok */
+
+  FD_TEST( fd_tcache_shared_delete( NULL                    )==NULL  ); /* null       */
+  FD_TEST( fd_tcache_shared_delete( ((uchar *)shtcache)+1UL )==NULL  ); /* misaligned */
+  FD_TEST( fd_tcache_shared_delete( shtcache                )==shmem ); /* ok */
+  FD_TEST( fd_tcache_shared_join  ( shtcache                )==NULL  ); /* bad magic  */
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -295,6 +295,10 @@ fd_quic_gen_keys(
   }
   keys->iv_sz = iv_sz;
 
+  /* expand the keys once, see fd_quic_crypto_keys_t */
+  fd_aes_gcm_init_key( &keys->pkt_cipher, keys->pkt_key, key_sz );
+  fd_aes_set_encrypt_key( keys->hp_key, key_sz<<3, &keys->hp_cipher );
+
   return FD_QUIC_SUCCESS;
 }
 
@@ -342,6 +346,9 @@ fd_quic_gen_new_keys(
   }
   keys->iv_sz = iv_sz;
 
+  /* header protection keys are not updated */
+  fd_aes_gcm_init_key( &keys->pkt_cipher, keys->pkt_key, key_sz );
+
   return FD_QUIC_SUCCESS;
 }
 
@@ -431,8 +438,8 @@ fd_quic_crypto_encrypt(
   // Initial packets cipher uses AEAD_AES_128_GCM with keys derived from the Destination Connection ID field of the
   // first Initial packet sent by the client; see rfc9001 Section 5.2.
 
-  fd_aes_gcm_t pkt_cipher[1];
-  fd_aes_128_gcm_init( pkt_cipher, pkt_keys->pkt_key, nonce );
+  fd_aes_gcm_t * pkt_cipher = &pkt_keys->pkt_cipher;
+  fd_aes_gcm_setiv( pkt_cipher, nonce );
 
   /* cipher_text is start of encrypted packet bytes, which starts after the header */
   uchar * cipher_text = out + hdr_sz;
@@ -449,10 +456,8 @@ fd_quic_crypto_encrypt(
      so shorter packet numbers means sample starts later in the cipher text */
   uchar const * sample = pkt_number + 4;
 
-  fd_aes_key_t ecb[1];
-  fd_aes_set_encrypt_key( hp_keys->hp_key, 128, ecb );
   uchar hp_cipher[16];
-  fd_aes_encrypt( sample, hp_cipher, ecb );
+  fd_aes_encrypt( sample, hp_cipher, &hp_keys->hp_cipher );
 
   /* hp_cipher is mask */
   uchar const * mask = hp_cipher;
@@ -469,18 +474,26 @@ fd_quic_crypto_encrypt(
   return FD_QUIC_SUCCESS;
 }
 
-int
-fd_quic_crypto_decrypt(
-    uchar *                  const out,
-    ulong *                  const p_out_sz,
-    uchar const *            const in,
-    ulong                    const in_sz,
-    ulong                    const pkt_number_off,
-    ulong                    const pkt_number,
-    fd_quic_crypto_suite_t const * const suite,
-    fd_quic_crypto_keys_t  const * const keys ) {
-
-  (void)suite;
+/* fd_quic_crypto_decrypt_prep does the checks and computes the AES-GCM
+   parameters for fd_quic_crypto_decrypt{,_batch}.  On success, the
+   plain text will be written to gcm_p[0,gcm_sz) and *p_out_sz is set to
+   the size of the result. */
+
+static int
+fd_quic_crypto_decrypt_prep( uchar *                 out,
+                             ulong *                 p_out_sz,
+                             uchar const *           in,
+                             ulong                   in_sz,
+                             ulong                   pkt_number_off,
+                             ulong                   pkt_number,
+                             fd_quic_crypto_keys_t * keys,
+                             uchar                   nonce[ static FD_QUIC_NONCE_SZ ],
+                             uchar **                p_gcm_p,
+                             uchar const **          p_gcm_c,
+                             ulong *                 p_gcm_sz,
+                             uchar const **          p_gcm_a,
+                             ulong *                 p_gcm_asz,
+                             uchar const **          p_gcm_tag ) {
 
   ulong const out_bufsz = *p_out_sz;
 
@@ -499,7 +512,7 @@ fd_quic_crypto_decrypt(
   /* calculate nonce for decryption
      nonce is quic-iv XORed with *reconstructed* packet-number
      packet number is 1-4 bytes, so only XOR last pkt_number_sz bytes */
-  uchar nonce[FD_QUIC_NONCE_SZ] = {0};
+  fd_memset( nonce, 0, FD_QUIC_NONCE_SZ );
   uint nonce_tmp = FD_QUIC_NONCE_SZ - 4;
   uchar const * quic_iv = keys->iv;
   fd_memcpy( nonce, quic_iv, nonce_tmp );
@@ -533,8 +546,39 @@ fd_quic_crypto_decrypt(
   assert( gcm_tag       >=in            );
   assert( gcm_tag+FD_QUIC_CRYPTO_TAG_SZ<=in+in_sz );
 
-  fd_aes_gcm_t pkt_cipher[1];
-  fd_aes_128_gcm_init( pkt_cipher, keys->pkt_key, nonce );
+  *p_gcm_p   = gcm_p;
+  *p_gcm_c   = gcm_c;
+  *p_gcm_sz  = gcm_sz;
+  *p_gcm_a   = gcm_a;
+  *p_gcm_asz = gcm_asz;
+  *p_gcm_tag = gcm_tag;
+  *p_out_sz  = (ulong)(out_end - out);
+  return FD_QUIC_SUCCESS;
+}
+
+int
+fd_quic_crypto_decrypt(
+    uchar *                  const out,
+    ulong *                  const p_out_sz,
+    uchar const *            const in,
+    ulong                    const in_sz,
+    ulong                    const pkt_number_off,
+    ulong                    const pkt_number,
+    fd_quic_crypto_suite_t const * const suite,
+    fd_quic_crypto_keys_t  *       const keys ) {
+
+  (void)suite;
+
+  uchar         nonce[ FD_QUIC_NONCE_SZ ];
+  uchar *       gcm_p;   uchar const * gcm_c;   ulong gcm_sz;
+  uchar const * gcm_a;   ulong         gcm_asz; uchar const * gcm_tag;
+  ulong         out_sz = *p_out_sz;
+  if( FD_UNLIKELY( fd_quic_crypto_decrypt_prep( out, &out_sz, in, in_sz, pkt_number_off, pkt_number, keys, nonce,
+                                                &gcm_p, &gcm_c, &gcm_sz, &gcm_a, &gcm_asz, &gcm_tag )!=FD_QUIC_SUCCESS ) )
+    return FD_QUIC_FAILED;
+
+  fd_aes_gcm_t * pkt_cipher = &keys->pkt_cipher;
+  fd_aes_gcm_setiv( pkt_cipher, nonce );
 
   int decrypt_ok =
     fd_aes_gcm_aead_decrypt( pkt_cipher, gcm_c, gcm_p, gcm_sz, gcm_a, gcm_asz, gcm_tag );
@@ -543,10 +587,57 @@ fd_quic_crypto_decrypt(
     return FD_QUIC_FAILED;
   }
 
-  *p_out_sz = (ulong)(out_end - out);
+  *p_out_sz = out_sz;
   return FD_QUIC_SUCCESS;
 }
 
+void
+fd_quic_crypto_decrypt_batch( fd_quic_crypto_decrypt_req_t * req,
+                              ulong                          req_cnt ) {
+
+  fd_aes_gcm_t * gcm   [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar const *  iv    [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar const *  c     [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar *        p     [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  ulong          sz    [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar const *  aad   [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  ulong          aad_sz[ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar const *  tag   [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  int            ok    [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  ulong          idx   [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  uchar          nonce [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ][ FD_QUIC_NONCE_SZ ];
+  ulong          out_sz[ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+
+  for( ulong r0=0UL; r0<req_cnt; r0+=FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ) {
+    ulong r1  = fd_ulong_min( r0+FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX, req_cnt );
+    ulong cnt = 0UL;
+    for( ulong r=r0; r<r1; r++ ) {
+      fd_quic_crypto_decrypt_req_t * q = req + r;
+      out_sz[ cnt ] = q->out_sz;
+      q->rc = fd_quic_crypto_decrypt_prep( q->out, &out_sz[ cnt ], q->in, q->in_sz, q->pkt_number_off, q->pkt_number,
+                                           q->keys, nonce[ cnt ],
+                                           &p[ cnt ], &c[ cnt ], &sz[ cnt ], &aad[ cnt ], &aad_sz[ cnt ], &tag[ cnt ] );
+      if( FD_UNLIKELY( q->rc!=FD_QUIC_SUCCESS ) ) continue;
+      gcm[ cnt ] = &q->keys->pkt_cipher;
+      iv [ cnt ] = nonce[ cnt ];
+      idx[ cnt ] = r;
+      cnt++;
+    }
+
+    fd_aes_gcm_aead_decrypt_batch( gcm, iv, c, p, sz, aad, aad_sz, tag, cnt, ok );
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      fd_quic_crypto_decrypt_req_t * q = req + idx[ i ];
+      if( FD_UNLIKELY( !ok[ i ] ) ) {
+        FD_DEBUG( FD_LOG_WARNING(( "fd_aes_gcm_aead_decrypt_batch failed" )) );
+        q->rc = FD_QUIC_FAILED;
+        continue;
+      }
+      q->out_sz = out_sz[ i ];
+    }
+  }
+}
+
 
 int
 fd_quic_crypto_decrypt_hdr(
@@ -556,7 +647,7 @@ fd_quic_crypto_decrypt_hdr(
     ulong                    cipher_text_sz,
     ulong                    pkt_number_off,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys ) {
+    fd_quic_crypto_keys_t *  keys ) {
 
   (void)suite;
 
@@ -583,11 +674,8 @@ fd_quic_crypto_decrypt_hdr(
 
   uchar const * sample = cipher_text + sample_off;
 
-  /* TODO this is hardcoded to AES-128 */
   uchar hp_cipher[16];
-  fd_aes_key_t ecb[1];
-  fd_aes_set_encrypt_key( keys->hp_key, 128, ecb );
-  fd_aes_encrypt( sample, hp_cipher, ecb );
+  fd_aes_encrypt( sample, hp_cipher, &keys->hp_cipher );
 
   /* copy header, up to packet number, into output */
   fd_memcpy( plain_text, cipher_text, sample_off );
@@ -623,126 +711,6 @@ fd_quic_crypto_rand( uchar * buf,
   return FD_QUIC_SUCCESS;
 }
 
-int fd_quic_retry_token_encrypt(
-    fd_quic_conn_id_t const * orig_dst_conn_id,
-    ulong               now,
-    fd_quic_conn_id_t const * retry_src_conn_id,
-    uint                ip_addr,
-    ushort              udp_port,
-    uchar               retry_token[static FD_QUIC_RETRY_TOKEN_SZ]
-) {
-  /* Generate pseudorandom bytes to use as the key for the AEAD HKDF. Note these bytes form the
-     beginning of the retry token. */
-  uchar * hkdf_key = retry_token;
-  int     rc       = fd_quic_crypto_rand( retry_token, FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ );
-  if ( FD_UNLIKELY( rc == FD_QUIC_FAILED ) ) {
-    return FD_QUIC_FAILED;
-  }
-
-  /* The `extract` step of HKDF is unnecessary because what's being passed in to `expand` are
-   pseudorandom bytes. */
-  uchar aead_key[FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ];
-  fd_quic_hkdf_expand_label(
-      aead_key,
-      FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ,
-      hkdf_key,
-      FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ,
-      FD_QUIC_RETRY_TOKEN_AEAD_INFO,
-      FD_QUIC_RETRY_TOKEN_AEAD_INFO_SZ,
-      fd_hmac_sha256,
-      FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ
-  );
-
-  /* Since the key is derived from random bytes and only used once, we use a zero IV (nonce).
-     Note the IV length is by default 12 bytes (which is the recommended length for AES-GCM). */
-  uchar iv[FD_QUIC_NONCE_SZ] = { 0 };
-
-  /* The AAD is the client IPv4 address, UDP port, and retry source connection id. */
-  ulong aad_sz = (ulong)FD_QUIC_RETRY_TOKEN_AAD_PREFIX_SZ + retry_src_conn_id->sz;
-  uchar aad[aad_sz];
-  memcpy( aad, &ip_addr, sizeof( uint ) );
-  memcpy( aad + sizeof( uint ), &udp_port, sizeof( ushort ) );
-  memcpy( aad + sizeof( uint ) + sizeof( ushort ), &retry_src_conn_id->sz, sizeof( uchar ) );
-  memcpy(
-      aad + sizeof( uint ) + sizeof( ushort ) + sizeof( uchar ),
-      &retry_src_conn_id->conn_id,
-      retry_src_conn_id->sz
-  );
-
-  uchar plaintext[FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ] = { 0 };
-  if ( FD_UNLIKELY( orig_dst_conn_id->sz > FD_QUIC_MAX_CONN_ID_SZ ) ) return FD_QUIC_FAILED;
-  memcpy( plaintext, &orig_dst_conn_id->sz, sizeof( uchar ) );
-  memcpy( plaintext + 1, orig_dst_conn_id->conn_id, orig_dst_conn_id->sz );
-  memcpy( plaintext + 1 + orig_dst_conn_id->sz, &now, sizeof( ulong ) );
-
-  /* Append the ciphertext after random bytes in the retry_token. */
-  uchar * ciphertext = hkdf_key + FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ;
-
-  /* Append the authentication tag after ciphertext in the retry_token. */
-  uchar * tag = ciphertext + FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ;
-
-  fd_aes_gcm_t gcm[1];
-  fd_aes_256_gcm_init( gcm, aead_key, iv );
-  fd_aes_gcm_aead_encrypt( gcm, ciphertext, plaintext, FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ, aad, aad_sz, tag );
-
-  return FD_QUIC_SUCCESS;
-}
-
-int fd_quic_retry_token_decrypt(
-    uchar *             retry_token,
-    fd_quic_conn_id_t * retry_src_conn_id,
-    uint                ip_addr,
-    ushort              udp_port,
-    fd_quic_conn_id_t * orig_dst_conn_id,
-    ulong *             now
-) {
-  /* Regenerate the AEAD key (the HKDF key is the first 32 bytes of the token). */
-  uchar * hkdf_key = retry_token;
-  uchar   aead_key[FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ] = { 0 };
-  fd_quic_hkdf_expand_label(
-      aead_key,
-      FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ,
-      hkdf_key,
-      FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ,
-      FD_QUIC_RETRY_TOKEN_AEAD_INFO,
-      FD_QUIC_RETRY_TOKEN_AEAD_INFO_SZ,
-      fd_hmac_sha256,
-      FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ
-  );
-
-  uchar * ciphertext = hkdf_key + FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ;
-  ulong   aad_sz     = (ulong)FD_QUIC_RETRY_TOKEN_AAD_PREFIX_SZ + retry_src_conn_id->sz;
-  uchar   aad[aad_sz];
-  memset( aad, 0, aad_sz );
-  memcpy( aad, &ip_addr, sizeof( uint ) );
-  memcpy( aad + sizeof( uint ), &udp_port, sizeof( ushort ) );
-  memcpy( aad + sizeof( uint ) + sizeof( ushort ), &retry_src_conn_id->sz, sizeof( uchar ) );
-  if ( FD_LIKELY( retry_src_conn_id->sz ) ) {
-    fd_memcpy(
-        aad + sizeof( uint ) + sizeof( ushort ) + sizeof( uchar ),
-        &retry_src_conn_id->conn_id,
-        retry_src_conn_id->sz
-    );
-  }
-  uchar   iv[FD_QUIC_NONCE_SZ] = { 0 };
-  uchar * tag                  = ciphertext + FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ;
-  uchar   plaintext[FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ] = { 0 };
-
-  fd_aes_gcm_t gcm[1];
-  fd_aes_256_gcm_init( gcm, aead_key, iv );
-  int decrypt_ok =
-    fd_aes_gcm_aead_decrypt( gcm, ciphertext, plaintext, FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ, aad, aad_sz, tag );
-  if( FD_UNLIKELY( !decrypt_ok ) )
-    return FD_QUIC_FAILED;
-
-  uchar orig_dst_conn_id_sz = *plaintext; /* untrusted input */
-  if ( FD_UNLIKELY( orig_dst_conn_id_sz > FD_QUIC_MAX_CONN_ID_SZ ) ) return FD_QUIC_FAILED;
-  orig_dst_conn_id->sz = orig_dst_conn_id_sz;
-  memcpy( orig_dst_conn_id->conn_id, plaintext + sizeof( uchar ), orig_dst_conn_id->sz );
-  *now = *( (ulong *)fd_type_pun( plaintext + sizeof( uchar ) + orig_dst_conn_id->sz ) );
-  return FD_QUIC_SUCCESS;
-}
-
 int fd_quic_retry_integrity_tag_encrypt(
     uchar * retry_pseudo_pkt,
     int     retry_pseudo_pkt_len,
@@ -4,6 +4,7 @@
 #include "../fd_quic_common.h"
 #include "../fd_quic_conn_id.h"
 #include "../../../ballet/hmac/fd_hmac.h"
+#include "../../../ballet/aes/fd_aes_gcm.h"
 
 /* Defines the crypto suites used by QUIC v1.
 
@@ -81,6 +82,15 @@ struct fd_quic_crypto_keys {
   /* header protection */
   uchar hp_key[FD_QUIC_KEY_MAX_SZ];
   ulong hp_key_sz;
+
+  /* pkt_key and hp_key expanded for the ciphers, computed once when the
+     keys are generated so that protecting and unprotecting a packet
+     only does per packet work.  pkt_cipher has the AES key schedule and
+     the GHASH tables of pkt_key (the iv is set per packet, so the state
+     in it is scratch).  hp_cipher is the AES key schedule of hp_key
+     (only set by fd_quic_gen_keys). */
+  fd_aes_gcm_t pkt_cipher;
+  fd_aes_key_t hp_cipher;
 };
 
 /* crypto context */
@@ -148,23 +158,6 @@ extern uchar FD_QUIC_CRYPTO_V1_INITIAL_SALT[ 20UL ];
 #define FD_QUIC_CRYPTO_LABEL_QUIC_IV_SZ   ( sizeof( FD_QUIC_CRYPTO_LABEL_QUIC_IV ) - 1 )
 #define FD_QUIC_CRYPTO_LABEL_QUIC_HP_SZ   ( sizeof( FD_QUIC_CRYPTO_LABEL_QUIC_HP ) - 1 )
 
-/* retry token plaintext: 1 + orig dst conn id (padded to 20 bytes) + fd_log_wallclock (long) */
-#define FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ (1 + FD_QUIC_MAX_CONN_ID_SZ + sizeof(long))
-/* ciphertext length should equal plaintext in chosen AEAD scheme */
-#define FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ
-/* retry token authenticated associated data (AAD): ipv4 + port + retry src conn id length */
-#define FD_QUIC_RETRY_TOKEN_AAD_PREFIX_SZ (4 + 2 + 1)
-/* 256-bit key */
-#define FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ 32
-/* retry token = prepended random bytes + encrypted ciphertext + appended authentication tag */
-#define FD_QUIC_RETRY_TOKEN_SZ (FD_QUIC_RETRY_TOKEN_HKDF_KEY_SZ + FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ + FD_QUIC_CRYPTO_TAG_SZ)
-/* 256-bit output from HKDF */
-#define FD_QUIC_RETRY_TOKEN_AEAD_KEY_SZ 32
-/* HKFD application-specific context (similar to a salt) */
-#define FD_QUIC_RETRY_TOKEN_AEAD_INFO ((const uchar *)"fd quic retry token")
-#define FD_QUIC_RETRY_TOKEN_AEAD_INFO_SZ (sizeof("fd quic retry token") - 1)
-/* Retry token lifetime is 15 seconds */
-#define FD_QUIC_RETRY_TOKEN_LIFETIME (ulong)(15 * 1e9L)
 /* The retry integrity tag is the 16-byte tag output of AES-128-GCM */
 #define FD_QUIC_RETRY_INTEGRITY_TAG_SZ FD_QUIC_CRYPTO_TAG_SZ
 #define FD_QUIC_RETRY_INTEGRITY_TAG_KEY ((uchar *)"\xbe\x0c\x69\x0b\x9f\x66\x57\x5a\x1d\x76\x6b\x54\xe3\x68\xc8\x4e")
@@ -411,7 +404,8 @@ fd_quic_crypto_encrypt(
      pkt_number_off     the offset of the packet number within the cipher text
                         this must be determined from unprotected header data
      suite              which particular cipher suite the packet was protected with
-     keys               the keys needed to decrypt */
+     keys               the keys needed to decrypt (the cipher state in it is
+                          used as scratch) */
 
 int
 fd_quic_crypto_decrypt(
@@ -422,7 +416,39 @@ fd_quic_crypto_decrypt(
     ulong                    pkt_number_off,
     ulong                    pkt_number,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys );
+    fd_quic_crypto_keys_t *  keys );
+
+
+/* fd_quic_crypto_decrypt_batch decrypts a batch of quic protected
+   packets, like req_cnt calls to fd_quic_crypto_decrypt (and with the
+   same requirements), but with the AES-GCM work of the packets
+   interleaved (see fd_aes_gcm_aead_decrypt_batch), which is
+   considerably faster than decrypting small packets one at a time.
+
+   Request r is the arguments of a fd_quic_crypto_decrypt call:
+   out/out_sz are plain_text/plain_text_sz (out_sz is updated on
+   success), in/in_sz are cipher_text/cipher_text_sz, etc.  On return,
+   req[r].rc is the fd_quic_crypto_decrypt return code for request r.
+   The same keys may be used by multiple requests. */
+
+#define FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX FD_AES_GCM_BATCH_MAX
+
+struct fd_quic_crypto_decrypt_req {
+  uchar *                 out;
+  ulong                   out_sz;
+  uchar const *           in;
+  ulong                   in_sz;
+  ulong                   pkt_number_off;
+  ulong                   pkt_number;
+  fd_quic_crypto_keys_t * keys;
+  int                     rc;
+};
+
+typedef struct fd_quic_crypto_decrypt_req fd_quic_crypto_decrypt_req_t;
+
+void
+fd_quic_crypto_decrypt_batch( fd_quic_crypto_decrypt_req_t * req,
+                              ulong                          req_cnt );
 
 
 /* decrypt a quic protected packet header
@@ -456,7 +482,7 @@ fd_quic_crypto_decrypt_hdr(
     ulong                    cipher_text_sz,
     ulong                    pkt_number_off,
     fd_quic_crypto_suite_t const * suite,
-    fd_quic_crypto_keys_t const *  keys );
+    fd_quic_crypto_keys_t *  keys );
 
 
 /* look up crypto suite by major/minor
@@ -485,54 +511,6 @@ fd_quic_crypto_lookup_suite( uchar major,
   }
 }
 
-/* Create a retry token (RFC 9000, Section 17.2.5). Note the RFC does not specify how to generate
-   the token, only specifying that it is "an opaque token that the server can use to validate the
-   client's address."
-
-   Hence, in this particular QUIC implementation, the token is generated via the following scheme:
-     1. Generate a sequence of 32 cryptographically-secure pseudorandom bytes (256 bits).
-     2. HKDF-expand these bytes to form a key for the subsequent AEAD function.
-          See RFC 5869, Section 3.3 for why it's ok to skip the HKDF-extract step.
-     3. Run AES-256-GCM.
-          The input plaintext is the client's original destination connection id and the current
-          timestamp. The associated data is the server's retry source connection id and client's
-          IPv4 address and UDP port.
-     4. The token is the concatenation of random bytes, encrypted ciphertext, and authentication
-        tag, in that order.
-
-  Returns the ciphertext's length, -1 on error.
-
-  Footnotes
-  - This is _not_ the Retry Integrity Tag scheme specified in RFC 9001, Section 5.8.
-  - This scheme is based on what's done in quinn (which is the QUIC implementation used by the
-    original Solana validator client), though a similar HKDF + AEAD scheme is used in other
-    implementations as well (quic-go, msquic). The differences are mainly what metadata is passed
-    to AEAD as plaintext vs. as associated data. */
-int fd_quic_retry_token_encrypt(
-    /* plaintext (timestamp calculated in function) */
-    fd_quic_conn_id_t const * orig_dst_conn_id,
-    ulong               now,
-    /* aad */
-    fd_quic_conn_id_t const * retry_src_conn_id,
-    uint                ip_addr,
-    ushort              udp_port,
-    /* ciphertext */
-    uchar retry_token[static FD_QUIC_RETRY_TOKEN_SZ]
-);
-
-/* Decrypt a retry token, and checks it for validity (see `fd_quic_retry_token_encrypt`). */
-int fd_quic_retry_token_decrypt(
-    /* ciphertext */
-    uchar * retry_token,
-    /* aad */
-    fd_quic_conn_id_t * retry_src_conn_id,
-    uint                ip_addr,
-    ushort              udp_port,
-    /* plaintext */
-    fd_quic_conn_id_t * orig_dst_conn_id,
-    ulong *             now
-);
-
 int fd_quic_retry_integrity_tag_encrypt(
     uchar * retry_pseudo_pkt,
     int     retry_pseudo_pkt_len,
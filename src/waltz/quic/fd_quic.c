@@ -23,10 +23,17 @@
 #define CONN_ID(CONN_ID) (CONN_ID)->conn_id[0], (CONN_ID)->conn_id[1], (CONN_ID)->conn_id[2], (CONN_ID)->conn_id[3],  \
                          (CONN_ID)->conn_id[4], (CONN_ID)->conn_id[5], (CONN_ID)->conn_id[6], (CONN_ID)->conn_id[7]
 
-/* Declare priority queue for time based processing */
-#define PRQ_NAME      service_queue
-#define PRQ_T         fd_quic_event_t
-#define PRQ_TIMEOUT_T ulong
+/* Declare priority queue for time based processing.  Each conn in the
+   queue tracks where its event is on the heap (updated behind the scenes
+   whenever the prq moves the event), so that a conn can be rescheduled
+   or removed in O(lg cnt) without searching the queue for it. */
+#define PRQ_NAME        service_queue
+#define PRQ_T           fd_quic_event_t
+#define PRQ_TIMEOUT_T   ulong
+#define PRQ_TMP_ST(p,t) do {                                           \
+                          (p)[0] = (t);                                \
+                          t.conn->service_queue_idx = (ulong)((p)-heap); \
+                        } while( 0 )
 #include "../../util/tmpl/fd_prq.c"
 
 /* Declare map type for stream_id -> stream* */
@@ -430,6 +437,16 @@ fd_quic_init( fd_quic_t * quic ) {
 
   fd_quic_crypto_ctx_init( state->crypto_ctx );
 
+  /* Pick the key of the retry tokens issued by this instance */
+
+  uchar retry_secret[ FD_QUIC_RETRY_SECRET_SZ ];
+  if( FD_UNLIKELY( fd_quic_crypto_rand( retry_secret, FD_QUIC_RETRY_SECRET_SZ )==FD_QUIC_FAILED ) ) {
+    FD_LOG_WARNING(( "fd_quic_crypto_rand failed" ));
+    return NULL;
+  }
+  fd_quic_retry_key_init( state->retry_key, retry_secret );
+  fd_memset_explicit( retry_secret, 0, FD_QUIC_RETRY_SECRET_SZ );
+
   /* Initialize transport params */
 
   /* total data that may be sent on the connection is rx_buf_sz per stream,
@@ -1126,6 +1143,7 @@ fd_quic_send_retry( fd_quic_t *                  quic,
   /* Retry token */
   ulong now = fd_quic_now(quic);
   int   rc  = fd_quic_retry_token_encrypt(
+      fd_quic_get_state( quic )->retry_key,
       orig_dst_conn_id,
       now,
       new_conn_id,
@@ -1201,6 +1219,86 @@ fd_quic_send_retry( fd_quic_t *                  quic,
   return 0UL;
 }
 
+/* fd_quic_retry_rx_validate finds the retry tokens of the batch_cnt
+   received datagrams in batch (carried by an Initial packet at the
+   start of a datagram) and validates them all at once into retry_rx,
+   so that fd_quic_handle_v1_initial does not have to validate them one
+   at a time.  This only peeks at the packet headers, the packets are
+   fully validated when processed (and the token of an invalid packet is
+   just not used). */
+
+static void
+fd_quic_retry_rx_validate( fd_quic_t *               quic,
+                           fd_quic_retry_rx_t *      retry_rx,
+                           fd_aio_pkt_info_t const * batch,
+                           ulong                     batch_cnt ) {
+  retry_rx->cnt = 0UL;
+  if( ( !quic->config.retry ) | ( quic->config.role!=FD_QUIC_ROLE_SERVER ) ) return;
+
+  for( ulong j=0UL; j<batch_cnt; j++ ) {
+    uchar const * data    = batch[ j ].buf;
+    ulong         data_sz = batch[ j ].buf_sz;
+
+    fd_eth_hdr_t eth[1];
+    fd_ip4_hdr_t ip4[1];
+    fd_udp_hdr_t udp[1];
+    ulong off = fd_quic_decode_eth( eth, data, data_sz );
+    if( FD_UNLIKELY( ( off==FD_QUIC_PARSE_FAIL ) || ( eth->net_type!=FD_ETH_HDR_TYPE_IP ) ) ) continue;
+    ulong rc = fd_quic_decode_ip4( ip4, data+off, data_sz-off );
+    if( FD_UNLIKELY( ( rc==FD_QUIC_PARSE_FAIL ) || ( ip4->protocol!=FD_IP4_HDR_PROTOCOL_UDP ) ) ) continue;
+    off += rc;
+    rc = fd_quic_decode_udp( udp, data+off, data_sz-off );
+    if( FD_UNLIKELY( rc==FD_QUIC_PARSE_FAIL ) ) continue;
+    off += rc;
+
+    /* Initial packet header up to the token (RFC 9000, Section 17.2.2) */
+
+    uchar const * cur_ptr = data   +off;
+    ulong         cur_sz  = data_sz-off;
+    if( FD_UNLIKELY( cur_sz<7UL ) ) continue;
+    if( ( cur_ptr[0] & 0xb0U )!=0x80U ) continue; /* not a long header Initial packet */
+    if( fd_uint_bswap( FD_LOAD( uint, cur_ptr+1 ) )!=1U ) continue;
+
+    ulong dst_conn_id_sz = cur_ptr[5];
+    ulong i              = 6UL + dst_conn_id_sz;
+    if( FD_UNLIKELY( ( dst_conn_id_sz>FD_QUIC_MAX_CONN_ID_SZ ) | ( i>=cur_sz ) ) ) continue;
+    ulong src_conn_id_sz = cur_ptr[i];
+    i += 1UL + src_conn_id_sz;
+    if( FD_UNLIKELY( ( src_conn_id_sz>FD_QUIC_MAX_CONN_ID_SZ ) | ( i>=cur_sz ) ) ) continue;
+
+    ulong varint_sz = 1UL<<( cur_ptr[i]>>6 );
+    if( FD_UNLIKELY( i+varint_sz>cur_sz ) ) continue;
+    ulong token_sz = cur_ptr[i] & 0x3fUL;
+    for( ulong k=1UL; k<varint_sz; k++ ) token_sz = ( token_sz<<8 ) | cur_ptr[i+k];
+    i += varint_sz;
+    if( ( token_sz!=FD_QUIC_RETRY_TOKEN_SZ ) | ( i+token_sz>cur_sz ) ) continue;
+
+    fd_quic_retry_token_req_t * req = &retry_rx->req[ retry_rx->cnt ];
+    req->token                = cur_ptr+i;
+    req->retry_src_conn_id.sz = (uchar)dst_conn_id_sz;
+    fd_memcpy( req->retry_src_conn_id.conn_id, cur_ptr+6, dst_conn_id_sz );
+    req->ip_addr              = FD_LOAD( uint, ip4->saddr_c );
+    req->udp_port             = udp->net_sport;
+    retry_rx->pkt[ retry_rx->cnt++ ] = cur_ptr;
+  }
+
+  fd_quic_retry_token_decrypt_batch( fd_quic_get_state( quic )->retry_key, retry_rx->req, retry_rx->cnt );
+}
+
+/* fd_quic_retry_rx_query returns the token of the Initial packet at
+   cur_ptr validated by fd_quic_retry_rx_validate, or NULL if it was not
+   validated ahead (retry_rx may be NULL) */
+
+static fd_quic_retry_token_req_t const *
+fd_quic_retry_rx_query( fd_quic_retry_rx_t const * retry_rx,
+                        uchar const *              cur_ptr ) {
+  if( !retry_rx ) return NULL;
+  for( ulong i=0UL; i<retry_rx->cnt; i++ ) {
+    if( retry_rx->pkt[i]==cur_ptr ) return &retry_rx->req[i];
+  }
+  return NULL;
+}
+
 /* fd_quic_handle_v1_initial handles an "Initial"-type packet.
    Valid for both server and client.  Initial packets are used to
    establish QUIC conns and wrap the TLS handshake flow among other
@@ -1400,11 +1498,20 @@ fd_quic_handle_v1_initial( fd_quic_t *               quic,
 
         fd_quic_conn_id_t retry_odcid;
         ulong issued;
-        if (FD_UNLIKELY(fd_quic_retry_token_decrypt((uchar *) initial->token, &retry_src_conn_id, dst_ip_addr, dst_udp_port, &retry_odcid, &issued))) {
+        fd_quic_retry_token_req_t const * req = fd_quic_retry_rx_query( pkt->retry_rx, cur_ptr );
+        if( FD_LIKELY( req ) ) {
+          /* already validated with the other tokens of the rx batch */
+          if( FD_UNLIKELY( req->rc!=FD_QUIC_SUCCESS ) ) {
+            quic->metrics.conn_err_retry_fail_cnt++;
+            return FD_QUIC_PARSE_FAIL;
+          }
+          retry_odcid = req->orig_dst_conn_id;
+          issued      = req->issued;
+        } else if( FD_UNLIKELY( fd_quic_retry_token_decrypt( state->retry_key, initial->token, &retry_src_conn_id, dst_ip_addr, dst_udp_port, &retry_odcid, &issued ) ) ) {
           quic->metrics.conn_err_retry_fail_cnt++;
           /* No need to set conn error, no conn object exists */
           return FD_QUIC_PARSE_FAIL;
-        };
+        }
         tp->original_destination_connection_id_len     = retry_odcid.sz;
         fd_memcpy( state->transport_params.original_destination_connection_id,
           retry_odcid.conn_id,
@@ -1957,12 +2064,39 @@ fd_quic_handle_v1_zero_rtt( fd_quic_t * quic, fd_quic_conn_t * conn, fd_quic_pkt
   return FD_QUIC_PARSE_FAIL;
 }
 
-ulong
-fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
-                           fd_quic_conn_t * conn,
-                           fd_quic_pkt_t *  pkt,
-                           uchar const *    cur_ptr,
-                           ulong            cur_sz ) {
+/* fd_quic_one_rtt_rx_t is a 1-RTT packet whose header has been
+   processed (see fd_quic_one_rtt_hdr) and whose payload is yet to be
+   decrypted and processed (see fd_quic_one_rtt_frames).  Splitting the
+   two allows the payloads of the packets of different connections to
+   be decrypted together (see fd_quic_rx_batch_t). */
+
+struct fd_quic_one_rtt_rx {
+  fd_quic_conn_t *        conn;
+  fd_quic_pkt_t *         pkt;
+  uchar const *           cur_ptr;
+  ulong                   cur_sz;
+  ulong                   pn_offset;
+  ulong                   pkt_number;
+  ulong                   pkt_number_sz;
+  fd_quic_crypto_keys_t * keys; /* payload keys, NULL if the payload is already in
+                                   conn->crypt_scratch (FD_QUIC_TEST_INSECURE) */
+};
+
+typedef struct fd_quic_one_rtt_rx fd_quic_one_rtt_rx_t;
+
+/* fd_quic_one_rtt_hdr does the first half of fd_quic_handle_v1_one_rtt:
+   it decodes the packet, removes header protection into
+   conn->crypt_scratch, reconstructs the packet number and handles key
+   phase changes, and fills in rx.  Returns FD_QUIC_PARSE_FAIL on
+   failure and cur_sz on success. */
+
+static ulong
+fd_quic_one_rtt_hdr( fd_quic_t *            quic,
+                     fd_quic_conn_t *       conn,
+                     fd_quic_pkt_t *        pkt,
+                     uchar const *          cur_ptr,
+                     ulong                  cur_sz,
+                     fd_quic_one_rtt_rx_t * rx ) {
   if( !conn ) {
     /* this can happen */
     return FD_QUIC_PARSE_FAIL;
@@ -2002,15 +2136,18 @@ fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
   /* header protection needs the offset to the packet number */
   ulong    pn_offset        = one_rtt->pkt_num_pnoff;
 
-  uchar *  crypt_scratch    = conn->crypt_scratch;
-  ulong    crypt_scratch_sz = sizeof( conn->crypt_scratch );
-
   uchar *  dec_hdr          = conn->crypt_scratch;
   ulong    dec_hdr_sz       = sizeof( conn->crypt_scratch );
 
   ulong    pkt_number       = ULONG_MAX;
   ulong    pkt_number_sz    = ULONG_MAX;
-  ulong    tot_sz           = ULONG_MAX;
+
+  rx->conn      = conn;
+  rx->pkt       = pkt;
+  rx->cur_ptr   = cur_ptr;
+  rx->cur_sz    = cur_sz;
+  rx->pn_offset = pn_offset;
+  rx->keys      = NULL;
 
 #ifdef FD_QUIC_TEST_INSECURE
   /* testing/sanitizing code */
@@ -2020,7 +2157,6 @@ fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
     fd_memcpy( conn->crypt_scratch, cur_ptr, cur_sz );
 
     pkt_number_sz     = ( (uint)dec_hdr[0] & 0x03u ) + 1u;
-    tot_sz            = cur_sz;
 
     pkt_number        = fd_quic_parse_bits( dec_hdr + pn_offset, 0, 8u * pkt_number_sz );
 
@@ -2064,7 +2200,6 @@ fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
 
     /* number of bytes in the packet header */
     pkt_number_sz = ( first & 0x03u ) + 1u;
-    tot_sz        = cur_sz; /* total including header and payload */
 
     /* now we have decrypted packet number */
     /* TODO packet number processing */
@@ -2133,25 +2268,38 @@ fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
       conn->key_phase_upd = 1;
     }
 
-    fd_quic_crypto_keys_t * keys = current_key_phase ? &conn->keys[enc_level][!server]
-                                                     : &conn->new_keys[!server];
-
-    /* this decrypts the header and payload */
-    if( fd_quic_crypto_decrypt( crypt_scratch, &crypt_scratch_sz,
-                                cur_ptr, tot_sz,
-                                pn_offset,
-                                pkt_number,
-                                suite,
-                                keys ) != FD_QUIC_SUCCESS ) {
-      /* remove connection from map, and insert into free list */
-      FD_DEBUG( FD_LOG_DEBUG(( "fd_quic_crypto_decrypt failed" )) );
-      quic->metrics.conn_err_tls_fail_cnt++;
-      return FD_QUIC_PARSE_FAIL;
-    }
+    rx->keys = current_key_phase ? &conn->keys[enc_level][!server]
+                                 : &conn->new_keys[!server];
 #ifdef FD_QUIC_TEST_INSECURE
   }
 #endif
 
+  rx->pkt_number    = pkt_number;
+  rx->pkt_number_sz = pkt_number_sz;
+
+  return cur_sz;
+}
+
+/* fd_quic_one_rtt_frames does the second half of
+   fd_quic_handle_v1_one_rtt, once the payload of rx has been decrypted
+   into rx->conn->crypt_scratch: it handles the frames of the packet.
+   Returns FD_QUIC_PARSE_FAIL on failure and the number of bytes
+   consumed on success. */
+
+static ulong
+fd_quic_one_rtt_frames( fd_quic_t *            quic,
+                        fd_quic_one_rtt_rx_t * rx ) {
+
+  fd_quic_conn_t * conn          = rx->conn;
+  fd_quic_pkt_t *  pkt           = rx->pkt;
+  uint             enc_level     = fd_quic_enc_level_appdata_id;
+  uchar const *    crypt_scratch = conn->crypt_scratch;
+  ulong            cur_sz        = rx->cur_sz;
+  ulong            pn_offset     = rx->pn_offset;
+  ulong            pkt_number    = rx->pkt_number;
+  ulong            pkt_number_sz = rx->pkt_number_sz;
+  ulong            rc;
+
   /* if peer encryption level increases, consider prior encryption
      level pkt_meta acked */
   fd_quic_ack_enc_level( conn, enc_level );
@@ -2187,7 +2335,47 @@ fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
     conn->exp_pkt_number[pn_space] = pkt_number + 1u;
   } while(0);
 
-  return tot_sz;
+  return cur_sz;
+}
+
+ulong
+fd_quic_handle_v1_one_rtt( fd_quic_t *      quic,
+                           fd_quic_conn_t * conn,
+                           fd_quic_pkt_t *  pkt,
+                           uchar const *    cur_ptr,
+                           ulong            cur_sz ) {
+
+  fd_quic_one_rtt_rx_t rx[1];
+  if( FD_UNLIKELY( fd_quic_one_rtt_hdr( quic, conn, pkt, cur_ptr, cur_sz, rx )==FD_QUIC_PARSE_FAIL ) )
+    return FD_QUIC_PARSE_FAIL;
+
+  if( FD_LIKELY( rx->keys ) ) {
+    /* this decrypts the header and payload */
+    ulong crypt_scratch_sz = sizeof( conn->crypt_scratch );
+    if( fd_quic_crypto_decrypt( conn->crypt_scratch, &crypt_scratch_sz,
+                                cur_ptr, cur_sz,
+                                rx->pn_offset,
+                                rx->pkt_number,
+                                conn->suites[ fd_quic_enc_level_appdata_id ],
+                                rx->keys ) != FD_QUIC_SUCCESS ) {
+      /* remove connection from map, and insert into free list */
+      FD_DEBUG( FD_LOG_DEBUG(( "fd_quic_crypto_decrypt failed" )) );
+      quic->metrics.conn_err_tls_fail_cnt++;
+      return FD_QUIC_PARSE_FAIL;
+    }
+  }
+
+  return fd_quic_one_rtt_frames( quic, rx );
+}
+
+void
+fd_quic_unschedule_conn( fd_quic_conn_t * conn ) {
+  if( !conn->in_service ) return;
+
+  fd_quic_state_t * state = fd_quic_get_state( conn->quic );
+  service_queue_remove( state->service_queue, conn->service_queue_idx );
+
+  conn->in_service = 0;
 }
 
 void
@@ -2198,29 +2386,8 @@ fd_quic_schedule_conn( fd_quic_conn_t * conn ) {
 
   ulong             timeout = conn->next_service_time;
 
-  /* scheduled? */
-  if( conn->in_service ) {
-    /* find conn in events, then remove, update, insert */
-    fd_quic_event_t * event     = NULL;
-    ulong             event_idx = 0;
-    ulong             cnt   = service_queue_cnt( state->service_queue );
-    for( ulong j = 0; j < cnt; ++j ) {
-      fd_quic_event_t * cur_event = state->service_queue + j;
-      if( cur_event->conn == conn ) {
-        event     = cur_event;
-        event_idx = j;
-        break;
-      }
-    }
-
-    if( FD_LIKELY( event ) ) {
-      /* remove key */
-      service_queue_remove( state->service_queue, event_idx );
-
-      /* TODO can use a priority queue key-reduce operation, which may be done more
-         quickly than remove, insert */
-    }
-  }
+  /* scheduled? remove, then reinsert at the new time */
+  fd_quic_unschedule_conn( conn );
 
   timeout = fd_ulong_max( timeout, fd_quic_now(quic) + 1UL );
 
@@ -2261,35 +2428,19 @@ fd_quic_reschedule_conn( fd_quic_conn_t * conn,
   /* scheduled? */
   if( conn->in_service ) {
     timeout = fd_ulong_min( timeout, conn->next_service_time );
+    timeout = fd_ulong_max( timeout, now + 1UL );
 
     /* in the queue, but already scheduled sooner */
     if( timeout >= conn->sched_service_time ) {
       return;
     }
 
-    /* find conn in events, then remove, update, insert */
-    fd_quic_event_t * event     = NULL;
-    ulong             event_idx = 0;
-    ulong             cnt   = service_queue_cnt( state->service_queue );
-    for( ulong j = 0; j < cnt; ++j ) {
-      fd_quic_event_t * cur_event = state->service_queue + j;
-      if( cur_event->conn == conn ) {
-        event     = cur_event;
-        event_idx = j;
-        break;
-      }
-    }
+    /* scheduled later, so move the conn's event up the queue in place */
+    fd_quic_event_t event[1] = {{ .timeout = timeout, .conn = conn }};
+    service_queue_private_fill_hole_up( state->service_queue, conn->service_queue_idx, event );
 
-    if( FD_LIKELY( event ) ) {
-      /* remove key */
-      service_queue_remove( state->service_queue, event_idx );
-
-      /* TODO can use a priority queue key-reduce operation, which may be done more
-         quickly than remove, insert */
-    }
-
-    conn->next_service_time = timeout;
-    fd_quic_schedule_conn( conn );
+    conn->sched_service_time = timeout;
+    conn->next_service_time  = timeout;
 
     return;
   }
@@ -2600,10 +2751,127 @@ fd_quic_process_quic_packet_v1( fd_quic_t *     quic,
   return (ulong)( cur_ptr - orig_ptr );
 }
 
+/* fd_quic_rx_batch_t gathers the 1-RTT packets of a receive batch
+   (fd_quic_aio_cb_receive) so that their payloads are decrypted
+   together with fd_quic_crypto_decrypt_batch, which is much faster than
+   decrypting them one at a time.  The header of a packet is processed
+   when it is added and its payload is decrypted and its frames handled
+   when the batch is flushed.
+
+   Packets are processed in arrival order: the batch is flushed before
+   any packet that is not batched is processed, and the payload of a
+   connection is decrypted into its crypt_scratch, so a batch holds at
+   most one packet per connection (the batch is flushed before adding a
+   second one). */
+
+struct fd_quic_rx_batch {
+  fd_quic_retry_rx_t           retry[1]; /* retry tokens of the datagrams being processed */
+
+  ulong                        cnt;
+  fd_quic_pkt_t                pkt[ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  fd_quic_one_rtt_rx_t         rx [ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+  fd_quic_crypto_decrypt_req_t req[ FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ];
+};
+
+typedef struct fd_quic_rx_batch fd_quic_rx_batch_t;
+
+/* fd_quic_rx_one_rtt_fini handles the frames of a decrypted 1-RTT
+   packet and acks it, like the end of fd_quic_process_quic_packet_v1 */
+
+static void
+fd_quic_rx_one_rtt_fini( fd_quic_t *            quic,
+                         fd_quic_one_rtt_rx_t * rx ) {
+  ulong rc = fd_quic_one_rtt_frames( quic, rx );
+  if( FD_UNLIKELY( ( rc==FD_QUIC_PARSE_FAIL ) | ( rc==0UL ) ) ) return;
+
+  /* if we get here we parsed all the frames, so ack the packet */
+  if( rx->pkt->pkt_number != FD_QUIC_PKT_NUM_UNUSED ) {
+    fd_quic_ack_pkt( quic, rx->conn, rx->pkt );
+  }
+}
+
+static void
+fd_quic_rx_batch_flush( fd_quic_t *          quic,
+                        fd_quic_rx_batch_t * batch ) {
+  ulong cnt = batch->cnt;
+  if( !cnt ) return;
+
+  fd_quic_crypto_decrypt_batch( batch->req, cnt );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    if( FD_UNLIKELY( batch->req[i].rc != FD_QUIC_SUCCESS ) ) {
+      FD_DEBUG( FD_LOG_DEBUG(( "fd_quic_crypto_decrypt failed" )) );
+      quic->metrics.conn_err_tls_fail_cnt++;
+      continue;
+    }
+    fd_quic_rx_one_rtt_fini( quic, &batch->rx[i] );
+  }
+
+  batch->cnt = 0UL;
+}
+
+/* fd_quic_rx_batch_add processes the header of 1-RTT packet cur_ptr
+   for conn and adds it to the batch (or processes it immediately if
+   its payload is not encrypted). */
+
+static void
+fd_quic_rx_batch_add( fd_quic_t *           quic,
+                      fd_quic_rx_batch_t *  batch,
+                      fd_quic_conn_t *      conn,
+                      fd_quic_pkt_t const * pkt,
+                      uchar const *         cur_ptr,
+                      ulong                 cur_sz ) {
+
+  for( ulong i=0UL; i<batch->cnt; i++ ) {
+    if( FD_UNLIKELY( batch->rx[i].conn==conn ) ) {
+      fd_quic_rx_batch_flush( quic, batch );
+      break;
+    }
+  }
+
+  ulong                  idx = batch->cnt;
+  fd_quic_pkt_t *        p   = &batch->pkt[ idx ];
+  fd_quic_one_rtt_rx_t * rx  = &batch->rx [ idx ];
+
+  *p = *pkt;
+
+  /* encryption level of short header packets is fd_quic_enc_level_appdata_id */
+  p->enc_level = fd_quic_enc_level_appdata_id;
+
+  /* initialize packet number to unused value */
+  p->pkt_number = FD_QUIC_PKT_NUM_UNUSED;
+
+  if( FD_UNLIKELY( fd_quic_one_rtt_hdr( quic, conn, p, cur_ptr, cur_sz, rx )==FD_QUIC_PARSE_FAIL ) ) return;
+
+  if( FD_UNLIKELY( !rx->keys ) ) {
+    /* not encrypted (testing only) */
+    fd_quic_rx_batch_flush( quic, batch ); /* leaves slot idx alone */
+    fd_quic_rx_one_rtt_fini( quic, rx );
+    return;
+  }
+
+  fd_quic_crypto_decrypt_req_t * req = &batch->req[ idx ];
+  req->out            = conn->crypt_scratch;
+  req->out_sz         = sizeof( conn->crypt_scratch );
+  req->in             = cur_ptr;
+  req->in_sz          = cur_sz;
+  req->pkt_number_off = rx->pn_offset;
+  req->pkt_number     = rx->pkt_number;
+  req->keys           = rx->keys;
+
+  batch->cnt = idx+1UL;
+  if( batch->cnt==FD_QUIC_CRYPTO_DECRYPT_BATCH_MAX ) fd_quic_rx_batch_flush( quic, batch );
+}
+
+/* fd_quic_process_packet processes the UDP datagram data.  If rx_batch
+   is non-NULL, 1-RTT packets are added to it rather than processed
+   immediately (the caller flushes it once done). */
+
 void
-fd_quic_process_packet( fd_quic_t *   quic,
-                        uchar const * data,
-                        ulong         data_sz ) {
+fd_quic_process_packet( fd_quic_t *          quic,
+                        uchar const *        data,
+                        ulong                data_sz,
+                        fd_quic_rx_batch_t * rx_batch ) {
 
   fd_quic_state_t * state = fd_quic_get_state( quic );
 
@@ -2620,7 +2888,8 @@ fd_quic_process_packet( fd_quic_t *   quic,
     return;
   }
 
-  fd_quic_pkt_t pkt = { .datagram_sz = (uint)data_sz };
+  fd_quic_pkt_t pkt = { .datagram_sz = (uint)data_sz,
+                        .retry_rx    = rx_batch ? rx_batch->retry : NULL };
 
   pkt.rcv_time = fd_quic_now( quic );
 
@@ -2701,6 +2970,9 @@ fd_quic_process_packet( fd_quic_t *   quic,
   uint version = 0;
 
   if( long_pkt ) {
+    /* preserve packet order, long header packets are not batched */
+    if( rx_batch ) fd_quic_rx_batch_flush( quic, rx_batch );
+
     version = DECODE_UINT32( cur_ptr + 1 );
 
     /* version negotiation packet has version 0 */
@@ -2781,15 +3053,34 @@ fd_quic_process_packet( fd_quic_t *   quic,
       return;
     }
 
-#if 0
-    fd_quic_conn_t * conn  = entry->conn;
-    (void)fd_quic_handle_v1_one_rtt( quic, conn, &pkt, cur_ptr, cur_sz );
-#else
-    (void)fd_quic_process_quic_packet_v1( quic, &pkt, cur_ptr, cur_sz );
-#endif
+    if( FD_LIKELY( rx_batch ) ) {
+      fd_quic_rx_batch_add( quic, rx_batch, entry->conn, &pkt, cur_ptr, cur_sz );
+    } else {
+      (void)fd_quic_process_quic_packet_v1( quic, &pkt, cur_ptr, cur_sz );
+    }
   }
 }
 
+void
+fd_quic_prefetch_rx( fd_quic_t *   quic,
+                     uchar const * data,
+                     ulong         data_sz ) {
+  /* Find the destination conn id of a 1-RTT (short header) packet
+     without fully decoding the headers.  The packet is validated when
+     processed, so this only needs to be memory safe. */
+  if( FD_UNLIKELY( data_sz<14UL+20UL ) ) return;
+  if( FD_UNLIKELY( fd_ushort_bswap( FD_LOAD( ushort, data+12UL ) )!=FD_ETH_HDR_TYPE_IP ) ) return;
+  uchar const * ip4 = data+14UL;
+  if( FD_UNLIKELY( ip4[ 9 ]!=FD_IP4_HDR_PROTOCOL_UDP ) ) return;
+  ulong pkt_off = 14UL + 4UL*(ulong)( ip4[ 0 ] & 0x0fU ) + 8UL;
+  if( FD_UNLIKELY( pkt_off+1UL+FD_QUIC_CONN_ID_SZ>data_sz ) ) return;
+  if( FD_UNLIKELY( data[ pkt_off ] & 0x80U ) ) return; /* long header */
+
+  fd_quic_conn_id_t dst_conn_id = { FD_QUIC_CONN_ID_SZ, {0}, {0} };
+  fd_memcpy( &dst_conn_id.conn_id, data+pkt_off+1UL, FD_QUIC_CONN_ID_SZ );
+  fd_quic_conn_map_prefetch( fd_quic_get_state( quic )->conn_map, &dst_conn_id );
+}
+
 /* main receive-side entry point */
 int
 fd_quic_aio_cb_receive( void *                    context,
@@ -2803,11 +3094,26 @@ fd_quic_aio_cb_receive( void *                    context,
 
   /* this aio interface is configured as one-packet per buffer
      so batch[0] refers to one buffer
-     as such, we simply forward each individual packet to a handling function */
-  for( ulong j = 0; j < batch_cnt; ++j ) {
-    fd_quic_process_packet( quic, batch[ j ].buf, batch[ j ].buf_sz );
-    quic->metrics.net_rx_byte_cnt += batch[ j ].buf_sz;
+     as such, we simply forward each individual packet to a handling function
+     (1-RTT packets are gathered in rx_batch to decrypt them together) */
+  fd_quic_rx_batch_t rx_batch[1];
+  rx_batch->cnt = 0UL;
+  if( batch_cnt>1UL ) {
+    /* look up the conns of all the packets together, so that the cache
+       misses overlap */
+    for( ulong j = 0; j < batch_cnt; ++j ) fd_quic_prefetch_rx( quic, batch[ j ].buf, batch[ j ].buf_sz );
+  }
+  for( ulong j0 = 0; j0 < batch_cnt; j0 += FD_QUIC_RETRY_TOKEN_BATCH_MAX ) {
+    /* validate the retry tokens of up to FD_QUIC_RETRY_TOKEN_BATCH_MAX
+       datagrams together before processing them */
+    ulong j1 = fd_ulong_min( j0 + FD_QUIC_RETRY_TOKEN_BATCH_MAX, batch_cnt );
+    fd_quic_retry_rx_validate( quic, rx_batch->retry, batch + j0, j1 - j0 );
+    for( ulong j = j0; j < j1; ++j ) {
+      fd_quic_process_packet( quic, batch[ j ].buf, batch[ j ].buf_sz, rx_batch );
+      quic->metrics.net_rx_byte_cnt += batch[ j ].buf_sz;
+    }
   }
+  fd_quic_rx_batch_flush( quic, rx_batch );
 
   /* the assumption here at present is that any packet that could not be processed
      is simply dropped
@@ -4636,17 +4942,8 @@ fd_quic_conn_free( fd_quic_t *      quic,
     }
   }
 
-  /* find conn in events, then remove */
-  /* FIXME O(n) scales badly with number of conns (#266) */
-  ulong             event_idx = 0;
-  ulong             cnt   = service_queue_cnt( state->service_queue );
-  for( ulong j = 0; j < cnt; ++j ) {
-    fd_quic_event_t * cur_event = state->service_queue + j;
-    if( cur_event->conn == conn ) {
-      /* remove */
-      service_queue_remove( state->service_queue, event_idx );
-    }
-  }
+  /* remove from the service queue */
+  fd_quic_unschedule_conn( conn );
 
   /* remove all stream ids from map, and free stream */
   ulong tot_num_streams = conn->tot_num_streams;
@@ -4735,6 +5032,8 @@ fd_quic_conn_free( fd_quic_t *      quic,
       conn->keys[j][k].pkt_key_sz = 0;
       conn->keys[j][k].hp_key_sz  = 0;
       conn->keys[j][k].iv_sz      = 0;
+      fd_memset( &conn->keys[j][k].pkt_cipher, 0, sizeof( fd_aes_gcm_t ) );
+      fd_memset( &conn->keys[j][k].hp_cipher,  0, sizeof( fd_aes_key_t ) );
     }
   }
   for( ulong k = 0U; k < 2U; ++k ) {
@@ -4744,6 +5043,8 @@ fd_quic_conn_free( fd_quic_t *      quic,
     conn->new_keys[k].pkt_key_sz = 0;
     conn->new_keys[k].hp_key_sz  = 0;
     conn->new_keys[k].iv_sz      = 0;
+    fd_memset( &conn->new_keys[k].pkt_cipher, 0, sizeof( fd_aes_gcm_t ) );
+    fd_memset( &conn->new_keys[k].hp_cipher,  0, sizeof( fd_aes_key_t ) );
   }
 }
 
@@ -5456,6 +5757,8 @@ fd_quic_reclaim_pkt_meta( fd_quic_conn_t *     conn,
       COPY_KEY(1,pkt_key);
       COPY_KEY(1,iv);
 #     undef COPY_KEY
+      conn->keys[enc_level][0].pkt_cipher = conn->new_keys[0].pkt_cipher;
+      conn->keys[enc_level][1].pkt_cipher = conn->new_keys[1].pkt_cipher;
 
       /* finally zero out new_keys */
       fd_memset( &conn->new_keys[0], 0, sizeof( fd_quic_crypto_keys_t ) );
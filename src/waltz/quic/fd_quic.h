@@ -536,6 +536,19 @@ fd_quic_config_from_env( int  *   pargc,
 FD_QUIC_API fd_aio_t const *
 fd_quic_get_aio_net_rx( fd_quic_t * quic );
 
+/* fd_quic_prefetch_rx prefetches the state needed to find the conn of
+   the datagram data (in the format accepted by the aio returned by
+   fd_quic_get_aio_net_rx, i.e. starting with the Ethernet header).
+   Calling this as soon as a datagram arrives, some time before it is
+   passed to the aio, hides the cache misses of the conn lookup.  Does
+   nothing for datagrams that are not 1-RTT packets.  Does not modify
+   quic and can be called by the thread that owns it at any time. */
+
+FD_QUIC_API void
+fd_quic_prefetch_rx( fd_quic_t *   quic,
+                     uchar const * data,
+                     ulong         data_sz );
+
 /* fd_quic_set_aio_net_tx sets the fd_aio_t used by the fd_quic_t to
    send tx data to the network driver.  Cleared on fini. */
 
@@ -99,7 +99,9 @@ fd_quic_conn_footprint_ext( fd_quic_limits_t const * limits,
   layout->ack_off       = off;
   off                  += inflight_pkt_cnt * sizeof(fd_quic_ack_t);
 
-  /* align total footprint */
+  /* align total footprint, so that conns laid out back to back are
+     all aligned */
+  off = fd_ulong_align_up( off, fd_quic_conn_align() );
 
   return off;
 }
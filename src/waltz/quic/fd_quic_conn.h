@@ -83,6 +83,8 @@ struct fd_quic_conn {
   ulong              next_service_time;   /* time service should be called next */
   ulong              sched_service_time;  /* time service is scheduled for, if in_service=1 */
   int                in_service;          /* whether the conn is in the service queue */
+  ulong              service_queue_idx;   /* index of the conn's event in the service queue, if in_service=1
+                                             (maintained by the service queue as events move) */
   uchar              called_conn_new;     /* whether we need to call conn_final on teardown */
 
   /* we can have multiple connection ids */
@@ -1,63 +1,224 @@
 #include "fd_quic_conn_map.h"
+#include "../../util/fd_util.h"
 
-/* define a map for connection id -> connection */
-#define MAP_NAME              fd_quic_conn_map_impl
-#define MAP_T                 fd_quic_conn_entry_t
-#define MAP_KEY_T             fd_quic_conn_id_t
-#define MAP_KEY_NULL          FD_QUIC_CONN_ID_NULL
-#define MAP_KEY_INVAL(key)    FD_QUIC_CONN_ID_INVAL(key)
-#define MAP_KEY_EQUAL(k0,k1)  FD_QUIC_CONN_ID_EQUAL(k0,k1)
-#define MAP_KEY_HASH(key)     FD_QUIC_CONN_ID_HASH(key)
-#define MAP_KEY_EQUAL_IS_SLOW 1
-#define MAP_QUERY_OPT         1
+#if FD_HAS_SSE
+#include "../../util/simd/fd_sse.h"
+#endif
 
-/* TODO define MAP_MOVE and MAP_KEY_MOVE? memcpy? */
+#define GROUP_SZ FD_QUIC_CONN_MAP_GROUP_SZ
 
-#include "../../util/tmpl/fd_map_dynamic.c"
+/* Private helpers ****************************************************/
 
+static inline uchar *
+fd_quic_conn_map_private_ctrl( fd_quic_conn_map_t const * map ) {
+  return (uchar *)( map+1 );
+}
+
+static inline fd_quic_conn_entry_t *
+fd_quic_conn_map_private_slot( fd_quic_conn_map_t const * map ) {
+  return (fd_quic_conn_entry_t *)( (ulong)map + map->slot_off );
+}
+
+/* control word of an occupied slot holding a key with the given hash
+   (the low bits of the hash pick the slot, so use the high bits) */
+
+static inline uchar
+fd_quic_conn_map_private_tag( uint hash ) {
+  return (uchar)( 0x80U | (hash>>25) );
+}
+
+static inline void
+fd_quic_conn_map_private_ctrl_set( fd_quic_conn_map_t * map,
+                                   ulong                idx,
+                                   uchar                ctrl ) {
+  uchar * ctrls = fd_quic_conn_map_private_ctrl( map );
+  ctrls[ idx ] = ctrl;
+  if( idx<GROUP_SZ ) ctrls[ map->slot_cnt+idx ] = ctrl;
+}
+
+/* fd_quic_conn_map_private_group returns the control words of the
+   GROUP_SZ slots starting at idx as two bit masks: bit i of *match is
+   set if the control word of slot idx+i is tag and bit i of *empty if
+   slot idx+i is empty. */
+
+static inline void
+fd_quic_conn_map_private_group( uchar const * ctrls,
+                                ulong         idx,
+                                uchar         tag,
+                                uint *        match,
+                                uint *        empty ) {
+#if FD_HAS_SSE
+  vb_t group = vb_ldu( ctrls+idx );
+  *match = (uint)_mm_movemask_epi8( vb_eq( group, vb_bcast( tag ) ) );
+  *empty = (uint)_mm_movemask_epi8( vb_eq( group, vb_zero()       ) );
+#else
+  uint m = 0U;
+  uint e = 0U;
+  for( ulong i=0UL; i<GROUP_SZ; i++ ) {
+    m |= ( (uint)( ctrls[ idx+i ]==tag ) )<<i;
+    e |= ( (uint)( ctrls[ idx+i ]==0   ) )<<i;
+  }
+  *match = m;
+  *empty = e;
+#endif
+}
+
+/* fd_quic_conn_map_private_probe looks for key with hash in map.
+   Returns the index of its slot if found.  Otherwise, returns ~idx
+   where idx is the empty slot ending its probe sequence (where it would
+   be inserted). */
+
+static inline ulong
+fd_quic_conn_map_private_probe( fd_quic_conn_map_t const * map,
+                                fd_quic_conn_id_t const *  key,
+                                uint                       hash ) {
+  uchar const *                ctrls = fd_quic_conn_map_private_ctrl( map );
+  fd_quic_conn_entry_t const * slot  = fd_quic_conn_map_private_slot( map );
+  ulong                        mask  = map->slot_cnt-1UL;
+  uchar                        tag   = fd_quic_conn_map_private_tag( hash );
+
+  ulong idx = (ulong)hash & mask;
+  for(;;) {
+    uint match; uint empty;
+    fd_quic_conn_map_private_group( ctrls, idx, tag, &match, &empty );
+
+    /* Only the slots before the first empty one are in the probe
+       sequence */
+    match &= (empty & -empty) - 1U;
+    while( match ) {
+      ulong i = ( idx + (ulong)fd_uint_find_lsb( match ) ) & mask;
+      if( FD_LIKELY( FD_QUIC_CONN_ID_EQUAL( slot[ i ].key, *key ) ) ) return i;
+      match &= match-1U;
+    }
+
+    if( FD_LIKELY( empty ) ) return ~( ( idx + (ulong)fd_uint_find_lsb( empty ) ) & mask );
+    idx = ( idx+GROUP_SZ ) & mask;
+  }
+}
+
+/* Public API *********************************************************/
 
 ulong
 fd_quic_conn_map_align( void ) {
-  return fd_quic_conn_map_impl_align();
+  return alignof(fd_quic_conn_map_t);
 }
 
 ulong
 fd_quic_conn_map_footprint( int lg_slot_cnt ) {
-  return fd_quic_conn_map_impl_footprint( lg_slot_cnt );
+  if( FD_UNLIKELY( lg_slot_cnt<0 || lg_slot_cnt>31 ) ) return 0UL;
+  ulong slot_cnt = fd_ulong_max( 1UL<<lg_slot_cnt, GROUP_SZ );
+
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof(fd_quic_conn_map_t),   sizeof(fd_quic_conn_map_t)                );
+  l = FD_LAYOUT_APPEND( l, 1UL,                           slot_cnt+GROUP_SZ                         );
+  l = FD_LAYOUT_APPEND( l, 64UL,                          slot_cnt*sizeof(fd_quic_conn_entry_t)     );
+  return FD_LAYOUT_FINI( l, fd_quic_conn_map_align() );
 }
 
 fd_quic_conn_map_t *
 fd_quic_conn_map_new( void * mem,
                       int    lg_slot_cnt ) {
-  mem = fd_quic_conn_map_impl_new( mem, lg_slot_cnt );
-  mem = fd_quic_conn_map_impl_join( mem );
-  return mem;
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, fd_quic_conn_map_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_quic_conn_map_footprint( lg_slot_cnt ) ) ) {
+    FD_LOG_WARNING(( "invalid lg_slot_cnt (%d)", lg_slot_cnt ));
+    return NULL;
+  }
+
+  ulong slot_cnt = fd_ulong_max( 1UL<<lg_slot_cnt, GROUP_SZ );
+
+  fd_quic_conn_map_t * map = (fd_quic_conn_map_t *)mem;
+  map->slot_cnt = slot_cnt;
+  map->key_max  = slot_cnt-1UL;
+  map->key_cnt  = 0UL;
+  map->slot_off = fd_ulong_align_up( sizeof(fd_quic_conn_map_t) + slot_cnt + GROUP_SZ, 64UL );
+
+  /* all slots empty */
+  fd_memset( fd_quic_conn_map_private_ctrl( map ), 0, slot_cnt+GROUP_SZ );
+
+  return map;
 }
 
 void
 fd_quic_conn_map_delete( fd_quic_conn_map_t * map ) {
-  void * mem = fd_quic_conn_map_impl_leave( map );
-  fd_quic_conn_map_impl_delete( mem );
+  (void)map;
 }
 
 fd_quic_conn_entry_t *
 fd_quic_conn_map_insert( fd_quic_conn_map_t * map, fd_quic_conn_id_t const * key ) {
-  return fd_quic_conn_map_impl_insert( map, *key );
+  if( FD_UNLIKELY( map->key_cnt>=map->key_max ) ) return NULL;
+
+  uint  hash = FD_QUIC_CONN_ID_HASH( *key );
+  ulong idx  = fd_quic_conn_map_private_probe( map, key, hash );
+  if( FD_UNLIKELY( (long)idx>=0L ) ) return NULL; /* already in map */
+  idx = ~idx;
+
+  fd_quic_conn_entry_t * entry = fd_quic_conn_map_private_slot( map ) + idx;
+  entry->key  = *key;
+  entry->hash = hash;
+  fd_quic_conn_map_private_ctrl_set( map, idx, fd_quic_conn_map_private_tag( hash ) );
+  map->key_cnt++;
+
+  return entry;
 }
 
 void
 fd_quic_conn_map_remove( fd_quic_conn_map_t * map, fd_quic_conn_entry_t * entry ) {
-  fd_quic_conn_map_impl_remove( map, entry );
+  uchar const *          ctrls = fd_quic_conn_map_private_ctrl( map );
+  fd_quic_conn_entry_t * slot  = fd_quic_conn_map_private_slot( map );
+  ulong                  mask  = map->slot_cnt-1UL;
+
+  /* Make a hole at the removed slot, then move back into it the first
+     following entry of the probe run that is allowed to be there (its
+     probe sequence starts at or before the hole), which makes a hole
+     at the moved entry, and so on until the end of the run */
+
+  ulong hole = (ulong)( entry-slot );
+  ulong idx  = hole;
+  for(;;) {
+    idx = ( idx+1UL ) & mask;
+    uchar ctrl = ctrls[ idx ];
+    if( !ctrl ) break;
+    ulong home = (ulong)slot[ idx ].hash & mask;
+    if( ( ( idx-home ) & mask ) >= ( ( idx-hole ) & mask ) ) {
+      slot[ hole ] = slot[ idx ];
+      fd_quic_conn_map_private_ctrl_set( map, hole, ctrl );
+      hole = idx;
+    }
+  }
+  fd_quic_conn_map_private_ctrl_set( map, hole, 0 );
+  map->key_cnt--;
 }
 
 fd_quic_conn_entry_t *
-fd_quic_conn_map_query( fd_quic_conn_map_t * map, fd_quic_conn_id_t * key ) {
-  return fd_quic_conn_map_impl_query( map, *key, NULL );
+fd_quic_conn_map_query( fd_quic_conn_map_t * map, fd_quic_conn_id_t const * key ) {
+  ulong idx = fd_quic_conn_map_private_probe( map, key, FD_QUIC_CONN_ID_HASH( *key ) );
+  return (long)idx>=0L ? fd_quic_conn_map_private_slot( map ) + idx : NULL;
+}
+
+void
+fd_quic_conn_map_prefetch( fd_quic_conn_map_t const * map, fd_quic_conn_id_t const * key ) {
+  ulong idx = (ulong)FD_QUIC_CONN_ID_HASH( *key ) & (map->slot_cnt-1UL);
+  __builtin_prefetch( fd_quic_conn_map_private_ctrl( map )+idx );
+  __builtin_prefetch( fd_quic_conn_map_private_slot( map )+idx );
 }
 
 /* max entries in the map */
 ulong
 fd_quic_conn_map_max( fd_quic_conn_map_t * map ) {
-  return fd_quic_conn_map_impl_key_max( map );
+  return map->key_max;
 }
 
+ulong
+fd_quic_conn_map_cnt( fd_quic_conn_map_t * map ) {
+  return map->key_cnt;
+}
@@ -1,6 +1,22 @@
 #ifndef HEADER_fd_src_waltz_quic_fd_quic_conn_map_h
 #define HEADER_fd_src_waltz_quic_fd_quic_conn_map_h
 
+/* fd_quic_conn_map_t maps connection ids to connections.  It is queried
+   for every received packet, so it is laid out for fast lookups in the
+   style of a SwissTable: next to the array of slots is an array of one
+   byte control words, one per slot, that is 0 if the slot is empty and
+   0x80 | 7 bits of the key hash if it is occupied.  A query starts at
+   the slot given by the key hash and compares the 16 control words from
+   there at once (one SSE compare), then only compares the keys of the
+   slots whose control word matches, which filters out almost all the
+   slots that hold a different key without touching them.  Collisions
+   are resolved by linear probing, and removing a key shifts the
+   following entries back (no tombstones), so probe sequences stay short
+   no matter how many connections come and go.
+
+   Removal moves entries around, so entry pointers are only valid until
+   the next insert or remove. */
+
 #include "fd_quic_conn_id.h"
 
 /* forward declare */
@@ -18,8 +34,27 @@ struct fd_quic_conn_entry {
 };
 typedef struct fd_quic_conn_entry fd_quic_conn_entry_t;
 
-/* the map itself is the first entry */
-typedef fd_quic_conn_entry_t fd_quic_conn_map_t;
+/* FD_QUIC_CONN_MAP_GROUP_SZ is the number of control words compared at
+   once by a query.  Maps have at least this many slots. */
+
+#define FD_QUIC_CONN_MAP_GROUP_SZ (16UL)
+
+struct __attribute__((aligned(64UL))) fd_quic_conn_map_private {
+  ulong slot_cnt;  /* number of slots, a power of 2 >= GROUP_SZ */
+  ulong key_max;   /* max number of keys, slot_cnt-1 */
+  ulong key_cnt;   /* number of keys in the map */
+  ulong slot_off;  /* byte offset from the map to the slot array */
+
+  /* padding to 64 */
+
+  /* slot_cnt+GROUP_SZ uchar (control words): the control word of slot i
+     is at [i], and [slot_cnt,slot_cnt+GROUP_SZ) mirrors [0,GROUP_SZ) so
+     that a group of control words can be loaded at any slot without
+     wrapping around */
+
+  /* slot_cnt fd_quic_conn_entry_t (slots), 64 byte aligned */
+};
+typedef struct fd_quic_conn_map_private fd_quic_conn_map_t;
 
 FD_PROTOTYPES_BEGIN
 
@@ -41,7 +76,9 @@ fd_quic_conn_map_footprint( int lg_slot_cnt );
      mem          memory to use to initialize the map
                     must be aligned according to fd_quic_conn_map_align(),
                     and sized according to fd_quic_conn_map_footprint()
-     lg_slot_cnt  log_2(number of slots in map) */
+     lg_slot_cnt  log_2(number of slots in map)
+                    values below lg(FD_QUIC_CONN_MAP_GROUP_SZ) are rounded
+                    up to it */
 fd_quic_conn_map_t *
 fd_quic_conn_map_new( void * mem, int lg_slot_cnt );
 
@@ -51,23 +88,37 @@ void
 fd_quic_conn_map_delete( fd_quic_conn_map_t * map );
 
 /* insert a key into map
-   returns NULL if key already in map, or map full */
+   returns NULL if key already in map, or map full
+   on success, the caller is expected to set the seq and conn of the
+   returned entry */
 fd_quic_conn_entry_t *
 fd_quic_conn_map_insert( fd_quic_conn_map_t * map, fd_quic_conn_id_t const * key );
 
-/* removes an entry from a map */
+/* removes an entry from a map
+   entry must be a current entry of map (e.g. returned by query) */
 void
 fd_quic_conn_map_remove( fd_quic_conn_map_t * map, fd_quic_conn_entry_t * entry );
 
-/* query for key in map */
+/* query for key in map
+   returns the entry of key, or NULL if key is not in map */
 fd_quic_conn_entry_t *
-fd_quic_conn_map_query( fd_quic_conn_map_t * map, fd_quic_conn_id_t * key );
+fd_quic_conn_map_query( fd_quic_conn_map_t * map, fd_quic_conn_id_t const * key );
+
+/* prefetch the memory a query for key would touch first
+   used to hide the cache misses of a query for a key that is known
+   some time before it is looked up (e.g. when a packet arrives, before
+   it is processed) */
+void
+fd_quic_conn_map_prefetch( fd_quic_conn_map_t const * map, fd_quic_conn_id_t const * key );
 
 /* max entries in the map */
 ulong
 fd_quic_conn_map_max( fd_quic_conn_map_t * map );
 
+/* number of entries in the map */
+ulong
+fd_quic_conn_map_cnt( fd_quic_conn_map_t * map );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_waltz_quic_fd_quic_conn_map_h */
-
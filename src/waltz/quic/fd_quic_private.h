@@ -6,6 +6,7 @@
 #include "fd_quic_conn_map.h"
 #include "fd_quic_stream.h"
 #include "fd_quic_pkt_meta.h"
+#include "fd_quic_retry.h"
 #include "crypto/fd_quic_crypto_suites.h"
 #include "tls/fd_quic_tls.h"
 
@@ -73,6 +74,7 @@ struct __attribute__((aligned(16UL))) fd_quic_state_private {
 
   /* crypto members */
   fd_quic_crypto_ctx_t   crypto_ctx[1];  /* crypto context */
+  fd_quic_retry_key_t    retry_key[1];   /* retry token key, picked at random on init */
 
   fd_quic_pkt_meta_t *   pkt_meta;       /* records the metadata for the contents
                                             of each sent packet */
@@ -91,6 +93,19 @@ struct __attribute__((aligned(16UL))) fd_quic_state_private {
 /* FD_QUIC_STATE_OFF is the offset of fd_quic_state_t within fd_quic_t. */
 #define FD_QUIC_STATE_OFF (fd_ulong_align_up( sizeof(fd_quic_t), alignof(fd_quic_state_t) ))
 
+/* fd_quic_retry_rx_t holds the retry tokens of the Initial packets of
+   a group of received datagrams, validated together before the
+   datagrams are processed.  pkt[i] points to the first byte of the
+   Initial packet carrying the token of req[i]. */
+
+struct fd_quic_retry_rx {
+  ulong                     cnt;
+  uchar const *             pkt[ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  fd_quic_retry_token_req_t req[ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+};
+
+typedef struct fd_quic_retry_rx fd_quic_retry_rx_t;
+
 struct fd_quic_pkt {
   fd_eth_hdr_t       eth[1];
   fd_ip4_hdr_t       ip4[1];
@@ -105,6 +120,7 @@ struct fd_quic_pkt {
   uint               datagram_sz; /* length of the original datagram */
   uint               ack_flag;    /* ORed together: 0-don't ack  1-ack  2-cancel ack */
   uint ping;
+  fd_quic_retry_rx_t const * retry_rx; /* pre-validated retry tokens or NULL */
 # define ACK_FLAG_NOT_RQD 0
 # define ACK_FLAG_RQD     1
 # define ACK_FLAG_CANCEL  2
@@ -145,6 +161,18 @@ ulong
 fd_quic_get_service_interval( fd_quic_t * quic );
 
 
+/* fd_quic_schedule_conn (re)inserts conn into the service queue at
+   conn->next_service_time (but no earlier than now+1).  If conn is
+   already in the queue, its existing event is replaced.  O(lg conn_cnt).
+
+   fd_quic_unschedule_conn removes conn from the service queue if it is
+   in it (no-op otherwise).  O(lg conn_cnt). */
+void
+fd_quic_schedule_conn( fd_quic_conn_t * conn );
+
+void
+fd_quic_unschedule_conn( fd_quic_conn_t * conn );
+
 /* reschedule a connection */
 void
 fd_quic_reschedule_conn( fd_quic_conn_t * conn,
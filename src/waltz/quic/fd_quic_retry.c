@@ -0,0 +1,136 @@
+#include "fd_quic_retry.h"
+#include "fd_quic.h"
+
+/* fd_quic_retry_private_aad writes the associated data of a token to
+   aad and returns its size */
+
+static ulong
+fd_quic_retry_private_aad( uchar                     aad[ static FD_QUIC_RETRY_TOKEN_AAD_MAX_SZ ],
+                           uchar const *             retry_token,
+                           fd_quic_conn_id_t const * retry_src_conn_id,
+                           uint                      ip_addr,
+                           ushort                    udp_port ) {
+  uchar * p = aad;
+  memcpy( p, retry_token + FD_QUIC_NONCE_SZ, FD_QUIC_RETRY_TOKEN_PREFIX_SZ - FD_QUIC_NONCE_SZ );
+  p += FD_QUIC_RETRY_TOKEN_PREFIX_SZ - FD_QUIC_NONCE_SZ;
+  memcpy( p, &ip_addr,  sizeof( uint   ) ); p += sizeof( uint   );
+  memcpy( p, &udp_port, sizeof( ushort ) ); p += sizeof( ushort );
+  ulong conn_id_sz = fd_ulong_min( retry_src_conn_id->sz, FD_QUIC_MAX_CONN_ID_SZ );
+  *p++ = (uchar)conn_id_sz;
+  memcpy( p, retry_src_conn_id->conn_id, conn_id_sz ); p += conn_id_sz;
+  return (ulong)( p - aad );
+}
+
+fd_quic_retry_key_t *
+fd_quic_retry_key_init( fd_quic_retry_key_t * key,
+                        uchar const           secret[ static FD_QUIC_RETRY_SECRET_SZ ] ) {
+  fd_aes_gcm_init_key( key->gcm, secret, FD_QUIC_RETRY_SECRET_SZ );
+  key->nonce_ctr = 0UL;
+  return key;
+}
+
+int
+fd_quic_retry_token_encrypt( fd_quic_retry_key_t *     key,
+                             fd_quic_conn_id_t const * orig_dst_conn_id,
+                             ulong                     now,
+                             fd_quic_conn_id_t const * retry_src_conn_id,
+                             uint                      ip_addr,
+                             ushort                    udp_port,
+                             uchar                     retry_token[ static FD_QUIC_RETRY_TOKEN_SZ ] ) {
+  if( FD_UNLIKELY( orig_dst_conn_id->sz > FD_QUIC_MAX_CONN_ID_SZ ) ) return FD_QUIC_FAILED;
+
+  /* Nonce is the token counter, unique for the lifetime of the key */
+  uchar * nonce = retry_token;
+  memset( retry_token, 0, FD_QUIC_RETRY_TOKEN_PREFIX_SZ );
+  ulong ctr = key->nonce_ctr++;
+  memcpy( nonce, &ctr, sizeof( ulong ) );
+
+  uchar aad[ FD_QUIC_RETRY_TOKEN_AAD_MAX_SZ ];
+  ulong aad_sz = fd_quic_retry_private_aad( aad, retry_token, retry_src_conn_id, ip_addr, udp_port );
+
+  uchar plaintext[ FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ ] = { 0 };
+  plaintext[ 0 ] = orig_dst_conn_id->sz;
+  memcpy( plaintext + 1, orig_dst_conn_id->conn_id, orig_dst_conn_id->sz );
+  memcpy( plaintext + 1 + orig_dst_conn_id->sz, &now, sizeof( ulong ) );
+
+  /* Append the ciphertext and the authentication tag after the prefix */
+  uchar * ciphertext = retry_token + FD_QUIC_RETRY_TOKEN_PREFIX_SZ;
+  uchar * tag        = ciphertext  + FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ;
+
+  fd_aes_gcm_setiv( key->gcm, nonce );
+  fd_aes_gcm_aead_encrypt( key->gcm, ciphertext, plaintext, FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ, aad, aad_sz, tag );
+
+  return FD_QUIC_SUCCESS;
+}
+
+void
+fd_quic_retry_token_decrypt_batch( fd_quic_retry_key_t *       key,
+                                   fd_quic_retry_token_req_t * req,
+                                   ulong                       req_cnt ) {
+
+  fd_aes_gcm_t * gcm      [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar const *  iv       [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar const *  c        [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar *        p        [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  ulong          sz       [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar const *  aad      [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  ulong          aad_sz   [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar const *  tag      [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  int            ok       [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ];
+  uchar          aad_buf  [ FD_QUIC_RETRY_TOKEN_BATCH_MAX ][ FD_QUIC_RETRY_TOKEN_AAD_MAX_SZ   ];
+  uchar          plaintext[ FD_QUIC_RETRY_TOKEN_BATCH_MAX ][ FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ ];
+
+  while( req_cnt ) {
+    ulong cnt = fd_ulong_min( req_cnt, FD_QUIC_RETRY_TOKEN_BATCH_MAX );
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      uchar const * token = req[i].token;
+      gcm   [i] = key->gcm;
+      iv    [i] = token;
+      c     [i] = token + FD_QUIC_RETRY_TOKEN_PREFIX_SZ;
+      p     [i] = plaintext[i];
+      sz    [i] = FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ;
+      aad   [i] = aad_buf[i];
+      aad_sz[i] = fd_quic_retry_private_aad( aad_buf[i], token, &req[i].retry_src_conn_id, req[i].ip_addr, req[i].udp_port );
+      tag   [i] = c[i] + FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ;
+    }
+
+    fd_aes_gcm_aead_decrypt_batch( gcm, iv, c, p, sz, aad, aad_sz, tag, cnt, ok );
+
+    for( ulong i=0UL; i<cnt; i++ ) {
+      uchar orig_dst_conn_id_sz = plaintext[i][0]; /* untrusted input */
+      if( FD_UNLIKELY( ( !ok[i] ) | ( orig_dst_conn_id_sz > FD_QUIC_MAX_CONN_ID_SZ ) ) ) {
+        req[i].rc = FD_QUIC_FAILED;
+        continue;
+      }
+      req[i].rc                  = FD_QUIC_SUCCESS;
+      req[i].orig_dst_conn_id.sz = orig_dst_conn_id_sz;
+      memcpy( req[i].orig_dst_conn_id.conn_id, plaintext[i] + 1, orig_dst_conn_id_sz );
+      memcpy( &req[i].issued, plaintext[i] + 1 + orig_dst_conn_id_sz, sizeof( ulong ) );
+    }
+
+    req     += cnt;
+    req_cnt -= cnt;
+  }
+}
+
+int
+fd_quic_retry_token_decrypt( fd_quic_retry_key_t *     key,
+                             uchar const               retry_token[ static FD_QUIC_RETRY_TOKEN_SZ ],
+                             fd_quic_conn_id_t const * retry_src_conn_id,
+                             uint                      ip_addr,
+                             ushort                    udp_port,
+                             fd_quic_conn_id_t *       orig_dst_conn_id,
+                             ulong *                   now ) {
+  fd_quic_retry_token_req_t req = {
+    .token             = retry_token,
+    .retry_src_conn_id = *retry_src_conn_id,
+    .ip_addr           = ip_addr,
+    .udp_port          = udp_port
+  };
+  fd_quic_retry_token_decrypt_batch( key, &req, 1UL );
+  if( FD_UNLIKELY( req.rc!=FD_QUIC_SUCCESS ) ) return FD_QUIC_FAILED;
+  *orig_dst_conn_id = req.orig_dst_conn_id;
+  *now              = req.issued;
+  return FD_QUIC_SUCCESS;
+}
@@ -0,0 +1,143 @@
+#ifndef HEADER_fd_src_waltz_quic_fd_quic_retry_h
+#define HEADER_fd_src_waltz_quic_fd_quic_retry_h
+
+/* fd_quic_retry creates and validates the tokens of QUIC Retry packets
+   (stateless address validation, RFC 9000, Section 8.1.2).  The RFC
+   does not specify how to generate a token, only that it is "an opaque
+   token that the server can use to validate the client's address".
+
+   A token is generated as follows:
+
+     1. The plaintext is the client's original destination connection
+        id and the time the token was issued.
+
+     2. The plaintext is encrypted with AES-256-GCM under a secret key
+        picked at random when the fd_quic_t is initialized.  The
+        associated data is the rest of the token prefix, the client's
+        IPv4 address and UDP port and the server's retry source
+        connection id.  The nonce is a per key counter, so every token
+        has a unique nonce.
+
+     3. The token is a 32 byte prefix (the 12 byte nonce followed by 20
+        zero bytes), the ciphertext and the authentication tag, in that
+        order.
+
+   The AES key schedule and GHASH table are computed once per key rather
+   than once per token, so creating or validating a token costs only the
+   encryption of a few blocks.  Tokens are usually validated in bursts
+   with fd_quic_retry_token_decrypt_batch, which interleaves the AES-GCM
+   computations of the tokens (see fd_aes_gcm_aead_decrypt_batch).
+   During a connection flood, most of the Initial packets a server
+   receives are either retried or carry a forged token, so this is what
+   decides how many handshake attempts it can turn away.
+
+   Tokens are only valid for the fd_quic_t that issued them (the key is
+   not persisted).  This is _not_ the Retry Integrity Tag scheme
+   specified in RFC 9001, Section 5.8 (see
+   fd_quic_retry_integrity_tag_encrypt). */
+
+#include "crypto/fd_quic_crypto_suites.h"
+
+/* retry token plaintext: 1 + orig dst conn id (padded to 20 bytes) + issue time (ulong) */
+#define FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ (1 + FD_QUIC_MAX_CONN_ID_SZ + sizeof(ulong))
+/* ciphertext length should equal plaintext in chosen AEAD scheme */
+#define FD_QUIC_RETRY_TOKEN_CIPHERTEXT_SZ FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ
+/* retry token prefix: nonce + zero padding */
+#define FD_QUIC_RETRY_TOKEN_PREFIX_SZ 32
+/* retry token authenticated associated data (AAD): token prefix after the nonce + ipv4 + port + retry src conn id length */
+#define FD_QUIC_RETRY_TOKEN_AAD_PREFIX_SZ (FD_QUIC_RETRY_TOKEN_PREFIX_SZ - FD_QUIC_NONCE_SZ + 4 + 2 + 1)
+/* max AAD size (retry src conn id of max size) */
+#define FD_QUIC_RETRY_TOKEN_AAD_MAX_SZ (FD_QUIC_RETRY_TOKEN_AAD_PREFIX_SZ + FD_QUIC_MAX_CONN_ID_SZ)
+/* retry token = prefix + encrypted ciphertext + appended authentication tag */
+#define FD_QUIC_RETRY_TOKEN_SZ (FD_QUIC_RETRY_TOKEN_PREFIX_SZ + FD_QUIC_RETRY_TOKEN_PLAINTEXT_SZ + FD_QUIC_CRYPTO_TAG_SZ)
+/* size of the secret a key is derived from (AES-256) */
+#define FD_QUIC_RETRY_SECRET_SZ 32
+/* Retry token lifetime is 15 seconds */
+#define FD_QUIC_RETRY_TOKEN_LIFETIME (ulong)(15 * 1e9L)
+
+/* FD_QUIC_RETRY_TOKEN_BATCH_MAX is the max number of tokens validated
+   together by fd_quic_retry_token_decrypt_batch (larger batches are
+   processed this many tokens at a time) */
+#define FD_QUIC_RETRY_TOKEN_BATCH_MAX (16UL)
+
+/* fd_quic_retry_key_t holds the expanded key tokens are encrypted
+   with, and the nonce counter */
+
+struct fd_quic_retry_key {
+  fd_aes_gcm_t gcm[1];     /* initialized with fd_aes_gcm_init_key */
+  ulong        nonce_ctr;  /* nonce of the next token */
+};
+typedef struct fd_quic_retry_key fd_quic_retry_key_t;
+
+/* fd_quic_retry_token_req_t is a token to validate with
+   fd_quic_retry_token_decrypt_batch, and the result */
+
+struct fd_quic_retry_token_req {
+  /* in */
+  uchar const *     token;             /* FD_QUIC_RETRY_TOKEN_SZ bytes */
+  fd_quic_conn_id_t retry_src_conn_id; /* dst conn id of the packet carrying the token */
+  uint              ip_addr;           /* src ipv4 address of the packet */
+  ushort            udp_port;          /* src udp port of the packet */
+
+  /* out */
+  int               rc;                /* FD_QUIC_SUCCESS or FD_QUIC_FAILED */
+  fd_quic_conn_id_t orig_dst_conn_id;  /* valid if rc==FD_QUIC_SUCCESS */
+  ulong             issued;            /* valid if rc==FD_QUIC_SUCCESS */
+};
+typedef struct fd_quic_retry_token_req fd_quic_retry_token_req_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_quic_retry_key_init initializes key from FD_QUIC_RETRY_SECRET_SZ
+   bytes of secret, which must be cryptographically random.  Returns
+   key. */
+
+fd_quic_retry_key_t *
+fd_quic_retry_key_init( fd_quic_retry_key_t * key,
+                        uchar const           secret[ static FD_QUIC_RETRY_SECRET_SZ ] );
+
+/* fd_quic_retry_token_encrypt creates the token of a Retry packet sent
+   at time now in reply to an Initial packet with destination connection
+   id orig_dst_conn_id, from ip_addr:udp_port.  retry_src_conn_id is the
+   source connection id of the Retry packet.  The token is written to
+   retry_token.  Returns FD_QUIC_SUCCESS, or FD_QUIC_FAILED if
+   orig_dst_conn_id is invalid. */
+
+int
+fd_quic_retry_token_encrypt( fd_quic_retry_key_t *     key,
+                             fd_quic_conn_id_t const * orig_dst_conn_id,
+                             ulong                     now,
+                             fd_quic_conn_id_t const * retry_src_conn_id,
+                             uint                      ip_addr,
+                             ushort                    udp_port,
+                             uchar                     retry_token[ static FD_QUIC_RETRY_TOKEN_SZ ] );
+
+/* fd_quic_retry_token_decrypt checks that retry_token was created by
+   fd_quic_retry_token_encrypt with key for retry_src_conn_id,
+   ip_addr and udp_port.  On success, returns FD_QUIC_SUCCESS and
+   writes the original destination conn id and the time the token was
+   issued to orig_dst_conn_id and now.  Otherwise, returns
+   FD_QUIC_FAILED.  The token lifetime is checked by the caller. */
+
+int
+fd_quic_retry_token_decrypt( fd_quic_retry_key_t *     key,
+                             uchar const               retry_token[ static FD_QUIC_RETRY_TOKEN_SZ ],
+                             fd_quic_conn_id_t const * retry_src_conn_id,
+                             uint                      ip_addr,
+                             ushort                    udp_port,
+                             fd_quic_conn_id_t *       orig_dst_conn_id,
+                             ulong *                   now );
+
+/* fd_quic_retry_token_decrypt_batch does fd_quic_retry_token_decrypt
+   for the req_cnt tokens in req, setting the output fields of each
+   req.  Equivalent to but much faster than decrypting the tokens one
+   at a time. */
+
+void
+fd_quic_retry_token_decrypt_batch( fd_quic_retry_key_t *       key,
+                                   fd_quic_retry_token_req_t * req,
+                                   ulong                       req_cnt );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_waltz_quic_fd_quic_retry_h */
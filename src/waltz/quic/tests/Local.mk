@@ -8,11 +8,15 @@ $(call make-unit-test,test_quic_conn,   test_quic_conn,   fd_quic fd_tls fd_aio
 $(call make-unit-test,test_quic_drops,  test_quic_drops,  fd_quic fd_tls fd_aio fd_ballet fd_waltz fd_util fd_fibre)
 $(call make-unit-test,test_quic_bw,     test_quic_bw,     fd_quic fd_tls fd_aio fd_ballet fd_waltz fd_util)
 $(call make-unit-test,test_quic_layout, test_quic_layout,                                          fd_util)
+$(call make-unit-test,test_quic_service,test_quic_service,fd_quic fd_tls fd_aio fd_ballet fd_waltz fd_util)
+$(call make-unit-test,test_quic_conn_map,test_quic_conn_map,fd_quic                             fd_util)
 # $(call run-unit-test,test_quic_hs)
 $(call run-unit-test,test_quic_streams)
 #$(call run-unit-test,test_quic_conn) -- broken because of fd_ip
 #$(call run-unit-test,test_quic_bw) -- broken because of fd_ip
 $(call run-unit-test,test_quic_layout)
+$(call run-unit-test,test_quic_service)
+$(call run-unit-test,test_quic_conn_map)
 
 # fd_quic_tls unit tests
 $(call make-unit-test,test_quic_tls_hs,test_quic_tls_hs,fd_aio fd_tls fd_ballet fd_quic fd_util)
@@ -0,0 +1,170 @@
+#include "../fd_quic_conn_map.h"
+#include "../../../util/fd_util.h"
+
+#define LG_SLOT_MAX (16)
+#define KEY_MAX     (1UL<<LG_SLOT_MAX)
+#define BURST_MAX   (32UL)
+
+static uchar __attribute__((aligned(64UL))) map_mem[ 4UL<<20 ];
+
+static fd_quic_conn_id_t keys[ KEY_MAX ];
+static int               in_map[ KEY_MAX ];
+
+/* key_init makes a unique key from i, mostly 8 byte conn ids like the
+   ones fd_quic hands out, sometimes of other lengths */
+
+static void
+key_init( fd_quic_conn_id_t * key,
+          fd_rng_t *          rng,
+          ulong               i ) {
+  memset( key, 0, sizeof(fd_quic_conn_id_t) );
+  uint r = fd_rng_uint( rng );
+  key->sz = (uchar)( (r&7U) ? FD_QUIC_CONN_ID_SZ : 8U+(r>>29) );
+  memcpy( key->conn_id, &i, 8UL );
+  for( ulong j=8UL; j<key->sz; j++ ) key->conn_id[ j ] = fd_rng_uchar( rng );
+}
+
+/* check_map verifies that every key in keys[0,key_cnt) is found in the
+   map if and only if it was inserted */
+
+static void
+check_map( fd_quic_conn_map_t * map,
+           ulong                key_cnt ) {
+  ulong cnt = 0UL;
+  for( ulong i=0UL; i<key_cnt; i++ ) {
+    fd_quic_conn_entry_t * entry = fd_quic_conn_map_query( map, keys+i );
+    if( in_map[ i ] ) {
+      FD_TEST( entry );
+      FD_TEST( FD_QUIC_CONN_ID_EQUAL( entry->key, keys[ i ] ) );
+      FD_TEST( entry->conn==(fd_quic_conn_t *)(i+1UL) );
+      cnt++;
+    } else {
+      FD_TEST( !entry );
+    }
+  }
+  FD_TEST( fd_quic_conn_map_cnt( map )==cnt );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  int   lg_slot_cnt = fd_env_strip_cmdline_int  ( &argc, &argv, "--lg-slot-cnt", NULL, 12     );
+  ulong iter_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt",    NULL, 1UL<<20 );
+
+  if( FD_UNLIKELY( lg_slot_cnt>LG_SLOT_MAX ) ) FD_LOG_ERR(( "Increase unit test LG_SLOT_MAX to support this large --lg-slot-cnt" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Test procurement */
+
+  FD_TEST( fd_quic_conn_map_footprint( -1 )==0UL );
+  FD_TEST( fd_quic_conn_map_footprint( 32 )==0UL );
+  FD_TEST( fd_quic_conn_map_footprint( 0  )==fd_quic_conn_map_footprint( 4 ) ); /* at least a group of slots */
+  FD_TEST( fd_quic_conn_map_footprint( LG_SLOT_MAX )<=sizeof(map_mem) );
+
+  FD_TEST( !fd_quic_conn_map_new( NULL,        lg_slot_cnt ) );
+  FD_TEST( !fd_quic_conn_map_new( map_mem+1UL, lg_slot_cnt ) );
+
+  /* Tiny map: fills up, keys wrap around the end of the slots */
+
+  fd_quic_conn_map_t * map = fd_quic_conn_map_new( map_mem, 2 );
+  FD_TEST( map );
+  ulong key_max = fd_quic_conn_map_max( map );
+  FD_TEST( key_max==FD_QUIC_CONN_MAP_GROUP_SZ-1UL );
+
+  for( ulong i=0UL; i<KEY_MAX; i++ ) key_init( keys+i, rng, i );
+
+  for( ulong i=0UL; i<key_max; i++ ) {
+    fd_quic_conn_entry_t * entry = fd_quic_conn_map_insert( map, keys+i );
+    FD_TEST( entry );
+    entry->conn = (fd_quic_conn_t *)(i+1UL);
+    in_map[ i ] = 1;
+  }
+  FD_TEST( !fd_quic_conn_map_insert( map, keys+key_max ) ); /* full */
+  FD_TEST( !fd_quic_conn_map_insert( map, keys         ) ); /* full */
+  check_map( map, key_max+1UL );
+
+  for( ulong i=0UL; i<key_max; i+=2UL ) {
+    fd_quic_conn_map_remove( map, fd_quic_conn_map_query( map, keys+i ) );
+    in_map[ i ] = 0;
+  }
+  FD_TEST( !fd_quic_conn_map_insert( map, keys+1UL ) ); /* already in map */
+  check_map( map, key_max+1UL );
+  fd_quic_conn_map_delete( map );
+
+  /* Random inserts and removes against a shadow set, the map kept about
+     half full like fd_quic does with the default sparsity */
+
+  memset( in_map, 0, sizeof(in_map) );
+  map = fd_quic_conn_map_new( map_mem, lg_slot_cnt );
+  FD_TEST( map );
+  ulong key_cnt = fd_ulong_min( 1UL<<lg_slot_cnt, KEY_MAX );
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    ulong i = fd_rng_ulong_roll( rng, key_cnt );
+    if( in_map[ i ] ) {
+      fd_quic_conn_entry_t * entry = fd_quic_conn_map_query( map, keys+i );
+      FD_TEST( entry && entry->conn==(fd_quic_conn_t *)(i+1UL) );
+      fd_quic_conn_map_remove( map, entry );
+      in_map[ i ] = 0;
+    } else {
+      FD_TEST( !fd_quic_conn_map_query( map, keys+i ) );
+      fd_quic_conn_entry_t * entry = fd_quic_conn_map_insert( map, keys+i );
+      FD_TEST( entry );
+      entry->conn = (fd_quic_conn_t *)(i+1UL);
+      in_map[ i ] = 1;
+    }
+    if( !(iter & 0xffffUL) ) check_map( map, key_cnt );
+  }
+  check_map( map, key_cnt );
+
+  /* Benchmark hits and misses, one at a time and in bursts prefetched
+     before they are queried (like fd_quic_aio_cb_receive does with
+     fd_quic_prefetch_rx) */
+
+  ulong hit[ 1024 ];
+  ulong hit_cnt = 0UL;
+  for( ulong i=0UL; i<key_cnt && hit_cnt<1024UL; i++ ) if( in_map[ i ] ) hit[ hit_cnt++ ] = i;
+  FD_TEST( hit_cnt );
+
+  static fd_quic_conn_id_t burst[ BURST_MAX ];
+  for( ulong i=0UL; i<BURST_MAX; i++ ) burst[ i ] = keys[ hit[ i % hit_cnt ] ];
+
+  ulong found = 0UL;
+  long dt_hit = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) found += (ulong)!!fd_quic_conn_map_query( map, keys+hit[ iter % hit_cnt ] );
+  dt_hit += fd_log_wallclock();
+  FD_TEST( found==iter_cnt );
+
+  fd_quic_conn_id_t miss; key_init( &miss, rng, KEY_MAX );
+  long dt_miss = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    miss.conn_id[ 0 ] = (uchar)iter; miss.conn_id[ 1 ] = (uchar)(iter>>8);
+    found += (ulong)!!fd_quic_conn_map_query( map, &miss );
+  }
+  dt_miss += fd_log_wallclock();
+  FD_TEST( found==iter_cnt );
+
+  ulong burst_iter_cnt = iter_cnt / BURST_MAX;
+  long dt_burst = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<burst_iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<BURST_MAX; i++ ) fd_quic_conn_map_prefetch( map, burst+i );
+    for( ulong i=0UL; i<BURST_MAX; i++ ) found += (ulong)!!fd_quic_conn_map_query( map, burst+i );
+  }
+  dt_burst += fd_log_wallclock();
+  FD_TEST( found==iter_cnt+burst_iter_cnt*BURST_MAX );
+
+  FD_LOG_NOTICE(( "lg_slot_cnt %d, %lu keys: query hit %.1f ns, query miss %.1f ns, prefetched burst query %.1f ns/key",
+                  lg_slot_cnt, fd_quic_conn_map_cnt( map ),
+                  (double)dt_hit  /(double)iter_cnt,
+                  (double)dt_miss /(double)iter_cnt,
+                  (double)dt_burst/(double)(burst_iter_cnt*BURST_MAX) ));
+
+  fd_quic_conn_map_delete( map );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
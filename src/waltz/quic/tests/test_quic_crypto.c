@@ -284,6 +284,47 @@ main( int     argc,
 
   FD_LOG_NOTICE(( "decrypted packet matches original packet" ));
 
+  /* Batched decryption, with the same keys used by multiple requests
+     and one corrupt packet */
+
+# define BATCH_CNT (3UL)
+  static uchar batch_cipher[ BATCH_CNT ][ 4096 ];
+  static uchar batch_revert[ BATCH_CNT ][ 4096 ];
+  fd_quic_crypto_decrypt_req_t req[ BATCH_CNT ];
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) {
+    fd_memcpy( batch_cipher[i], cipher_text, cipher_text_sz );
+    FD_TEST( fd_quic_crypto_decrypt_hdr( batch_revert[i], sizeof(batch_revert[i]),
+                                         batch_cipher[i], cipher_text_sz,
+                                         pn_offset, suite, &client_keys )==FD_QUIC_SUCCESS );
+    req[i] = (fd_quic_crypto_decrypt_req_t) {
+      .out            = batch_revert[i],
+      .out_sz         = sizeof(batch_revert[i]),
+      .in             = batch_cipher[i],
+      .in_sz          = cipher_text_sz,
+      .pkt_number_off = pn_offset,
+      .pkt_number     = pkt_number,
+      .keys           = &client_keys,
+      .rc             = -1
+    };
+  }
+  batch_cipher[1][ cipher_text_sz-20UL ] ^= 0x01;
+
+  fd_quic_crypto_decrypt_batch( req, BATCH_CNT );
+
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) {
+    if( i==1UL ) {
+      FD_TEST( req[i].rc==FD_QUIC_FAILED );
+      continue;
+    }
+    FD_TEST( req[i].rc==FD_QUIC_SUCCESS );
+    FD_TEST( req[i].out_sz==hdr_sz + test_client_initial_sz );
+    FD_TEST( 0==memcmp( batch_revert[i], hdr, hdr_sz ) );
+    FD_TEST( 0==memcmp( batch_revert[i] + hdr_sz, test_client_initial, test_client_initial_sz ) );
+  }
+# undef BATCH_CNT
+
+  FD_LOG_NOTICE(( "batch decrypted packets match original packet" ));
+
   fd_quic_crypto_ctx_fini( &crypto_ctx );
 
   FD_LOG_NOTICE(( "pass" ));
@@ -1,5 +1,6 @@
 #include "../crypto/fd_quic_crypto_suites.h"
 #include "../fd_quic.h"
+#include "../fd_quic_retry.h"
 
 #include "../fd_quic_common.h"
 #include "../fd_quic_types.h"
@@ -11,6 +12,8 @@
 
 #include "../../../util/net/fd_ip4.h"
 
+static fd_quic_retry_key_t key[1];
+
 void
 test_retry_token_encrypt_decrypt( void ) {
 #define NUM_TEST_CASES 3
@@ -46,20 +49,21 @@ test_retry_token_encrypt_decrypt( void ) {
     fd_quic_conn_id_t retry_src_conn_id = retry_src_conn_ids[i];
 
     fd_quic_retry_token_encrypt(
-        &orig_dst_conn_id, now, &retry_src_conn_id, client.ip_addr, client.udp_port, retry_token
+        key, &orig_dst_conn_id, now, &retry_src_conn_id, client.ip_addr, client.udp_port, retry_token
     );
 
     fd_quic_conn_id_t orig_dst_conn_id_decrypt;
     ulong             now_decrypt;
 
-    fd_quic_retry_token_decrypt(
+    FD_TEST( fd_quic_retry_token_decrypt(
+        key,
         retry_token,
         &retry_src_conn_id,
         client.ip_addr,
         client.udp_port,
         &orig_dst_conn_id_decrypt,
         &now_decrypt
-    );
+    )==FD_QUIC_SUCCESS );
 
     FD_TEST( orig_dst_conn_id.sz == orig_dst_conn_id_decrypt.sz );
     for ( int j = 0; j < orig_dst_conn_id.sz; j++ ) {
@@ -128,17 +132,17 @@ test_retry_integrity_tag( void ) {
   FD_TEST( rc == FD_QUIC_SUCCESS );
 }
 
+/* Token length is checked by the caller (fd_quic_handle_v1_initial),
+   a forged token of the right length must not validate */
 void
-test_retry_token_invalid_length( void ) {
-  uchar invalid_length_retry_token[42] = {0};
-  uchar *invalid_length_retry_token_ptr = invalid_length_retry_token;
+test_retry_token_forged( void ) {
+  uchar forged_retry_token[FD_QUIC_RETRY_TOKEN_SZ] = {0};
   fd_quic_conn_id_t retry_src_conn_id = { .sz = 8, .conn_id = "\x42\x41\x40\x3F\x3E\x3D\x3C\x3B" };
-  fd_quic_conn_id_t orig_dst_conn_id = { .sz = 20,
-       .conn_id =
-            "\x83\x94\xc8\xf0\x3e\x51\x57\x08\x83\x94\xc8\xf0\x3e\x51\x57\x08\x00\x00\x00\x00" };
+  fd_quic_conn_id_t orig_dst_conn_id;
   ulong now;
   int rc = fd_quic_retry_token_decrypt(
-    invalid_length_retry_token_ptr,
+    key,
+    forged_retry_token,
     &retry_src_conn_id,
     FD_IP4_ADDR(127, 0, 0, 1),
     9000,
@@ -148,6 +152,84 @@ test_retry_token_invalid_length( void ) {
   FD_TEST ( rc == FD_QUIC_FAILED );
 }
 
+/* A burst of tokens, some tampered with or presented from the wrong
+   address, validates the same in a batch as one at a time */
+void
+test_retry_token_decrypt_batch( fd_rng_t * rng ) {
+#define BATCH_CNT 37UL
+  static uchar                     tokens[ BATCH_CNT ][ FD_QUIC_RETRY_TOKEN_SZ ];
+  static fd_quic_conn_id_t         odcid [ BATCH_CNT ];
+  static fd_quic_retry_token_req_t req   [ BATCH_CNT ];
+  static int                       valid [ BATCH_CNT ];
+
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) {
+    odcid[i].sz = (uchar)fd_rng_uint_roll( rng, FD_QUIC_MAX_CONN_ID_SZ+1U );
+    for( ulong j=0UL; j<odcid[i].sz; j++ ) odcid[i].conn_id[j] = fd_rng_uchar( rng );
+
+    fd_quic_conn_id_t rscid = { .sz = 8 };
+    for( ulong j=0UL; j<8UL; j++ ) rscid.conn_id[j] = fd_rng_uchar( rng );
+    uint   ip_addr  = fd_rng_uint( rng );
+    ushort udp_port = fd_rng_ushort( rng );
+    FD_TEST( fd_quic_retry_token_encrypt( key, &odcid[i], 1000UL+i, &rscid, ip_addr, udp_port, tokens[i] )==FD_QUIC_SUCCESS );
+
+    req[i] = (fd_quic_retry_token_req_t) {
+      .token             = tokens[i],
+      .retry_src_conn_id = rscid,
+      .ip_addr           = ip_addr,
+      .udp_port          = udp_port
+    };
+    valid[i] = 1;
+    switch( fd_rng_uint_roll( rng, 6U ) ) {
+    case 0U: tokens[i][ fd_rng_ulong_roll( rng, FD_QUIC_RETRY_TOKEN_SZ ) ] ^= (uchar)( 1U<<fd_rng_uint_roll( rng, 8U ) ); valid[i] = 0; break;
+    case 1U: req[i].ip_addr++;                  valid[i] = 0; break;
+    case 2U: req[i].udp_port++;                 valid[i] = 0; break;
+    case 3U: req[i].retry_src_conn_id.sz = 7;   valid[i] = 0; break;
+    default: break;
+    }
+  }
+
+  fd_quic_retry_token_decrypt_batch( key, req, BATCH_CNT );
+
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) {
+    fd_quic_conn_id_t odcid_decrypt;
+    ulong             issued;
+    int rc = fd_quic_retry_token_decrypt( key, tokens[i], &req[i].retry_src_conn_id, req[i].ip_addr, req[i].udp_port, &odcid_decrypt, &issued );
+    FD_TEST( rc==req[i].rc );
+    FD_TEST( rc==( valid[i] ? FD_QUIC_SUCCESS : FD_QUIC_FAILED ) );
+    if( rc!=FD_QUIC_SUCCESS ) continue;
+    FD_TEST( issued==1000UL+i && req[i].issued==issued );
+    FD_TEST( odcid_decrypt.sz==odcid[i].sz && req[i].orig_dst_conn_id.sz==odcid[i].sz );
+    FD_TEST( !memcmp( odcid_decrypt.conn_id,            odcid[i].conn_id, odcid[i].sz ) );
+    FD_TEST( !memcmp( req[i].orig_dst_conn_id.conn_id, odcid[i].conn_id, odcid[i].sz ) );
+  }
+
+  /* Tokens of another key are rejected */
+
+  fd_quic_retry_key_t other[1];
+  uchar secret[ FD_QUIC_RETRY_SECRET_SZ ];
+  for( ulong j=0UL; j<FD_QUIC_RETRY_SECRET_SZ; j++ ) secret[j] = fd_rng_uchar( rng );
+  fd_quic_retry_key_init( other, secret );
+  fd_quic_retry_token_decrypt_batch( other, req, BATCH_CNT );
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) FD_TEST( req[i].rc==FD_QUIC_FAILED );
+
+  /* Benchmark validating a burst of tokens one at a time vs together */
+
+  for( ulong i=0UL; i<BATCH_CNT; i++ ) req[i].token = tokens[0];
+  ulong iter_cnt = 1UL<<14;
+  long dt_single = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    for( ulong i=0UL; i<FD_QUIC_RETRY_TOKEN_BATCH_MAX; i++ ) fd_quic_retry_token_decrypt_batch( key, req+i, 1UL );
+  }
+  dt_single += fd_log_wallclock();
+  long dt_batch = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) fd_quic_retry_token_decrypt_batch( key, req, FD_QUIC_RETRY_TOKEN_BATCH_MAX );
+  dt_batch += fd_log_wallclock();
+  FD_LOG_NOTICE(( "retry token validation: %.1f ns/token one at a time, %.1f ns/token batched",
+                  (double)dt_single/(double)(iter_cnt*FD_QUIC_RETRY_TOKEN_BATCH_MAX),
+                  (double)dt_batch /(double)(iter_cnt*FD_QUIC_RETRY_TOKEN_BATCH_MAX) ));
+#undef BATCH_CNT
+}
+
 /* Invariant: a valid token should always decrypt to the original inputs. */
 void
 test_property_retry_token_encrypt_decrypt( void ) {
@@ -171,9 +253,18 @@ main( int     argc,
       char ** argv ) {
   fd_boot( &argc, &argv );
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  uchar secret[ FD_QUIC_RETRY_SECRET_SZ ];
+  for( ulong j=0UL; j<FD_QUIC_RETRY_SECRET_SZ; j++ ) secret[j] = fd_rng_uchar( rng );
+  FD_TEST( fd_quic_retry_key_init( key, secret )==key );
+
   test_retry_token_encrypt_decrypt();
+  test_retry_token_decrypt_batch( rng );
   test_retry_integrity_tag();
-  // test_retry_token_invalid_length();  // FIXME after error change
+  test_retry_token_forged();
+
+  fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE( ( "pass" ) );
   fd_halt();
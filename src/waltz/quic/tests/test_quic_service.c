@@ -0,0 +1,231 @@
+#include "../fd_quic.h"
+#include "../fd_quic_private.h"
+#include "fd_quic_test_helpers.h"
+
+/* Same declaration as fd_quic.c, used to inspect the service queue */
+
+#define PRQ_NAME        service_queue
+#define PRQ_T           fd_quic_event_t
+#define PRQ_TIMEOUT_T   ulong
+#define PRQ_TMP_ST(p,t) do {                                           \
+                          (p)[0] = (t);                                \
+                          t.conn->service_queue_idx = (ulong)((p)-heap); \
+                        } while( 0 )
+#include "../../../util/tmpl/fd_prq.c"
+
+#define CONN_MAX (1UL<<14)
+
+static fd_quic_conn_t * conns[ CONN_MAX ];
+
+/* global "clock" */
+static ulong now = 123UL;
+
+static ulong
+test_clock( void * ctx ) {
+  (void)ctx;
+  return now;
+}
+
+/* Nothing is transmitted by this test */
+
+static int
+test_aio_send_func( void *                    ctx,
+                    fd_aio_pkt_info_t const * batch,
+                    ulong                     batch_cnt,
+                    ulong *                   opt_batch_idx,
+                    int                       flush ) {
+  (void)ctx; (void)batch; (void)batch_cnt; (void)opt_batch_idx; (void)flush;
+  return FD_AIO_SUCCESS;
+}
+
+/* check_queue verifies that the service queue is a valid heap, that
+   every event in it is the event of the conn it points to, and that it
+   holds exactly the conns in conns[0,cnt) that are in service. */
+
+static void
+check_queue( fd_quic_t * quic,
+             ulong       cnt ) {
+  fd_quic_event_t * heap = fd_quic_get_state( quic )->service_queue;
+  ulong q_cnt = service_queue_cnt( heap );
+
+  ulong in_service_cnt = 0UL;
+  for( ulong i=0UL; i<cnt; i++ ) in_service_cnt += (ulong)!!conns[ i ]->in_service;
+  FD_TEST( q_cnt==in_service_cnt );
+
+  for( ulong i=0UL; i<q_cnt; i++ ) {
+    fd_quic_conn_t * conn = heap[ i ].conn;
+    FD_TEST( conn->in_service );
+    FD_TEST( conn->service_queue_idx==i );
+    FD_TEST( conn->sched_service_time==heap[ i ].timeout );
+    if( i ) FD_TEST( heap[ (i-1UL)>>1 ].timeout<=heap[ i ].timeout );
+  }
+}
+
+static void
+test_service( fd_wksp_t * wksp,
+              fd_rng_t *  rng,
+              ulong       conn_cnt,
+              ulong       iter_cnt ) {
+
+  fd_quic_limits_t const quic_limits = {
+    .conn_cnt         = conn_cnt,
+    .conn_id_cnt      = 4,
+    .conn_id_sparsity = 4.0,
+    .handshake_cnt    = 1,
+    .stream_cnt       = {0, 0, 1, 0},
+    .inflight_pkt_cnt = 4,
+    .tx_buf_sz        = 1<<8
+  };
+
+  fd_quic_t * quic = fd_quic_new_anonymous( wksp, &quic_limits, FD_QUIC_ROLE_SERVER, rng );
+  FD_TEST( quic );
+  quic->cb.now = test_clock;
+
+  fd_aio_t _aio[1];
+  fd_aio_t * aio = fd_aio_join( fd_aio_new( _aio, NULL, test_aio_send_func ) );
+  FD_TEST( aio );
+  fd_quic_set_aio_net_tx( quic, aio );
+  FD_TEST( fd_quic_init( quic ) );
+
+  fd_quic_event_t * heap = fd_quic_get_state( quic )->service_queue;
+
+  /* Create conn_cnt conns, each is scheduled immediately */
+
+  for( ulong i=0UL; i<conn_cnt; i++ ) {
+    fd_quic_conn_id_t our_conn_id  = { 8u, {0}, {0} };
+    fd_quic_conn_id_t peer_conn_id = { 8u, {0}, {0} };
+    ulong id = i+1UL;
+    memcpy( our_conn_id.conn_id,  &id, 8UL );
+    memcpy( peer_conn_id.conn_id, &id, 8UL );
+    conns[ i ] = fd_quic_conn_create( quic, &our_conn_id, &peer_conn_id, 0U, (ushort)0, 1, 1U );
+    FD_TEST( conns[ i ] );
+  }
+  check_queue( quic, conn_cnt );
+  FD_TEST( service_queue_cnt( heap )==conn_cnt );
+
+  /* Randomly schedule, reschedule sooner and unschedule */
+
+  ulong interval = fd_quic_get_service_interval( quic );
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_quic_conn_t * conn = conns[ fd_rng_ulong_roll( rng, conn_cnt ) ];
+    uint r = fd_rng_uint( rng );
+    switch( r & 3U ) {
+    case 0U: case 1U:
+      conn->next_service_time = now + 1UL + (ulong)(r>>2) % interval;
+      fd_quic_schedule_conn( conn );
+      FD_TEST( conn->in_service );
+      break;
+    case 2U: {
+      ulong sched  = conn->sched_service_time;
+      int   before = conn->in_service;
+      fd_quic_reschedule_conn( conn, now + 1UL + (ulong)(r>>2) % interval );
+      if( before ) FD_TEST( conn->in_service && conn->sched_service_time<=sched );
+      break;
+    }
+    default:
+      fd_quic_unschedule_conn( conn );
+      FD_TEST( !conn->in_service );
+      break;
+    }
+    if( !(iter & 1023UL) ) check_queue( quic, conn_cnt );
+    now += (ulong)(r & 1U);
+  }
+  check_queue( quic, conn_cnt );
+
+  /* Freeing conns removes them from the queue */
+
+  for( ulong i=0UL; i<conn_cnt; i+=2UL ) {
+    fd_quic_conn_free( quic, conns[ i ] );
+    FD_TEST( !conns[ i ]->in_service );
+  }
+  check_queue( quic, conn_cnt );
+
+  /* Benchmark rescheduling sooner (decrease key) and later (remove and
+     reinsert), the common operations when processing packets and
+     running fd_quic_service respectively */
+
+  for( ulong i=0UL; i<conn_cnt; i++ ) {
+    if( conns[ i ]->state==FD_QUIC_CONN_STATE_INVALID ) continue;
+    conns[ i ]->next_service_time = now + interval;
+    fd_quic_schedule_conn( conns[ i ] );
+  }
+  ulong live_cnt = service_queue_cnt( heap );
+
+  long dt_sched = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_quic_conn_t * conn = heap[ (iter * 0x9e3779b97f4a7c15UL) % live_cnt ].conn;
+    conn->next_service_time = now + 1UL + (iter & 1023UL);
+    fd_quic_schedule_conn( conn );
+  }
+  dt_sched += fd_log_wallclock();
+
+  long dt_resched = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_quic_conn_t * conn = heap[ (iter * 0x9e3779b97f4a7c15UL) % live_cnt ].conn;
+    fd_quic_reschedule_conn( conn, now + 1UL + fd_ulong_hash( iter ) % interval );
+  }
+  dt_resched += fd_log_wallclock();
+
+  /* A service loop step: pop the earliest conn and put it back one
+     service interval later */
+
+  long dt_service = -fd_log_wallclock();
+  for( ulong iter=0UL; iter<iter_cnt; iter++ ) {
+    fd_quic_conn_t * conn = heap[ 0 ].conn;
+    fd_quic_unschedule_conn( conn );
+    conn->next_service_time = fd_quic_get_next_wakeup( quic ) + interval;
+    fd_quic_schedule_conn( conn );
+  }
+  dt_service += fd_log_wallclock();
+
+  check_queue( quic, conn_cnt );
+
+  FD_LOG_NOTICE(( "conn_cnt %6lu: schedule %6.1f ns, reschedule %6.1f ns, service step %6.1f ns",
+                  conn_cnt,
+                  (double)dt_sched  /(double)iter_cnt,
+                  (double)dt_resched/(double)iter_cnt,
+                  (double)dt_service/(double)iter_cnt ));
+
+  fd_wksp_free_laddr( fd_quic_delete( fd_quic_leave( fd_quic_fini( quic ) ) ) );
+  fd_aio_delete( fd_aio_leave( aio ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot          ( &argc, &argv );
+  fd_quic_test_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",  NULL, "gigantic"                   );
+  ulong        page_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt", NULL, 2UL                          );
+  ulong        numa_idx  = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx", NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        conn_max  = fd_env_strip_cmdline_ulong( &argc, &argv, "--conn-max", NULL, 4096UL                       );
+  ulong        iter_cnt  = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-cnt", NULL, 1UL<<18                      );
+
+  if( FD_UNLIKELY( conn_max>CONN_MAX ) ) FD_LOG_ERR(( "Increase unit test CONN_MAX to support this large --conn-max" ));
+
+  ulong page_sz = fd_cstr_to_shmem_page_sz( _page_sz );
+  if( FD_UNLIKELY( !page_sz ) ) FD_LOG_ERR(( "unsupported --page-sz" ));
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( page_sz, page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  /* Service cost vs connection count.  With the conns tracking their
+     position in the service queue, this should grow with lg conn_cnt. */
+
+  for( ulong conn_cnt=16UL; conn_cnt<=conn_max; conn_cnt<<=2 ) test_service( wksp, rng, conn_cnt, iter_cnt );
+
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_quic_test_halt();
+  fd_halt();
+  return 0;
+}
@@ -25,6 +25,18 @@
 #define FD_ACQUIRE FD_COMPILER_MFENCE
 #define FD_RELEASE FD_COMPILER_MFENCE
 
+/* Busy polling socket options, missing from older libc headers */
+
+#ifndef SO_BUSY_POLL
+#define SO_BUSY_POLL        46
+#endif
+#ifndef SO_PREFER_BUSY_POLL
+#define SO_PREFER_BUSY_POLL 69
+#endif
+#ifndef SO_BUSY_POLL_BUDGET
+#define SO_BUSY_POLL_BUDGET 70
+#endif
+
 /* Set to 1 to trace packet events to debug log */
 
 #if 0
@@ -175,6 +187,69 @@ fd_xsk_unbind( void * shxsk ) {
   return shxsk;
 }
 
+void *
+fd_xsk_set_busy_poll( void * shxsk,
+                      uint   usecs,
+                      uint   budget ) {
+  /* Argument checks */
+
+  if( FD_UNLIKELY( !shxsk ) ) {
+    FD_LOG_WARNING(( "NULL shxsk" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shxsk, fd_xsk_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shxsk" ));
+    return NULL;
+  }
+
+  fd_xsk_t * xsk = (fd_xsk_t *)shxsk;
+  if( FD_UNLIKELY( xsk->magic!=FD_XSK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic (not an fd_xsk_t?)" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( budget>USHORT_MAX ) ) {
+    FD_LOG_WARNING(( "busy poll budget %u exceeds %u", budget, (uint)USHORT_MAX ));
+    return NULL;
+  }
+
+  /* Assign */
+
+  xsk->params.busy_poll_usecs  = usecs;
+  xsk->params.busy_poll_budget = budget;
+
+  return shxsk;
+}
+
+void *
+fd_xsk_set_adaptive_wakeup( void * shxsk,
+                            int    adaptive ) {
+  /* Argument checks */
+
+  if( FD_UNLIKELY( !shxsk ) ) {
+    FD_LOG_WARNING(( "NULL shxsk" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shxsk, fd_xsk_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shxsk" ));
+    return NULL;
+  }
+
+  fd_xsk_t * xsk = (fd_xsk_t *)shxsk;
+  if( FD_UNLIKELY( xsk->magic!=FD_XSK_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic (not an fd_xsk_t?)" ));
+    return NULL;
+  }
+
+  /* Assign */
+
+  xsk->params.adaptive_wakeup = !!adaptive;
+
+  return shxsk;
+}
+
 /* New/delete *********************************************************/
 
 void *
@@ -432,6 +507,35 @@ fd_xsk_setup_umem( fd_xsk_t * xsk ) {
   return 0;
 }
 
+/* fd_xsk_setup_busy_poll: Puts the XSK in preferred busy polling mode
+   via setsockopt() if configured.  Returns 0 on success, -1 on
+   failure. */
+static int
+fd_xsk_setup_busy_poll( fd_xsk_t * xsk ) {
+  if( !xsk->params.busy_poll_usecs ) return 0;
+
+  int res;
+# define FD_SET_XSK_SOCKOPT(name, val)                                     \
+    do {                                                                  \
+      int _val = (int)(val);                                              \
+      res = setsockopt( xsk->xsk_fd, SOL_SOCKET, name, &_val, sizeof(int) ); \
+      if( FD_UNLIKELY( res!=0 ) ) {                                       \
+        FD_LOG_WARNING(( "setsockopt(SOL_SOCKET, " #name ") failed (%i-%s)", \
+                         errno, fd_io_strerror( errno ) ));               \
+        return -1;                                                        \
+      }                                                                   \
+    } while(0)
+  FD_SET_XSK_SOCKOPT( SO_PREFER_BUSY_POLL, 1                             );
+  FD_SET_XSK_SOCKOPT( SO_BUSY_POLL,        xsk->params.busy_poll_usecs   );
+  if( xsk->params.busy_poll_budget )
+    FD_SET_XSK_SOCKOPT( SO_BUSY_POLL_BUDGET, xsk->params.busy_poll_budget );
+# undef FD_SET_XSK_SOCKOPT
+
+  FD_LOG_INFO(( "xsk busy poll enabled (usecs %u, budget %u)",
+                xsk->params.busy_poll_usecs, xsk->params.busy_poll_budget ));
+  return 0;
+}
+
 /* fd_xsk_init: Creates and configures an XSK socket object, and
    attaches to a preinstalled XDP program.  The various steps are
    implemented in fd_xsk_setup_{...}. */
@@ -499,6 +603,13 @@ fd_xsk_init( fd_xsk_t * xsk ) {
   }
   FD_LOG_INFO(( "xsk bind() success" ));
 
+  /* Configure busy polling and reset wakeup accounting */
+
+  if( FD_UNLIKELY( 0!=fd_xsk_setup_busy_poll( xsk ) ) ) return -1;
+
+  fd_memset( &xsk->metrics, 0, sizeof(fd_xsk_metrics_t) );
+  xsk->tx_wakeup_cons = 0U;
+
   /* XSK successfully configured.  Traffic will arrive in XSK after
      configuring an XDP program to forward packets via XDP_REDIRECT.
      This requires providing the XSK file descriptor to the program via
@@ -608,6 +719,23 @@ fd_xsk_ifqueue( fd_xsk_t * const xsk ) {
 
 /* RX/TX implementation ***********************************************/
 
+/* fd_xsk_rx_kick: Wakes the driver for RX with a recvmsg on the XSK */
+
+static void
+fd_xsk_rx_kick( fd_xsk_t * xsk ) {
+  if( FD_UNLIKELY( -1==recvmsg( xsk->xsk_fd, NULL, MSG_DONTWAIT ) ) ) {
+    if( FD_UNLIKELY( errno!=EAGAIN ) ) {
+      FD_LOG_WARNING(( "xsk recvmsg failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
+    }
+  }
+}
+
+void
+fd_xsk_rx_wakeup( fd_xsk_t * xsk ) {
+  xsk->metrics.rx_wakeup_cnt++;
+  fd_xsk_rx_kick( xsk );
+}
+
 ulong
 fd_xsk_rx_enqueue( fd_xsk_t * xsk,
                    ulong *    offset,
@@ -696,14 +824,16 @@ fd_xsk_rx_enqueue( fd_xsk_t * xsk,
      spin two cores for us permanently, one for the TX path and one for
      the RX path.  Then we never need to notify, never need to make
      syscalls, and the performance would be even better.  Sadly, this
-     is not possible. */
-  if( FD_UNLIKELY( fd_xsk_rx_need_wakeup( xsk ) ) ) {
-    if( FD_UNLIKELY( -1==recvmsg( xsk->xsk_fd, NULL, MSG_DONTWAIT ) ) ) {
-      if( FD_UNLIKELY( errno!=EAGAIN ) ) {
-        FD_LOG_WARNING(( "xsk recvmsg failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
-      }
-    }
-  }
+     is not possible.
+
+     The closest we can get is preferred busy polling (see
+     fd_xsk_set_busy_poll), where the driver runs on our core, inside
+     the recvmsg/sendto syscalls, rather than from interrupts.  Then the
+     syscalls are how the driver gets to run at all, so they are issued
+     regardless of the need_wakeup flags.  The adaptive wakeup policy
+     (see fd_xsk_rx_wakeup_check) cuts down on the syscalls in both
+     modes by not issuing them while the RX ring is still backlogged. */
+  if( FD_UNLIKELY( fd_xsk_rx_wakeup_check( xsk ) ) ) fd_xsk_rx_kick( xsk );
 
   return sz;
 }
@@ -754,13 +884,7 @@ fd_xsk_rx_enqueue2( fd_xsk_t *            xsk,
   FD_VOLATILE( *fill->prod        ) = prod;
 
   /* See the corresponding comments in fd_xsk_rx_enqueue */
-  if( FD_UNLIKELY( fd_xsk_rx_need_wakeup( xsk ) ) ) {
-    if( FD_UNLIKELY( -1==recvmsg( xsk->xsk_fd, NULL, MSG_DONTWAIT ) ) ) {
-      if( FD_UNLIKELY( errno!=EAGAIN ) ) {
-        FD_LOG_WARNING(( "xsk recvmsg failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
-      }
-    }
-  }
+  if( FD_UNLIKELY( fd_xsk_rx_wakeup_check( xsk ) ) ) fd_xsk_rx_kick( xsk );
 
   return sz;
 }
@@ -840,7 +964,7 @@ fd_xsk_tx_enqueue( fd_xsk_t *            xsk,
        we only call `sendto` if flush is true, because otherwise there
        are no new TX messages in the ring and waking up the driver will
        have no effect. */
-    if( fd_xsk_tx_need_wakeup( xsk ) ) {
+    if( fd_xsk_tx_wakeup_check( xsk ) ) {
       if( FD_UNLIKELY( -1==sendto( xsk->xsk_fd, NULL, 0, MSG_DONTWAIT, NULL, 0 ) ) ) {
         if( FD_UNLIKELY( errno!=EAGAIN ) ) {
           FD_LOG_WARNING(( "xsk sendto failed xsk_fd=%d (%i-%s)", xsk->xsk_fd, errno, fd_io_strerror( errno ) ));
@@ -984,3 +1108,8 @@ FD_FN_CONST fd_xsk_params_t const *
 fd_xsk_get_params( fd_xsk_t const * xsk ) {
   return &xsk->params;
 }
+
+FD_FN_CONST fd_xsk_metrics_t const *
+fd_xsk_get_metrics( fd_xsk_t const * xsk ) {
+  return &xsk->metrics;
+}
@@ -152,9 +152,35 @@ struct fd_xsk_params {
        XDP_COPY      Force "copy" mode
        XDP_ZEROCOPY  Force "zero copy" mode (faster, but unstable on some NICs) */
   ushort zerocopy;
+
+  /* busy_poll_usecs: If non-zero, the XSK is put in preferred busy
+     polling mode (SO_PREFER_BUSY_POLL) with SO_BUSY_POLL set to this
+     value.  The driver then mostly runs when the application asks for
+     it (recvmsg/sendto on the XSK) instead of from interrupts, so every
+     RX and TX enqueue drives the driver, and so does an empty RX poll.
+     busy_poll_budget: Max packets processed per busy poll
+     (SO_BUSY_POLL_BUDGET), 0 for the kernel default.  See
+     fd_xsk_set_busy_poll. */
+  uint busy_poll_usecs;
+  uint busy_poll_budget;
+
+  /* adaptive_wakeup: If non-zero, wakeup syscalls are skipped while
+     the rings are hot.  See fd_xsk_set_adaptive_wakeup. */
+  int  adaptive_wakeup;
 };
 typedef struct fd_xsk_params fd_xsk_params_t;
 
+/* fd_xsk_metrics_t: Counters of the wakeup syscalls issued (or avoided)
+   by an XSK join.  Can be retrieved using fd_xsk_get_metrics() */
+
+struct fd_xsk_metrics {
+  ulong rx_wakeup_cnt;      /* recvmsg calls to wake the driver for RX         */
+  ulong tx_wakeup_cnt;      /* sendto calls to wake the driver for TX          */
+  ulong rx_wakeup_skip_cnt; /* RX wakeups skipped by the adaptive policy       */
+  ulong tx_wakeup_skip_cnt; /* TX wakeups skipped by the adaptive policy       */
+};
+typedef struct fd_xsk_metrics fd_xsk_metrics_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* Setup API **********************************************************/
@@ -207,6 +233,37 @@ fd_xsk_bind( void *       shxsk,
 void *
 fd_xsk_unbind( void * shxsk );
 
+/* fd_xsk_set_busy_poll configures the XSK to use preferred busy
+   polling (SO_PREFER_BUSY_POLL) instead of relying on interrupts and
+   the XDP_USE_NEED_WAKEUP flag alone.  usecs is the SO_BUSY_POLL value
+   and budget the SO_BUSY_POLL_BUDGET value (0 for the kernel default,
+   at most USHORT_MAX).  usecs==0 disables busy polling (the default).
+   Takes effect on the next fd_xsk_join, which requires CAP_NET_ADMIN
+   to set values above the net.core.busy_{read,poll} sysctls.  Busy
+   polling is only effective if the interface defers its interrupts,
+   e.g. via the napi_defer_hard_irqs and gro_flush_timeout sysfs knobs.
+   Returns shxsk on success or NULL on failure (logs details). */
+
+void *
+fd_xsk_set_busy_poll( void * shxsk,
+                      uint   usecs,
+                      uint   budget );
+
+/* fd_xsk_set_adaptive_wakeup enables (adaptive!=0) or disables the
+   adaptive wakeup policy of the XSK.  When enabled, the RX wakeup
+   (recvmsg) is skipped while the RX ring still holds packets that the
+   application has not consumed yet, as the application will enqueue
+   again (and wake the driver then) once it catches up.  When busy
+   polling, the TX wakeup (sendto) is also skipped while the driver is
+   already draining the TX ring.  Wakeups resume as soon as the rings go
+   idle, and the wakeups explicitly requested by the kernel via the
+   need_wakeup flags on TX are never skipped.  Returns shxsk on success
+   or NULL on failure (logs details). */
+
+void *
+fd_xsk_set_adaptive_wakeup( void * shxsk,
+                            int    adaptive );
+
 /* fd_xsk_join joins the caller to the fd_xsk_t and starts packet
    redirection.  shxsk points to the first byte of the memory region
    backing the fd_xsk_t in the caller's address space.  Returns a
@@ -391,6 +448,20 @@ fd_xsk_umem_laddr( fd_xsk_t * xsk );
 FD_FN_CONST fd_xsk_params_t const *
 fd_xsk_get_params( fd_xsk_t const * xsk );
 
+/* fd_xsk_get_metrics returns a pointer to the wakeup syscall counters
+   of xsk.  xsk must be a valid join to fd_xsk_t.  The counters are
+   updated by the I/O API and only valid for the lifetime of the join. */
+
+FD_FN_CONST fd_xsk_metrics_t const *
+fd_xsk_get_metrics( fd_xsk_t const * xsk );
+
+/* fd_xsk_rx_wakeup wakes the driver for RX by calling recvmsg on the
+   XSK unconditionally.  Used to drive the driver from an idle poll loop
+   when busy polling.  Counts as a RX wakeup in the metrics. */
+
+void
+fd_xsk_rx_wakeup( fd_xsk_t * xsk );
+
 FD_PROTOTYPES_END
 
 #endif /* defined(__linux__) */
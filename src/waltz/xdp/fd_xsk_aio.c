@@ -275,6 +275,10 @@ fd_xsk_aio_service( fd_xsk_aio_t * xsk_aio ) {
         j += enq_rc;
       }
     }
+  } else if( fd_xsk_get_params( xsk )->busy_poll_usecs ) {
+    /* Nothing received.  When busy polling, the driver only picks up
+       new packets if we ask it to. */
+    fd_xsk_rx_wakeup( xsk );
   }
 
   /* any tx to complete? */
@@ -294,6 +298,52 @@ fd_xsk_aio_tx_complete( fd_xsk_aio_t * xsk_aio ) {
 }
 
 
+uchar *
+fd_xsk_aio_tx_prepare( fd_xsk_aio_t * xsk_aio ) {
+  /* Reclaim transmit frames if we ran out */
+  if( FD_UNLIKELY( !xsk_aio->tx_top ) ) {
+    fd_xsk_aio_tx_complete( xsk_aio );
+    if( FD_UNLIKELY( !xsk_aio->tx_top ) ) return NULL;
+  }
+
+  /* The frame stays on the stack until committed */
+  return (uchar *)xsk_aio->frame_mem + xsk_aio->tx_stack[ xsk_aio->tx_top-1UL ];
+}
+
+int
+fd_xsk_aio_tx_commit( fd_xsk_aio_t * xsk_aio,
+                      ulong          sz,
+                      int            flush ) {
+
+  if( FD_UNLIKELY( sz>xsk_aio->frame_sz ) ) {
+    FD_LOG_WARNING(( "frame too large for xsk ring (%lu > %lu), aborting send",
+                     sz, xsk_aio->frame_sz ));
+    return FD_AIO_ERR_INVAL;
+  }
+
+  fd_xsk_frame_meta_t meta[1] = {{
+    .off   = xsk_aio->tx_stack[ xsk_aio->tx_top-1UL ],
+    .sz    = (uint)sz,
+    .flags = 0U
+  }};
+  if( FD_UNLIKELY( !fd_xsk_tx_enqueue( xsk_aio->xsk, meta, 1UL, flush ) ) ) return FD_AIO_ERR_AGAIN;
+
+  /* Frame is now owned by the kernel until completed */
+  xsk_aio->tx_top--;
+  return FD_AIO_SUCCESS;
+}
+
+void
+fd_xsk_aio_tx_flush( fd_xsk_aio_t * xsk_aio ) {
+  fd_xsk_frame_meta_t meta[1] = {{0}};
+  fd_xsk_tx_enqueue( xsk_aio->xsk, meta, 0UL, 1 );
+}
+
+ulong
+fd_xsk_aio_tx_frame_sz( fd_xsk_aio_t const * xsk_aio ) {
+  return xsk_aio->frame_sz;
+}
+
 /* fd_xsk_aio_send is an aio callback that transmits the given batch of
    packets through the XSK. */
 static int
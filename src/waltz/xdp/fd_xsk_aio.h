@@ -94,6 +94,47 @@ fd_xsk_aio_set_rx( fd_xsk_aio_t *   xsk_aio,
 FD_FN_CONST fd_aio_t const *
 fd_xsk_aio_get_tx( fd_xsk_aio_t const * xsk_aio );
 
+/* fd_xsk_aio_tx_{prepare,commit} are a zero copy alternative to
+   sending through fd_xsk_aio_get_tx for producers that can write the
+   packet directly into the XSK frame.
+
+   fd_xsk_aio_tx_prepare returns a pointer in the caller's address
+   space to a free TX frame in the XSK UMEM, with room for a packet of
+   up to fd_xsk_aio_tx_frame_sz() bytes.  Returns NULL if no TX frame
+   is available (all are in flight).  The frame is only reserved until
+   the next call to any other fd_xsk_aio function for this xsk_aio (in
+   particular fd_xsk_aio_service and aio sends through
+   fd_xsk_aio_get_tx use the same frames).  Calling prepare again
+   without a commit in between returns the same frame, so a prepared
+   packet can be abandoned by simply not committing it.
+
+   fd_xsk_aio_tx_commit enqueues the packet of sz bytes written to the
+   frame returned by the last fd_xsk_aio_tx_prepare for transmission.
+   If flush is non-zero, wakes up the kernel to send all enqueued
+   packets.  Returns FD_AIO_SUCCESS on success, FD_AIO_ERR_INVAL if sz
+   is too large for a frame and FD_AIO_ERR_AGAIN if the XSK TX ring is
+   full.  On failure, the packet is not sent and the frame remains
+   prepared.
+
+   fd_xsk_aio_tx_flush wakes up the kernel to send all packets enqueued
+   so far.  Committing a burst of packets with flush==0 followed by a
+   single flush costs one syscall for the whole burst instead of one
+   per packet. */
+
+uchar *
+fd_xsk_aio_tx_prepare( fd_xsk_aio_t * xsk_aio );
+
+int
+fd_xsk_aio_tx_commit( fd_xsk_aio_t * xsk_aio,
+                      ulong          sz,
+                      int            flush );
+
+void
+fd_xsk_aio_tx_flush( fd_xsk_aio_t * xsk_aio );
+
+FD_FN_PURE ulong
+fd_xsk_aio_tx_frame_sz( fd_xsk_aio_t const * xsk_aio );
+
 /* fd_xsk_aio_service services aio callbacks for incoming packets and
    handles completions for tx requests. */
 
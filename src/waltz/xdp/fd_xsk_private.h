@@ -112,6 +112,11 @@ struct __attribute__((aligned(FD_XSK_ALIGN))) fd_xsk_private {
   fd_ring_desc_t ring_fr;
   fd_ring_desc_t ring_cr;
 
+  /* Wakeup syscall counters and adaptive wakeup state.  tx_wakeup_cons
+     is the TX ring consumer seq last observed by the adaptive policy. */
+  fd_xsk_metrics_t metrics;
+  uint             tx_wakeup_cons;
+
   /* Variable-length data *********************************************/
 
   /* ... UMEM area follows ... */
@@ -135,6 +140,49 @@ fd_xsk_tx_need_wakeup( fd_xsk_t * xsk ) {
   return !!( *xsk->ring_tx.flags & XDP_RING_NEED_WAKEUP );
 }
 
+/* fd_xsk_rx_wakeup_check: returns whether a RX enqueue should wake the
+   driver with a recvmsg.  Wakes if the kernel asked for it or, when
+   busy polling, always (the recvmsg is what runs the driver).  The
+   adaptive policy defers the wakeup while the RX ring still holds
+   packets not consumed by the application: the driver is not starved
+   of work visible to us yet, and the enqueue after the ring drains
+   issues the deferred wakeup.  Updates the wakeup counters. */
+
+static inline int
+fd_xsk_rx_wakeup_check( fd_xsk_t * xsk ) {
+  if( !xsk->params.busy_poll_usecs && !fd_xsk_rx_need_wakeup( xsk ) ) return 0;
+  if( xsk->params.adaptive_wakeup &&
+      FD_VOLATILE_CONST( *xsk->ring_rx.prod )!=xsk->ring_rx.cached_cons ) {
+    xsk->metrics.rx_wakeup_skip_cnt++;
+    return 0;
+  }
+  xsk->metrics.rx_wakeup_cnt++;
+  return 1;
+}
+
+/* fd_xsk_tx_wakeup_check: returns whether a TX flush should wake the
+   driver with a sendto.  Wakes if the kernel asked for it.  When busy
+   polling, also wakes to run the driver, except (adaptive policy) if
+   the driver consumed from the TX ring since the last check, i.e. it is
+   still busy draining it.  Updates the wakeup counters. */
+
+static inline int
+fd_xsk_tx_wakeup_check( fd_xsk_t * xsk ) {
+  if( !fd_xsk_tx_need_wakeup( xsk ) ) {
+    if( !xsk->params.busy_poll_usecs ) return 0;
+    if( xsk->params.adaptive_wakeup ) {
+      uint cons = FD_VOLATILE_CONST( *xsk->ring_tx.cons );
+      if( cons!=xsk->tx_wakeup_cons ) {
+        xsk->tx_wakeup_cons = cons;
+        xsk->metrics.tx_wakeup_skip_cnt++;
+        return 0;
+      }
+    }
+  }
+  xsk->metrics.tx_wakeup_cnt++;
+  return 1;
+}
+
 FD_PROTOTYPES_END
 
 #endif /* defined(__linux__) */
@@ -209,6 +209,55 @@ test_xsk( void ) {
   FD_TEST( fd_xsk_tx_need_wakeup( xsk )==0 );
   *xsk->ring_cr.flags = 0UL;
 
+  /* Check wakeup policy */
+
+  fd_xsk_metrics_t const * metrics = fd_xsk_get_metrics( xsk );
+  FD_TEST( metrics==&xsk->metrics );
+
+  FD_TEST( fd_xsk_rx_wakeup_check( xsk )==0 ); /* no wakeup requested */
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==0 );
+
+  *xsk->ring_fr.flags = XDP_RING_NEED_WAKEUP;
+  *xsk->ring_tx.flags = XDP_RING_NEED_WAKEUP;
+  FD_TEST( fd_xsk_rx_wakeup_check( xsk )==1 );
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==1 );
+  FD_TEST( metrics->rx_wakeup_cnt==1UL && metrics->tx_wakeup_cnt==1UL );
+
+  /* Adaptive: RX wakeup deferred while RX ring has unconsumed packets,
+     TX wakeup requested by the kernel never skipped */
+
+  FD_TEST( fd_xsk_set_adaptive_wakeup( NULL,  1 )==NULL  );
+  FD_TEST( fd_xsk_set_adaptive_wakeup( shxsk, 1 )==shxsk );
+  FD_TEST( xsk->params.adaptive_wakeup==1 );
+  test_xsk_ring_rx.prod = 2U;
+  FD_TEST( fd_xsk_rx_wakeup_check( xsk )==0 );
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==1 );
+  FD_TEST( metrics->rx_wakeup_skip_cnt==1UL && metrics->tx_wakeup_cnt==2UL );
+  test_xsk_ring_rx.prod = 0U;
+  FD_TEST( fd_xsk_rx_wakeup_check( xsk )==1 );
+  *xsk->ring_fr.flags = 0UL;
+  *xsk->ring_tx.flags = 0UL;
+
+  /* Busy polling: wakeups drive the driver even if not requested.
+     Adaptive skips TX wakeups while the driver consumes the TX ring. */
+
+  FD_TEST( fd_xsk_set_busy_poll( NULL,  50U, 64U          )==NULL  );
+  FD_TEST( fd_xsk_set_busy_poll( shxsk, 50U, USHORT_MAX+1U )==NULL  );
+  FD_TEST( fd_xsk_set_busy_poll( shxsk, 50U, 64U          )==shxsk );
+  FD_TEST( xsk->params.busy_poll_usecs==50U && xsk->params.busy_poll_budget==64U );
+  FD_TEST( fd_xsk_rx_wakeup_check( xsk )==1 );
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==1 );
+  test_xsk_ring_tx.cons = 3U;
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==0 );
+  FD_TEST( fd_xsk_tx_wakeup_check( xsk )==1 ); /* no progress since */
+  FD_TEST( metrics->tx_wakeup_skip_cnt==1UL );
+  test_xsk_ring_tx.cons = 0U;
+
+  FD_TEST( fd_xsk_set_adaptive_wakeup( shxsk, 0 )==shxsk );
+  FD_TEST( fd_xsk_set_busy_poll( shxsk, 0U, 0U )==shxsk );
+  fd_memset( &xsk->metrics, 0, sizeof(fd_xsk_metrics_t) );
+  xsk->tx_wakeup_cons = 0U;
+
   /* Test fd_xsk_rx_enqueue (fill ring) */
 
   FD_TEST( fd_xsk_rx_enqueue( xsk, NULL, 0UL )==0UL );
@@ -592,6 +641,61 @@ test_xsk_aio( void ) {
   for( uint i=0U; i<8U; i++ )
     FD_TEST( xsk_aio->tx_stack[i]==i*2048U );
 
+  /* Send packets in place.  The TX ring is still full: the frames were
+     completed above, but the mock kernel did not consume the ring. */
+
+  uchar * frame_mem = (uchar *)fd_xsk_umem_laddr( xsk );
+  FD_TEST( fd_xsk_aio_tx_frame_sz( xsk_aio )==2048UL );
+
+  uchar * frame = fd_xsk_aio_tx_prepare( xsk_aio );
+  FD_TEST( frame==frame_mem + 7UL*2048UL );
+  FD_TEST( fd_xsk_aio_tx_prepare( xsk_aio )==frame ); /* uncommitted frame is reused */
+  memcpy( frame, "jjj", 3UL );
+
+  FD_TEST( fd_xsk_aio_tx_commit( xsk_aio, 2049UL, 1 )==FD_AIO_ERR_INVAL ); /* too large */
+  FD_TEST( fd_xsk_aio_tx_commit( xsk_aio,    3UL, 1 )==FD_AIO_ERR_AGAIN ); /* TX ring full */
+  FD_TEST( xsk_aio->tx_top==8UL );
+  FD_TEST( fd_xsk_aio_tx_prepare( xsk_aio )==frame ); /* still prepared */
+
+  test_xsk_ring_tx.cons = 8U;
+
+  /* Commit every TX frame without flushing */
+
+  FD_TEST( fd_xsk_aio_tx_commit( xsk_aio, 3UL, 0 )==FD_AIO_SUCCESS );
+  FD_TEST( xsk_aio->tx_top==7UL );
+  for( ulong i=1UL; i<8UL; i++ ) {
+    frame = fd_xsk_aio_tx_prepare( xsk_aio );
+    FD_TEST( frame==frame_mem + (7UL-i)*2048UL );
+    memset( frame, 'k', i );
+    FD_TEST( fd_xsk_aio_tx_commit( xsk_aio, i, 0 )==FD_AIO_SUCCESS );
+    FD_TEST( xsk_aio->tx_top==7UL-i );
+  }
+  FD_TEST( test_xsk_ring_tx.prod==8U ); /* not visible to the kernel yet */
+
+  /* All frames in flight */
+
+  FD_TEST( !fd_xsk_aio_tx_prepare( xsk_aio ) );
+
+  fd_xsk_aio_tx_flush( xsk_aio );
+  FD_TEST( test_xsk_ring_tx.prod==16U );
+  FD_TEST( test_xsk_ring_tx.packets[0].addr==7UL*2048UL );
+  FD_TEST( test_xsk_ring_tx.packets[0].len ==3U         );
+  FD_TEST( 0==memcmp( frame_mem+7UL*2048UL, "jjj", 3UL ) );
+  for( ulong i=1UL; i<8UL; i++ ) {
+    FD_TEST( test_xsk_ring_tx.packets[i].addr==(7UL-i)*2048UL );
+    FD_TEST( test_xsk_ring_tx.packets[i].len ==i              );
+  }
+
+  /* Prepare reclaims completed frames */
+
+  test_xsk_ring_tx.cons = 16U;
+  test_xsk_ring_cr.frame_idxs[ 0 ] = 7U*2048U;
+  test_xsk_ring_cr.frame_idxs[ 1 ] = 6U*2048U;
+  test_xsk_ring_cr.prod = 10U;
+
+  FD_TEST( fd_xsk_aio_tx_prepare( xsk_aio )==frame_mem + 6UL*2048UL );
+  FD_TEST( xsk_aio->tx_top==2UL );
+
   /* Connect fd_aio_t rx */
 
   fd_aio_t * rx = fd_aio_new( &_rx, NULL, test_xsk_aio_rx );